@@ -99,6 +99,13 @@ DEFINE_Double(soft_mem_limit_frac, "0.9");
 // memory greater than 16 GB.
 DEFINE_mInt64(mmap_threshold, "134217728"); // bytes
 
+// The max total bytes of the freed mmap chunks of Allocator cached for reuse, to avoid the
+// page faults and TLB shootdowns of mmap/munmap. 0 means disable the cache. Only the Allocators
+// with use_mmap = true use the cache, which no column or hash table enables now.
+DEFINE_Int64(mmap_chunk_cache_capacity, "0");
+// The cached mmap chunks not reused in this time will be unmapped.
+DEFINE_mInt32(mmap_chunk_cache_stale_sweep_time_sec, "300");
+
 // When hash table capacity is greater than 2^double_grow_degree(default 2G), grow when 75% of the capacity is satisfied.
 // Increase can reduce the number of hash table resize, but may waste more memory.
 DEFINE_mInt32(hash_table_double_grow_degree, "31");
@@ -345,6 +352,13 @@ DEFINE_mInt64(vertical_compaction_max_segment_size, "268435456");
 // In ordered data compaction, min segment size for input rowset
 DEFINE_mInt32(ordered_data_compaction_min_segment_size, "10485760");
 
+// Max number of key ranges merged in parallel by one compaction, 1 means disabled
+DEFINE_mInt32(compaction_key_range_parallelism, "1");
+// Min number of input rows of one key range in parallel compaction
+DEFINE_mInt64(compaction_key_range_min_rows, "1000000");
+// Thread number of the pool merging key ranges for all compactions
+DEFINE_Int32(compaction_key_range_max_threads, "8");
+
 // This config can be set to limit thread number in compaction thread pool.
 DEFINE_mInt32(max_base_compaction_threads, "4");
 DEFINE_mInt32(max_cumu_compaction_threads, "10");
@@ -469,6 +483,13 @@ DEFINE_mInt64(streaming_load_max_mb, "10240");
 // Therefore, it is necessary to limit the maximum number of
 // such data when using stream load to prevent excessive memory consumption.
 DEFINE_mInt64(streaming_load_json_max_mb, "100");
+// The number of scanners parsing the data of a single uncompressed csv or json lines
+// stream load in parallel. The data is split into chunks of lines which are parsed
+// out of order, so it only works for the loads whose result doesn't depend on the
+// order of rows. 1 means disabled.
+DEFINE_mInt32(stream_load_parse_parallelism, "1");
+// The size of the chunks split from stream load data for parallel parsing
+DEFINE_mInt64(stream_load_parse_chunk_size, "4194304");
 // the alive time of a TabletsChannel.
 // If the channel does not receive any data till this time,
 // the channel will be removed.
@@ -759,6 +780,11 @@ DEFINE_mInt32(external_table_connect_timeout_sec, "30");
 
 // Global bitmap cache capacity for aggregation cache, size in bytes
 DEFINE_Int64(delete_bitmap_agg_cache_capacity, "104857600");
+DEFINE_mInt32(delete_bitmap_agg_cache_stale_sweep_time_sec, "1800");
+
+// Pick the candidate segments of a primary key lookup through an interval tree of the
+// segments' key bounds, if the looked up rowsets have at least so many segments.
+DEFINE_mInt32(pk_lookup_rowset_tree_min_segments, "32");
 
 // s3 config
 DEFINE_mInt32(max_remote_storage_count, "10");
@@ -852,6 +878,8 @@ DEFINE_mInt32(parquet_header_max_size_mb, "1");
 DEFINE_mInt32(parquet_rowgroup_max_buffer_mb, "128");
 // Max buffer size for parquet chunk column
 DEFINE_mInt32(parquet_column_max_buffer_mb, "8");
+// The size of the data buffered by parquet writer before the row group is flushed
+DEFINE_mInt32(parquet_writer_row_group_max_buffer_mb, "128");
 DEFINE_mDouble(max_amplified_read_ratio, "0.8");
 
 // OrcReader
@@ -929,6 +957,9 @@ DEFINE_Bool(enable_java_support, "true");
 DEFINE_Bool(enable_fuzzy_mode, "false");
 
 DEFINE_Int32(pipeline_executor_size, "0");
+// Bind the pipeline workers to the cores of NUMA nodes, and steal the tasks in the same NUMA node
+// first. The memory of a task is allocated in the node of the worker by the first touch policy.
+DEFINE_Bool(enable_pipeline_numa_affinity, "false");
 DEFINE_Bool(enable_workload_group_for_scan, "false");
 
 // Temp config. True to use optimization for bitmap_index apply predicate except leaf node of the and node.
@@ -965,6 +996,8 @@ DEFINE_Int32(inverted_index_fd_number_limit_percent, "40"); // 40%
 
 // inverted index match bitmap cache size
 DEFINE_String(inverted_index_query_cache_limit, "10%");
+// inverted index term postings cache size
+DEFINE_String(inverted_index_term_cache_limit, "5%");
 
 // inverted index
 DEFINE_mDouble(inverted_index_ram_buffer_size, "512");
@@ -998,6 +1031,33 @@ DEFINE_mInt64(time_series_compaction_time_threshold_seconds, "3600");
 // max depth of expression tree allowed.
 DEFINE_Int32(max_depth_of_expr_tree, "600");
 
+// Evaluate an expr, e.g. the rhs of AND/OR or a branch of CASE WHEN, only on the rows whose
+// results are needed if the ratio of them to the rows of the block is not larger than this.
+DEFINE_mDouble(expr_selection_max_ratio, "0.3");
+
+// Evaluate the trees of numeric arithmetic, comparison and cast exprs over slot refs and
+// literals in one pass over the input columns, without a column for each node of the tree.
+DEFINE_mBool(enable_fused_expr_kernel, "true");
+
+// Evaluate the identical deterministic subexprs of the projections, conjuncts and agg inputs
+// of an operator once per block and share the result column between them.
+DEFINE_mBool(enable_shared_common_exprs, "true");
+
+// Measure the cost and the selectivity of the conjuncts on one of every this number of
+// blocks, and evaluate the conjuncts in the order of the least expected cost. 0 disables it.
+DEFINE_mInt32(conjuncts_reorder_sample_interval, "8");
+
+// Aggregate the string keys of a multi-column GROUP BY by their dictionary codes, so that the
+// keys are packed into fixed size keys, if the ratio of the distinct keys to the rows of the
+// first block is not larger than this. 0 disables it.
+DEFINE_mDouble(agg_string_key_dict_max_ratio, "0.25");
+
+// Finalize this number of output blocks of an aggregation concurrently, if there are enough
+// rows left in the hash table. 1 disables it.
+DEFINE_mInt32(agg_finalize_parallelism, "4");
+// The thread number of the pool finalizing the results of the aggregations.
+DEFINE_Int32(agg_finalize_thread_num, "16");
+
 // Report a tablet as bad when io errors occurs more than this value.
 DEFINE_mInt64(max_tablet_io_errors, "-1");
 
@@ -1028,6 +1088,24 @@ DEFINE_Bool(enable_set_in_bitmap_value, "false");
 
 DEFINE_Int64(max_hdfs_file_handle_cache_num, "20000");
 DEFINE_Int64(max_external_file_meta_cache_num, "20000");
+// capacity in bytes of the cache of parquet dictionary pages and row group filter results,
+// 0 means disable the cache
+DEFINE_Int64(parquet_scan_cache_capacity, "268435456");
+DEFINE_mInt32(parquet_scan_cache_stale_sweep_time_sec, "1800");
+
+// capacity in bytes of the cache of the output blocks of olap scan nodes, which is reused by
+// the queries with the same scan on the same tablet versions. 0 means disable the cache
+DEFINE_Int64(scan_result_cache_capacity, "0");
+DEFINE_mInt32(scan_result_cache_stale_sweep_time_sec, "300");
+// the scan results larger than this are not cached
+DEFINE_mInt64(scan_result_cache_max_entry_bytes, "1073741824");
+// the scan results larger than this are spilled to the local disk
+DEFINE_mInt64(scan_result_cache_max_memory_entry_bytes, "67108864");
+// max total bytes of the scan results spilled to the local disk
+DEFINE_mInt64(scan_result_cache_disk_capacity, "10737418240");
+// whether to cache the scan results of duplicate key tablets by rowsets, the scans of the
+// tablets with new loads only read the new rowsets
+DEFINE_mBool(enable_scan_result_cache_by_rowset, "false");
 
 // max_write_buffer_number for rocksdb
 DEFINE_Int32(rocksdb_max_write_buffer_number, "5");
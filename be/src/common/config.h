@@ -134,6 +134,13 @@ DECLARE_Double(soft_mem_limit_frac);
 // memory greater than 16 GB.
 DECLARE_mInt64(mmap_threshold); // bytes
 
+// The max total bytes of the freed mmap chunks of Allocator cached for reuse, to avoid the
+// page faults and TLB shootdowns of mmap/munmap. 0 means disable the cache. Only the Allocators
+// with use_mmap = true use the cache, which no column or hash table enables now.
+DECLARE_Int64(mmap_chunk_cache_capacity);
+// The cached mmap chunks not reused in this time will be unmapped.
+DECLARE_mInt32(mmap_chunk_cache_stale_sweep_time_sec);
+
 // When hash table capacity is greater than 2^double_grow_degree(default 2G), grow when 75% of the capacity is satisfied.
 // Increase can reduce the number of hash table resize, but may waste more memory.
 DECLARE_mInt32(hash_table_double_grow_degree);
@@ -391,6 +398,13 @@ DECLARE_mInt64(vertical_compaction_max_segment_size);
 // In ordered data compaction, min segment size for input rowset
 DECLARE_mInt32(ordered_data_compaction_min_segment_size);
 
+// Max number of key ranges merged in parallel by one compaction, 1 means disabled
+DECLARE_mInt32(compaction_key_range_parallelism);
+// Min number of input rows of one key range in parallel compaction
+DECLARE_mInt64(compaction_key_range_min_rows);
+// Thread number of the pool merging key ranges for all compactions
+DECLARE_Int32(compaction_key_range_max_threads);
+
 // This config can be set to limit thread number in compaction thread pool.
 DECLARE_mInt32(max_base_compaction_threads);
 DECLARE_mInt32(max_cumu_compaction_threads);
@@ -510,6 +524,13 @@ DECLARE_mInt64(streaming_load_max_mb);
 // Therefore, it is necessary to limit the maximum number of
 // such data when using stream load to prevent excessive memory consumption.
 DECLARE_mInt64(streaming_load_json_max_mb);
+// The number of scanners parsing the data of a single uncompressed csv or json lines
+// stream load in parallel. The data is split into chunks of lines which are parsed
+// out of order, so it only works for the loads whose result doesn't depend on the
+// order of rows. 1 means disabled.
+DECLARE_mInt32(stream_load_parse_parallelism);
+// The size of the chunks split from stream load data for parallel parsing
+DECLARE_mInt64(stream_load_parse_chunk_size);
 // the alive time of a TabletsChannel.
 // If the channel does not receive any data till this time,
 // the channel will be removed.
@@ -801,6 +822,11 @@ DECLARE_mInt32(external_table_connect_timeout_sec);
 
 // Global bitmap cache capacity for aggregation cache, size in bytes
 DECLARE_Int64(delete_bitmap_agg_cache_capacity);
+DECLARE_mInt32(delete_bitmap_agg_cache_stale_sweep_time_sec);
+
+// Pick the candidate segments of a primary key lookup through an interval tree of the
+// segments' key bounds, if the looked up rowsets have at least so many segments.
+DECLARE_mInt32(pk_lookup_rowset_tree_min_segments);
 
 // s3 config
 DECLARE_mInt32(max_remote_storage_count);
@@ -885,6 +911,8 @@ DECLARE_mInt32(parquet_header_max_size_mb);
 DECLARE_mInt32(parquet_rowgroup_max_buffer_mb);
 // Max buffer size for parquet chunk column
 DECLARE_mInt32(parquet_column_max_buffer_mb);
+// The size of the data buffered by parquet writer before the row group is flushed
+DECLARE_mInt32(parquet_writer_row_group_max_buffer_mb);
 // Merge small IO, the max amplified read ratio
 DECLARE_mDouble(max_amplified_read_ratio);
 
@@ -959,6 +987,9 @@ DECLARE_Bool(enable_java_support);
 DECLARE_Bool(enable_fuzzy_mode);
 
 DECLARE_Int32(pipeline_executor_size);
+// Bind the pipeline workers to the cores of NUMA nodes, and steal the tasks in the same NUMA node
+// first. The memory of a task is allocated in the node of the worker by the first touch policy.
+DECLARE_Bool(enable_pipeline_numa_affinity);
 DECLARE_Bool(enable_workload_group_for_scan);
 
 // Temp config. True to use optimization for bitmap_index apply predicate except leaf node of the and node.
@@ -989,6 +1020,8 @@ DECLARE_Int32(inverted_index_fd_number_limit_percent); // 50%
 
 // inverted index match bitmap cache size
 DECLARE_String(inverted_index_query_cache_limit);
+// inverted index term postings cache size
+DECLARE_String(inverted_index_term_cache_limit);
 
 // inverted index
 DECLARE_mDouble(inverted_index_ram_buffer_size);
@@ -1019,6 +1052,33 @@ DECLARE_mInt64(time_series_compaction_time_threshold_seconds);
 // max depth of expression tree allowed.
 DECLARE_Int32(max_depth_of_expr_tree);
 
+// Evaluate an expr, e.g. the rhs of AND/OR or a branch of CASE WHEN, only on the rows whose
+// results are needed if the ratio of them to the rows of the block is not larger than this.
+DECLARE_mDouble(expr_selection_max_ratio);
+
+// Evaluate the trees of numeric arithmetic, comparison and cast exprs over slot refs and
+// literals in one pass over the input columns, without a column for each node of the tree.
+DECLARE_mBool(enable_fused_expr_kernel);
+
+// Evaluate the identical deterministic subexprs of the projections, conjuncts and agg inputs
+// of an operator once per block and share the result column between them.
+DECLARE_mBool(enable_shared_common_exprs);
+
+// Measure the cost and the selectivity of the conjuncts on one of every this number of
+// blocks, and evaluate the conjuncts in the order of the least expected cost. 0 disables it.
+DECLARE_mInt32(conjuncts_reorder_sample_interval);
+
+// Aggregate the string keys of a multi-column GROUP BY by their dictionary codes, so that the
+// keys are packed into fixed size keys, if the ratio of the distinct keys to the rows of the
+// first block is not larger than this. 0 disables it.
+DECLARE_mDouble(agg_string_key_dict_max_ratio);
+
+// Finalize this number of output blocks of an aggregation concurrently, if there are enough
+// rows left in the hash table. 1 disables it.
+DECLARE_mInt32(agg_finalize_parallelism);
+// The thread number of the pool finalizing the results of the aggregations.
+DECLARE_Int32(agg_finalize_thread_num);
+
 // Report a tablet as bad when io errors occurs more than this value.
 DECLARE_mInt64(max_tablet_io_errors);
 
@@ -1052,6 +1112,24 @@ DECLARE_Bool(enable_set_in_bitmap_value);
 DECLARE_Int64(max_hdfs_file_handle_cache_num);
 // max number of meta info of external files, such as parquet footer
 DECLARE_Int64(max_external_file_meta_cache_num);
+// capacity in bytes of the cache of parquet dictionary pages and row group filter results,
+// 0 means disable the cache
+DECLARE_Int64(parquet_scan_cache_capacity);
+DECLARE_mInt32(parquet_scan_cache_stale_sweep_time_sec);
+
+// capacity in bytes of the cache of the output blocks of olap scan nodes, which is reused by
+// the queries with the same scan on the same tablet versions. 0 means disable the cache
+DECLARE_Int64(scan_result_cache_capacity);
+DECLARE_mInt32(scan_result_cache_stale_sweep_time_sec);
+// the scan results larger than this are not cached
+DECLARE_mInt64(scan_result_cache_max_entry_bytes);
+// the scan results larger than this are spilled to the local disk
+DECLARE_mInt64(scan_result_cache_max_memory_entry_bytes);
+// max total bytes of the scan results spilled to the local disk
+DECLARE_mInt64(scan_result_cache_disk_capacity);
+// whether to cache the scan results of duplicate key tablets by rowsets, the scans of the
+// tablets with new loads only read the new rowsets
+DECLARE_mBool(enable_scan_result_cache_by_rowset);
 
 // max_write_buffer_number for rocksdb
 DECLARE_Int32(rocksdb_max_write_buffer_number);
@@ -197,6 +197,13 @@ Status ExecNode::close(RuntimeState* state) {
     LOG(INFO) << "fragment_instance_id=" << print_id(state->fragment_instance_id()) << " closed";
     _is_closed = true;
 
+    if (_runtime_profile != nullptr) {
+        auto conjuncts_info = vectorized::VExprContext::conjuncts_stats_string(_conjuncts);
+        if (!conjuncts_info.empty()) {
+            _runtime_profile->add_info_string("ConjunctsOrder", conjuncts_info);
+        }
+    }
+
     Status result;
     for (int i = 0; i < _children.size(); ++i) {
         auto st = _children[i]->close(state);
@@ -179,6 +179,26 @@ Status OlapTableSchemaParam::init(const TOlapTableSchemaParam& tschema) {
     return Status::OK();
 }
 
+bool OlapTableSchemaParam::is_load_order_insensitive(const TOlapTableSchemaParam& tschema) {
+    if (tschema.__isset.is_partial_update && tschema.is_partial_update) {
+        return false;
+    }
+    for (auto& t_index : tschema.indexes) {
+        if (!t_index.__isset.columns_desc) {
+            return false;
+        }
+        for (auto& tcolumn_desc : t_index.columns_desc) {
+            // the value of the last loaded row is kept, eg. value columns of unique key table
+            if (tcolumn_desc.__isset.aggregation_type &&
+                (tcolumn_desc.aggregation_type == TAggregationType::REPLACE ||
+                 tcolumn_desc.aggregation_type == TAggregationType::REPLACE_IF_NOT_NULL)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 void OlapTableSchemaParam::to_protobuf(POlapTableSchemaParam* pschema) const {
     pschema->set_db_id(_db_id);
     pschema->set_table_id(_table_id);
@@ -73,6 +73,10 @@ public:
 
     void to_protobuf(POlapTableSchemaParam* pschema) const;
 
+    // Whether the data of the table after a load doesn't depend on the order of the
+    // loaded rows, so the rows can be loaded out of order.
+    static bool is_load_order_insensitive(const TOlapTableSchemaParam& tschema);
+
     // NOTE: this function is not thread-safe.
     POlapTableSchemaParam* to_protobuf() const {
         if (_proto_schema == nullptr) {
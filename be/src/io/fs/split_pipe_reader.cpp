@@ -0,0 +1,129 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/split_pipe_reader.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace doris {
+namespace io {
+
+PipeSplitter::PipeSplitter(FileReaderSPtr pipe, char line_delimiter, size_t chunk_size)
+        : _pipe(std::move(pipe)),
+          _line_delimiter(line_delimiter),
+          _chunk_size(std::max<size_t>(chunk_size, 1)) {}
+
+Status PipeSplitter::next_chunk(std::unique_ptr<uint8_t[]>* chunk, size_t* size) {
+    std::lock_guard<std::mutex> l(_lock);
+    *size = 0;
+    if (_eof && _remain_size == 0) {
+        return Status::OK();
+    }
+
+    size_t capacity = std::max(_chunk_size, _remain_size * 2);
+    std::unique_ptr<uint8_t[]> buf(new uint8_t[capacity]);
+    size_t buf_size = _remain_size;
+    if (_remain_size > 0) {
+        memcpy(buf.get(), _remain.get(), _remain_size);
+        _remain.reset();
+        _remain_size = 0;
+    }
+
+    // the remaining data doesn't contain the line delimiter
+    size_t search_pos = buf_size;
+    size_t chunk_end = 0;
+    while (!_eof) {
+        if (buf_size == capacity) {
+            // the line is longer than the chunk, extend the buffer
+            capacity *= 2;
+            std::unique_ptr<uint8_t[]> new_buf(new uint8_t[capacity]);
+            memcpy(new_buf.get(), buf.get(), buf_size);
+            buf = std::move(new_buf);
+        }
+        size_t read_len = 0;
+        RETURN_IF_ERROR(_pipe->read_at(0, Slice(buf.get() + buf_size, capacity - buf_size),
+                                       &read_len));
+        if (read_len == 0) {
+            _eof = true;
+            break;
+        }
+        buf_size += read_len;
+        auto* last_delimiter = reinterpret_cast<const uint8_t*>(
+                memrchr(buf.get() + search_pos, _line_delimiter, buf_size - search_pos));
+        if (last_delimiter != nullptr) {
+            chunk_end = last_delimiter - buf.get() + 1;
+            break;
+        }
+        search_pos = buf_size;
+    }
+
+    if (_eof) {
+        // the last chunk contains all the remaining data
+        chunk_end = buf_size;
+    }
+    if (chunk_end < buf_size) {
+        _remain_size = buf_size - chunk_end;
+        _remain.reset(new uint8_t[_remain_size]);
+        memcpy(_remain.get(), buf.get() + chunk_end, _remain_size);
+    }
+    *chunk = std::move(buf);
+    *size = chunk_end;
+    return Status::OK();
+}
+
+SplitPipeReader::SplitPipeReader(std::shared_ptr<PipeSplitter> splitter, RuntimeProfile* profile)
+        : _splitter(std::move(splitter)) {
+    _read_bytes_counter = ADD_COUNTER(profile, "SplitPipeReadBytes", TUnit::BYTES);
+    _read_chunks_counter = ADD_COUNTER(profile, "SplitPipeReadChunks", TUnit::UNIT);
+    _wait_chunk_timer = ADD_TIMER(profile, "SplitPipeWaitChunkTime");
+}
+
+Status SplitPipeReader::read_at_impl(size_t /*offset*/, Slice result, size_t* bytes_read,
+                                     const IOContext* /*io_ctx*/) {
+    *bytes_read = 0;
+    if (result.size == 0) {
+        return Status::OK();
+    }
+    if (_chunk_pos == _chunk_size) {
+        if (_eof) {
+            return Status::OK();
+        }
+        {
+            SCOPED_TIMER(_wait_chunk_timer);
+            _chunk_pos = 0;
+            RETURN_IF_ERROR(_splitter->next_chunk(&_chunk, &_chunk_size));
+        }
+        if (_chunk_size == 0) {
+            _eof = true;
+            _chunk.reset();
+            return Status::OK();
+        }
+        COUNTER_UPDATE(_read_chunks_counter, 1);
+        COUNTER_UPDATE(_read_bytes_counter, _chunk_size);
+    }
+    // only return the data of current chunk, the reader will read again for more data
+    *bytes_read = std::min(result.size, _chunk_size - _chunk_pos);
+    memcpy(result.data, _chunk.get() + _chunk_pos, *bytes_read);
+    _chunk_pos += *bytes_read;
+    return Status::OK();
+}
+
+} // namespace io
+} // namespace doris
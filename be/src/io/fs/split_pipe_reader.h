@@ -0,0 +1,102 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <mutex>
+
+#include "common/status.h"
+#include "io/fs/file_reader.h"
+#include "io/fs/file_reader_writer_fwd.h"
+#include "io/fs/file_system.h"
+#include "io/fs/path.h"
+#include "util/runtime_profile.h"
+#include "util/slice.h"
+
+namespace doris {
+namespace io {
+class IOContext;
+
+// Splits the data read from a pipe into chunks which end at the line delimiter,
+// so that the chunks can be parsed by several readers in parallel.
+// Thread safe.
+class PipeSplitter {
+public:
+    PipeSplitter(FileReaderSPtr pipe, char line_delimiter, size_t chunk_size);
+
+    // Read the next chunk of lines. *size is 0 if all data of the pipe has been read.
+    // The last chunk may not end with the line delimiter.
+    Status next_chunk(std::unique_ptr<uint8_t[]>* chunk, size_t* size);
+
+private:
+    std::mutex _lock;
+    FileReaderSPtr _pipe;
+    const char _line_delimiter;
+    const size_t _chunk_size;
+    // the data after the last line delimiter of the previous chunk
+    std::unique_ptr<uint8_t[]> _remain;
+    size_t _remain_size = 0;
+    bool _eof = false;
+};
+
+// Reads the chunks of a PipeSplitter one by one as a stream.
+// Each chunk is read by only one SplitPipeReader, and every line is in one chunk.
+class SplitPipeReader final : public FileReader {
+public:
+    SplitPipeReader(std::shared_ptr<PipeSplitter> splitter, RuntimeProfile* profile);
+
+    ~SplitPipeReader() override = default;
+
+    Status close() override {
+        _closed = true;
+        return Status::OK();
+    }
+
+    const Path& path() const override { return _path; }
+
+    size_t size() const override { return 0; }
+
+    bool closed() const override { return _closed; }
+
+    FileSystemSPtr fs() const override { return nullptr; }
+
+protected:
+    Status read_at_impl(size_t offset, Slice result, size_t* bytes_read,
+                        const IOContext* io_ctx) override;
+
+private:
+    std::shared_ptr<PipeSplitter> _splitter;
+    std::unique_ptr<uint8_t[]> _chunk;
+    size_t _chunk_size = 0;
+    size_t _chunk_pos = 0;
+    bool _eof = false;
+    bool _closed = false;
+
+    // no use, only for compatibility with the `Path` interface
+    Path _path = "";
+
+    RuntimeProfile::Counter* _read_bytes_counter = nullptr;
+    RuntimeProfile::Counter* _read_chunks_counter = nullptr;
+    RuntimeProfile::Counter* _wait_chunk_timer = nullptr;
+};
+
+} // namespace io
+} // namespace doris
@@ -59,6 +59,32 @@ Status CalcDeleteBitmapToken::submit(TabletSharedPtr tablet, RowsetSharedPtr cur
     });
 }
 
+Status CalcDeleteBitmapToken::submit_between_segments(
+        TabletSharedPtr tablet, RowsetSharedPtr cur_rowset,
+        const std::vector<segment_v2::SegmentSharedPtr>& segments) {
+    {
+        std::shared_lock rlock(_lock);
+        RETURN_IF_ERROR(_status);
+    }
+
+    DeleteBitmapPtr bitmap = std::make_shared<DeleteBitmap>(tablet->tablet_id());
+    {
+        std::lock_guard wlock(_lock);
+        _delete_bitmaps.push_back(bitmap);
+    }
+    return _thread_token->submit_func([=, this]() {
+        auto st = tablet->calc_delete_bitmap_between_segments(cur_rowset, segments, bitmap);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to calc delete bitmap between segments, tablet_id: "
+                         << tablet->tablet_id() << " rowset: " << cur_rowset->rowset_id();
+            std::lock_guard wlock(_lock);
+            if (_status.ok()) {
+                _status = st;
+            }
+        }
+    });
+}
+
 Status CalcDeleteBitmapToken::wait() {
     _thread_token->wait();
     // all tasks complete here, don't need lock;
@@ -54,6 +54,11 @@ public:
                   const std::vector<RowsetSharedPtr>& target_rowsets, int64_t end_version,
                   RowsetWriter* rowset_writer);
 
+    // Submit the calculation of delete bitmap between the segments of `cur_rowset`, it's
+    // independent of the tasks looking up the keys in existing rowsets so they run concurrently.
+    Status submit_between_segments(TabletSharedPtr tablet, RowsetSharedPtr cur_rowset,
+                                   const std::vector<segment_v2::SegmentSharedPtr>& segments);
+
     // wait all tasks in token to be completed.
     Status wait();
 
@@ -55,8 +55,12 @@
 #include "olap/txn_manager.h"
 #include "olap/utils.h"
 #include "runtime/memory/mem_tracker_limiter.h"
+#include "runtime/thread_context.h"
+#include "util/defer_op.h"
+#include "util/threadpool.h"
 #include "util/time.h"
 #include "util/trace.h"
+#include "vec/exec/scan/scan_result_cache.h"
 
 using std::vector;
 
@@ -295,6 +299,7 @@ Status Compaction::do_compaction_impl(int64_t permits) {
 
     if (handle_ordered_data_compaction()) {
         RETURN_IF_ERROR(modify_rowsets());
+        carry_over_scan_result_cache();
 
         int64_t now = UnixMillis();
         if (compaction_type() == ReaderType::READER_CUMULATIVE_COMPACTION) {
@@ -337,10 +342,23 @@ Status Compaction::do_compaction_impl(int64_t permits) {
         stats.rowid_conversion = &_rowid_conversion;
     }
 
+    // Merge key ranges in parallel. Cold data compaction can't link files and
+    // index compaction needs the segments of the output rowset writer.
+    std::vector<Merger::KeyRange> key_ranges;
+    if (config::compaction_key_range_parallelism > 1 &&
+        compaction_type() != ReaderType::READER_COLD_DATA_COMPACTION &&
+        ctx.skip_inverted_index.empty()) {
+        Merger::split_key_ranges(_input_rowsets, config::compaction_key_range_parallelism,
+                                 config::compaction_key_range_min_rows, &key_ranges);
+    }
+    bool parallel_merge = key_ranges.size() > 1;
+
     Status res;
     {
         SCOPED_TIMER(_merge_rowsets_latency_timer);
-        if (vertical_compaction) {
+        if (parallel_merge) {
+            res = do_key_range_parallel_merge(ctx, vertical_compaction, key_ranges, &stats);
+        } else if (vertical_compaction) {
             res = Merger::vertical_merge_rowsets(_tablet, compaction_type(), _cur_tablet_schema,
                                                  _input_rs_readers, _output_rs_writer.get(),
                                                  get_avg_segment_rows(), &stats);
@@ -359,7 +377,10 @@ Status Compaction::do_compaction_impl(int64_t permits) {
     COUNTER_UPDATE(_merged_rows_counter, stats.merged_rows);
     COUNTER_UPDATE(_filtered_rows_counter, stats.filtered_rows);
 
-    _output_rowset = _output_rs_writer->build();
+    if (!parallel_merge) {
+        // the output rowset of parallel merge has been built
+        _output_rowset = _output_rs_writer->build();
+    }
     if (_output_rowset == nullptr) {
         return Status::Error<ROWSET_BUILDER_INIT>("rowset writer build failed. output_version: {}",
                                                   _output_version.to_string());
@@ -372,7 +393,8 @@ Status Compaction::do_compaction_impl(int64_t permits) {
     // 3. check correctness
     RETURN_IF_ERROR(check_correctness(stats));
 
-    if (_input_row_num > 0 && stats.rowid_conversion && config::inverted_index_compaction_enable) {
+    if (_input_row_num > 0 && stats.rowid_conversion && config::inverted_index_compaction_enable &&
+        !ctx.skip_inverted_index.empty()) {
         OlapStopWatch inverted_watch;
         // translation vec
         // <<dest_idx_num, desc_docId>>
@@ -445,6 +467,7 @@ Status Compaction::do_compaction_impl(int64_t permits) {
 
     // 4. modify rowsets in memory
     RETURN_IF_ERROR(modify_rowsets(&stats));
+    carry_over_scan_result_cache();
 
     // 5. update last success compaction time
     int64_t now = UnixMillis();
@@ -476,6 +499,7 @@ Status Compaction::do_compaction_impl(int64_t permits) {
               << ", disk=" << _tablet->data_dir()->path() << ", segments=" << _input_num_segments
               << ", input_row_num=" << _input_row_num
               << ", output_row_num=" << _output_rowset->num_rows()
+              << ", key_ranges=" << std::max<size_t>(key_ranges.size(), 1)
               << ". elapsed time=" << watch.get_elapse_second()
               << "s. cumulative_compaction_policy=" << cumu_policy->name()
               << ", compact_row_per_second=" << int(_input_row_num / watch.get_elapse_second());
@@ -483,6 +507,138 @@ Status Compaction::do_compaction_impl(int64_t permits) {
     return Status::OK();
 }
 
+Status Compaction::do_key_range_parallel_merge(const RowsetWriterContext& ctx, bool is_vertical,
+                                               const std::vector<Merger::KeyRange>& key_ranges,
+                                               Merger::Statistics* stats) {
+    size_t num_ranges = key_ranges.size();
+    LOG(INFO) << "merge " << num_ranges << " key ranges in parallel, tablet="
+              << _tablet->full_name() << ", output_version=" << _output_version;
+    std::vector<std::unique_ptr<RowsetWriter>> range_writers(num_ranges);
+    std::vector<RowIdConversion> range_rowid_conversions(num_ranges);
+    std::vector<Merger::Statistics> range_stats(num_ranges);
+    std::vector<Status> range_statuses(num_ranges);
+    for (size_t i = 0; i < num_ranges; ++i) {
+        RowsetWriterContext range_ctx = ctx;
+        if (is_vertical) {
+            RETURN_IF_ERROR(_tablet->create_vertical_rowset_writer(range_ctx, &range_writers[i]));
+        } else {
+            RETURN_IF_ERROR(_tablet->create_rowset_writer(range_ctx, &range_writers[i]));
+        }
+        if (stats->rowid_conversion != nullptr) {
+            range_stats[i].rowid_conversion = &range_rowid_conversions[i];
+        }
+    }
+
+    int64_t max_rows_per_segment = get_avg_segment_rows();
+    auto merge_range = [&, this](size_t i) -> Status {
+        // every range reads the input rowsets with readers of its own
+        std::vector<RowSetSplits> rs_splits;
+        for (size_t j = 0; j < _input_rowsets.size(); ++j) {
+            const auto& segment_offsets = key_ranges[i].segment_offsets[j];
+            if (segment_offsets.first == segment_offsets.second) {
+                continue;
+            }
+            RowsetReaderSharedPtr rs_reader;
+            RETURN_IF_ERROR(_input_rowsets[j]->create_reader(&rs_reader));
+            RowSetSplits rs_split(rs_reader);
+            rs_split.segment_offsets = segment_offsets;
+            rs_splits.push_back(std::move(rs_split));
+        }
+        if (is_vertical) {
+            return Merger::vertical_merge_rowsets(_tablet, compaction_type(), _cur_tablet_schema,
+                                                  rs_splits, range_writers[i].get(),
+                                                  max_rows_per_segment, &range_stats[i]);
+        }
+        return Merger::vmerge_rowsets(_tablet, compaction_type(), _cur_tablet_schema, rs_splits,
+                                      range_writers[i].get(), &range_stats[i]);
+    };
+
+    ThreadPool* thread_pool = StorageEngine::instance()->compaction_key_range_thread_pool();
+    if (thread_pool == nullptr) {
+        for (size_t i = 0; i < num_ranges; ++i) {
+            range_statuses[i] = merge_range(i);
+        }
+    } else {
+        auto token = thread_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+        for (size_t i = 0; i < num_ranges; ++i) {
+            auto st = token->submit_func([&, i, this]() {
+                SCOPED_ATTACH_TASK(_mem_tracker);
+                range_statuses[i] = merge_range(i);
+            });
+            if (!st.ok()) {
+                range_statuses[i] = st;
+            }
+        }
+        // the tasks reference the local variables, wait them before return
+        token->wait();
+    }
+    for (auto& st : range_statuses) {
+        RETURN_IF_ERROR(st);
+    }
+
+    // the files of range rowsets are hard linked to the output rowset, so the
+    // range rowsets are always unused after this function
+    std::vector<RowsetSharedPtr> range_rowsets;
+    Defer defer {[&range_rowsets]() {
+        for (auto& rowset : range_rowsets) {
+            StorageEngine::instance()->add_unused_rowset(rowset);
+        }
+    }};
+    for (size_t i = 0; i < num_ranges; ++i) {
+        RowsetSharedPtr rowset = range_writers[i]->build();
+        if (rowset == nullptr) {
+            return Status::Error<ROWSET_BUILDER_INIT>(
+                    "rowset writer build failed. output_version: {}, key range: {}",
+                    _output_version.to_string(), i);
+        }
+        range_rowsets.push_back(std::move(rowset));
+    }
+
+    RowsetId output_rowset_id = _output_rs_writer->rowset_id();
+    if (stats->rowid_conversion != nullptr) {
+        stats->rowid_conversion->set_dst_rowset_id(output_rowset_id);
+    }
+    uint32_t seg_id = 0;
+    int64_t num_rows = 0;
+    int64_t total_disk_size = 0;
+    int64_t data_disk_size = 0;
+    int64_t index_disk_size = 0;
+    std::vector<KeyBoundsPB> segment_key_bounds;
+    for (size_t i = 0; i < num_ranges; ++i) {
+        auto& rowset = range_rowsets[i];
+        RETURN_IF_ERROR(rowset->link_files_to(_tablet->tablet_path(), output_rowset_id, seg_id));
+        if (stats->rowid_conversion != nullptr) {
+            stats->rowid_conversion->merge(range_rowid_conversions[i], seg_id);
+        }
+        seg_id += rowset->num_segments();
+
+        std::vector<KeyBoundsPB> key_bounds;
+        rowset->get_segments_key_bounds(&key_bounds);
+        segment_key_bounds.insert(segment_key_bounds.end(), key_bounds.begin(), key_bounds.end());
+        num_rows += rowset->num_rows();
+        total_disk_size += rowset->rowset_meta()->total_disk_size();
+        data_disk_size += rowset->rowset_meta()->data_disk_size();
+        index_disk_size += rowset->index_disk_size();
+        stats->output_rows += range_stats[i].output_rows;
+        stats->merged_rows += range_stats[i].merged_rows;
+        stats->filtered_rows += range_stats[i].filtered_rows;
+    }
+
+    // build output rowset
+    RowsetMetaSharedPtr rowset_meta = std::make_shared<RowsetMeta>();
+    rowset_meta->set_num_rows(num_rows);
+    rowset_meta->set_total_disk_size(total_disk_size);
+    rowset_meta->set_data_disk_size(data_disk_size);
+    rowset_meta->set_index_disk_size(index_disk_size);
+    rowset_meta->set_empty(num_rows == 0);
+    rowset_meta->set_num_segments(seg_id);
+    rowset_meta->set_segments_overlap(NONOVERLAPPING);
+    rowset_meta->set_rowset_state(VISIBLE);
+    rowset_meta->set_segments_key_bounds(segment_key_bounds);
+    _output_rowset = _output_rs_writer->manual_build(rowset_meta);
+    return Status::OK();
+}
+
 Status Compaction::construct_output_rowset_writer(RowsetWriterContext& ctx, bool is_vertical) {
     ctx.version = _output_version;
     ctx.rowset_state = VISIBLE;
@@ -681,6 +837,19 @@ Status Compaction::modify_rowsets(const Merger::Statistics* stats) {
     return Status::OK();
 }
 
+void Compaction::carry_over_scan_result_cache() {
+    // the output rowset of a duplicate key tablet has exactly the rows of the input rowsets,
+    // unless there are delete predicates
+    if (_tablet->keys_type() == KeysType::DUP_KEYS &&
+        vectorized::ScanResultCache::instance() != nullptr &&
+        std::none_of(_input_rowsets.begin(), _input_rowsets.end(), [](const auto& rowset) {
+            return rowset->rowset_meta()->has_delete_predicate();
+        })) {
+        vectorized::ScanResultCache::instance()->carry_over_rowset_results(
+                _input_rowsets, _output_rowset, _profile.get());
+    }
+}
+
 bool Compaction::_check_if_includes_input_rowsets(
         const RowsetIdUnorderedSet& commit_rowset_ids_set) const {
     std::vector<RowsetId> commit_rowset_ids {};
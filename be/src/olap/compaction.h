@@ -73,6 +73,9 @@ protected:
     Status do_compaction_impl(int64_t permits);
 
     virtual Status modify_rowsets(const Merger::Statistics* stats = nullptr);
+    // Copy the cached scan results of the input rowsets to the output rowset, it reads and
+    // copies the results, so it's called after modify_rowsets() without any tablet lock.
+    void carry_over_scan_result_cache();
     void gc_output_rowset();
 
     Status construct_output_rowset_writer(RowsetWriterContext& ctx, bool is_vertical = false);
@@ -87,6 +90,12 @@ protected:
     bool should_vertical_compaction();
     int64_t get_avg_segment_rows();
 
+    // Merge the key ranges of the input rowsets in parallel into rowsets of
+    // their own, then link them into the output rowset in key order.
+    Status do_key_range_parallel_merge(const RowsetWriterContext& ctx, bool is_vertical,
+                                       const std::vector<Merger::KeyRange>& key_ranges,
+                                       Merger::Statistics* stats);
+
     bool handle_ordered_data_compaction();
     Status do_compact_ordered_rowsets();
     bool is_rowset_tidy(std::string& pre_max_key, const RowsetSharedPtr& rhs);
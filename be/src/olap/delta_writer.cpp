@@ -452,19 +452,25 @@ Status DeltaWriter::submit_calc_delete_bitmap_task() {
         SchemaChangeHandler::tablet_in_converting(_tablet->tablet_id())) {
         return Status::OK();
     }
-    if (segments.size() > 1) {
-        // calculate delete bitmap between segments
-        RETURN_IF_ERROR(_tablet->calc_delete_bitmap_between_segments(_cur_rowset, segments,
-                                                                     _delete_bitmap));
-    }
-
     // For partial update, we need to fill in the entire row of data, during the calculation
     // of the delete bitmap. This operation is resource-intensive, and we need to minimize
     // the number of times it occurs. Therefore, we skip this operation here.
     if (_cur_rowset->tablet_schema()->is_partial_update()) {
+        if (segments.size() > 1) {
+            // calculate delete bitmap between segments
+            RETURN_IF_ERROR(_tablet->calc_delete_bitmap_between_segments(_cur_rowset, segments,
+                                                                         _delete_bitmap));
+        }
         return Status::OK();
     }
 
+    if (segments.size() > 1) {
+        // calculate delete bitmap between segments concurrently with the lookups in existing
+        // rowsets, the result is merged in wait_calc_delete_bitmap()
+        RETURN_IF_ERROR(_calc_delete_bitmap_token->submit_between_segments(
+                _tablet, _cur_rowset, segments));
+    }
+
     LOG(INFO) << "submit calc delete bitmap task to executor, tablet_id: " << _tablet->tablet_id()
               << ", txn_id: " << _req.txn_id;
     return _tablet->commit_phase_update_delete_bitmap(_cur_rowset, _rowset_ids, _delete_bitmap,
@@ -52,18 +52,58 @@
 
 namespace doris {
 
+namespace {
+
+// init the segment rowid map of the segments covered by the splits
+Status init_rowid_conversion(const std::vector<RowSetSplits>& rs_splits,
+                             RowIdConversion* rowid_conversion) {
+    std::vector<uint32_t> segment_num_rows;
+    for (auto& rs_split : rs_splits) {
+        RETURN_IF_ERROR(rs_split.rs_reader->get_segment_num_rows(&segment_num_rows));
+        auto [seg_start, seg_end] = rs_split.segment_offsets;
+        if (seg_start == seg_end) {
+            seg_start = 0;
+            seg_end = segment_num_rows.size();
+        }
+        DCHECK_LE(seg_end, segment_num_rows.size());
+        rowid_conversion->init_segment_map(
+                rs_split.rs_reader->rowset()->rowset_id(),
+                std::vector<uint32_t>(segment_num_rows.begin() + seg_start,
+                                      segment_num_rows.begin() + seg_end),
+                seg_start);
+    }
+    return Status::OK();
+}
+
+std::vector<RowSetSplits> to_rowset_splits(
+        const std::vector<RowsetReaderSharedPtr>& src_rowset_readers) {
+    std::vector<RowSetSplits> rs_splits;
+    rs_splits.reserve(src_rowset_readers.size());
+    for (const RowsetReaderSharedPtr& rs_reader : src_rowset_readers) {
+        rs_splits.emplace_back(RowSetSplits(rs_reader));
+    }
+    return rs_splits;
+}
+
+} // namespace
+
 Status Merger::vmerge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
                               TabletSchemaSPtr cur_tablet_schema,
                               const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
                               RowsetWriter* dst_rowset_writer, Statistics* stats_output) {
+    return vmerge_rowsets(tablet, reader_type, cur_tablet_schema,
+                          to_rowset_splits(src_rowset_readers), dst_rowset_writer, stats_output);
+}
+
+Status Merger::vmerge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
+                              TabletSchemaSPtr cur_tablet_schema,
+                              const std::vector<RowSetSplits>& src_rowset_splits,
+                              RowsetWriter* dst_rowset_writer, Statistics* stats_output) {
     vectorized::BlockReader reader;
     TabletReader::ReaderParams reader_params;
     reader_params.tablet = tablet;
     reader_params.reader_type = reader_type;
-    reader_params.rs_splits.reserve(src_rowset_readers.size());
-    for (const RowsetReaderSharedPtr& rs_reader : src_rowset_readers) {
-        reader_params.rs_splits.emplace_back(RowSetSplits(rs_reader));
-    }
+    reader_params.rs_splits = src_rowset_splits;
     reader_params.version = dst_rowset_writer->version();
 
     TabletSchemaSPtr merge_tablet_schema = std::make_shared<TabletSchema>();
@@ -94,12 +134,8 @@ Status Merger::vmerge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
     if (reader_params.record_rowids) {
         stats_output->rowid_conversion->set_dst_rowset_id(dst_rowset_writer->rowset_id());
         // init segment rowid map for rowid conversion
-        std::vector<uint32_t> segment_num_rows;
-        for (auto& rs_split : reader_params.rs_splits) {
-            RETURN_IF_ERROR(rs_split.rs_reader->get_segment_num_rows(&segment_num_rows));
-            stats_output->rowid_conversion->init_segment_map(
-                    rs_split.rs_reader->rowset()->rowset_id(), segment_num_rows);
-        }
+        RETURN_IF_ERROR(
+                init_rowid_conversion(reader_params.rs_splits, stats_output->rowid_conversion));
     }
 
     vectorized::Block block = cur_tablet_schema->create_block(reader_params.return_columns);
@@ -188,8 +224,8 @@ void Merger::vertical_split_columns(TabletSchemaSPtr tablet_schema,
 Status Merger::vertical_compact_one_group(
         TabletSharedPtr tablet, ReaderType reader_type, TabletSchemaSPtr tablet_schema, bool is_key,
         const std::vector<uint32_t>& column_group, vectorized::RowSourcesBuffer* row_source_buf,
-        const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
-        RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment, Statistics* stats_output) {
+        const std::vector<RowSetSplits>& src_rowset_splits, RowsetWriter* dst_rowset_writer,
+        int64_t max_rows_per_segment, Statistics* stats_output) {
     // build tablet reader
     VLOG_NOTICE << "vertical compact one group, max_rows_per_segment=" << max_rows_per_segment;
     vectorized::VerticalBlockReader reader(row_source_buf);
@@ -197,10 +233,7 @@ Status Merger::vertical_compact_one_group(
     reader_params.is_key_column_group = is_key;
     reader_params.tablet = tablet;
     reader_params.reader_type = reader_type;
-    reader_params.rs_splits.reserve(src_rowset_readers.size());
-    for (const RowsetReaderSharedPtr& rs_reader : src_rowset_readers) {
-        reader_params.rs_splits.emplace_back(RowSetSplits(rs_reader));
-    }
+    reader_params.rs_splits = src_rowset_splits;
     reader_params.version = dst_rowset_writer->version();
 
     TabletSchemaSPtr merge_tablet_schema = std::make_shared<TabletSchema>();
@@ -230,12 +263,8 @@ Status Merger::vertical_compact_one_group(
     if (reader_params.record_rowids) {
         stats_output->rowid_conversion->set_dst_rowset_id(dst_rowset_writer->rowset_id());
         // init segment rowid map for rowid conversion
-        std::vector<uint32_t> segment_num_rows;
-        for (auto& rs_split : reader_params.rs_splits) {
-            RETURN_IF_ERROR(rs_split.rs_reader->get_segment_num_rows(&segment_num_rows));
-            stats_output->rowid_conversion->init_segment_map(
-                    rs_split.rs_reader->rowset()->rowset_id(), segment_num_rows);
-        }
+        RETURN_IF_ERROR(
+                init_rowid_conversion(reader_params.rs_splits, stats_output->rowid_conversion));
     }
 
     vectorized::Block block = tablet_schema->create_block(reader_params.return_columns);
@@ -340,6 +369,16 @@ Status Merger::vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_
                                       const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
                                       RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment,
                                       Statistics* stats_output) {
+    return vertical_merge_rowsets(tablet, reader_type, tablet_schema,
+                                  to_rowset_splits(src_rowset_readers), dst_rowset_writer,
+                                  max_rows_per_segment, stats_output);
+}
+
+Status Merger::vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
+                                      TabletSchemaSPtr tablet_schema,
+                                      const std::vector<RowSetSplits>& src_rowset_splits,
+                                      RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment,
+                                      Statistics* stats_output) {
     LOG(INFO) << "Start to do vertical compaction, tablet_id: " << tablet->tablet_id();
     std::vector<std::vector<uint32_t>> column_groups;
     vertical_split_columns(tablet_schema, &column_groups);
@@ -352,7 +391,7 @@ Status Merger::vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_
         bool is_key = (i == 0);
         RETURN_IF_ERROR(vertical_compact_one_group(
                 tablet, reader_type, tablet_schema, is_key, column_groups[i], &row_sources_buf,
-                src_rowset_readers, dst_rowset_writer, max_rows_per_segment, stats_output));
+                src_rowset_splits, dst_rowset_writer, max_rows_per_segment, stats_output));
         if (is_key) {
             row_sources_buf.flush();
         }
@@ -366,4 +405,90 @@ Status Merger::vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_
     return Status::OK();
 }
 
+void Merger::split_key_ranges(const std::vector<RowsetSharedPtr>& rowsets, int64_t max_ranges,
+                              int64_t min_rows_per_range, std::vector<KeyRange>* key_ranges) {
+    key_ranges->clear();
+    // key interval of a segment, or of all segments of a segments overlapping rowset
+    struct KeyInterval {
+        std::string min_key;
+        std::string max_key;
+        size_t rowset_idx;
+        std::pair<int, int> segment_offsets;
+        int64_t num_rows;
+    };
+    std::vector<KeyInterval> intervals;
+    int64_t total_rows = 0;
+    bool splittable = max_ranges > 1;
+    for (size_t i = 0; splittable && i < rowsets.size(); ++i) {
+        const auto& rowset = rowsets[i];
+        int num_segments = rowset->num_segments();
+        if (num_segments == 0) {
+            continue;
+        }
+        std::vector<KeyBoundsPB> key_bounds;
+        rowset->get_segments_key_bounds(&key_bounds);
+        if (key_bounds.size() != num_segments) {
+            // rowsets written by old versions may have no key bounds
+            splittable = false;
+            break;
+        }
+        total_rows += rowset->num_rows();
+        if (rowset->is_segments_overlapping()) {
+            KeyInterval interval {key_bounds[0].min_key(), key_bounds[0].max_key(), i,
+                                  {0, num_segments}, rowset->num_rows()};
+            for (const auto& key_bound : key_bounds) {
+                interval.min_key = std::min(interval.min_key, key_bound.min_key());
+                interval.max_key = std::max(interval.max_key, key_bound.max_key());
+            }
+            intervals.push_back(std::move(interval));
+        } else {
+            // segments of a non overlapping rowset are ordered by key
+            for (int seg = 0; seg < num_segments; ++seg) {
+                intervals.push_back({key_bounds[seg].min_key(), key_bounds[seg].max_key(), i,
+                                     {seg, seg + 1}, rowset->num_rows() / num_segments});
+            }
+        }
+    }
+
+    int64_t rows_per_range =
+            std::max(min_rows_per_range, total_rows / std::max<int64_t>(max_ranges, 1));
+    if (!splittable || total_rows < rows_per_range * 2) {
+        KeyRange key_range;
+        for (const auto& rowset : rowsets) {
+            key_range.segment_offsets.emplace_back(0, rowset->num_segments());
+            key_range.num_rows += rowset->num_rows();
+        }
+        key_ranges->push_back(std::move(key_range));
+        return;
+    }
+
+    std::stable_sort(intervals.begin(), intervals.end(),
+                     [](const KeyInterval& lhs, const KeyInterval& rhs) {
+                         return lhs.min_key < rhs.min_key;
+                     });
+    KeyRange key_range;
+    key_range.segment_offsets.resize(rowsets.size(), {0, 0});
+    std::string max_key;
+    for (auto& interval : intervals) {
+        // a new range can only start from an interval which doesn't overlap
+        // with any previous ones, otherwise a key may spread over two ranges
+        if (key_range.num_rows >= rows_per_range && interval.min_key > max_key &&
+            key_ranges->size() + 1 < max_ranges) {
+            key_ranges->push_back(std::move(key_range));
+            key_range = KeyRange();
+            key_range.segment_offsets.resize(rowsets.size(), {0, 0});
+        }
+        auto& offsets = key_range.segment_offsets[interval.rowset_idx];
+        if (offsets.first == offsets.second) {
+            offsets = interval.segment_offsets;
+        } else {
+            offsets.first = std::min(offsets.first, interval.segment_offsets.first);
+            offsets.second = std::max(offsets.second, interval.segment_offsets.second);
+        }
+        key_range.num_rows += interval.num_rows;
+        max_key = std::max(max_key, interval.max_key);
+    }
+    key_ranges->push_back(std::move(key_range));
+}
+
 } // namespace doris
@@ -19,6 +19,7 @@
 
 #include <stdint.h>
 
+#include <utility>
 #include <vector>
 
 #include "common/status.h"
@@ -51,6 +52,16 @@ public:
         RowIdConversion* rowid_conversion = nullptr;
     };
 
+    // A key range of the input rowsets which can be merged independently,
+    // rows with the same key never spread over two key ranges.
+    struct KeyRange {
+        // segments [first, second) of every input rowset covered by this range,
+        // first == second means no segment of the rowset is covered
+        std::vector<std::pair<int, int>> segment_offsets;
+        // estimated number of input rows
+        int64_t num_rows = 0;
+    };
+
     // merge rows from `src_rowset_readers` and write into `dst_rowset_writer`.
     // return OK and set statistics into `*stats_output`.
     // return others on error
@@ -59,11 +70,27 @@ public:
                                  TabletSchemaSPtr cur_tablet_schema,
                                  const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
                                  RowsetWriter* dst_rowset_writer, Statistics* stats_output);
+    static Status vmerge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
+                                 TabletSchemaSPtr cur_tablet_schema,
+                                 const std::vector<RowSetSplits>& src_rowset_splits,
+                                 RowsetWriter* dst_rowset_writer, Statistics* stats_output);
     static Status vertical_merge_rowsets(
             TabletSharedPtr tablet, ReaderType reader_type, TabletSchemaSPtr tablet_schema,
             const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
             RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment,
             Statistics* stats_output);
+    static Status vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
+                                         TabletSchemaSPtr tablet_schema,
+                                         const std::vector<RowSetSplits>& src_rowset_splits,
+                                         RowsetWriter* dst_rowset_writer,
+                                         int64_t max_rows_per_segment, Statistics* stats_output);
+
+    // Split the key space of `rowsets` into at most `max_ranges` ranges by the
+    // key bounds of their segments, every range has at least `min_rows_per_range`
+    // rows except the last one. Only one range is returned if the key space
+    // can't be split.
+    static void split_key_ranges(const std::vector<RowsetSharedPtr>& rowsets, int64_t max_ranges,
+                                 int64_t min_rows_per_range, std::vector<KeyRange>* key_ranges);
 
 public:
     // for vertical compaction
@@ -73,9 +100,8 @@ public:
             TabletSharedPtr tablet, ReaderType reader_type, TabletSchemaSPtr tablet_schema,
             bool is_key, const std::vector<uint32_t>& column_group,
             vectorized::RowSourcesBuffer* row_source_buf,
-            const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
-            RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment,
-            Statistics* stats_output);
+            const std::vector<RowSetSplits>& src_rowset_splits, RowsetWriter* dst_rowset_writer,
+            int64_t max_rows_per_segment, Statistics* stats_output);
 
     // for segcompaction
     static Status vertical_compact_one_group(TabletSharedPtr tablet, ReaderType reader_type,
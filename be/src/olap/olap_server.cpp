@@ -140,6 +140,10 @@ Status StorageEngine::start_bg_threads() {
             .set_min_threads(config::cold_data_compaction_thread_num)
             .set_max_threads(config::cold_data_compaction_thread_num)
             .build(&_cold_data_compaction_thread_pool);
+    ThreadPoolBuilder("CompactionKeyRangeThreadPool")
+            .set_min_threads(config::compaction_key_range_max_threads)
+            .set_max_threads(config::compaction_key_range_max_threads)
+            .build(&_compaction_key_range_thread_pool);
 
     // compaction tasks producer thread
     RETURN_IF_ERROR(Thread::create(
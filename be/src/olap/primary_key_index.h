@@ -22,6 +22,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <vector>
 
 #include "common/status.h"
 #include "io/fs/file_reader_writer_fwd.h"
@@ -111,6 +112,12 @@ public:
         return _bf->test_bytes(key.data, key.size);
     }
 
+    // verify a batch of keys in BloomFilter, (*present)[i] is the result of keys[i]
+    void check_present(const std::vector<Slice>& keys, std::vector<uint8_t>* present) {
+        DCHECK(_bf_parsed);
+        _bf->test_bytes_batch(keys.data(), keys.size(), present);
+    }
+
     uint32_t num_rows() const {
         DCHECK(_index_parsed);
         return _index_reader->num_values();
@@ -35,17 +35,47 @@ public:
     RowIdConversion() = default;
     ~RowIdConversion() = default;
 
-    // resize segment rowid map to its rows num
-    void init_segment_map(const RowsetId& src_rowset_id, const std::vector<uint32_t>& num_rows) {
+    // resize segment rowid map to its rows num, `num_rows` starts from
+    // segment `start_segment_id` of the src rowset
+    void init_segment_map(const RowsetId& src_rowset_id, const std::vector<uint32_t>& num_rows,
+                          uint32_t start_segment_id = 0) {
         for (size_t i = 0; i < num_rows.size(); i++) {
             uint32_t id = _segments_rowid_map.size();
-            _segment_to_id_map.emplace(std::pair<RowsetId, uint32_t> {src_rowset_id, i}, id);
-            _id_to_segment_map.emplace_back(src_rowset_id, i);
+            uint32_t segment_id = start_segment_id + i;
+            _segment_to_id_map.emplace(std::pair<RowsetId, uint32_t> {src_rowset_id, segment_id},
+                                       id);
+            _id_to_segment_map.emplace_back(src_rowset_id, segment_id);
             _segments_rowid_map.emplace_back(std::vector<std::pair<uint32_t, uint32_t>>(
                     num_rows[i], std::pair<uint32_t, uint32_t>(UINT32_MAX, UINT32_MAX)));
         }
     }
 
+    // merge the map of `other`, which converts rows of different src segments
+    // to dst segments starting from `dst_segment_offset` of the dst rowset.
+    void merge(const RowIdConversion& other, uint32_t dst_segment_offset) {
+        for (size_t other_id = 0; other_id < other._segments_rowid_map.size(); ++other_id) {
+            const auto& segment = other._id_to_segment_map[other_id];
+            const auto& other_rowid_map = other._segments_rowid_map[other_id];
+            auto iter = _segment_to_id_map.find(segment);
+            if (iter == _segment_to_id_map.end()) {
+                iter = _segment_to_id_map.emplace(segment, _segments_rowid_map.size()).first;
+                _id_to_segment_map.emplace_back(segment);
+                _segments_rowid_map.emplace_back(std::vector<std::pair<uint32_t, uint32_t>>(
+                        other_rowid_map.size(),
+                        std::pair<uint32_t, uint32_t>(UINT32_MAX, UINT32_MAX)));
+            }
+            auto& rowid_map = _segments_rowid_map[iter->second];
+            DCHECK_EQ(rowid_map.size(), other_rowid_map.size());
+            for (size_t rowid = 0; rowid < other_rowid_map.size(); ++rowid) {
+                auto& [dst_segment_id, dst_rowid] = other_rowid_map[rowid];
+                if (dst_segment_id == UINT32_MAX && dst_rowid == UINT32_MAX) {
+                    continue;
+                }
+                rowid_map[rowid] = {dst_segment_offset + dst_segment_id, dst_rowid};
+            }
+        }
+    }
+
     // set dst rowset id
     void set_dst_rowset_id(const RowsetId& dst_rowset_id) { _dst_rowst_id = dst_rowset_id; }
     const RowsetId get_dst_rowset_id() { return _dst_rowst_id; }
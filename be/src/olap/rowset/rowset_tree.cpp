@@ -172,12 +172,15 @@ Status RowsetTree::Init(const RowsetVector& rowsets) {
 
     // Build the mapping from RS_ID to RS.
     rs_by_id_.clear();
-    for (auto& rs : all_rowsets_) {
+    rs_ordinal_by_id_.clear();
+    for (int32_t i = 0; i < all_rowsets_.size(); i++) {
+        auto& rs = all_rowsets_[i];
         if (!rs_by_id_.insert({rs->rowset_id(), rs}).second) {
             return Status::InternalError(strings::Substitute(
                     "Add rowset with $0 to rowset tree of tablet $1 failed",
                     rs->rowset_id().to_string(), rs->rowset_meta()->tablet_uid().to_string()));
         }
+        rs_ordinal_by_id_[rs->rowset_id()] = i;
     }
 
     initted_ = true;
@@ -105,6 +105,12 @@ public:
 
     RowsetSharedPtr rs_by_id(RowsetId rs_id) const { return FindPtrOrNull(rs_by_id_, rs_id); }
 
+    // Return the position of the rowset in the vector passed to Init(), or -1 if
+    // the rowset is not in this RowsetTree.
+    int32_t rs_ordinal_by_id(RowsetId rs_id) const {
+        return FindWithDefault(rs_ordinal_by_id_, rs_id, -1);
+    }
+
     // Iterates over RowsetTree::RSEndpoint, guaranteed to be ordered and for
     // any rowset to appear exactly twice, once at its start slice and once at
     // its stop slice, equivalent to its GetBounds() values.
@@ -130,6 +136,9 @@ private:
     // The Rowsets in this RowsetTree, keyed by their id.
     std::unordered_map<RowsetId, RowsetSharedPtr, HashOfRowsetId> rs_by_id_;
 
+    // The position of the Rowsets in all_rowsets_, keyed by their id.
+    std::unordered_map<RowsetId, int32_t, HashOfRowsetId> rs_ordinal_by_id_;
+
     bool initted_;
 };
 
@@ -24,9 +24,11 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "common/status.h"
 #include "util/murmur_hash3.h"
+#include "util/slice.h"
 
 namespace doris {
 namespace segment_v2 {
@@ -135,6 +137,19 @@ public:
         return test_hash(code);
     }
 
+    // Test a batch of non-null keys, (*results)[i] is set to 1 if keys[i] may be present.
+    // All hash codes are computed first so the probe loop only touches the bitset.
+    void test_bytes_batch(const Slice* keys, size_t num_keys, std::vector<uint8_t>* results) const {
+        std::vector<uint64_t> codes(num_keys);
+        for (size_t i = 0; i < num_keys; ++i) {
+            codes[i] = hash(keys[i].data, keys[i].size);
+        }
+        results->resize(num_keys);
+        for (size_t i = 0; i < num_keys; ++i) {
+            (*results)[i] = test_hash(codes[i]);
+        }
+    }
+
     /// Checks if this contains everything from another bloom filter.
     /// Bloom filters must have equal size and seed.
     virtual bool contains(const BloomFilter& bf_) const = 0;
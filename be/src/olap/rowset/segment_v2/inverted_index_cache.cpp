@@ -233,18 +233,23 @@ void InvertedIndexQueryCache::insert(const CacheKey& key, std::shared_ptr<roarin
 
     std::unique_ptr<InvertedIndexQueryCache::CacheValue> cache_value_ptr =
             std::make_unique<InvertedIndexQueryCache::CacheValue>();
-    cache_value_ptr->last_visit_time = UnixMillis();
-    cache_value_ptr->bitmap = bitmap;
-    cache_value_ptr->size = bitmap->getSizeInBytes();
     if (key.encode().empty()) {
         return;
     }
+    // use run containers for the dense ranges and release the spare capacity of the containers
+    bitmap->runOptimize();
+    bitmap->shrinkToFit();
+    cache_value_ptr->last_visit_time = UnixMillis();
+    cache_value_ptr->bitmap = bitmap;
+    cache_value_ptr->size = bitmap->getSizeInBytes();
 
     auto lru_handle = _cache->insert(key.encode(), (void*)cache_value_ptr.release(),
                                      bitmap->getSizeInBytes(), deleter, CachePriority::NORMAL);
     *handle = InvertedIndexQueryCacheHandle(_cache.get(), lru_handle);
 }
 
+InvertedIndexTermCache* InvertedIndexTermCache::_s_instance = nullptr;
+
 int64_t InvertedIndexQueryCache::mem_consumption() {
     if (_cache) {
         return _cache->mem_consumption();
@@ -237,20 +237,49 @@ public:
     InvertedIndexQueryCache() = delete;
 
     InvertedIndexQueryCache(size_t capacity, uint32_t num_shards)
-            : LRUCachePolicy("InvertedIndexQueryCache", capacity, LRUCacheType::SIZE,
-                             config::inverted_index_cache_stale_sweep_time_sec, num_shards) {}
+            : InvertedIndexQueryCache("InvertedIndexQueryCache", capacity, num_shards) {}
 
     bool lookup(const CacheKey& key, InvertedIndexQueryCacheHandle* handle);
 
+    // The bitmap is compressed before it is cached, it must not be modified later.
     void insert(const CacheKey& key, std::shared_ptr<roaring::Roaring> bitmap,
                 InvertedIndexQueryCacheHandle* handle);
 
     int64_t mem_consumption();
 
+protected:
+    InvertedIndexQueryCache(const std::string& name, size_t capacity, uint32_t num_shards)
+            : LRUCachePolicy(name, capacity, LRUCacheType::SIZE,
+                             config::inverted_index_cache_stale_sweep_time_sec, num_shards) {}
+
 private:
     static InvertedIndexQueryCache* _s_instance;
 };
 
+// Cache of the postings of the terms in the fulltext indexes of segments, the key is the
+// term with EQUAL_QUERY type.
+//
+// The match queries are answered by combining the postings of their terms, the combined
+// results are cached in InvertedIndexQueryCache. The postings are cached separately so that
+// the composite results, which are more likely to be different between queries, don't evict
+// the postings of the frequent terms.
+class InvertedIndexTermCache : public InvertedIndexQueryCache {
+public:
+    static void create_global_cache(size_t capacity, uint32_t num_shards = 16) {
+        DCHECK(_s_instance == nullptr);
+        static InvertedIndexTermCache instance(capacity, num_shards);
+        _s_instance = &instance;
+    }
+
+    static InvertedIndexTermCache* instance() { return _s_instance; }
+
+    InvertedIndexTermCache(size_t capacity, uint32_t num_shards)
+            : InvertedIndexQueryCache("InvertedIndexTermCache", capacity, num_shards) {}
+
+private:
+    static InvertedIndexTermCache* _s_instance;
+};
+
 class InvertedIndexQueryCacheHandle {
 public:
     InvertedIndexQueryCacheHandle() {}
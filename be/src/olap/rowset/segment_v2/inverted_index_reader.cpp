@@ -42,6 +42,7 @@
 
 #include <algorithm>
 #include <filesystem>
+#include <numeric>
 #include <ostream>
 #include <roaring/roaring.hh>
 #include <set>
@@ -200,7 +201,6 @@ Status InvertedIndexReader::read_null_bitmap(InvertedIndexQueryCacheHandle* cach
             buf.resize(null_bitmap_size);
             null_bitmap_in->readBytes(reinterpret_cast<uint8_t*>(buf.data()), null_bitmap_size);
             *null_bitmap = roaring::Roaring::read(reinterpret_cast<char*>(buf.data()), false);
-            null_bitmap->runOptimize();
             cache->insert(cache_key, null_bitmap, cache_handle);
             FINALIZE_INPUT(null_bitmap_in);
         }
@@ -256,14 +256,19 @@ Status FullTextIndexReader::query(OlapReaderStatistics* stats, const std::string
                     search_str, get_parser_string_from_properties(_index_meta.properties()));
         }
 
-        std::unique_ptr<lucene::search::Query> query;
+        if (analyse_result.size() > 1 && query_type != InvertedIndexQueryType::MATCH_ANY_QUERY &&
+            query_type != InvertedIndexQueryType::MATCH_ALL_QUERY &&
+            query_type != InvertedIndexQueryType::MATCH_PHRASE_QUERY &&
+            query_type != InvertedIndexQueryType::EQUAL_QUERY) {
+            return Status::Error<ErrorCode::INVERTED_INDEX_NOT_SUPPORTED>(
+                    "fulltext query do not support query type other than match.");
+        }
+
         std::wstring field_ws = std::wstring(column_name.begin(), column_name.end());
+        bool null_bitmap_already_read = false;
 
-        auto index_search = [&](bool& null_bitmap_already_read,
-                                std::shared_ptr<roaring::Roaring>& term_match_bitmap,
-                                InvertedIndexQueryCache* cache,
-                                InvertedIndexQueryCache::CacheKey& cache_key,
-                                InvertedIndexQueryCacheHandle& cache_handle) {
+        auto index_search = [&](lucene::search::Query* query,
+                                std::shared_ptr<roaring::Roaring>& match_bitmap) {
             // check index file existence
             if (!indexExists(index_file_path)) {
                 return Status::Error<ErrorCode::INVERTED_INDEX_FILE_NOT_FOUND>(
@@ -286,125 +291,147 @@ Status FullTextIndexReader::query(OlapReaderStatistics* stats, const std::string
 
             try {
                 SCOPED_RAW_TIMER(&stats->inverted_index_searcher_search_timer);
-                index_searcher->_search(query.get(), [&term_match_bitmap](const int32_t docid,
-                                                                          const float_t /*score*/) {
+                index_searcher->_search(query, [&match_bitmap](const int32_t docid,
+                                                               const float_t /*score*/) {
                     // docid equal to rowid in segment
-                    term_match_bitmap->add(docid);
+                    match_bitmap->add(docid);
                 });
             } catch (const CLuceneError& e) {
                 return Status::Error<ErrorCode::INVERTED_INDEX_CLUCENE_ERROR>(
                         "CLuceneError occured: {}", e.what());
             }
-
-            {
-                // add to cache
-                term_match_bitmap->runOptimize();
-                cache->insert(cache_key, term_match_bitmap, &cache_handle);
-            }
             return Status::OK();
         };
 
-        roaring::Roaring query_match_bitmap;
-        bool null_bitmap_already_read = false;
-        if (query_type == InvertedIndexQueryType::MATCH_PHRASE_QUERY) {
-            std::wstring str_tokens;
-            for (auto& token : analyse_result) {
-                str_tokens += token;
+        // 1. the result of the whole query, the terms of match any/all queries are deduplicated
+        // and sorted, so the same terms in different orders share the result.
+        // The result of a single term query is the postings of the term.
+        bool is_composite = analyse_result.size() > 1;
+        auto query_cache = InvertedIndexQueryCache::instance();
+        InvertedIndexQueryCache::CacheKey query_cache_key {index_file_path, column_name,
+                                                           query_type, L""};
+        for (size_t i = 0; i < analyse_result.size(); ++i) {
+            if (i > 0) {
+                query_cache_key.value += L'\x1f';
             }
-
-            auto cache = InvertedIndexQueryCache::instance();
-            InvertedIndexQueryCache::CacheKey cache_key;
-            cache_key.index_path = index_file_path;
-            cache_key.column_name = column_name;
-            cache_key.query_type = InvertedIndexQueryType::MATCH_PHRASE_QUERY;
-            cache_key.value.swap(str_tokens);
-            InvertedIndexQueryCacheHandle cache_handle;
-            std::shared_ptr<roaring::Roaring> term_match_bitmap = nullptr;
-            if (cache->lookup(cache_key, &cache_handle)) {
+            query_cache_key.value += analyse_result[i];
+        }
+        InvertedIndexQueryCacheHandle query_cache_handle;
+        if (is_composite) {
+            if (query_cache->lookup(query_cache_key, &query_cache_handle)) {
                 stats->inverted_index_query_cache_hit++;
-                term_match_bitmap = cache_handle.get_bitmap();
-            } else {
-                stats->inverted_index_query_cache_miss++;
-
-                term_match_bitmap = std::make_shared<roaring::Roaring>();
+                SCOPED_RAW_TIMER(&stats->inverted_index_query_bitmap_copy_timer);
+                *bit_map = *query_cache_handle.get_bitmap();
+                return Status::OK();
+            }
+            stats->inverted_index_query_cache_miss++;
+        }
 
-                auto* phrase_query = new lucene::search::PhraseQuery();
-                for (auto& token : analyse_result) {
-                    auto* term = _CLNEW lucene::index::Term(field_ws.c_str(), token.c_str());
-                    phrase_query->add(term);
-                    _CLDECDELETE(term);
-                }
-                query.reset(phrase_query);
+        // 2. the postings of the terms
+        auto term_cache = InvertedIndexTermCache::instance();
+        std::vector<InvertedIndexQueryCacheHandle> term_cache_handles(analyse_result.size());
+        std::vector<std::shared_ptr<roaring::Roaring>> term_bitmaps(analyse_result.size());
+        for (size_t i = 0; i < analyse_result.size(); ++i) {
+            // use EQUAL_QUERY type here since cache is for each term/token
+            InvertedIndexQueryCache::CacheKey cache_key {index_file_path, column_name,
+                                                         InvertedIndexQueryType::EQUAL_QUERY,
+                                                         analyse_result[i]};
+            if (term_cache->lookup(cache_key, &term_cache_handles[i])) {
+                stats->inverted_index_term_cache_hit++;
+                term_bitmaps[i] = term_cache_handles[i].get_bitmap();
+            } else {
+                stats->inverted_index_term_cache_miss++;
+            }
+        }
+        auto term_search = [&](size_t i) {
+            if (term_bitmaps[i] != nullptr) {
+                return Status::OK();
+            }
+            std::unique_ptr<lucene::index::Term, void (*)(lucene::index::Term*)> term {
+                    _CLNEW lucene::index::Term(field_ws.c_str(), analyse_result[i].c_str()),
+                    [](lucene::index::Term* term) { _CLDECDELETE(term); }};
+            lucene::search::TermQuery query(term.get());
+            auto term_match_bitmap = std::make_shared<roaring::Roaring>();
+            RETURN_IF_ERROR(index_search(&query, term_match_bitmap));
+            InvertedIndexQueryCache::CacheKey cache_key {index_file_path, column_name,
+                                                         InvertedIndexQueryType::EQUAL_QUERY,
+                                                         analyse_result[i]};
+            term_cache->insert(cache_key, term_match_bitmap, &term_cache_handles[i]);
+            term_bitmaps[i] = std::move(term_match_bitmap);
+            return Status::OK();
+        };
 
-                Status res = index_search(null_bitmap_already_read, term_match_bitmap, cache,
-                                          cache_key, cache_handle);
-                if (!res.ok()) {
-                    return res;
-                }
+        // 3. combine the postings
+        std::shared_ptr<roaring::Roaring> query_match_bitmap;
+        // the cached postings are shared, copy them before they are modified
+        bool is_term_bitmap = false;
+        if (query_type == InvertedIndexQueryType::MATCH_ANY_QUERY) {
+            query_match_bitmap = std::make_shared<roaring::Roaring>();
+            for (size_t i = 0; i < analyse_result.size(); ++i) {
+                RETURN_IF_ERROR(term_search(i));
+                SCOPED_RAW_TIMER(&stats->inverted_index_query_bitmap_op_timer);
+                *query_match_bitmap |= *term_bitmaps[i];
             }
-            query_match_bitmap = *term_match_bitmap;
         } else {
-            bool first = true;
-            for (auto token_ws : analyse_result) {
-                std::shared_ptr<roaring::Roaring> term_match_bitmap = nullptr;
-
-                // try to get term bitmap match result from cache to avoid query index on cache hit
-                auto cache = InvertedIndexQueryCache::instance();
-                // use EQUAL_QUERY type here since cache is for each term/token
-                InvertedIndexQueryCache::CacheKey cache_key {index_file_path, column_name,
-                                                             InvertedIndexQueryType::EQUAL_QUERY,
-                                                             token_ws};
-                VLOG_DEBUG << "cache_key:" << cache_key.encode();
-                InvertedIndexQueryCacheHandle cache_handle;
-                if (cache->lookup(cache_key, &cache_handle)) {
-                    stats->inverted_index_query_cache_hit++;
-                    term_match_bitmap = cache_handle.get_bitmap();
-                } else {
-                    stats->inverted_index_query_cache_miss++;
-
-                    term_match_bitmap = std::make_shared<roaring::Roaring>();
-                    // unique_ptr with custom deleter
-                    std::unique_ptr<lucene::index::Term, void (*)(lucene::index::Term*)> term {
-                            _CLNEW lucene::index::Term(field_ws.c_str(), token_ws.c_str()),
-                            [](lucene::index::Term* term) { _CLDECDELETE(term); }};
-                    query.reset(new lucene::search::TermQuery(term.get()));
-
-                    Status res = index_search(null_bitmap_already_read, term_match_bitmap, cache,
-                                              cache_key, cache_handle);
-                    if (!res.ok()) {
-                        return res;
-                    }
+            // intersect the cached postings from the smallest, the terms not cached needn't be
+            // searched once the intersection is empty
+            std::vector<size_t> order(analyse_result.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+                if ((term_bitmaps[lhs] == nullptr) != (term_bitmaps[rhs] == nullptr)) {
+                    return term_bitmaps[lhs] != nullptr;
                 }
-
-                // add to query_match_bitmap
-                if (first) {
-                    SCOPED_RAW_TIMER(&stats->inverted_index_query_bitmap_copy_timer);
-                    query_match_bitmap = *term_match_bitmap;
-                    first = false;
+                return term_bitmaps[lhs] != nullptr &&
+                       term_bitmaps[lhs]->cardinality() < term_bitmaps[rhs]->cardinality();
+            });
+            // the phrase matches only the rows with all of its terms, the terms not cached are
+            // searched by the phrase query itself
+            bool is_phrase = query_type == InvertedIndexQueryType::MATCH_PHRASE_QUERY &&
+                             analyse_result.size() > 1;
+            for (size_t i : order) {
+                if (is_phrase && term_bitmaps[i] == nullptr) {
+                    break;
+                }
+                RETURN_IF_ERROR(term_search(i));
+                if (query_match_bitmap == nullptr) {
+                    query_match_bitmap = term_bitmaps[i];
+                    is_term_bitmap = true;
                     continue;
                 }
-
-                switch (query_type) {
-                case InvertedIndexQueryType::MATCH_ANY_QUERY: {
-                    SCOPED_RAW_TIMER(&stats->inverted_index_query_bitmap_op_timer);
-                    query_match_bitmap |= *term_match_bitmap;
-                    break;
+                if (is_term_bitmap) {
+                    SCOPED_RAW_TIMER(&stats->inverted_index_query_bitmap_copy_timer);
+                    query_match_bitmap = std::make_shared<roaring::Roaring>(*query_match_bitmap);
+                    is_term_bitmap = false;
                 }
-                case InvertedIndexQueryType::EQUAL_QUERY:
-                case InvertedIndexQueryType::MATCH_ALL_QUERY: {
+                {
                     SCOPED_RAW_TIMER(&stats->inverted_index_query_bitmap_op_timer);
-                    query_match_bitmap &= *term_match_bitmap;
-                    break;
+                    *query_match_bitmap &= *term_bitmaps[i];
                 }
-                default: {
-                    return Status::Error<ErrorCode::INVERTED_INDEX_NOT_SUPPORTED>(
-                            "fulltext query do not support query type other than match.");
+                if (query_match_bitmap->isEmpty()) {
+                    break;
                 }
+            }
+            if (is_phrase && (query_match_bitmap == nullptr || !query_match_bitmap->isEmpty())) {
+                lucene::search::PhraseQuery phrase_query;
+                for (auto& token : analyse_result) {
+                    auto* term = _CLNEW lucene::index::Term(field_ws.c_str(), token.c_str());
+                    phrase_query.add(term);
+                    _CLDECDELETE(term);
                 }
+                query_match_bitmap = std::make_shared<roaring::Roaring>();
+                is_term_bitmap = false;
+                RETURN_IF_ERROR(index_search(&phrase_query, query_match_bitmap));
             }
         }
 
-        bit_map->swap(query_match_bitmap);
+        if (is_composite) {
+            if (is_term_bitmap) {
+                query_match_bitmap = std::make_shared<roaring::Roaring>(*query_match_bitmap);
+            }
+            query_cache->insert(query_cache_key, query_match_bitmap, &query_cache_handle);
+        }
+        SCOPED_RAW_TIMER(&stats->inverted_index_query_bitmap_copy_timer);
+        *bit_map = *query_match_bitmap;
         return Status::OK();
     } catch (const CLuceneError& e) {
         return Status::Error<ErrorCode::INVERTED_INDEX_CLUCENE_ERROR>(
@@ -531,7 +558,6 @@ Status StringTypeInvertedIndexReader::query(OlapReaderStatistics* stats,
     // add to cache
     std::shared_ptr<roaring::Roaring> term_match_bitmap =
             std::make_shared<roaring::Roaring>(result);
-    term_match_bitmap->runOptimize();
     cache->insert(cache_key, term_match_bitmap, &cache_handle);
 
     bit_map->swap(result);
@@ -369,9 +369,59 @@ Status Segment::lookup_row_key(const Slice& key, bool with_seq_col, RowLocation*
     if (!_pk_index_reader->check_present(key_without_seq)) {
         return Status::NotFound("Can't find key in the segment");
     }
-    bool exact_match = false;
     std::unique_ptr<segment_v2::IndexedColumnIterator> index_iterator;
     RETURN_IF_ERROR(_pk_index_reader->new_iterator(&index_iterator));
+    return _seek_row_key(key, with_seq_col, index_iterator.get(), row_location);
+}
+
+Status Segment::lookup_row_keys(const std::vector<Slice>& keys, bool with_seq_col,
+                                std::vector<RowLocation>* row_locations,
+                                std::vector<Status>* statuses) {
+    RETURN_IF_ERROR(load_pk_index_and_bf());
+    size_t seq_col_length = 0;
+    if (_tablet_schema->has_sequence_col() && with_seq_col) {
+        seq_col_length = _tablet_schema->column(_tablet_schema->sequence_col_idx()).length() + 1;
+    }
+    row_locations->resize(keys.size());
+    statuses->assign(keys.size(), Status::OK());
+
+    std::vector<Slice> keys_without_seq(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys_without_seq[i] = Slice(keys[i].get_data(), keys[i].get_size() - seq_col_length);
+    }
+    DCHECK(_pk_index_reader != nullptr);
+    std::vector<uint8_t> present;
+    _pk_index_reader->check_present(keys_without_seq, &present);
+
+    std::unique_ptr<segment_v2::IndexedColumnIterator> index_iterator;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (!present[i]) {
+            (*statuses)[i] = Status::NotFound("Can't find key in the segment");
+            continue;
+        }
+        // the iterator is created lazily and shared by all keys, seeking in ascending
+        // order lets it reuse the data page loaded by the previous key.
+        if (index_iterator == nullptr) {
+            RETURN_IF_ERROR(_pk_index_reader->new_iterator(&index_iterator));
+        }
+        (*statuses)[i] = _seek_row_key(keys[i], with_seq_col, index_iterator.get(),
+                                       &(*row_locations)[i]);
+    }
+    return Status::OK();
+}
+
+Status Segment::_seek_row_key(const Slice& key, bool with_seq_col,
+                              IndexedColumnIterator* index_iterator, RowLocation* row_location) {
+    bool has_seq_col = _tablet_schema->has_sequence_col();
+    size_t seq_col_length = 0;
+    if (has_seq_col) {
+        seq_col_length = _tablet_schema->column(_tablet_schema->sequence_col_idx()).length() + 1;
+    }
+
+    Slice key_without_seq =
+            Slice(key.get_data(), key.get_size() - (with_seq_col ? seq_col_length : 0));
+
+    bool exact_match = false;
     RETURN_IF_ERROR(index_iterator->seek_at_or_after(&key_without_seq, &exact_match));
     if (!has_seq_col && !exact_match) {
         return Status::NotFound("Can't find key in the segment");
@@ -59,6 +59,7 @@ namespace segment_v2 {
 class BitmapIndexIterator;
 class Segment;
 class InvertedIndexIterator;
+class IndexedColumnIterator;
 
 using SegmentSharedPtr = std::shared_ptr<Segment>;
 // A Segment is used to represent a segment in memory format. When segment is
@@ -109,6 +110,15 @@ public:
 
     Status lookup_row_key(const Slice& key, bool with_seq_col, RowLocation* row_location);
 
+    // Batched version of lookup_row_key. `keys` must be sorted in ascending order of the key
+    // without sequence column. All keys are checked against the bloom filter in one pass and
+    // the surviving ones are sought through a single primary key index iterator, so adjacent
+    // keys falling into the same index page only decode it once.
+    // The lookup result of keys[i] is stored in (*statuses)[i] and (*row_locations)[i].
+    Status lookup_row_keys(const std::vector<Slice>& keys, bool with_seq_col,
+                           std::vector<RowLocation>* row_locations,
+                           std::vector<Status>* statuses);
+
     Status read_key_by_rowid(uint32_t row_id, std::string* key);
 
     // only used by UT
@@ -139,6 +149,8 @@ private:
     Status _parse_footer();
     Status _create_column_readers();
     Status _load_pk_bloom_filter();
+    Status _seek_row_key(const Slice& key, bool with_seq_col,
+                         IndexedColumnIterator* index_iterator, RowLocation* row_location);
 
 private:
     friend class SegmentIterator;
@@ -63,6 +63,7 @@
 #include "util/doris_metrics.h"
 #include "util/key_util.h"
 #include "util/simd/bits.h"
+#include "util/time.h"
 #include "vec/columns/column.h"
 #include "vec/columns/column_const.h"
 #include "vec/columns/column_nullable.h"
@@ -1329,6 +1330,7 @@ Status SegmentIterator::_vec_init_lazy_materialization() {
                 _filter_info_id.push_back(predicate);
             }
         }
+        _short_cir_eval_predicate_stats.resize(_short_cir_eval_predicate.size());
 
         // handle delete_condition
         if (!del_cond_id_set.empty()) {
@@ -1694,10 +1696,25 @@ uint16_t SegmentIterator::_evaluate_short_circuit_predicate(uint16_t* vec_sel_ro
     }
 
     uint16_t original_size = selected_size;
-    for (auto predicate : _short_cir_eval_predicate) {
+    // the predicates are evaluated on the rows selected by the former ones, measure them on the
+    // sampled batches to evaluate them in the order of the least expected cost
+    const int sample_interval = config::conjuncts_reorder_sample_interval;
+    bool sample = sample_interval > 0 && _short_cir_eval_predicate.size() > 1 &&
+                  _short_cir_eval_times++ % sample_interval == 0;
+    for (size_t i = 0; i < _short_cir_eval_predicate.size(); ++i) {
+        auto predicate = _short_cir_eval_predicate[i];
         auto column_id = predicate->column_id();
         auto& short_cir_column = _current_return_columns[column_id];
+        int64_t start_ns = sample ? MonotonicNanos() : 0;
+        uint16_t input_size = selected_size;
         selected_size = predicate->evaluate(*short_cir_column, vec_sel_rowid_idx, selected_size);
+        if (sample) {
+            _short_cir_eval_predicate_stats[i].update(MonotonicNanos() - start_ns, input_size,
+                                                      selected_size);
+        }
+    }
+    if (sample) {
+        reorder_by_rank(_short_cir_eval_predicate, _short_cir_eval_predicate_stats);
     }
 
     // collect profile
@@ -1737,10 +1754,48 @@ Status SegmentIterator::_read_columns_by_rowids(std::vector<ColumnId>& read_colu
 }
 
 Status SegmentIterator::next_batch(vectorized::Block* block) {
-    RETURN_IF_CATCH_EXCEPTION({ return _next_batch_internal(block); });
+    RETURN_IF_CATCH_EXCEPTION({
+        RETURN_IF_ERROR(_next_batch_internal(block));
+        // the row ids of the rows are recorded for the compactions only, which have no TopN
+        if (_runtime_predicate && !_opts.record_rowids) {
+            _filter_by_topn_top_row(block);
+        }
+        return Status::OK();
+    });
     return Status::OK();
 }
 
+void SegmentIterator::_filter_by_topn_top_row(vectorized::Block* block) {
+    auto& runtime_predicate = _opts.runtime_state->get_query_ctx()->get_runtime_predicate();
+    auto top_row = runtime_predicate.get_top_row(&_topn_top_row_version, &_topn_sort_description);
+    if (top_row.rows() > 0) {
+        _topn_top_row = std::move(top_row);
+        _topn_top_row_positions.clear();
+        for (const auto& top_column : _topn_top_row) {
+            int position = -1;
+            for (size_t i = 0; i < _schema->num_column_ids() && i < block->columns(); ++i) {
+                if (_schema->column(_schema->column_id(i))->name() == top_column.name) {
+                    position = i;
+                    break;
+                }
+            }
+            if (position < 0 || !block->get_by_position(position).type->equals(*top_column.type)) {
+                _topn_top_row_positions.clear();
+                break;
+            }
+            _topn_top_row_positions.push_back(position);
+        }
+    }
+    size_t num_rows = block->rows();
+    if (_topn_top_row_positions.empty() || num_rows == 0) {
+        return;
+    }
+    SCOPED_RAW_TIMER(&_opts.stats->vec_cond_ns);
+    vectorized::RuntimePredicate::filter_by_top_row(block, _topn_top_row_positions, _topn_top_row,
+                                                    _topn_sort_description);
+    _opts.stats->rows_vec_cond_filtered += num_rows - block->rows();
+}
+
 Status SegmentIterator::_next_batch_internal(vectorized::Block* block) {
     bool is_mem_reuse = block->mem_reuse();
     DCHECK(is_mem_reuse);
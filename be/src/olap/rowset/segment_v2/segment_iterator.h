@@ -43,10 +43,12 @@
 #include "olap/rowset/segment_v2/common.h"
 #include "olap/rowset/segment_v2/segment.h"
 #include "olap/schema.h"
+#include "util/predicate_stats.h"
 #include "util/runtime_profile.h"
 #include "util/slice.h"
 #include "vec/columns/column.h"
 #include "vec/core/block.h"
+#include "vec/core/sort_description.h"
 #include "vec/data_types/data_type.h"
 
 namespace doris {
@@ -122,7 +124,8 @@ public:
 
     bool update_profile(RuntimeProfile* profile) override {
         bool updated = false;
-        updated |= _update_profile(profile, _short_cir_eval_predicate, "ShortCircuitPredicates");
+        updated |= _update_profile(profile, _short_cir_eval_predicate, "ShortCircuitPredicates",
+                                   &_short_cir_eval_predicate_stats);
         updated |= _update_profile(profile, _pre_eval_block_predicate, "PreEvaluatePredicates");
 
         if (_opts.delete_condition_predicates != nullptr) {
@@ -139,13 +142,19 @@ private:
 
     template <typename Container>
     bool _update_profile(RuntimeProfile* profile, const Container& predicates,
-                         const std::string& title) {
+                         const std::string& title,
+                         const std::vector<PredicateStats>* stats = nullptr) {
         if (predicates.empty()) {
             return false;
         }
         std::string info;
+        size_t i = 0;
         for (auto pred : predicates) {
             info += "\n" + pred->debug_string();
+            if (stats != nullptr && i < stats->size() && (*stats)[i].input_rows > 0) {
+                info += ", " + (*stats)[i].debug_string();
+            }
+            ++i;
         }
         profile->add_info_string(title, info);
         return true;
@@ -252,6 +261,10 @@ private:
 
     void _update_max_row(const vectorized::Block* block);
 
+    // Filter the output rows by the top row of the TopN on all the sort columns, while the
+    // runtime predicate only checks the first one.
+    void _filter_by_topn_top_row(vectorized::Block* block);
+
     bool _check_apply_by_bitmap_index(ColumnPredicate* pred);
     bool _check_apply_by_inverted_index(ColumnPredicate* pred, bool pred_in_compound = false);
 
@@ -370,6 +383,9 @@ private:
     vectorized::MutableColumns _current_return_columns;
     std::vector<ColumnPredicate*> _pre_eval_block_predicate;
     std::vector<ColumnPredicate*> _short_cir_eval_predicate;
+    // the measured cost and selectivity of _short_cir_eval_predicate, to reorder them
+    std::vector<PredicateStats> _short_cir_eval_predicate_stats;
+    int64_t _short_cir_eval_times = 0;
     std::vector<uint32_t> _delete_range_column_ids;
     std::vector<uint32_t> _delete_bloom_filter_column_ids;
     // when lazy materialization is enabled, segmentIter need to read data at least twice
@@ -402,6 +418,12 @@ private:
     std::set<ColumnId> _not_apply_index_pred;
 
     std::shared_ptr<ColumnPredicate> _runtime_predicate {nullptr};
+    // the top row of the TopN and the positions of its sort columns in the output block, the
+    // positions are empty if any sort column is not output with the same type
+    vectorized::Block _topn_top_row;
+    vectorized::SortDescription _topn_sort_description;
+    std::vector<int> _topn_top_row_positions;
+    int64_t _topn_top_row_version = 0;
 
     // row schema of the key to seek
     // only used in `_get_row_ranges_by_keys`
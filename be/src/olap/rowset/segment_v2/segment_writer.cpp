@@ -37,6 +37,7 @@
 #include "olap/olap_common.h"
 #include "olap/primary_key_index.h"
 #include "olap/row_cursor.h"                      // RowCursor // IWYU pragma: keep
+#include "olap/rowset/rowset_tree.h"
 #include "olap/rowset/rowset_writer_context.h"    // RowsetWriterContext
 #include "olap/rowset/segment_v2/column_writer.h" // ColumnWriter
 #include "olap/rowset/segment_v2/page_io.h"
@@ -385,6 +386,7 @@ Status SegmentWriter::append_block_with_partial_content(const vectorized::Block*
         specified_rowsets = _tablet->get_rowset_by_ids(&_mow_context->rowset_ids);
     }
     std::vector<std::unique_ptr<SegmentCacheHandle>> segment_caches(specified_rowsets.size());
+    auto rowset_tree = _tablet->get_rowset_tree(specified_rowsets);
     // locate rows in base data
 
     int64_t num_rows_filtered = 0;
@@ -405,7 +407,8 @@ Status SegmentWriter::append_block_with_partial_content(const vectorized::Block*
         // save rowset shared ptr so this rowset wouldn't delete
         RowsetSharedPtr rowset;
         auto st = _tablet->lookup_row_key(key, have_input_seq_column, specified_rowsets, &loc,
-                                          _mow_context->max_version, segment_caches, &rowset);
+                                          _mow_context->max_version, segment_caches, &rowset,
+                                          rowset_tree.get());
         if (st.is<NOT_FOUND>()) {
             if (_tablet_schema->is_strict_mode()) {
                 ++num_rows_filtered;
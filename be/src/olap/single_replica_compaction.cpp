@@ -158,6 +158,7 @@ Status SingleReplicaCompaction::_do_single_replica_compaction_impl() {
     RETURN_IF_ERROR(_fetch_rowset(addr, token, proper_version));
     // 5. modify rowsets in memory
     RETURN_IF_ERROR(modify_rowsets());
+    carry_over_scan_result_cache();
 
     // 6. update last success compaction time
     if (compaction_type() == ReaderType::READER_CUMULATIVE_COMPACTION) {
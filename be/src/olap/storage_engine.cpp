@@ -159,6 +159,9 @@ StorageEngine::~StorageEngine() {
     if (_cold_data_compaction_thread_pool) {
         _cold_data_compaction_thread_pool->shutdown();
     }
+    if (_compaction_key_range_thread_pool) {
+        _compaction_key_range_thread_pool->shutdown();
+    }
     _clear();
     _s_instance = nullptr;
 }
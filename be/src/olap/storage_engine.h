@@ -216,6 +216,9 @@ public:
     }
     bool stopped() { return _stopped; }
     ThreadPool* get_bg_multiget_threadpool() { return _bg_multi_get_thread_pool.get(); }
+    ThreadPool* compaction_key_range_thread_pool() {
+        return _compaction_key_range_thread_pool.get();
+    }
 
     Status process_index_change_task(const TAlterInvertedIndexReq& reqest);
 
@@ -435,6 +438,8 @@ private:
     std::unique_ptr<ThreadPool> _single_replica_compaction_thread_pool;
     std::unique_ptr<ThreadPool> _seg_compaction_thread_pool;
     std::unique_ptr<ThreadPool> _cold_data_compaction_thread_pool;
+    // merge the key ranges of one compaction in parallel
+    std::unique_ptr<ThreadPool> _compaction_key_range_thread_pool;
 
     std::unique_ptr<ThreadPool> _tablet_publish_txn_thread_pool;
 
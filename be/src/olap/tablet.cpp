@@ -50,6 +50,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <numeric>
 #include <set>
 #include <shared_mutex>
 #include <string>
@@ -90,6 +91,7 @@
 #include "olap/rowset/rowset_factory.h"
 #include "olap/rowset/rowset_meta.h"
 #include "olap/rowset/rowset_meta_manager.h"
+#include "olap/rowset/rowset_tree.h"
 #include "olap/rowset/rowset_writer.h"
 #include "olap/rowset/rowset_writer_context.h"
 #include "olap/rowset/segment_v2/column_reader.h"
@@ -142,6 +144,7 @@ using std::vector;
 using io::FileSystemSPtr;
 
 static bvar::LatencyRecorder g_tablet_lookup_rowkey_latency("doris_pk", "tablet_lookup_rowkey");
+static bvar::LatencyRecorder g_tablet_lookup_rowkeys_latency("doris_pk", "tablet_lookup_rowkeys");
 static bvar::LatencyRecorder g_tablet_commit_phase_update_delete_bitmap_latency(
         "doris_pk", "commit_phase_update_delete_bitmap");
 static bvar::LatencyRecorder g_tablet_update_delete_bitmap_latency("doris_pk",
@@ -154,6 +157,7 @@ const std::chrono::seconds TRACE_TABLET_LOCK_THRESHOLD = 10s;
 
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(flush_bytes, MetricUnit::BYTES);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(flush_finish_count, MetricUnit::OPERATIONS);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(delete_bitmap_memory_bytes, MetricUnit::BYTES);
 
 bvar::Adder<uint64_t> exceed_version_limit_counter;
 bvar::Window<bvar::Adder<uint64_t>> exceed_version_limit_counter_minute(
@@ -274,6 +278,7 @@ Tablet::Tablet(TabletMetaSharedPtr tablet_meta, DataDir* data_dir,
 
     INT_COUNTER_METRIC_REGISTER(_metric_entity, flush_bytes);
     INT_COUNTER_METRIC_REGISTER(_metric_entity, flush_finish_count);
+    INT_GAUGE_METRIC_REGISTER(_metric_entity, delete_bitmap_memory_bytes);
 }
 
 Status Tablet::_init_once_action() {
@@ -496,6 +501,9 @@ Status Tablet::modify_rowsets(std::vector<RowsetSharedPtr>& to_add,
         }
     }
 
+    if (!to_delete.empty()) {
+        _clear_rowset_trees();
+    }
     std::vector<RowsetMetaSharedPtr> rs_metas_to_delete;
     for (auto& rs : to_delete) {
         rs_metas_to_delete.push_back(rs->rowset_meta());
@@ -553,6 +561,7 @@ void Tablet::delete_rowsets(const std::vector<RowsetSharedPtr>& to_delete, bool
     if (to_delete.empty()) {
         return;
     }
+    _clear_rowset_trees();
     std::vector<RowsetMetaSharedPtr> rs_metas;
     rs_metas.reserve(to_delete.size());
     for (auto& rs : to_delete) {
@@ -680,6 +689,10 @@ void Tablet::delete_expired_stale_rowset() {
     _timestamped_version_tracker.capture_expired_paths(
             static_cast<int64_t>(expired_stale_sweep_endtime), &path_id_vec);
 
+    if (enable_unique_key_merge_on_write()) {
+        delete_bitmap_memory_bytes->set_value(_tablet_meta->delete_bitmap().get_size_in_bytes());
+    }
+
     if (path_id_vec.empty()) {
         return;
     }
@@ -776,6 +789,9 @@ void Tablet::delete_expired_stale_rowset() {
     auto old_size = _stale_rs_version_map.size();
     auto old_meta_size = _tablet_meta->all_stale_rs_metas().size();
 
+    // the cached rowset trees may still hold the stale rowsets
+    _clear_rowset_trees();
+
     // do delete operation
     auto to_delete_iter = stale_version_path_map.begin();
     while (to_delete_iter != stale_version_path_map.end()) {
@@ -805,6 +821,10 @@ void Tablet::delete_expired_stale_rowset() {
 
     bool reconstructed = _reconstruct_version_tracker_if_necessary();
 
+    if (enable_unique_key_merge_on_write()) {
+        _compact_delete_bitmap_versions_unlocked();
+    }
+
     VLOG_NOTICE << "delete stale rowset _stale_rs_version_map tablet=" << full_name()
                 << " current_size=" << _stale_rs_version_map.size() << " old_size=" << old_size
                 << " current_meta_size=" << _tablet_meta->all_stale_rs_metas().size()
@@ -816,6 +836,28 @@ void Tablet::delete_expired_stale_rowset() {
 #endif
 }
 
+void Tablet::_compact_delete_bitmap_versions_unlocked() {
+    // A reader must start from version 0, so the smallest end version of the rowsets
+    // starting from 0 is the smallest version which can still be read.
+    int64_t min_readable_version = -1;
+    for (auto* rs_map : {&_rs_version_map, &_stale_rs_version_map}) {
+        for (auto& [version, _] : *rs_map) {
+            if (version.first == 0 &&
+                (min_readable_version < 0 || version.second < min_readable_version)) {
+                min_readable_version = version.second;
+            }
+        }
+    }
+    if (min_readable_version <= 0) {
+        return;
+    }
+    size_t num_merged = _tablet_meta->delete_bitmap().compact_versions(min_readable_version);
+    delete_bitmap_memory_bytes->set_value(_tablet_meta->delete_bitmap().get_size_in_bytes());
+    VLOG_NOTICE << "compact delete bitmap versions, tablet=" << full_name()
+                << " min_readable_version=" << min_readable_version
+                << " merged bitmaps=" << num_merged;
+}
+
 bool Tablet::_reconstruct_version_tracker_if_necessary() {
     double orphan_vertex_ratio = _timestamped_version_tracker.get_orphan_vertex_ratio();
     if (orphan_vertex_ratio >= config::tablet_version_graph_orphan_vertex_ratio) {
@@ -2749,11 +2791,98 @@ Status Tablet::lookup_row_data(const Slice& encoded_key, const RowLocation& row_
     return Status::OK();
 }
 
+Status Tablet::lookup_row_data(RowsetSharedPtr input_rowset, uint32_t segid,
+                               const std::vector<uint32_t>& rowids, OlapReaderStatistics& stats,
+                               vectorized::MutableColumnPtr& values) {
+    BetaRowsetSharedPtr rowset = std::static_pointer_cast<BetaRowset>(input_rowset);
+    CHECK(rowset);
+    const TabletSchemaSPtr tablet_schema = rowset->tablet_schema();
+    CHECK(tablet_schema->store_row_column());
+    SegmentCacheHandle segment_cache;
+    RETURN_IF_ERROR(SegmentLoader::instance()->load_segments(rowset, &segment_cache, true));
+    // find segment
+    auto it = std::find_if(
+            segment_cache.get_segments().begin(), segment_cache.get_segments().end(),
+            [&segid](const segment_v2::SegmentSharedPtr& seg) { return seg->id() == segid; });
+    if (it == segment_cache.get_segments().end()) {
+        return Status::NotFound(fmt::format("rowset {} 's segemnt not found, seg_id {}",
+                                            rowset->rowset_id().to_string(), segid));
+    }
+    segment_v2::SegmentSharedPtr segment = *it;
+    std::unique_ptr<segment_v2::ColumnIterator> column_iterator;
+    RETURN_IF_ERROR(segment->new_column_iterator(tablet_schema->column(BeConsts::ROW_STORE_COL),
+                                                 &column_iterator));
+    segment_v2::ColumnIteratorOptions opt;
+    opt.file_reader = segment->file_reader().get();
+    opt.stats = &stats;
+    opt.use_page_cache = !config::disable_storage_page_cache;
+    column_iterator->init(opt);
+    RETURN_IF_ERROR(column_iterator->read_by_rowids(rowids.data(), rowids.size(), values));
+    DCHECK_EQ(values->size(), rowids.size());
+    return Status::OK();
+}
+
+std::shared_ptr<const RowsetTree> Tablet::get_rowset_tree(
+        const std::vector<RowsetSharedPtr>& specified_rowsets) {
+    int64_t num_segments = 0;
+    int64_t version = -1;
+    for (auto& rs : specified_rowsets) {
+        num_segments += rs->num_segments();
+        version = std::max(version, rs->end_version());
+    }
+    if (num_segments < config::pk_lookup_rowset_tree_min_segments) {
+        return nullptr;
+    }
+    auto same_rowsets = [&](const RowsetTree& tree) {
+        auto& tree_rowsets = tree.all_rowsets();
+        if (tree_rowsets.size() != specified_rowsets.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < tree_rowsets.size(); i++) {
+            if (tree_rowsets[i]->rowset_id() != specified_rowsets[i]->rowset_id()) {
+                return false;
+            }
+        }
+        return true;
+    };
+    int64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(_rowset_tree_lock);
+        auto it = _rowset_trees.find(version);
+        if (it != _rowset_trees.end() && same_rowsets(*it->second)) {
+            return it->second;
+        }
+        generation = _rowset_tree_generation;
+    }
+    // build the tree out of lock, it only reads rowset metas
+    auto rowset_tree = std::make_shared<RowsetTree>();
+    Status st = rowset_tree->Init(specified_rowsets);
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to build rowset tree, tablet: " << tablet_id() << ", " << st;
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(_rowset_tree_lock);
+    // the rowsets may be removed from the tablet while building the tree, don't keep them
+    if (generation == _rowset_tree_generation) {
+        _rowset_trees[version] = rowset_tree;
+        if (_rowset_trees.size() > MAX_CACHED_ROWSET_TREES) {
+            _rowset_trees.erase(_rowset_trees.begin());
+        }
+    }
+    return rowset_tree;
+}
+
+void Tablet::_clear_rowset_trees() {
+    std::lock_guard<std::mutex> lock(_rowset_tree_lock);
+    _rowset_trees.clear();
+    ++_rowset_tree_generation;
+}
+
 Status Tablet::lookup_row_key(const Slice& encoded_key, bool with_seq_col,
                               const std::vector<RowsetSharedPtr>& specified_rowsets,
                               RowLocation* row_location, uint32_t version,
                               std::vector<std::unique_ptr<SegmentCacheHandle>>& segment_caches,
-                              RowsetSharedPtr* rowset) {
+                              RowsetSharedPtr* rowset, const RowsetTree* rowset_tree) {
     SCOPED_BVAR_LATENCY(g_tablet_lookup_rowkey_latency);
     size_t seq_col_length = 0;
     if (_schema->has_sequence_col() && with_seq_col) {
@@ -2762,63 +2891,199 @@ Status Tablet::lookup_row_key(const Slice& encoded_key, bool with_seq_col,
     Slice key_without_seq = Slice(encoded_key.get_data(), encoded_key.get_size() - seq_col_length);
     RowLocation loc;
 
-    for (size_t i = 0; i < specified_rowsets.size(); i++) {
-        auto& rs = specified_rowsets[i];
-        auto& segments_key_bounds = rs->rowset_meta()->get_segments_key_bounds();
-        int num_segments = rs->num_segments();
-        DCHECK_EQ(segments_key_bounds.size(), num_segments);
-        std::vector<uint32_t> picked_segments;
-        for (int i = num_segments - 1; i >= 0; i--) {
-            if (key_without_seq.compare(segments_key_bounds[i].max_key()) > 0 ||
-                key_without_seq.compare(segments_key_bounds[i].min_key()) < 0) {
-                continue;
+    // (index in specified_rowsets, segment id) of the segments whose key bounds contain the key,
+    // ordered by rowset index ascending and then segment id descending.
+    std::vector<std::pair<size_t, uint32_t>> picked_segments;
+    if (rowset_tree != nullptr) {
+        std::vector<std::pair<RowsetSharedPtr, int32_t>> candidates;
+        rowset_tree->FindRowsetsWithKeyInRange(key_without_seq, nullptr, &candidates);
+        for (auto& [rs, segment_id] : candidates) {
+            int32_t ordinal = rowset_tree->rs_ordinal_by_id(rs->rowset_id());
+            DCHECK(ordinal >= 0 && ordinal < specified_rowsets.size());
+            picked_segments.emplace_back(ordinal, segment_id);
+        }
+        std::sort(picked_segments.begin(), picked_segments.end(),
+                  [](const std::pair<size_t, uint32_t>& lhs,
+                     const std::pair<size_t, uint32_t>& rhs) {
+                      return lhs.first != rhs.first ? lhs.first < rhs.first
+                                                    : lhs.second > rhs.second;
+                  });
+    } else {
+        for (size_t i = 0; i < specified_rowsets.size(); i++) {
+            auto& segments_key_bounds =
+                    specified_rowsets[i]->rowset_meta()->get_segments_key_bounds();
+            int num_segments = specified_rowsets[i]->num_segments();
+            DCHECK_EQ(segments_key_bounds.size(), num_segments);
+            for (int j = num_segments - 1; j >= 0; j--) {
+                if (key_without_seq.compare(segments_key_bounds[j].max_key()) > 0 ||
+                    key_without_seq.compare(segments_key_bounds[j].min_key()) < 0) {
+                    continue;
+                }
+                picked_segments.emplace_back(i, j);
             }
-            picked_segments.emplace_back(i);
         }
-        if (picked_segments.empty()) {
+    }
+
+    // the key is deleted in this rowset, skip its remaining segments
+    size_t skipped_rowset = specified_rowsets.size();
+    for (auto [i, id] : picked_segments) {
+        if (i == skipped_rowset) {
             continue;
         }
-
+        auto& rs = specified_rowsets[i];
         if (UNLIKELY(segment_caches[i] == nullptr)) {
             segment_caches[i] = std::make_unique<SegmentCacheHandle>();
             RETURN_IF_ERROR(SegmentLoader::instance()->load_segments(
                     std::static_pointer_cast<BetaRowset>(rs), segment_caches[i].get(), true));
         }
         auto& segments = segment_caches[i]->get_segments();
-        DCHECK_EQ(segments.size(), num_segments);
+        DCHECK_EQ(segments.size(), rs->num_segments());
 
-        for (auto id : picked_segments) {
-            Status s = segments[id]->lookup_row_key(encoded_key, with_seq_col, &loc);
-            if (s.is<NOT_FOUND>()) {
+        Status s = segments[id]->lookup_row_key(encoded_key, with_seq_col, &loc);
+        if (s.is<NOT_FOUND>()) {
+            continue;
+        }
+        if (!s.ok() && !s.is<ALREADY_EXIST>()) {
+            return s;
+        }
+        if (s.ok() && _tablet_meta->delete_bitmap().contains_agg_without_cache(
+                              {loc.rowset_id, loc.segment_id, version}, loc.row_id)) {
+            // if has sequence col, we continue to compare the sequence_id of
+            // all rowsets, util we find an existing key.
+            if (_schema->has_sequence_col()) {
                 continue;
             }
-            if (!s.ok() && !s.is<ALREADY_EXIST>()) {
-                return s;
+            // The key is deleted, we don't need to search for it any more.
+            skipped_rowset = i;
+            continue;
+        }
+        // `st` is either OK or ALREADY_EXIST now.
+        // for partial update, even if the key is already exists, we still need to
+        // read it's original values to keep all columns align.
+        *row_location = loc;
+        if (rowset) {
+            // return it's rowset
+            *rowset = rs;
+        }
+        // find it and return
+        return s;
+    }
+    g_tablet_pk_not_found << 1;
+    return Status::NotFound("can't find key in all rowsets");
+}
+
+Status Tablet::lookup_row_keys(const std::vector<Slice>& encoded_keys, bool with_seq_col,
+                               const std::vector<RowsetSharedPtr>& specified_rowsets,
+                               uint32_t version,
+                               std::vector<std::unique_ptr<SegmentCacheHandle>>& segment_caches,
+                               std::vector<Status>* statuses,
+                               std::vector<RowLocation>* row_locations,
+                               std::vector<RowsetSharedPtr>* rowsets) {
+    SCOPED_BVAR_LATENCY(g_tablet_lookup_rowkeys_latency);
+    size_t seq_col_length = 0;
+    if (_schema->has_sequence_col() && with_seq_col) {
+        seq_col_length = _schema->column(_schema->sequence_col_idx()).length() + 1;
+    }
+    size_t num_keys = encoded_keys.size();
+    statuses->assign(num_keys, Status::NotFound("can't find key in all rowsets"));
+    row_locations->resize(num_keys);
+    rowsets->resize(num_keys);
+
+    std::vector<Slice> keys_without_seq(num_keys);
+    for (size_t i = 0; i < num_keys; ++i) {
+        keys_without_seq[i] =
+                Slice(encoded_keys[i].get_data(), encoded_keys[i].get_size() - seq_col_length);
+    }
+    // sort ordinals of keys so that each segment is probed with ascending keys, and the keys
+    // in a segment's bounds form a continuous range.
+    std::vector<uint32_t> pending(num_keys);
+    std::iota(pending.begin(), pending.end(), 0);
+    std::sort(pending.begin(), pending.end(), [&](uint32_t lhs, uint32_t rhs) {
+        return keys_without_seq[lhs].compare(keys_without_seq[rhs]) < 0;
+    });
+
+    // keys which are deleted in a rowset are not searched in its remaining segments,
+    // the same as lookup_row_key
+    std::vector<uint8_t> skipped_in_rowset(num_keys, 0);
+    std::vector<Slice> segment_keys;
+    std::vector<RowLocation> segment_locs;
+    std::vector<Status> segment_statuses;
+    for (size_t i = 0; i < specified_rowsets.size() && !pending.empty(); i++) {
+        auto& rs = specified_rowsets[i];
+        auto& segments_key_bounds = rs->rowset_meta()->get_segments_key_bounds();
+        int num_segments = rs->num_segments();
+        DCHECK_EQ(segments_key_bounds.size(), num_segments);
+        std::fill(skipped_in_rowset.begin(), skipped_in_rowset.end(), 0);
+        bool resolved_any = false;
+
+        for (int seg = num_segments - 1; seg >= 0; seg--) {
+            Slice min_key(segments_key_bounds[seg].min_key());
+            Slice max_key(segments_key_bounds[seg].max_key());
+            auto first = std::lower_bound(pending.begin(), pending.end(), min_key,
+                                          [&](uint32_t ordinal, const Slice& key) {
+                                              return keys_without_seq[ordinal].compare(key) < 0;
+                                          });
+            auto last = std::upper_bound(first, pending.end(), max_key,
+                                         [&](const Slice& key, uint32_t ordinal) {
+                                             return key.compare(keys_without_seq[ordinal]) < 0;
+                                         });
+            std::vector<uint32_t> candidates;
+            for (auto it = first; it != last; ++it) {
+                if (!skipped_in_rowset[*it] && !(*rowsets)[*it]) {
+                    candidates.push_back(*it);
+                }
+            }
+            if (candidates.empty()) {
+                continue;
             }
-            if (s.ok() && _tablet_meta->delete_bitmap().contains_agg_without_cache(
-                                  {loc.rowset_id, loc.segment_id, version}, loc.row_id)) {
-                // if has sequence col, we continue to compare the sequence_id of
-                // all rowsets, util we find an existing key.
-                if (_schema->has_sequence_col()) {
+
+            if (UNLIKELY(segment_caches[i] == nullptr)) {
+                segment_caches[i] = std::make_unique<SegmentCacheHandle>();
+                RETURN_IF_ERROR(SegmentLoader::instance()->load_segments(
+                        std::static_pointer_cast<BetaRowset>(rs), segment_caches[i].get(), true));
+            }
+            auto& segments = segment_caches[i]->get_segments();
+            DCHECK_EQ(segments.size(), num_segments);
+
+            segment_keys.clear();
+            for (auto ordinal : candidates) {
+                segment_keys.push_back(encoded_keys[ordinal]);
+            }
+            RETURN_IF_ERROR(segments[seg]->lookup_row_keys(segment_keys, with_seq_col,
+                                                           &segment_locs, &segment_statuses));
+            for (size_t k = 0; k < candidates.size(); ++k) {
+                auto ordinal = candidates[k];
+                Status& s = segment_statuses[k];
+                RowLocation& loc = segment_locs[k];
+                if (s.is<NOT_FOUND>()) {
                     continue;
                 }
-                // The key is deleted, we don't need to search for it any more.
-                break;
-            }
-            // `st` is either OK or ALREADY_EXIST now.
-            // for partial update, even if the key is already exists, we still need to
-            // read it's original values to keep all columns align.
-            *row_location = loc;
-            if (rowset) {
-                // return it's rowset
-                *rowset = rs;
+                if (!s.ok() && !s.is<ALREADY_EXIST>()) {
+                    return s;
+                }
+                if (s.ok() && _tablet_meta->delete_bitmap().contains_agg_without_cache(
+                                      {loc.rowset_id, loc.segment_id, version}, loc.row_id)) {
+                    if (!_schema->has_sequence_col()) {
+                        skipped_in_rowset[ordinal] = 1;
+                    }
+                    continue;
+                }
+                (*statuses)[ordinal] = std::move(s);
+                (*row_locations)[ordinal] = loc;
+                (*rowsets)[ordinal] = rs;
+                resolved_any = true;
             }
-            // find it and return
-            return s;
+        }
+        if (resolved_any) {
+            pending.erase(std::remove_if(pending.begin(), pending.end(),
+                                         [&](uint32_t ordinal) {
+                                             return (*rowsets)[ordinal] != nullptr;
+                                         }),
+                          pending.end());
         }
     }
-    g_tablet_pk_not_found << 1;
-    return Status::NotFound("can't find key in all rowsets");
+    g_tablet_pk_not_found << pending.size();
+    return Status::OK();
 }
 
 // load segment may do io so it should out lock
@@ -2896,6 +3161,7 @@ Status Tablet::calc_segment_delete_bitmap(RowsetSharedPtr rowset,
     // will update the lru cache, and there will be obvious lock competition in multithreading
     // scenarios, so using a segment_caches to cache SegmentCacheHandle.
     std::vector<std::unique_ptr<SegmentCacheHandle>> segment_caches(specified_rowsets.size());
+    auto rowset_tree = get_rowset_tree(specified_rowsets);
     while (remaining > 0) {
         std::unique_ptr<segment_v2::IndexedColumnIterator> iter;
         RETURN_IF_ERROR(pk_idx->new_iterator(&iter));
@@ -2931,7 +3197,7 @@ Status Tablet::calc_segment_delete_bitmap(RowsetSharedPtr rowset,
 
             RowsetSharedPtr rowset_find;
             auto st = lookup_row_key(key, true, specified_rowsets, &loc, dummy_version.first - 1,
-                                     segment_caches, &rowset_find);
+                                     segment_caches, &rowset_find, rowset_tree.get());
             bool expected_st = st.ok() || st.is<NOT_FOUND>() || st.is<ALREADY_EXIST>();
             DCHECK(expected_st) << "unexpected error status while lookup_row_key:" << st;
             if (!expected_st) {
@@ -3279,7 +3545,14 @@ Status Tablet::update_delete_bitmap(const RowsetSharedPtr& rowset,
     std::vector<segment_v2::SegmentSharedPtr> segments;
     _load_rowset_segments(rowset, &segments);
 
-    std::lock_guard<std::mutex> rwlock(_rowset_update_lock);
+    // 1. Calculate the delete bitmap against a snapshot of the rowsets without holding
+    // _rowset_update_lock, so that the lookups don't block compactions of this tablet.
+    // Partial update writes rows filled with the values of the matched rowsets, which can't
+    // be revised if those rowsets are compacted meanwhile, so it holds the lock all along.
+    std::unique_lock<std::mutex> rwlock(_rowset_update_lock, std::defer_lock);
+    if (rowset->tablet_schema()->is_partial_update()) {
+        rwlock.lock();
+    }
     {
         std::shared_lock meta_rlock(_meta_lock);
         // tablet is under alter process. The delete bitmap will be calculated after conversion.
@@ -3291,31 +3564,51 @@ Status Tablet::update_delete_bitmap(const RowsetSharedPtr& rowset,
         }
         cur_rowset_ids = all_rs_id(cur_version - 1);
     }
-    _rowset_ids_difference(cur_rowset_ids, pre_rowset_ids, &rowset_ids_to_add, &rowset_ids_to_del);
-    for (const auto& to_del : rowset_ids_to_del) {
-        delete_bitmap->remove({to_del, 0, 0}, {to_del, UINT32_MAX, INT64_MAX});
+    OlapStopWatch watch;
+    RETURN_IF_ERROR(_calc_delete_bitmap_of_rowset_diff(rowset, segments, pre_rowset_ids,
+                                                       cur_rowset_ids, delete_bitmap, cur_version,
+                                                       rowset_writer, &rowset_ids_to_add,
+                                                       &rowset_ids_to_del));
+    int64_t calc_cost_us = watch.get_elapse_time_us();
+#ifdef BE_TEST
+    if (_update_delete_bitmap_hook) {
+        _update_delete_bitmap_hook();
     }
+#endif
 
-    std::vector<RowsetSharedPtr> specified_rowsets;
+    // 2. Catch up with the rowsets changed by compactions during step 1, compactions
+    // modify rowsets under _rowset_update_lock so the rowsets are stable until we finish.
+    if (!rwlock.owns_lock()) {
+        rwlock.lock();
+    }
+    RowsetIdUnorderedSet latest_rowset_ids;
     {
         std::shared_lock meta_rlock(_meta_lock);
-        specified_rowsets = get_rowset_by_ids(&rowset_ids_to_add);
+        if (tablet_state() == TABLET_NOTREADY &&
+            SchemaChangeHandler::tablet_in_converting(tablet_id())) {
+            LOG(INFO) << "tablet is under alter process, update delete bitmap later, tablet_id="
+                      << tablet_id();
+            return Status::OK();
+        }
+        latest_rowset_ids = all_rs_id(cur_version - 1);
     }
+    RowsetIdUnorderedSet catch_up_ids_to_add;
+    RowsetIdUnorderedSet catch_up_ids_to_del;
+    RETURN_IF_ERROR(_calc_delete_bitmap_of_rowset_diff(
+            rowset, segments, cur_rowset_ids, latest_rowset_ids, delete_bitmap, cur_version,
+            rowset_writer, &catch_up_ids_to_add, &catch_up_ids_to_del));
 
-    OlapStopWatch watch;
-    auto token = StorageEngine::instance()->calc_delete_bitmap_executor()->create_token();
-    RETURN_IF_ERROR(calc_delete_bitmap(rowset, segments, specified_rowsets, delete_bitmap,
-                                       cur_version - 1, token.get(), rowset_writer));
-    token->wait();
-    token->get_delete_bitmap(delete_bitmap);
     size_t total_rows = std::accumulate(
             segments.begin(), segments.end(), 0,
             [](size_t sum, const segment_v2::SegmentSharedPtr& s) { return sum += s->num_rows(); });
     LOG(INFO) << "[Publish] construct delete bitmap tablet: " << tablet_id()
               << ", rowset_ids to add: " << rowset_ids_to_add.size()
               << ", rowset_ids to del: " << rowset_ids_to_del.size()
+              << ", catch up rowset_ids to add: " << catch_up_ids_to_add.size()
+              << ", catch up rowset_ids to del: " << catch_up_ids_to_del.size()
               << ", cur max_version: " << cur_version << ", transaction_id: " << txn_id
-              << ", cost: " << watch.get_elapse_time_us() << "(us), total rows: " << total_rows;
+              << ", cost: " << watch.get_elapse_time_us() << "(us), calc cost: " << calc_cost_us
+              << "(us), total rows: " << total_rows;
 
     // update version without write lock, compaction and publish_txn
     // will update delete bitmap, handle compaction with _rowset_update_lock
@@ -3329,6 +3622,31 @@ Status Tablet::update_delete_bitmap(const RowsetSharedPtr& rowset,
     return Status::OK();
 }
 
+Status Tablet::_calc_delete_bitmap_of_rowset_diff(
+        const RowsetSharedPtr& rowset, const std::vector<segment_v2::SegmentSharedPtr>& segments,
+        const RowsetIdUnorderedSet& pre_rowset_ids, const RowsetIdUnorderedSet& cur_rowset_ids,
+        DeleteBitmapPtr delete_bitmap, int64_t cur_version, RowsetWriter* rowset_writer,
+        RowsetIdUnorderedSet* rowset_ids_to_add, RowsetIdUnorderedSet* rowset_ids_to_del) {
+    _rowset_ids_difference(cur_rowset_ids, pre_rowset_ids, rowset_ids_to_add, rowset_ids_to_del);
+    for (const auto& to_del : *rowset_ids_to_del) {
+        delete_bitmap->remove({to_del, 0, 0}, {to_del, UINT32_MAX, INT64_MAX});
+    }
+    if (rowset_ids_to_add->empty()) {
+        return Status::OK();
+    }
+
+    std::vector<RowsetSharedPtr> specified_rowsets;
+    {
+        std::shared_lock meta_rlock(_meta_lock);
+        specified_rowsets = get_rowset_by_ids(rowset_ids_to_add);
+    }
+    auto token = StorageEngine::instance()->calc_delete_bitmap_executor()->create_token();
+    RETURN_IF_ERROR(calc_delete_bitmap(rowset, segments, specified_rowsets, delete_bitmap,
+                                       cur_version - 1, token.get(), rowset_writer));
+    RETURN_IF_ERROR(token->wait());
+    return token->get_delete_bitmap(delete_bitmap);
+}
+
 void Tablet::calc_compaction_output_rowset_delete_bitmap(
         const std::vector<RowsetSharedPtr>& input_rowsets, const RowIdConversion& rowid_conversion,
         uint64_t start_version, uint64_t end_version, std::set<RowLocation>* missed_rows,
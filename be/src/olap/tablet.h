@@ -71,6 +71,7 @@ class TTabletInfo;
 class TabletMetaPB;
 class TupleDescriptor;
 class CalcDeleteBitmapToken;
+class RowsetTree;
 enum CompressKind : int;
 
 namespace io {
@@ -419,7 +420,27 @@ public:
                           const std::vector<RowsetSharedPtr>& specified_rowsets,
                           RowLocation* row_location, uint32_t version,
                           std::vector<std::unique_ptr<SegmentCacheHandle>>& segment_caches,
-                          RowsetSharedPtr* rowset = nullptr);
+                          RowsetSharedPtr* rowset = nullptr,
+                          const RowsetTree* rowset_tree = nullptr);
+
+    // Return the interval tree of the segments' key bounds of `specified_rowsets`, which can be
+    // passed to lookup_row_key to pick candidate segments without checking every segment's
+    // key bounds. Return nullptr if the rowsets have too few segments to benefit from it.
+    // The trees of the latest few versions are cached, so lookups on the same version share it.
+    std::shared_ptr<const RowsetTree> get_rowset_tree(
+            const std::vector<RowsetSharedPtr>& specified_rowsets);
+
+    // Batched version of lookup_row_key, used by point queries with many keys.
+    // Keys are sorted internally, then every candidate segment is probed once for all the
+    // keys falling into its key bounds instead of once per key. The result of
+    // encoded_keys[i] is stored in (*statuses)[i], (*row_locations)[i] and (*rowsets)[i],
+    // with the same meaning as the return value and outputs of lookup_row_key.
+    Status lookup_row_keys(const std::vector<Slice>& encoded_keys, bool with_seq_col,
+                           const std::vector<RowsetSharedPtr>& specified_rowsets,
+                           uint32_t version,
+                           std::vector<std::unique_ptr<SegmentCacheHandle>>& segment_caches,
+                           std::vector<Status>* statuses, std::vector<RowLocation>* row_locations,
+                           std::vector<RowsetSharedPtr>* rowsets);
 
     // Lookup a row with TupleDescriptor and fill Block
     Status lookup_row_data(const Slice& encoded_key, const RowLocation& row_location,
@@ -427,6 +448,12 @@ public:
                            OlapReaderStatistics& stats, std::string& values,
                            bool write_to_cache = false);
 
+    // Read the row store values of `rowids` (sorted in ascending order) of segment `segid`
+    // in `rowset` through one column iterator, values are appended to `values` in order.
+    Status lookup_row_data(RowsetSharedPtr rowset, uint32_t segid,
+                           const std::vector<uint32_t>& rowids, OlapReaderStatistics& stats,
+                           vectorized::MutableColumnPtr& values);
+
     Status fetch_value_by_rowids(RowsetSharedPtr input_rowset, uint32_t segid,
                                  const std::vector<uint32_t>& rowids,
                                  const TabletColumn& tablet_column,
@@ -486,6 +513,13 @@ public:
                                 const RowsetIdUnorderedSet& pre_rowset_ids,
                                 DeleteBitmapPtr delete_bitmap, int64_t txn_id,
                                 RowsetWriter* rowset_writer = nullptr);
+#ifdef BE_TEST
+    // Called by update_delete_bitmap after the delete bitmap is calculated without
+    // _rowset_update_lock and before the catch-up, to change the rowsets in the meantime.
+    void set_update_delete_bitmap_hook(std::function<void()> hook) {
+        _update_delete_bitmap_hook = std::move(hook);
+    }
+#endif
     void calc_compaction_output_rowset_delete_bitmap(
             const std::vector<RowsetSharedPtr>& input_rowsets,
             const RowIdConversion& rowid_conversion, uint64_t start_version, uint64_t end_version,
@@ -560,6 +594,8 @@ private:
     /// Delete stale rowset by version. This method not only delete the version in expired rowset map,
     /// but also delete the version in rowset meta vector.
     void _delete_stale_rowset_by_version(const Version& version);
+    // Drop the cached rowset trees, called when rowsets are removed from the tablet.
+    void _clear_rowset_trees();
     Status _capture_consistent_rowsets_unlocked(const std::vector<Version>& version_path,
                                                 std::vector<RowsetSharedPtr>* rowsets) const;
 
@@ -576,6 +612,16 @@ private:
                                      const std::vector<segment_v2::SegmentSharedPtr>& pre_segments,
                                      const Slice& key, DeleteBitmapPtr delete_bitmap,
                                      RowLocation* loc);
+    // Calculate delete bitmap of `rowset` against the rowsets in `cur_rowset_ids` but not in
+    // `pre_rowset_ids`, and remove the marks on the rowsets which are gone.
+    Status _calc_delete_bitmap_of_rowset_diff(
+            const RowsetSharedPtr& rowset,
+            const std::vector<segment_v2::SegmentSharedPtr>& segments,
+            const RowsetIdUnorderedSet& pre_rowset_ids, const RowsetIdUnorderedSet& cur_rowset_ids,
+            DeleteBitmapPtr delete_bitmap, int64_t cur_version, RowsetWriter* rowset_writer,
+            RowsetIdUnorderedSet* rowset_ids_to_add, RowsetIdUnorderedSet* rowset_ids_to_del);
+    // Merge the delete bitmaps of the versions which can't be read any more.
+    void _compact_delete_bitmap_versions_unlocked();
     void _rowset_ids_difference(const RowsetIdUnorderedSet& cur, const RowsetIdUnorderedSet& pre,
                                 RowsetIdUnorderedSet* to_add, RowsetIdUnorderedSet* to_del);
     Status _load_rowset_segments(const RowsetSharedPtr& rowset,
@@ -619,6 +665,17 @@ private:
     // We use a separate lock rather than _meta_lock, to avoid blocking read queries
     // during publish_txn, which might take hundreds of milliseconds
     mutable std::mutex _rowset_update_lock;
+#ifdef BE_TEST
+    std::function<void()> _update_delete_bitmap_hook;
+#endif
+
+    // Interval trees of the segments' key bounds of the rowsets used by primary key lookups,
+    // keyed by the max version of the rowsets. They are dropped whenever rowsets are removed
+    // from the tablet, so that no cached tree keeps a compacted rowset from being deleted.
+    static constexpr size_t MAX_CACHED_ROWSET_TREES = 4;
+    std::mutex _rowset_tree_lock;
+    int64_t _rowset_tree_generation = 0;
+    std::map<int64_t, std::shared_ptr<const RowsetTree>> _rowset_trees;
 
     // After version 0.13, all newly created rowsets are saved in _rs_version_map.
     // And if rowset being compacted, the old rowsetis will be saved in _stale_rs_version_map;
@@ -692,6 +749,7 @@ private:
 public:
     IntCounter* flush_bytes;
     IntCounter* flush_finish_count;
+    IntGauge* delete_bitmap_memory_bytes;
     std::atomic<int64_t> publised_count = 0;
 };
 
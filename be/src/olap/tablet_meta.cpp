@@ -39,6 +39,7 @@
 #include "olap/tablet_meta_manager.h"
 #include "olap/utils.h"
 #include "util/string_util.h"
+#include "util/time.h"
 #include "util/uid_util.h"
 
 using std::string;
@@ -862,9 +863,7 @@ bool operator!=(const TabletMeta& a, const TabletMeta& b) {
     return !(a == b);
 }
 
-DeleteBitmap::DeleteBitmap(int64_t tablet_id) : _tablet_id(tablet_id) {
-    _agg_cache.reset(new AggCache(config::delete_bitmap_agg_cache_capacity));
-}
+DeleteBitmap::DeleteBitmap(int64_t tablet_id) : _tablet_id(tablet_id) {}
 
 DeleteBitmap::DeleteBitmap(const DeleteBitmap& o) {
     delete_bitmap = o.delete_bitmap; // just copy data
@@ -1032,42 +1031,110 @@ static std::string agg_cache_key(int64_t tablet_id, const DeleteBitmap::BitmapKe
 }
 
 std::shared_ptr<roaring::Roaring> DeleteBitmap::get_agg(const BitmapKey& bmk) const {
+    auto aggregate = [this, &bmk](roaring::Roaring* bitmap) {
+        std::shared_lock l(lock);
+        DeleteBitmap::BitmapKey start {std::get<0>(bmk), std::get<1>(bmk), 0};
+        for (auto it = delete_bitmap.lower_bound(start); it != delete_bitmap.end(); ++it) {
+            auto& [k, bm] = *it;
+            if (std::get<0>(k) != std::get<0>(bmk) || std::get<1>(k) != std::get<1>(bmk) ||
+                std::get<2>(k) > std::get<2>(bmk)) {
+                break;
+            }
+            *bitmap |= bm;
+        }
+    };
+    AggCache* agg_cache = AggCache::instance();
+    if (agg_cache == nullptr) {
+        // no cache in tools, aggregate every time
+        auto bitmap = std::make_shared<roaring::Roaring>();
+        aggregate(bitmap.get());
+        return bitmap;
+    }
+
+    Cache* cache = agg_cache->get();
     std::string key_str = agg_cache_key(_tablet_id, bmk); // Cache key container
     CacheKey key(key_str);
-    Cache::Handle* handle = _agg_cache->repr()->lookup(key);
+    Cache::Handle* handle = cache->lookup(key);
 
     AggCache::Value* val =
-            handle == nullptr
-                    ? nullptr
-                    : reinterpret_cast<AggCache::Value*>(_agg_cache->repr()->value(handle));
+            handle == nullptr ? nullptr : reinterpret_cast<AggCache::Value*>(cache->value(handle));
     // FIXME: do we need a mutex here to get rid of duplicated initializations
     //        of cache entries in some cases?
     if (val == nullptr) { // Renew if needed, put a new Value to cache
         val = new AggCache::Value();
-        {
-            std::shared_lock l(lock);
-            DeleteBitmap::BitmapKey start {std::get<0>(bmk), std::get<1>(bmk), 0};
-            for (auto it = delete_bitmap.lower_bound(start); it != delete_bitmap.end(); ++it) {
-                auto& [k, bm] = *it;
-                if (std::get<0>(k) != std::get<0>(bmk) || std::get<1>(k) != std::get<1>(bmk) ||
-                    std::get<2>(k) > std::get<2>(bmk)) {
-                    break;
-                }
-                val->bitmap |= bm;
-            }
-        }
+        aggregate(&val->bitmap);
+        // shrink the containers of the aggregated bitmap before it's charged
+        val->bitmap.runOptimize();
+        val->bitmap.shrinkToFit();
         static auto deleter = [](const CacheKey& key, void* value) {
             delete (AggCache::Value*)value; // Just delete to reclaim
         };
         size_t charge = val->bitmap.getSizeInBytes() + sizeof(AggCache::Value);
-        handle = _agg_cache->repr()->insert(key, val, charge, deleter, CachePriority::NORMAL);
+        val->size = charge;
+        handle = cache->insert(key, val, charge, deleter, CachePriority::NORMAL);
     }
+    val->last_visit_time = UnixMillis();
 
     // It is natural for the cache to reclaim the underlying memory
-    return std::shared_ptr<roaring::Roaring>(
-            &val->bitmap, [this, handle](...) { _agg_cache->repr()->release(handle); });
+    return std::shared_ptr<roaring::Roaring>(&val->bitmap,
+                                             [cache, handle](...) { cache->release(handle); });
 }
 
-std::atomic<ShardedLRUCache*> DeleteBitmap::AggCache::s_repr {nullptr};
+size_t DeleteBitmap::compact_versions(Version version) {
+    std::lock_guard l(lock);
+    size_t num_merged = 0;
+    auto it = delete_bitmap.begin();
+    while (it != delete_bitmap.end()) {
+        RowsetId rowset_id = std::get<0>(it->first);
+        SegmentId segment_id = std::get<1>(it->first);
+        auto same_segment = [&](const BitmapKey& key) {
+            return std::get<0>(key) == rowset_id && std::get<1>(key) == segment_id;
+        };
+        // find the last bitmap of this segment whose version <= the given version
+        auto last = it;
+        for (auto next = std::next(it); next != delete_bitmap.end(); ++next) {
+            if (!same_segment(next->first) || std::get<2>(next->first) > version) {
+                break;
+            }
+            last = next;
+        }
+        if (last != it) {
+            for (auto merged = it; merged != last; ++merged) {
+                last->second |= merged->second;
+                ++num_merged;
+            }
+            last->second.runOptimize();
+            last->second.shrinkToFit();
+            delete_bitmap.erase(it, last);
+        }
+        // skip the bitmaps of this segment with greater versions
+        it = std::next(last);
+        while (it != delete_bitmap.end() && same_segment(it->first)) {
+            ++it;
+        }
+    }
+    return num_merged;
+}
+
+size_t DeleteBitmap::get_size_in_bytes() const {
+    std::shared_lock l(lock);
+    size_t size = 0;
+    for (auto& [_, bitmap] : delete_bitmap) {
+        size += bitmap.getSizeInBytes();
+    }
+    return size;
+}
+
+DeleteBitmap::AggCache* DeleteBitmap::AggCache::_s_instance = nullptr;
+
+DeleteBitmap::AggCache::AggCache(size_t capacity)
+        : LRUCachePolicy("DeleteBitmap AggCache", capacity, LRUCacheType::SIZE,
+                         config::delete_bitmap_agg_cache_stale_sweep_time_sec, 256) {}
+
+void DeleteBitmap::AggCache::create_global_instance(size_t capacity) {
+    DCHECK(_s_instance == nullptr);
+    static AggCache instance(capacity);
+    _s_instance = &instance;
+}
 
 } // namespace doris
@@ -45,6 +45,7 @@
 #include "olap/olap_common.h"
 #include "olap/rowset/rowset_meta.h"
 #include "olap/tablet_schema.h"
+#include "runtime/memory/lru_cache_policy.h"
 #include "util/uid_util.h"
 
 namespace json2pb {
@@ -431,30 +432,40 @@ public:
      */
     std::shared_ptr<roaring::Roaring> get_agg(const BitmapKey& bmk) const;
 
-    class AggCache {
+    /**
+     * Merges the bitmaps of each segment whose version <= the given version
+     * into one bitmap, whose version is the max version of the merged ones.
+     * Only aggregations on versions >= the given version are preserved, so
+     * the caller must make sure that no reader will read a smaller version.
+     *
+     * @return the number of bitmaps merged away
+     */
+    size_t compact_versions(Version version);
+
+    /**
+     * Gets the memory used by all the bitmaps, read lock will be acquired
+     */
+    size_t get_size_in_bytes() const;
+
+    // The global LRU cache of aggregated bitmaps shared by all tablets, it's
+    // size bounded and registered to CacheManager so that GC can prune it.
+    class AggCache : public LRUCachePolicy {
     public:
-        struct Value {
+        struct Value : public LRUCacheValueBase {
             roaring::Roaring bitmap;
         };
 
-        AggCache(size_t size_in_bytes) {
-            static std::once_flag once;
-            std::call_once(once, [size_in_bytes] {
-                auto tmp = new ShardedLRUCache("DeleteBitmap AggCache", size_in_bytes,
-                                               LRUCacheType::SIZE, 256);
-                AggCache::s_repr.store(tmp, std::memory_order_release);
-            });
+        static AggCache* instance() { return _s_instance; }
 
-            while (!s_repr.load(std::memory_order_acquire)) {
-            }
-        }
+        static void create_global_instance(size_t capacity);
+
+    private:
+        AggCache(size_t capacity);
 
-        static ShardedLRUCache* repr() { return s_repr.load(std::memory_order_acquire); }
-        static std::atomic<ShardedLRUCache*> s_repr;
+        static AggCache* _s_instance;
     };
 
 private:
-    mutable std::shared_ptr<AggCache> _agg_cache;
     int64_t _tablet_id;
 };
 
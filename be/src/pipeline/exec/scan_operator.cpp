@@ -37,8 +37,10 @@ bool ScanOperator::can_read() {
             return false;
         }
     } else {
-        if (_node->_eos || _node->_scanner_ctx->done()) {
+        if (_node->_eos || _node->_result_cache_reader || !_node->_rowset_cache_readers.empty() ||
+            _node->_scanner_ctx->done()) {
             // _eos: need eos
+            // _result_cache_reader, _rowset_cache_readers: read the cached results
             // _scanner_ctx->done(): need finish
             // _scanner_ctx->no_schedule(): should schedule _scanner_ctx
             return true;
@@ -39,6 +39,7 @@
 #include "exec/data_sink.h"
 #include "exec/exec_node.h"
 #include "exec/scan_node.h"
+#include "exec/tablet_info.h"
 #include "io/fs/stream_load_pipe.h"
 #include "pipeline/exec/aggregation_sink_operator.h"
 #include "pipeline/exec/aggregation_source_operator.h"
@@ -243,6 +244,11 @@ Status PipelineFragmentContext::prepare(const doris::TPipelineFragmentParams& re
     if (request.__isset.load_job_id) {
         _runtime_state->set_load_job_id(request.load_job_id);
     }
+    if (request.fragment.__isset.output_sink &&
+        request.fragment.output_sink.__isset.olap_table_sink) {
+        _runtime_state->set_load_order_insensitive(OlapTableSchemaParam::is_load_order_insensitive(
+                request.fragment.output_sink.olap_table_sink.schema));
+    }
 
     if (request.query_options.__isset.is_report_success) {
         fragment_context->set_is_report_success(request.query_options.is_report_success);
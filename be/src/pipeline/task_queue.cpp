@@ -21,8 +21,10 @@
 #include <chrono> // IWYU pragma: keep
 #include <string>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "pipeline/pipeline_task.h"
+#include "util/cpu_info.h"
 
 namespace doris {
 namespace pipeline {
@@ -139,6 +141,39 @@ MultiCoreTaskQueue::~MultiCoreTaskQueue() = default;
 
 MultiCoreTaskQueue::MultiCoreTaskQueue(size_t core_size) : TaskQueue(core_size), _closed(false) {
     _prio_task_queue_list.reset(new PriorityTaskQueue[core_size]);
+    _init_numa_nodes();
+}
+
+void MultiCoreTaskQueue::_init_numa_nodes() {
+    _numa_nodes.assign(_core_size, -1);
+    if (config::enable_pipeline_numa_affinity && CpuInfo::get_max_num_numa_nodes() > 1) {
+        // Spread the workers over the cores ordered by NUMA node evenly: the i-th worker takes
+        // the node of the core in the middle of its share of the cores. So each node gets
+        // workers in proportion to its cores, also when there are fewer workers than cores,
+        // and the workers of a node have adjacent ids.
+        std::vector<int> cores_by_node;
+        for (int node = 0; node < CpuInfo::get_max_num_numa_nodes(); ++node) {
+            const auto& cores = CpuInfo::get_cores_of_numa_node(node);
+            cores_by_node.insert(cores_by_node.end(), cores.size(), node);
+        }
+        for (size_t i = 0; i < _core_size && !cores_by_node.empty(); ++i) {
+            _numa_nodes[i] = cores_by_node[(2 * i + 1) * cores_by_node.size() / (2 * _core_size)];
+        }
+    }
+
+    _steal_orders.resize(_core_size);
+    for (size_t core_id = 0; core_id < _core_size; ++core_id) {
+        auto& order = _steal_orders[core_id];
+        order.reserve(_core_size - 1);
+        for (bool same_node : {true, false}) {
+            for (size_t i = 1; i < _core_size; ++i) {
+                size_t next_id = (core_id + i) % _core_size;
+                if ((_numa_nodes[next_id] == _numa_nodes[core_id]) == same_node) {
+                    order.push_back(next_id);
+                }
+            }
+        }
+    }
 }
 
 void MultiCoreTaskQueue::close() {
@@ -174,12 +209,7 @@ PipelineTask* MultiCoreTaskQueue::take(size_t core_id) {
 
 PipelineTask* MultiCoreTaskQueue::_steal_take(size_t core_id) {
     DCHECK(core_id < _core_size);
-    size_t next_id = core_id;
-    for (size_t i = 1; i < _core_size; ++i) {
-        ++next_id;
-        if (next_id == _core_size) {
-            next_id = 0;
-        }
+    for (size_t next_id : _steal_orders[core_id]) {
         DCHECK(next_id < _core_size);
         auto task = _prio_task_queue_list[next_id].try_take(true);
         if (task) {
@@ -27,6 +27,7 @@
 #include <ostream>
 #include <queue>
 #include <set>
+#include <vector>
 
 #include "common/status.h"
 #include "pipeline_task.h"
@@ -57,6 +58,9 @@ public:
 
     int cores() const { return _core_size; }
 
+    // The NUMA node the worker of `core_id` should be bound to, -1 means no binding.
+    virtual int numa_node(size_t core_id) const { return -1; }
+
 protected:
     size_t _core_size;
     static constexpr auto WAIT_CORE_TASK_TIMEOUT_MS = 100;
@@ -130,7 +134,9 @@ private:
     int _compute_level(uint64_t real_runtime);
 };
 
-// Need consider NUMA architecture
+// If config::enable_pipeline_numa_affinity, the workers are assigned to the NUMA nodes in
+// proportion to the cores of each node, and a worker steals the tasks of the workers in the
+// same node first, so that the memory of a task is mostly allocated and accessed in one node.
 class MultiCoreTaskQueue : public TaskQueue {
 public:
     explicit MultiCoreTaskQueue(size_t core_size);
@@ -159,10 +165,18 @@ public:
         LOG(FATAL) << "update_tg_cpu_share not implemented";
     }
 
+    int numa_node(size_t core_id) const override { return _numa_nodes[core_id]; }
+
 private:
+    void _init_numa_nodes();
+
     PipelineTask* _steal_take(size_t core_id);
 
     std::unique_ptr<PriorityTaskQueue[]> _prio_task_queue_list;
+    // NUMA node of each worker, all -1 if the workers are not bound to NUMA nodes
+    std::vector<int> _numa_nodes;
+    // For each worker, the workers to steal tasks from, the ones in the same NUMA node first
+    std::vector<std::vector<size_t>> _steal_orders;
     std::atomic<size_t> _next_core = 0;
     std::atomic<bool> _closed;
 };
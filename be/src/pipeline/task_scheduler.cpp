@@ -21,6 +21,7 @@
 #include <gen_cpp/Types_types.h>
 #include <gen_cpp/types.pb.h>
 #include <glog/logging.h>
+#include <pthread.h>
 #include <sched.h>
 
 #include <algorithm>
@@ -36,6 +37,7 @@
 #include "pipeline/task_queue.h"
 #include "pipeline_fragment_context.h"
 #include "runtime/query_context.h"
+#include "util/cpu_info.h"
 #include "util/sse_util.hpp"
 #include "util/thread.h"
 #include "util/threadpool.h"
@@ -231,7 +233,27 @@ Status TaskScheduler::schedule_task(PipelineTask* task) {
     // TODO control num of task
 }
 
+void TaskScheduler::_bind_numa_node(size_t index) {
+    int node = _task_queue->numa_node(index);
+    if (node < 0) {
+        return;
+    }
+#if defined(OS_LINUX)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int core : CpuInfo::get_cores_of_numa_node(node)) {
+        CPU_SET(core, &cpu_set);
+    }
+    int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (ret != 0) {
+        LOG(WARNING) << fmt::format("Failed to bind pipeline worker {} to NUMA node {}, ret={}",
+                                    index, node, ret);
+    }
+#endif
+}
+
 void TaskScheduler::_do_work(size_t index) {
+    _bind_numa_node(index);
     const auto& marker = _markers[index];
     while (*marker) {
         auto* task = _task_queue->take(index);
@@ -101,6 +101,8 @@ private:
     std::atomic<bool> _shutdown;
 
     void _do_work(size_t index);
+    // Bind the worker thread to the cores of its NUMA node if the task queue requires.
+    void _bind_numa_node(size_t index);
     // after _try_close_task, task maybe destructed.
     void _try_close_task(PipelineTask* task, PipelineTaskState state);
 };
@@ -139,4 +139,10 @@ void BlockSpillManager::remove(int64_t stream_id) {
     std::lock_guard<std::mutex> l(lock_);
     id_to_file_paths_.erase(stream_id);
 }
+
+std::string BlockSpillManager::get_path(int64_t stream_id) {
+    std::lock_guard<std::mutex> l(lock_);
+    auto it = id_to_file_paths_.find(stream_id);
+    return it == id_to_file_paths_.end() ? "" : it->second;
+}
 } // namespace doris
@@ -53,6 +53,9 @@ public:
 
     void remove(int64_t streamid_);
 
+    // Return the path of the spill file of the stream, empty if the stream is removed.
+    std::string get_path(int64_t stream_id);
+
     void gc(int64_t max_file_count);
 
 private:
@@ -132,6 +132,7 @@ public:
     }
     ThreadPool* send_report_thread_pool() { return _send_report_thread_pool.get(); }
     ThreadPool* join_node_thread_pool() { return _join_node_thread_pool.get(); }
+    ThreadPool* agg_finalize_thread_pool() { return _agg_finalize_thread_pool.get(); }
 
     void set_serial_download_cache_thread_token() {
         _serial_download_cache_thread_token =
@@ -185,6 +186,9 @@ public:
     void set_stream_load_executor(std::shared_ptr<StreamLoadExecutor> stream_load_executor) {
         this->_stream_load_executor = stream_load_executor;
     }
+    void set_agg_finalize_thread_pool(std::unique_ptr<ThreadPool> agg_finalize_thread_pool) {
+        this->_agg_finalize_thread_pool = std::move(agg_finalize_thread_pool);
+    }
 
 private:
     Status _init(const std::vector<StorePath>& store_paths);
@@ -232,6 +236,8 @@ private:
     std::unique_ptr<ThreadPool> _send_report_thread_pool;
     // Pool used by join node to build hash table
     std::unique_ptr<ThreadPool> _join_node_thread_pool;
+    // Pool used by the aggregations to finalize the results in parallel
+    std::unique_ptr<ThreadPool> _agg_finalize_thread_pool;
     // ThreadPoolToken -> buffer
     std::unordered_map<ThreadPoolToken*, std::unique_ptr<char[]>> _download_cache_buf_map;
     FragmentMgr* _fragment_mgr = nullptr;
@@ -43,6 +43,7 @@
 #include "olap/rowset/segment_v2/inverted_index_cache.h"
 #include "olap/schema_cache.h"
 #include "olap/segment_loader.h"
+#include "olap/tablet_meta.h"
 #include "pipeline/task_queue.h"
 #include "pipeline/task_scheduler.h"
 #include "runtime/block_spill_manager.h"
@@ -58,6 +59,7 @@
 #include "runtime/memory/cache_manager.h"
 #include "runtime/memory/mem_tracker.h"
 #include "runtime/memory/mem_tracker_limiter.h"
+#include "runtime/memory/mmap_chunk_cache.h"
 #include "runtime/memory/thread_mem_tracker_mgr.h"
 #include "runtime/result_buffer_mgr.h"
 #include "runtime/result_queue_mgr.h"
@@ -78,6 +80,8 @@
 #include "util/parse_util.h"
 #include "util/pretty_printer.h"
 #include "util/threadpool.h"
+#include "vec/exec/format/parquet/parquet_scan_cache.h"
+#include "vec/exec/scan/scan_result_cache.h"
 #include "vec/exec/scan/scanner_scheduler.h"
 #include "vec/runtime/vdata_stream_mgr.h"
 
@@ -149,6 +153,11 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
             .set_max_queue_size(config::fragment_pool_queue_size)
             .build(&_join_node_thread_pool);
 
+    ThreadPoolBuilder("AggFinalizeThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::agg_finalize_thread_num)
+            .build(&_agg_finalize_thread_pool);
+
     RETURN_IF_ERROR(init_pipeline_task_scheduler());
     _task_group_manager = new taskgroup::TaskGroupManager();
     _scanner_scheduler = new doris::vectorized::ScannerScheduler();
@@ -292,6 +301,20 @@ Status ExecEnv::_init_mem_env() {
 
     LookupConnectionCache::create_global_instance(config::lookup_connection_cache_bytes_limit);
 
+    DeleteBitmap::AggCache::create_global_instance(config::delete_bitmap_agg_cache_capacity);
+
+    if (config::parquet_scan_cache_capacity > 0) {
+        vectorized::ParquetScanCache::create_global_instance(config::parquet_scan_cache_capacity);
+    }
+
+    if (config::scan_result_cache_capacity > 0) {
+        vectorized::ScanResultCache::create_global_instance(config::scan_result_cache_capacity);
+    }
+
+    if (config::mmap_chunk_cache_capacity > 0) {
+        MmapChunkCache::create_global_instance(config::mmap_chunk_cache_capacity);
+    }
+
     // use memory limit
     int64_t inverted_index_cache_limit =
             ParseUtil::parse_mem_spec(config::inverted_index_searcher_cache_limit,
@@ -318,6 +341,18 @@ Status ExecEnv::_init_mem_env() {
               << PrettyPrinter::print(inverted_index_cache_limit, TUnit::BYTES)
               << ", origin config value: " << config::inverted_index_query_cache_limit;
 
+    int64_t inverted_index_term_cache_limit =
+            ParseUtil::parse_mem_spec(config::inverted_index_term_cache_limit,
+                                      MemInfo::mem_limit(), MemInfo::physical_mem(), &is_percent);
+    while (!is_percent && inverted_index_term_cache_limit > MemInfo::mem_limit() / 2) {
+        // Reason same as buffer_pool_limit
+        inverted_index_term_cache_limit = inverted_index_term_cache_limit / 2;
+    }
+    InvertedIndexTermCache::create_global_cache(inverted_index_term_cache_limit);
+    LOG(INFO) << "Inverted index term postings cache memory limit: "
+              << PrettyPrinter::print(inverted_index_term_cache_limit, TUnit::BYTES)
+              << ", origin config value: " << config::inverted_index_term_cache_limit;
+
     // 4. init other managers
     RETURN_IF_ERROR(_block_spill_mgr->init());
     return Status::OK();
@@ -411,6 +446,7 @@ void ExecEnv::_destroy() {
     _buffered_reader_prefetch_thread_pool.reset(nullptr);
     _send_report_thread_pool.reset(nullptr);
     _join_node_thread_pool.reset(nullptr);
+    _agg_finalize_thread_pool.reset(nullptr);
     _serial_download_cache_thread_token.reset(nullptr);
     _download_cache_thread_pool.reset(nullptr);
     _orphan_mem_tracker.reset();
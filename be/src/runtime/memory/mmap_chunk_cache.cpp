@@ -0,0 +1,177 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/memory/mmap_chunk_cache.h"
+
+#include <glog/logging.h>
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+#include "common/config.h"
+#include "runtime/memory/mem_tracker_limiter.h"
+#include "util/cpu_info.h"
+#include "util/time.h"
+
+namespace doris {
+
+static constexpr size_t MMAP_CHUNK_PAGE_SIZE = 4096;
+
+MmapChunkCache::MmapChunkCache(size_t capacity)
+        : CachePolicy("MmapChunkCache", config::mmap_chunk_cache_stale_sweep_time_sec),
+          _capacity(capacity) {
+    size_t num_arenas = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    _arenas.reserve(num_arenas);
+    for (size_t i = 0; i < num_arenas; ++i) {
+        _arenas.emplace_back(std::make_unique<Arena>());
+    }
+    _mem_tracker =
+            std::make_unique<MemTrackerLimiter>(MemTrackerLimiter::Type::GLOBAL, "MmapChunkCache");
+}
+
+MmapChunkCache::~MmapChunkCache() {
+    if (_s_instance == this) {
+        _s_instance = nullptr;
+    }
+    int64_t freed_bytes = 0;
+    _prune(std::numeric_limits<int64_t>::max(), &freed_bytes);
+}
+
+size_t MmapChunkCache::_size_class(size_t size) {
+    return (size + MMAP_CHUNK_PAGE_SIZE - 1) & ~(MMAP_CHUNK_PAGE_SIZE - 1);
+}
+
+MmapChunkCache::Arena& MmapChunkCache::_current_arena() {
+    return *_arenas[CpuInfo::get_current_core() % _arenas.size()];
+}
+
+void* MmapChunkCache::_pop_from(Arena& arena, size_t size_class) {
+    std::lock_guard<std::mutex> l(arena.lock);
+    auto it = arena.chunks.find(size_class);
+    if (it == arena.chunks.end() || it->second.empty()) {
+        return nullptr;
+    }
+    // reuse the most recently cached chunk, whose pages are more likely to be hot
+    void* data = it->second.back().data;
+    it->second.pop_back();
+    return data;
+}
+
+void* MmapChunkCache::pop(size_t size) {
+    if (_cached_bytes.load(std::memory_order_relaxed) == 0) {
+        return nullptr;
+    }
+    size_t size_class = _size_class(size);
+    Arena& local = _current_arena();
+    void* data = _pop_from(local, size_class);
+    if (data == nullptr) {
+        // steal from the free lists of other cores
+        for (auto& arena : _arenas) {
+            if (arena.get() != &local && (data = _pop_from(*arena, size_class)) != nullptr) {
+                break;
+            }
+        }
+    }
+    if (data != nullptr) {
+        _cached_bytes.fetch_sub(size_class, std::memory_order_relaxed);
+        _mem_tracker->release(size_class);
+    }
+    return data;
+}
+
+bool MmapChunkCache::push(void* chunk, size_t size) {
+    size_t size_class = _size_class(size);
+    if (_cached_bytes.fetch_add(size_class, std::memory_order_relaxed) + size_class > _capacity) {
+        _cached_bytes.fetch_sub(size_class, std::memory_order_relaxed);
+        return false;
+    }
+    _mem_tracker->consume(size_class);
+    Arena& arena = _current_arena();
+    std::lock_guard<std::mutex> l(arena.lock);
+    arena.chunks[size_class].push_back({chunk, UnixMillis()});
+    return true;
+}
+
+int64_t MmapChunkCache::_prune(int64_t deadline_ms, int64_t* freed_bytes) {
+    int64_t freed_chunks = 0;
+    for (auto& arena : _arenas) {
+        std::vector<std::pair<void*, size_t>> to_unmap;
+        {
+            std::lock_guard<std::mutex> l(arena->lock);
+            for (auto it = arena->chunks.begin(); it != arena->chunks.end();) {
+                auto& chunks = it->second;
+                size_t i = 0;
+                for (auto& chunk : chunks) {
+                    if (chunk.cache_time_ms < deadline_ms) {
+                        to_unmap.emplace_back(chunk.data, it->first);
+                    } else {
+                        chunks[i++] = chunk;
+                    }
+                }
+                chunks.resize(i);
+                it = chunks.empty() ? arena->chunks.erase(it) : std::next(it);
+            }
+        }
+        // unmap out of the lock, munmap is slow
+        for (auto& [data, size_class] : to_unmap) {
+            if (0 != munmap(data, size_class)) {
+                LOG(WARNING) << "MmapChunkCache: Cannot munmap " << size_class;
+            }
+            _cached_bytes.fetch_sub(size_class, std::memory_order_relaxed);
+            _mem_tracker->release(size_class);
+            *freed_bytes += size_class;
+            ++freed_chunks;
+        }
+    }
+    return freed_chunks;
+}
+
+void MmapChunkCache::prune_stale() {
+    if (_cached_bytes.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    COUNTER_SET(_cost_timer, (int64_t)0);
+    SCOPED_TIMER(_cost_timer);
+    int64_t freed_bytes = 0;
+    COUNTER_SET(_freed_entrys_counter, _prune(UnixMillis() - _stale_sweep_time_s * 1000L,
+                                              &freed_bytes));
+    COUNTER_SET(_freed_memory_counter, freed_bytes);
+    COUNTER_UPDATE(_prune_stale_number_counter, 1);
+    LOG(INFO) << fmt::format("{} prune stale {} entries, {} bytes, {} times prune", _name,
+                             _freed_entrys_counter->value(), _freed_memory_counter->value(),
+                             _prune_stale_number_counter->value());
+}
+
+void MmapChunkCache::prune_all() {
+    if (_cached_bytes.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    COUNTER_SET(_cost_timer, (int64_t)0);
+    SCOPED_TIMER(_cost_timer);
+    int64_t freed_bytes = 0;
+    COUNTER_SET(_freed_entrys_counter,
+                _prune(std::numeric_limits<int64_t>::max(), &freed_bytes));
+    COUNTER_SET(_freed_memory_counter, freed_bytes);
+    COUNTER_UPDATE(_prune_all_number_counter, 1);
+    LOG(INFO) << fmt::format("{} prune all {} entries, {} bytes, {} times prune", _name,
+                             _freed_entrys_counter->value(), _freed_memory_counter->value(),
+                             _prune_all_number_counter->value());
+}
+
+} // namespace doris
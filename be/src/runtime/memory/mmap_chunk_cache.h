@@ -0,0 +1,103 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "runtime/memory/cache_policy.h"
+
+namespace doris {
+
+class MemTrackerLimiter;
+
+// Cache of the large memory chunks allocated by mmap in `Allocator`.
+//
+// Every munmap of a large chunk triggers TLB shootdowns on all cores, and the pages of
+// a new mmapped chunk have to be faulted in again, which is expensive when queries
+// allocate and free big PODArrays and hash tables at high QPS. The freed chunks are kept
+// in the free lists of the core that freed them, keyed by the page aligned chunk size,
+// and reused by the next allocation of the same size class.
+//
+// The total size of the cached chunks is limited, the chunks not reused for a while are
+// unmapped by `prune_stale`, and all chunks are unmapped by `prune_all` when the process
+// memory is not enough. Thread safe.
+class MmapChunkCache : public CachePolicy {
+public:
+    static MmapChunkCache* instance() { return _s_instance; }
+
+    static void create_global_instance(size_t capacity) {
+        DCHECK(_s_instance == nullptr);
+        static MmapChunkCache instance(capacity);
+        _s_instance = &instance;
+    }
+
+    MmapChunkCache(size_t capacity);
+
+    ~MmapChunkCache() override;
+
+    // Return a cached chunk of `size` bytes, or nullptr if there is no chunk of this size class.
+    // The content of the chunk is not zeroed.
+    void* pop(size_t size);
+
+    // Cache the chunk of `size` bytes allocated by mmap.
+    // Return false if the cache is full, the caller should unmap the chunk itself.
+    bool push(void* chunk, size_t size);
+
+    void prune_stale() override;
+
+    void prune_all() override;
+
+    size_t cached_bytes() const { return _cached_bytes.load(std::memory_order_relaxed); }
+
+private:
+    struct Chunk {
+        void* data;
+        int64_t cache_time_ms;
+    };
+
+    // Free lists of one core, aligned to avoid false sharing between cores.
+    struct alignas(64) Arena {
+        std::mutex lock;
+        std::unordered_map<size_t, std::vector<Chunk>> chunks;
+    };
+
+    static size_t _size_class(size_t size);
+
+    Arena& _current_arena();
+
+    void* _pop_from(Arena& arena, size_t size_class);
+
+    // Unmap the chunks cached before `deadline_ms`, return the number of unmapped chunks.
+    int64_t _prune(int64_t deadline_ms, int64_t* freed_bytes);
+
+    static inline MmapChunkCache* _s_instance = nullptr;
+
+    const size_t _capacity;
+    std::atomic<size_t> _cached_bytes = 0;
+    std::vector<std::unique_ptr<Arena>> _arenas;
+    std::unique_ptr<MemTrackerLimiter> _mem_tracker;
+};
+
+} // namespace doris
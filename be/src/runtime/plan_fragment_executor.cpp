@@ -42,6 +42,7 @@
 #include "exec/data_sink.h"
 #include "exec/exec_node.h"
 #include "exec/scan_node.h"
+#include "exec/tablet_info.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
 #include "runtime/memory/mem_tracker_limiter.h"
@@ -143,6 +144,11 @@ Status PlanFragmentExecutor::prepare(const TExecPlanFragmentParams& request,
     if (request.__isset.load_job_id) {
         _runtime_state->set_load_job_id(request.load_job_id);
     }
+    if (request.fragment.__isset.output_sink &&
+        request.fragment.output_sink.__isset.olap_table_sink) {
+        _runtime_state->set_load_order_insensitive(OlapTableSchemaParam::is_load_order_insensitive(
+                request.fragment.output_sink.olap_table_sink.schema));
+    }
 
     if (request.query_options.__isset.is_report_success) {
         _is_report_success = request.query_options.is_report_success;
@@ -17,6 +17,7 @@
 
 #include "runtime/runtime_predicate.h"
 
+#include <glog/logging.h>
 #include <stdint.h>
 
 #include <memory>
@@ -187,5 +188,58 @@ Status RuntimePredicate::update(const Field& value, const String& col_name, bool
     return Status::OK();
 }
 
+bool RuntimePredicate::_is_tighter_top_row(const Block& top_row,
+                                           const SortDescription& sort_description) const {
+    if (_top_row.rows() == 0) {
+        return true;
+    }
+    int res = 0;
+    for (size_t i = 0; i < sort_description.size() && res == 0; ++i) {
+        res = sort_description[i].direction *
+              top_row.get_by_position(i).column->compare_at(
+                      0, 0, *_top_row.get_by_position(i).column,
+                      sort_description[i].nulls_direction);
+    }
+    return res < 0;
+}
+
+void RuntimePredicate::update_top_row(const Block& top_row,
+                                      const SortDescription& sort_description) {
+    DCHECK_EQ(top_row.rows(), 1);
+    DCHECK_EQ(top_row.columns(), sort_description.size());
+    // most of the rows of the instances are looser than the shared one, check them without
+    // blocking the readers
+    {
+        std::shared_lock<std::shared_mutex> rlock(_rwlock);
+        if (!_is_tighter_top_row(top_row, sort_description)) {
+            return;
+        }
+    }
+    std::unique_lock<std::shared_mutex> wlock(_rwlock);
+    if (!_is_tighter_top_row(top_row, sort_description)) {
+        return;
+    }
+    _top_row = top_row;
+    _top_row_sort_description = sort_description;
+    _top_row_version.fetch_add(1, std::memory_order_release);
+}
+
+void RuntimePredicate::filter_by_top_row(Block* block, const std::vector<int>& positions,
+                                         const Block& top_row,
+                                         const SortDescription& sort_description) {
+    DCHECK_EQ(positions.size(), top_row.columns());
+    size_t num_rows = block->rows();
+    IColumn::Filter filter(num_rows, 0);
+    std::vector<uint8_t> cmp_res(num_rows, 0);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        auto column =
+                block->get_by_position(positions[i]).column->convert_to_full_column_if_const();
+        column->compare_internal(0, *top_row.get_by_position(i).column,
+                                 sort_description[i].nulls_direction,
+                                 sort_description[i].direction, cmp_res, filter.data());
+    }
+    Block::filter_block_internal(block, filter, block->columns());
+}
+
 } // namespace vectorized
 } // namespace doris
@@ -17,11 +17,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
+#include <vector>
 
 #include "common/status.h"
 #include "exec/olap_common.h"
@@ -30,7 +32,9 @@
 #include "runtime/primitive_type.h"
 #include "util/binary_cast.hpp"
 #include "vec/common/arena.h"
+#include "vec/core/block.h"
 #include "vec/core/field.h"
+#include "vec/core/sort_description.h"
 #include "vec/core/types.h"
 #include "vec/runtime/vdatetime_value.h"
 
@@ -62,9 +66,44 @@ public:
 
     Status update(const Field& value, const String& col_name, bool is_reverse);
 
+    Field get_orderby_extrem() {
+        std::shared_lock<std::shared_mutex> rlock(_rwlock);
+        return _orderby_extrem;
+    }
+
+    // The sort columns of the top row of a full heap of the TopN, shared by all the instances of
+    // the query on this BE. The rows not less than the tightest one on all the sort columns are
+    // not in the result, while the predicate above only checks the first one. The sorters and
+    // the segment iterators filter their input with it.
+    void update_top_row(const Block& top_row, const SortDescription& sort_description);
+
+    // Returns an empty block if the top row is not changed since the version.
+    Block get_top_row(int64_t* version, SortDescription* sort_description = nullptr) {
+        if (_top_row_version.load(std::memory_order_acquire) == *version) {
+            return {};
+        }
+        std::shared_lock<std::shared_mutex> rlock(_rwlock);
+        *version = _top_row_version.load(std::memory_order_relaxed);
+        if (sort_description != nullptr) {
+            *sort_description = _top_row_sort_description;
+        }
+        return _top_row;
+    }
+
+    // Keep the rows of the block less than the top row, the i-th sort column of the top row is
+    // compared with the column of the block at positions[i].
+    static void filter_by_top_row(Block* block, const std::vector<int>& positions,
+                                  const Block& top_row, const SortDescription& sort_description);
+
 private:
+    // Whether the row is tighter than the current top row, the lock must be held.
+    bool _is_tighter_top_row(const Block& top_row, const SortDescription& sort_description) const;
+
     mutable std::shared_mutex _rwlock;
     Field _orderby_extrem {Field::Types::Null};
+    Block _top_row;
+    SortDescription _top_row_sort_description;
+    std::atomic<int64_t> _top_row_version = 0;
     std::shared_ptr<ColumnPredicate> _predictate {nullptr};
     TabletSchemaSPtr _tablet_schema;
     std::unique_ptr<Arena> _predicate_arena;
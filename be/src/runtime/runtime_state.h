@@ -222,6 +222,11 @@ public:
 
     int64_t load_job_id() const { return _load_job_id; }
 
+    // whether the rows of the load can be written to the table out of order
+    void set_load_order_insensitive(bool v) { _load_order_insensitive = v; }
+
+    bool load_order_insensitive() const { return _load_order_insensitive; }
+
     const std::string get_error_log_file_path() const { return _error_log_file_path; }
 
     // append error msg and error line to file when loading data.
@@ -511,6 +516,7 @@ private:
     std::string _db_name;
     std::string _load_dir;
     int64_t _load_job_id;
+    bool _load_order_insensitive = false;
 
     // mini load
     int64_t _normal_row_number;
@@ -17,12 +17,15 @@
 
 #include "service/point_query_executor.h"
 
+#include <bvar/latency_recorder.h>
 #include <fmt/format.h>
 #include <gen_cpp/Descriptors_types.h>
 #include <gen_cpp/Exprs_types.h>
 #include <gen_cpp/internal_service.pb.h>
 #include <stdlib.h>
 
+#include <algorithm>
+#include <map>
 #include <unordered_map>
 #include <vector>
 
@@ -37,6 +40,7 @@
 #include "util/key_util.h"
 #include "util/runtime_profile.h"
 #include "util/thrift_util.h"
+#include "vec/columns/column_string.h"
 #include "vec/data_types/serde/data_type_serde.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/exprs/vexpr_context.h"
@@ -46,6 +50,14 @@
 
 namespace doris {
 
+// per stage latency of point queries, in microseconds
+static bvar::LatencyRecorder g_point_query_init_key_latency("doris_point_query", "init_key");
+static bvar::LatencyRecorder g_point_query_lookup_key_latency("doris_point_query", "lookup_key");
+static bvar::LatencyRecorder g_point_query_lookup_data_latency("doris_point_query",
+                                                               "lookup_data");
+static bvar::LatencyRecorder g_point_query_output_data_latency("doris_point_query",
+                                                               "output_data");
+
 Reusable::~Reusable() {}
 constexpr static int s_preallocted_blocks_num = 64;
 Status Reusable::init(const TDescriptorTable& t_desc_tbl, const std::vector<TExpr>& output_exprs,
@@ -205,6 +217,10 @@ Status PointQueryExecutor::lookup_up() {
     RETURN_IF_ERROR(_lookup_row_key());
     RETURN_IF_ERROR(_lookup_row_data());
     RETURN_IF_ERROR(_output_data());
+    g_point_query_init_key_latency << _profile_metrics.init_key_ns.value() / 1000;
+    g_point_query_lookup_key_latency << _profile_metrics.lookup_key_ns.value() / 1000;
+    g_point_query_lookup_data_latency << _profile_metrics.lookup_data_ns.value() / 1000;
+    g_point_query_output_data_latency << _profile_metrics.output_data_ns.value() / 1000;
     return Status::OK();
 }
 
@@ -263,15 +279,15 @@ Status PointQueryExecutor::_init_keys(const PTabletKeyLookupRequest* request) {
 Status PointQueryExecutor::_lookup_row_key() {
     SCOPED_TIMER(&_profile_metrics.lookup_key_ns);
     // 2. lookup row location
-    Status st;
     std::vector<RowsetSharedPtr> specified_rowsets;
     {
         std::shared_lock rlock(_tablet->get_header_lock());
         specified_rowsets = _tablet->get_rowset_by_ids(nullptr);
     }
-    std::vector<std::unique_ptr<SegmentCacheHandle>> segment_caches(specified_rowsets.size());
+    // keys missed in row cache, looked up together in one batch
+    std::vector<size_t> missed_ctx_idxs;
+    std::vector<Slice> missed_keys;
     for (size_t i = 0; i < _row_read_ctxs.size(); ++i) {
-        RowLocation location;
         if (!config::disable_storage_row_cache) {
             RowCache::CacheHandle cache_handle;
             auto hit_cache = RowCache::instance()->lookup(
@@ -282,20 +298,31 @@ Status PointQueryExecutor::_lookup_row_key() {
                 continue;
             }
         }
-        // Get rowlocation and rowset, ctx._rowset_ptr will acquire wrap this ptr
-        auto rowset_ptr = std::make_unique<RowsetSharedPtr>();
-        st = (_tablet->lookup_row_key(_row_read_ctxs[i]._primary_key, true, specified_rowsets,
-                                      &location, INT32_MAX /*rethink?*/, segment_caches,
-                                      rowset_ptr.get()));
-        if (st.is_not_found()) {
+        missed_ctx_idxs.push_back(i);
+        missed_keys.emplace_back(_row_read_ctxs[i]._primary_key);
+    }
+    if (missed_keys.empty()) {
+        return Status::OK();
+    }
+    std::vector<std::unique_ptr<SegmentCacheHandle>> segment_caches(specified_rowsets.size());
+    std::vector<Status> statuses;
+    std::vector<RowLocation> locations;
+    std::vector<RowsetSharedPtr> rowsets;
+    RETURN_IF_ERROR(_tablet->lookup_row_keys(missed_keys, true, specified_rowsets,
+                                             INT32_MAX /*rethink?*/, segment_caches, &statuses,
+                                             &locations, &rowsets));
+    for (size_t k = 0; k < missed_ctx_idxs.size(); ++k) {
+        if (statuses[k].is_not_found()) {
             continue;
         }
-        RETURN_IF_ERROR(st);
-        _row_read_ctxs[i]._row_location = location;
-        // acquire and wrap this rowset
+        RETURN_IF_ERROR(statuses[k]);
+        auto& ctx = _row_read_ctxs[missed_ctx_idxs[k]];
+        ctx._row_location = locations[k];
+        // acquire and wrap this rowset, ctx._rowset_ptr will release it after used
+        auto rowset_ptr = std::make_unique<RowsetSharedPtr>(std::move(rowsets[k]));
         (*rowset_ptr)->acquire();
         VLOG_DEBUG << "aquire rowset " << (*rowset_ptr)->unique_id();
-        _row_read_ctxs[i]._rowset_ptr = std::unique_ptr<RowsetSharedPtr, decltype(&release_rowset)>(
+        ctx._rowset_ptr = std::unique_ptr<RowsetSharedPtr, decltype(&release_rowset)>(
                 rowset_ptr.release(), &release_rowset);
     }
     return Status::OK();
@@ -304,6 +331,41 @@ Status PointQueryExecutor::_lookup_row_key() {
 Status PointQueryExecutor::_lookup_row_data() {
     // 3. get values
     SCOPED_TIMER(&_profile_metrics.lookup_data_ns);
+    // Group the rows to read by segment, so that the row store column of each segment is
+    // read once with sorted rowids and neighbouring rows share the page cache lookups.
+    struct SegmentRows {
+        RowsetSharedPtr rowset;
+        std::vector<std::pair<uint32_t, size_t>> rowid_and_ctx_idxs;
+    };
+    std::map<std::pair<RowsetId, uint32_t>, SegmentRows> segment_rows;
+    for (size_t i = 0; i < _row_read_ctxs.size(); ++i) {
+        if (_row_read_ctxs[i]._cached_row_data.valid() ||
+            !_row_read_ctxs[i]._row_location.has_value()) {
+            continue;
+        }
+        const RowLocation& loc = _row_read_ctxs[i]._row_location.value();
+        auto& rows = segment_rows[{loc.rowset_id, loc.segment_id}];
+        rows.rowset = *(_row_read_ctxs[i]._rowset_ptr);
+        rows.rowid_and_ctx_idxs.emplace_back(loc.row_id, i);
+    }
+
+    std::vector<vectorized::MutableColumnPtr> value_columns;
+    // ctx index -> (index of value column, row in value column)
+    std::vector<std::pair<size_t, size_t>> value_positions(_row_read_ctxs.size());
+    for (auto& [segment_key, rows] : segment_rows) {
+        std::sort(rows.rowid_and_ctx_idxs.begin(), rows.rowid_and_ctx_idxs.end());
+        std::vector<uint32_t> rowids(rows.rowid_and_ctx_idxs.size());
+        for (size_t k = 0; k < rows.rowid_and_ctx_idxs.size(); ++k) {
+            rowids[k] = rows.rowid_and_ctx_idxs[k].first;
+            value_positions[rows.rowid_and_ctx_idxs[k].second] = {value_columns.size(), k};
+        }
+        vectorized::MutableColumnPtr column = vectorized::ColumnString::create();
+        RETURN_IF_ERROR(_tablet->lookup_row_data(rows.rowset, segment_key.second, rowids,
+                                                 _profile_metrics.read_stats, column));
+        value_columns.emplace_back(std::move(column));
+    }
+
+    // serilize value to block in the order of keys, currently only jsonb row formt
     for (size_t i = 0; i < _row_read_ctxs.size(); ++i) {
         if (_row_read_ctxs[i]._cached_row_data.valid()) {
             vectorized::JsonbSerializeUtil::jsonb_to_block(
@@ -316,15 +378,14 @@ Status PointQueryExecutor::_lookup_row_data() {
         if (!_row_read_ctxs[i]._row_location.has_value()) {
             continue;
         }
-        std::string value;
-        RETURN_IF_ERROR(_tablet->lookup_row_data(
-                _row_read_ctxs[i]._primary_key, _row_read_ctxs[i]._row_location.value(),
-                *(_row_read_ctxs[i]._rowset_ptr), _reusable->tuple_desc(),
-                _profile_metrics.read_stats, value,
-                !config::disable_storage_row_cache /*whether write row cache*/));
-        // serilize value to block, currently only jsonb row formt
+        auto [column_idx, row] = value_positions[i];
+        StringRef value = value_columns[column_idx]->get_data_at(row);
+        if (!config::disable_storage_row_cache) {
+            RowCache::instance()->insert({_tablet->tablet_id(), _row_read_ctxs[i]._primary_key},
+                                         Slice {value.data, value.size});
+        }
         vectorized::JsonbSerializeUtil::jsonb_to_block(
-                _reusable->get_data_type_serdes(), value.data(), value.size(),
+                _reusable->get_data_type_serdes(), value.data, value.size,
                 _reusable->get_col_uid_to_idx(), *_result_block);
     }
     return Status::OK();
@@ -0,0 +1,100 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <fmt/format.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace doris {
+
+// The cost and the selectivity of a predicate in a conjunction, measured on the sampled
+// batches, to evaluate the predicates in the order of the least expected cost.
+struct PredicateStats {
+    int64_t exec_ns = 0;
+    int64_t input_rows = 0;
+    int64_t passed_rows = 0;
+
+    void update(int64_t ns, int64_t input, int64_t passed) {
+        if (input == 0) {
+            return;
+        }
+        // the older samples decay to follow the changes of the data
+        exec_ns += ns - (exec_ns >> 3);
+        input_rows += input - (input_rows >> 3);
+        passed_rows += passed - (passed_rows >> 3);
+    }
+
+    double ns_per_row() const { return input_rows == 0 ? 0 : double(exec_ns) / input_rows; }
+
+    double pass_ratio() const { return input_rows == 0 ? 1 : double(passed_rows) / input_rows; }
+
+    // The cost to filter out a row. If the predicates are independent, evaluating them in the
+    // ascending order of the ranks has the least expected cost. The predicates not measured
+    // yet rank first to be measured.
+    double rank() const {
+        if (input_rows == 0) {
+            return 0;
+        }
+        double filtered = 1 - pass_ratio();
+        return filtered > 0 ? ns_per_row() / filtered : std::numeric_limits<double>::max();
+    }
+
+    std::string debug_string() const {
+        return fmt::format("ns_per_row={:.2f}, pass_ratio={:.4f}", ns_per_row(), pass_ratio());
+    }
+};
+
+// The order of the predicates in the ascending order of the ranks, the ties keep their
+// original order.
+inline std::vector<size_t> order_by_rank(const std::vector<const PredicateStats*>& stats) {
+    std::vector<size_t> order(stats.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return stats[a]->rank() < stats[b]->rank(); });
+    return order;
+}
+
+// Reorder the predicates and their stats in the ascending order of the ranks.
+template <typename T>
+void reorder_by_rank(std::vector<T>& predicates, std::vector<PredicateStats>& stats) {
+    std::vector<const PredicateStats*> stats_ptrs;
+    for (const auto& s : stats) {
+        stats_ptrs.push_back(&s);
+    }
+    auto order = order_by_rank(stats_ptrs);
+    if (std::is_sorted(order.begin(), order.end())) {
+        return;
+    }
+    std::vector<T> sorted_predicates;
+    std::vector<PredicateStats> sorted_stats;
+    for (size_t i : order) {
+        sorted_predicates.push_back(std::move(predicates[i]));
+        sorted_stats.push_back(stats[i]);
+    }
+    predicates.swap(sorted_predicates);
+    stats.swap(sorted_stats);
+}
+
+} // namespace doris
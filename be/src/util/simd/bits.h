@@ -55,6 +55,29 @@ inline uint32_t bytes32_mask_to_bits32_mask(const bool* data) {
     return bytes32_mask_to_bits32_mask(reinterpret_cast<const uint8_t*>(data));
 }
 
+/// Transform the bytes equal to `byte` in 32 bytes to a 32-bit mask
+inline uint32_t bytes32_eq_mask(const uint8_t* data, uint8_t byte) {
+#ifdef __AVX2__
+    auto byte32 = _mm256_set1_epi8(static_cast<char>(byte));
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)), byte32)));
+#elif defined(__SSE2__) || defined(__aarch64__)
+    auto byte16 = _mm_set1_epi8(static_cast<char>(byte));
+    uint32_t mask =
+            static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), byte16))) |
+            (static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                     _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), byte16)))
+             << 16);
+#else
+    uint32_t mask = 0;
+    for (std::size_t i = 0; i < 32; ++i) {
+        mask |= static_cast<uint32_t>(byte == *(data + i)) << i;
+    }
+#endif
+    return mask;
+}
+
 inline size_t count_zero_num(const int8_t* __restrict data, size_t size) {
     size_t num = 0;
     const int8_t* end = data + size;
@@ -160,6 +160,10 @@ public:
     /// Returns true if a function requires Arena to handle own states (see add(), merge(), deserialize()).
     virtual bool allocates_memory_in_arena() const { return false; }
 
+    /// Returns false if the results of the different states can't be inserted concurrently,
+    /// e.g. the states share the data to call into the UDF executor.
+    virtual bool is_insert_result_thread_safe() const { return true; }
+
     /// Inserts results into a column.
     virtual void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const = 0;
 
@@ -593,6 +593,9 @@ public:
         }
     }
 
+    // the results of all the states are got through the data of `_exec_place`
+    bool is_insert_result_thread_safe() const override { return false; }
+
 private:
     TFunction _fn;
     DataTypePtr _return_type;
@@ -174,6 +174,10 @@ public:
         return nested_function->allocates_memory_in_arena();
     }
 
+    bool is_insert_result_thread_safe() const override {
+        return nested_function->is_insert_result_thread_safe();
+    }
+
     bool is_state() const override { return nested_function->is_state(); }
 };
 
@@ -387,6 +387,8 @@ public:
         this->data(const_cast<AggregateDataPtr>(place)).get(to, _return_type);
     }
 
+    bool is_insert_result_thread_safe() const override { return false; }
+
 private:
     TFunction _fn;
     DataTypePtr _return_type;
@@ -29,6 +29,7 @@
 // Allocator is used by too many files. For compilation speed, put dependencies in `.cpp` as much as possible.
 #include "runtime/fragment_mgr.h"
 #include "runtime/memory/mem_tracker_limiter.h"
+#include "runtime/memory/mmap_chunk_cache.h"
 #include "runtime/memory/thread_mem_tracker_mgr.h"
 #include "runtime/thread_context.h"
 #include "util/defer_op.h"
@@ -191,6 +192,39 @@ void* Allocator<clear_memory_, mmap_populate, use_mmap>::realloc(void* buf, size
     return realloc_impl(buf, old_size, new_size, alignment);
 }
 
+template <bool clear_memory_, bool mmap_populate, bool use_mmap>
+void* Allocator<clear_memory_, mmap_populate, use_mmap>::mmap_alloc(size_t size) const {
+    if (auto* cache = doris::MmapChunkCache::instance(); cache != nullptr) {
+        if (void* buf = cache->pop(size); buf != nullptr) {
+            // The pages of the reused chunk are already faulted in, but they are dirty.
+            if constexpr (clear_memory) memset(buf, 0, size);
+            return buf;
+        }
+    }
+#if defined(OS_LINUX)
+    if (doris::config::madvise_huge_pages) {
+        // Populate the pages after madvise, otherwise they are populated by normal pages.
+        void* buf = mmap(nullptr, size, PROT_READ | PROT_WRITE, mmap_flags & ~MAP_POPULATE, -1,
+                         0);
+        if (MAP_FAILED != buf) {
+            madvise(buf, size, MADV_HUGEPAGE);
+            if constexpr (mmap_populate) memset(buf, 0, size);
+        }
+        return buf;
+    }
+#endif
+    return mmap(nullptr, size, PROT_READ | PROT_WRITE, mmap_flags, -1, 0);
+}
+
+template <bool clear_memory_, bool mmap_populate, bool use_mmap>
+int Allocator<clear_memory_, mmap_populate, use_mmap>::mmap_free(void* buf, size_t size) const {
+    if (auto* cache = doris::MmapChunkCache::instance();
+        cache != nullptr && cache->push(buf, size)) {
+        return 0;
+    }
+    return munmap(buf, size);
+}
+
 template class Allocator<true, true, true>;
 template class Allocator<true, true, false>;
 template class Allocator<true, false, true>;
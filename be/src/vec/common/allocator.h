@@ -94,6 +94,10 @@ public:
 
     void* alloc(size_t size, size_t alignment = 0);
     void* realloc(void* buf, size_t old_size, size_t new_size, size_t alignment = 0);
+    // mmap a memory range, or reuse a chunk of the same size cached in MmapChunkCache.
+    void* mmap_alloc(size_t size) const;
+    // Cache the memory range in MmapChunkCache for reuse, or munmap it if the cache is full.
+    int mmap_free(void* buf, size_t size) const;
 
     /// Allocate memory range.
     void* alloc_impl(size_t size, size_t alignment = 0) {
@@ -108,13 +112,14 @@ public:
                         alignment, size);
 
             consume_memory(size);
-            buf = mmap(nullptr, size, PROT_READ | PROT_WRITE, mmap_flags, -1, 0);
+            buf = mmap_alloc(size);
             if (MAP_FAILED == buf) {
                 release_memory(size);
                 throw_bad_alloc(fmt::format("Allocator: Cannot mmap {}.", size));
             }
 
-            /// No need for zero-fill, because mmap guarantees it.
+            /// No need for zero-fill, because mmap guarantees it, and mmap_alloc zero-fills
+            /// the reused chunk if clear_memory.
         } else {
             if (alignment <= MALLOC_MIN_ALIGNMENT) {
                 if constexpr (clear_memory)
@@ -144,7 +149,7 @@ public:
     void free(void* buf, size_t size = -1) {
         if (use_mmap && size >= doris::config::mmap_threshold) {
             DCHECK(size != -1);
-            if (0 != munmap(buf, size)) {
+            if (0 != mmap_free(buf, size)) {
                 throw_bad_alloc(fmt::format("Allocator: Cannot munmap {}.", size));
             } else {
                 release_memory(size);
@@ -88,18 +88,22 @@ Status HeapSorter::append_block(Block* block) {
             new SharedHeapSortCursorBlockView(std::move(block_view_val));
     block_view->ref();
     Defer defer([&] { block_view->unref(); });
-    size_t num_rows = tmp_block.rows();
+    size_t input_rows = block_view->value().block.rows();
+    if (!_shared_top_columns.empty()) {
+        SCOPED_TIMER(_topn_filter_timer);
+        _do_filter(block_view->value(), input_rows, _shared_top_columns, 0);
+    }
+    size_t num_rows = block_view->value().block.rows();
     if (_heap_size == _heap->size()) {
         {
             SCOPED_TIMER(_topn_filter_timer);
-            _do_filter(block_view->value(), num_rows);
+            const auto& top = _heap->top();
+            _do_filter(block_view->value(), num_rows, top.sort_columns(), top.row_id());
         }
-        size_t remain_rows = block_view->value().block.rows();
-        _topn_filter_rows += (num_rows - remain_rows);
-        COUNTER_SET(_topn_filter_rows_counter, _topn_filter_rows);
-        for (size_t i = 0; i < remain_rows; ++i) {
+        num_rows = block_view->value().block.rows();
+        for (size_t i = 0; i < num_rows; ++i) {
             HeapSortCursorImpl cursor(i, block_view);
-            _heap->replace_top_if_less(std::move(cursor));
+            _top_changed |= _heap->replace_top_if_less(std::move(cursor));
         }
     } else {
         size_t free_slots = std::min<size_t>(_heap_size - _heap->size(), num_rows);
@@ -109,12 +113,15 @@ Status HeapSorter::append_block(Block* block) {
             HeapSortCursorImpl cursor(i, block_view);
             _heap->push(std::move(cursor));
         }
+        _top_changed |= _heap_size == _heap->size();
 
         for (; i < num_rows; ++i) {
             HeapSortCursorImpl cursor(i, block_view);
             _heap->replace_top_if_less(std::move(cursor));
         }
     }
+    _topn_filter_rows += (input_rows - num_rows);
+    COUNTER_SET(_topn_filter_rows_counter, _topn_filter_rows);
     if (block_view->ref_count() > 1) {
         _data_size += block_view->value().block.allocated_bytes();
     }
@@ -173,11 +180,31 @@ Field HeapSorter::get_top_value() {
     return field;
 }
 
-// need exception safety
-void HeapSorter::_do_filter(HeapSortCursorBlockView& block_view, size_t num_rows) {
-    const auto& top_cursor = _heap->top();
-    const int cursor_rid = top_cursor.row_id();
+Block HeapSorter::get_top_row() {
+    if (!_top_changed) {
+        return {};
+    }
+    _top_changed = false;
+    const auto& top = _heap->top();
+    Block top_row;
+    for (size_t i = 0; i < _sort_description.size(); ++i) {
+        const auto& column = top.block()->get_by_position(_sort_description[i].column_number);
+        top_row.insert({top.sort_columns()[i]->cut(top.row_id(), 1), column.type, column.name});
+    }
+    return top_row;
+}
 
+void HeapSorter::set_shared_top_row(Block&& top_row) {
+    _shared_top_row = std::move(top_row);
+    _shared_top_columns.clear();
+    for (const auto& column : _shared_top_row) {
+        _shared_top_columns.push_back(column.column.get());
+    }
+}
+
+// need exception safety
+void HeapSorter::_do_filter(HeapSortCursorBlockView& block_view, size_t num_rows,
+                            const ColumnRawPtrs& top_columns, size_t top_row_id) {
     IColumn::Filter filter(num_rows);
     for (size_t i = 0; i < num_rows; ++i) {
         filter[i] = 0;
@@ -187,7 +214,7 @@ void HeapSorter::_do_filter(HeapSortCursorBlockView& block_view, size_t num_rows
 
     for (size_t col_id = 0; col_id < _sort_description.size(); ++col_id) {
         block_view.sort_columns[col_id]->compare_internal(
-                cursor_rid, *top_cursor.sort_columns()[col_id],
+                top_row_id, *top_columns[col_id],
                 _sort_description[col_id].nulls_direction, _sort_description[col_id].direction,
                 cmp_res, filter.data());
     }
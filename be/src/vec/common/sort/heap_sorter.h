@@ -62,10 +62,13 @@ public:
 
     void push(HeapSortCursorImpl&& cursor) { _queue.push(std::move(cursor)); }
 
-    void replace_top_if_less(HeapSortCursorImpl&& val) {
+    // Returns true if the top is replaced.
+    bool replace_top_if_less(HeapSortCursorImpl&& val) {
         if (val < top()) {
             replace_top(std::move(val));
+            return true;
         }
+        return false;
     }
 
 private:
@@ -98,10 +101,16 @@ public:
 
     Field get_top_value() override;
 
+    Block get_top_row() override;
+
+    void set_shared_top_row(Block&& top_row) override;
+
     static constexpr size_t HEAP_SORT_THRESHOLD = 1024;
 
 private:
-    void _do_filter(HeapSortCursorBlockView& block_view, size_t num_rows);
+    // keep the rows less than the row of the top columns
+    void _do_filter(HeapSortCursorBlockView& block_view, size_t num_rows,
+                    const ColumnRawPtrs& top_columns, size_t top_row_id);
 
     Status _prepare_sort_descs(Block* block);
 
@@ -109,6 +118,10 @@ private:
     size_t _heap_size;
     std::unique_ptr<SortingHeap> _heap;
     Block _return_block;
+    Block _shared_top_row;
+    ColumnRawPtrs _shared_top_columns;
+    // the top of the full heap is changed since the last get_top_row()
+    bool _top_changed = false;
     int64_t _topn_filter_rows;
     bool _init_sort_descs;
 
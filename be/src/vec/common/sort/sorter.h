@@ -164,6 +164,11 @@ public:
     // for topn runtime predicate
     const SortDescription& get_sort_description() { return _sort_description; }
     virtual Field get_top_value() { return Field {Field::Types::Null}; }
+    // the sort columns of the top row, empty if the heap is not full or its top is not changed
+    // since the last call
+    virtual Block get_top_row() { return {}; }
+    // the top row of the other instances to filter the input
+    virtual void set_shared_top_row(Block&& top_row) {}
 
 protected:
     Status partial_sort(Block& src_block, Block& dest_block);
@@ -0,0 +1,103 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/common/string_key_dictionary.h"
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
+
+namespace doris::vectorized {
+
+UInt32 StringKeyDictionary::_encode(const StringRef& str) {
+    auto it = _codes.find(str);
+    if (it != _codes.end()) {
+        return it->second;
+    }
+    UInt32 code = _strings.size();
+    StringRef stored(_arena.insert(str.data, str.size), str.size);
+    _strings.push_back(stored);
+    _codes.emplace(stored, code);
+    return code;
+}
+
+ColumnPtr StringKeyDictionary::encode(const IColumn& column) {
+    const auto* nullable = check_and_get_column<ColumnNullable>(column);
+    const auto& strings = assert_cast<const ColumnString&>(
+            nullable != nullptr ? nullable->get_nested_column() : column);
+    size_t rows = strings.size();
+    auto codes = ColumnUInt32::create(rows);
+    auto* __restrict data = codes->get_data().data();
+    // the keys are often clustered, e.g. read from the sorted segments
+    StringRef last;
+    UInt32 last_code = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        auto str = strings.get_data_at(i);
+        if (i == 0 || str != last) {
+            last = str;
+            last_code = _encode(str);
+        }
+        data[i] = last_code;
+    }
+    if (nullable != nullptr) {
+        return ColumnNullable::create(std::move(codes), nullable->get_null_map_column_ptr());
+    }
+    return codes;
+}
+
+void StringKeyDictionary::decode(const IColumn& codes, IColumn& column) const {
+    const NullMap* null_map = nullptr;
+    const IColumn* nested_codes = &codes;
+    if (const auto* nullable = check_and_get_column<ColumnNullable>(codes)) {
+        null_map = &nullable->get_null_map_data();
+        nested_codes = &nullable->get_nested_column();
+    }
+    NullMap* result_null_map = nullptr;
+    IColumn* result_strings = &column;
+    if (is_column_nullable(column)) {
+        auto& nullable = assert_cast<ColumnNullable&>(column);
+        result_null_map = &nullable.get_null_map_data();
+        result_strings = &nullable.get_nested_column();
+    }
+    DCHECK(null_map == nullptr || result_null_map != nullptr);
+
+    const auto& data = assert_cast<const ColumnUInt32&>(*nested_codes).get_data();
+    auto& strings = assert_cast<ColumnString&>(*result_strings);
+    strings.reserve(strings.size() + data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        bool is_null = null_map != nullptr && (*null_map)[i];
+        if (is_null) {
+            strings.insert_default();
+        } else {
+            const auto& str = _strings[data[i]];
+            strings.insert_data(str.data, str.size);
+        }
+        if (result_null_map != nullptr) {
+            result_null_map->push_back(is_null);
+        }
+    }
+}
+
+MutableColumnPtr StringKeyDictionary::create_code_column(bool is_nullable) {
+    if (is_nullable) {
+        return ColumnNullable::create(ColumnUInt32::create(), ColumnUInt8::create());
+    }
+    return ColumnUInt32::create();
+}
+
+} // namespace doris::vectorized
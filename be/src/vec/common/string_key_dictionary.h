@@ -0,0 +1,64 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <parallel_hashmap/phmap.h>
+#include <stddef.h>
+
+#include <vector>
+
+#include "vec/columns/column.h"
+#include "vec/common/arena.h"
+#include "vec/common/string_ref.h"
+#include "vec/core/types.h"
+
+namespace doris::vectorized {
+
+/** Encodes the strings of a GROUP BY key to dense UInt32 codes, so that the string keys are
+  * packed with the other keys and aggregated by the fixed key hash tables. The strings are
+  * decoded only when the keys are output.
+  * The codes of a string are the same in all the blocks, the dictionary only grows.
+  */
+class StringKeyDictionary {
+public:
+    // Encode a ColumnString, or a nullable one, to a ColumnUInt32 of the codes with the same
+    // null map.
+    ColumnPtr encode(const IColumn& column);
+
+    // Append the strings of the codes to `column`, which is nullable if the codes are.
+    void decode(const IColumn& codes, IColumn& column) const;
+
+    static MutableColumnPtr create_code_column(bool is_nullable);
+
+    size_t size() const { return _strings.size(); }
+
+    size_t memory_usage() const {
+        return _arena.size() + _codes.capacity() * (sizeof(StringRef) + sizeof(UInt32)) +
+               _strings.capacity() * sizeof(StringRef);
+    }
+
+private:
+    UInt32 _encode(const StringRef& str);
+
+    Arena _arena;
+    phmap::flat_hash_map<StringRef, UInt32, StringRefHash> _codes;
+    // code -> string
+    std::vector<StringRef> _strings;
+};
+
+} // namespace doris::vectorized
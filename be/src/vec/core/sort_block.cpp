@@ -21,6 +21,7 @@
 #include "vec/core/sort_block.h"
 
 #include "vec/core/column_with_type_and_name.h"
+#include "vec/core/sort_normalized_key.h"
 
 namespace doris::vectorized {
 
@@ -62,6 +63,49 @@ struct PartialSortingLess {
     }
 };
 
+struct NormalizedKeyWithRow {
+    NormalizedKey key;
+    uint32_t row;
+};
+
+// Sort the rows by the normalized keys of the leading sort columns, and compare the columns
+// only if the keys are equal but not exact. Return false if the keys can't be encoded.
+static bool get_permutation_by_normalized_keys(const ColumnsWithSortDescriptions& columns,
+                                               UInt64 limit, IColumn::Permutation& perm) {
+    ColumnRawPtrs sort_columns;
+    SortDescription description;
+    for (const auto& column : columns) {
+        sort_columns.push_back(column.first);
+        description.push_back(column.second);
+    }
+    std::vector<NormalizedKey> keys;
+    bool exact = false;
+    if (NormalizedKeyEncoder::encode(sort_columns, description, &keys, &exact) == 0) {
+        return false;
+    }
+
+    std::vector<NormalizedKeyWithRow> rows(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        rows[i] = {keys[i], uint32_t(i)};
+    }
+    PartialSortingLess less(columns);
+    auto compare = [&](const NormalizedKeyWithRow& a, const NormalizedKeyWithRow& b) {
+        if (a.key != b.key) {
+            return a.key < b.key;
+        }
+        return !exact && less(a.row, b.row);
+    };
+    if (limit > 0 && limit < rows.size()) {
+        std::partial_sort(rows.begin(), rows.begin() + limit, rows.end(), compare);
+    } else {
+        pdqsort(rows.begin(), rows.end(), compare);
+    }
+    for (size_t i = 0; i < rows.size(); ++i) {
+        perm[i] = rows[i].row;
+    }
+    return true;
+}
+
 void sort_block(Block& src_block, Block& dest_block, const SortDescription& description,
                 UInt64 limit) {
     if (!src_block) {
@@ -98,7 +142,7 @@ void sort_block(Block& src_block, Block& dest_block, const SortDescription& desc
 
         ColumnsWithSortDescriptions columns_with_sort_desc =
                 get_columns_with_sort_description(src_block, description);
-        {
+        if (!get_permutation_by_normalized_keys(columns_with_sort_desc, limit, perm)) {
             EqualFlags flags(size, 1);
             EqualRange range {0, size};
 
@@ -23,6 +23,7 @@
 #include "vec/columns/column.h"
 #include "vec/core/block.h"
 #include "vec/core/sort_description.h"
+#include "vec/core/sort_normalized_key.h"
 #include "vec/exprs/vexpr_context.h"
 
 namespace doris::vectorized {
@@ -157,6 +158,12 @@ struct MergeSortCursorImpl {
     size_t sort_columns_size = 0;
     size_t pos = 0;
     size_t rows = 0;
+    /// The prefixes of the sort keys, compared before the columns. They are encoded at the
+    /// first comparison of the block, the blocks output as a whole don't need them.
+    std::vector<NormalizedKey> normalized_keys;
+    size_t normalized_key_columns = 0;
+    bool normalized_keys_exact = false;
+    bool normalized_keys_encoded = false;
 
     MergeSortCursorImpl() = default;
     virtual ~MergeSortCursorImpl() = default;
@@ -194,6 +201,15 @@ struct MergeSortCursorImpl {
 
         pos = 0;
         rows = all_columns[0]->size();
+        normalized_keys_encoded = false;
+    }
+
+    void encode_normalized_keys() {
+        if (!normalized_keys_encoded) {
+            normalized_key_columns = NormalizedKeyEncoder::encode(
+                    sort_columns, desc, &normalized_keys, &normalized_keys_exact);
+            normalized_keys_encoded = true;
+        }
     }
 
     bool isFirst() const { return pos == 0; }
@@ -281,6 +297,19 @@ struct MergeSortCursor {
 
     /// The specified row of this cursor is greater than the specified row of another cursor.
     int8_t greater_at(const MergeSortCursor& rhs, size_t lhs_pos, size_t rhs_pos) const {
+        impl->encode_normalized_keys();
+        rhs.impl->encode_normalized_keys();
+        if (impl->normalized_key_columns > 0 &&
+            impl->normalized_key_columns == rhs.impl->normalized_key_columns) {
+            const auto& lhs_key = impl->normalized_keys[lhs_pos];
+            const auto& rhs_key = rhs.impl->normalized_keys[rhs_pos];
+            if (lhs_key != rhs_key) {
+                return rhs_key < lhs_key ? 1 : -1;
+            }
+            if (impl->normalized_keys_exact) {
+                return 0;
+            }
+        }
         for (size_t i = 0; i < impl->sort_columns_size; ++i) {
             int direction = impl->desc[i].direction;
             int nulls_direction = impl->desc[i].nulls_direction;
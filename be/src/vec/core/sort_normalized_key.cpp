@@ -0,0 +1,186 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/core/sort_normalized_key.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <type_traits>
+
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+constexpr size_t KEY_BYTES = NormalizedKeyEncoder::KEY_BYTES;
+
+template <typename T>
+struct UnsignedOf {
+    using Type = std::make_unsigned_t<T>;
+};
+
+template <>
+struct UnsignedOf<Int128> {
+    using Type = unsigned __int128;
+};
+
+// Big endian, with the sign bit flipped to order the negative values first.
+template <typename T>
+void encode_integer(T value, bool reverse, uint8_t* dst) {
+    using U = typename UnsignedOf<T>::Type;
+    auto bits = static_cast<U>(value);
+    if constexpr (std::is_signed_v<T> || std::is_same_v<T, Int128>) {
+        bits ^= U(1) << (sizeof(T) * 8 - 1);
+    }
+    if (reverse) {
+        bits = ~bits;
+    }
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        dst[i] = uint8_t(bits >> ((sizeof(T) - 1 - i) * 8));
+    }
+}
+
+#define DISPATCH_NUMBER_COLUMN(COLUMN_TYPE, VALUE_TYPE)                             \
+    if (const auto* col = check_and_get_column<COLUMN_TYPE>(column)) {              \
+        return func(reinterpret_cast<const VALUE_TYPE*>(col->get_data().data())); \
+    }
+
+// Call `func` with the data of the column if it is an integer or decimal column. The
+// decimals of a column have the same scale, so they are ordered as their integer values.
+template <typename Func>
+bool dispatch_integer_column(const IColumn& column, Func&& func) {
+    DISPATCH_NUMBER_COLUMN(ColumnUInt8, UInt8)
+    DISPATCH_NUMBER_COLUMN(ColumnUInt16, UInt16)
+    DISPATCH_NUMBER_COLUMN(ColumnUInt32, UInt32)
+    DISPATCH_NUMBER_COLUMN(ColumnUInt64, UInt64)
+    DISPATCH_NUMBER_COLUMN(ColumnInt8, Int8)
+    DISPATCH_NUMBER_COLUMN(ColumnInt16, Int16)
+    DISPATCH_NUMBER_COLUMN(ColumnInt32, Int32)
+    DISPATCH_NUMBER_COLUMN(ColumnInt64, Int64)
+    DISPATCH_NUMBER_COLUMN(ColumnInt128, Int128)
+    DISPATCH_NUMBER_COLUMN(ColumnDecimal<Decimal32>, Int32)
+    DISPATCH_NUMBER_COLUMN(ColumnDecimal<Decimal64>, Int64)
+    DISPATCH_NUMBER_COLUMN(ColumnDecimal<Decimal128>, Int128)
+    DISPATCH_NUMBER_COLUMN(ColumnDecimal<Decimal128I>, Int128)
+    return false;
+}
+
+#undef DISPATCH_NUMBER_COLUMN
+
+// The prefix of the string, padded by zero. The strings equal in the prefix are compared by
+// the columns, so the padding doesn't need to be distinguished from the zero bytes.
+void encode_strings(const ColumnString& column, const UInt8* null_map, bool reverse,
+                    size_t offset, uint8_t* bytes) {
+    size_t width = KEY_BYTES - offset;
+    for (size_t i = 0; i < column.size(); ++i) {
+        if (null_map != nullptr && null_map[i]) {
+            continue;
+        }
+        auto str = column.get_data_at(i);
+        uint8_t* dst = bytes + i * KEY_BYTES + offset;
+        memcpy(dst, str.data, std::min(width, str.size));
+        if (reverse) {
+            for (size_t j = 0; j < width; ++j) {
+                dst[j] = ~dst[j];
+            }
+        }
+    }
+}
+
+} // namespace
+
+size_t NormalizedKeyEncoder::encode(const ColumnRawPtrs& columns,
+                                    const SortDescription& description,
+                                    std::vector<NormalizedKey>* keys, bool* exact) {
+    DCHECK_EQ(columns.size(), description.size());
+    size_t rows = columns.empty() ? 0 : columns[0]->size();
+    std::vector<uint8_t> bytes(rows * KEY_BYTES, 0);
+    size_t offset = 0;
+    size_t num_encoded = 0;
+    bool has_string = false;
+    for (size_t i = 0; i < columns.size() && offset < KEY_BYTES && !has_string; ++i) {
+        const IColumn* column = columns[i];
+        const UInt8* null_map = nullptr;
+        if (const auto* nullable = check_and_get_column<ColumnNullable>(*column)) {
+            column = &nullable->get_nested_column();
+            null_map = nullable->get_null_map_data().data();
+        }
+        bool reverse = description[i].direction < 0;
+        size_t value_offset = offset + (null_map != nullptr ? 1 : 0);
+        size_t value_width = 0;
+        if (const auto* strings = check_and_get_column<ColumnString>(*column)) {
+            if (value_offset < KEY_BYTES) {
+                encode_strings(*strings, null_map, reverse, value_offset, bytes.data());
+                value_width = KEY_BYTES - value_offset;
+                has_string = true;
+            }
+        } else {
+            dispatch_integer_column(*column, [&](const auto* data) {
+                using T = std::decay_t<decltype(*data)>;
+                if (value_offset + sizeof(T) > KEY_BYTES) {
+                    return false;
+                }
+                for (size_t row = 0; row < rows; ++row) {
+                    if (null_map == nullptr || !null_map[row]) {
+                        encode_integer(data[row], reverse,
+                                       bytes.data() + row * KEY_BYTES + value_offset);
+                    }
+                }
+                value_width = sizeof(T);
+                return true;
+            });
+        }
+        if (value_width == 0) {
+            break;
+        }
+
+        if (null_map != nullptr) {
+            // the nulls are ordered by the null byte, their values are all zero
+            bool null_first = description[i].nulls_direction * description[i].direction < 0;
+            uint8_t null_byte = null_first ? 0 : 2;
+            for (size_t row = 0; row < rows; ++row) {
+                bytes[row * KEY_BYTES + offset] = null_map[row] ? null_byte : 1;
+            }
+        }
+        offset = value_offset + value_width;
+        ++num_encoded;
+    }
+
+    *exact = num_encoded == columns.size() && !has_string;
+    if (num_encoded == 0) {
+        keys->clear();
+        return 0;
+    }
+    keys->resize(rows);
+    for (size_t row = 0; row < rows; ++row) {
+        const uint8_t* src = bytes.data() + row * KEY_BYTES;
+        UInt64 high;
+        UInt64 low;
+        memcpy(&high, src, sizeof(UInt64));
+        memcpy(&low, src + sizeof(UInt64), sizeof(UInt64));
+        (*keys)[row].high = __builtin_bswap64(high);
+        (*keys)[row].low = __builtin_bswap64(low);
+    }
+    return num_encoded;
+}
+
+} // namespace doris::vectorized
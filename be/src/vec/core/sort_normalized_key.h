@@ -0,0 +1,62 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "vec/columns/column.h"
+#include "vec/core/sort_description.h"
+#include "vec/core/types.h"
+
+namespace doris::vectorized {
+
+/** A memcomparable prefix of the sort keys of a row, with the directions and the null orders
+  * of the sort description applied. If the prefixes of two rows differ, their order is the
+  * order of the rows. Otherwise the rows are equal if the prefixes are exact, or have to be
+  * compared by the columns.
+  */
+struct NormalizedKey {
+    UInt64 high = 0;
+    UInt64 low = 0;
+
+    bool operator<(const NormalizedKey& rhs) const {
+        return high < rhs.high || (high == rhs.high && low < rhs.low);
+    }
+    bool operator==(const NormalizedKey& rhs) const {
+        return high == rhs.high && low == rhs.low;
+    }
+    bool operator!=(const NormalizedKey& rhs) const { return !(*this == rhs); }
+};
+
+class NormalizedKeyEncoder {
+public:
+    static constexpr size_t KEY_BYTES = sizeof(NormalizedKey);
+
+    /// Encode the leading sort columns, which are integers, decimals or strings, nullable or
+    /// not, into `keys`. A string takes the rest of the bytes. The encoded columns depend only
+    /// on the types of the columns, so the keys of the blocks of the same types are comparable.
+    /// Return the number of the encoded columns, 0 if the first column can't be encoded.
+    /// `exact` is set if the prefixes are the whole keys.
+    static size_t encode(const ColumnRawPtrs& columns, const SortDescription& description,
+                         std::vector<NormalizedKey>* keys, bool* exact);
+};
+
+} // namespace doris::vectorized
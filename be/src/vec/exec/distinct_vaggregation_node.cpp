@@ -80,8 +80,9 @@ Status DistinctAggregationNode::_distinct_pre_agg_with_serialized_key(
 }
 
 void DistinctAggregationNode::_emplace_into_hash_table_to_distinct(IColumn::Selector& distinct_row,
-                                                                   ColumnRawPtrs& key_columns,
+                                                                   ColumnRawPtrs& input_key_columns,
                                                                    const size_t num_rows) {
+    auto key_columns = _encode_dict_keys(input_key_columns, num_rows);
     std::visit(
             [&](auto&& agg_method) -> void {
                 SCOPED_TIMER(_hash_table_compute_timer);
@@ -180,7 +180,10 @@ Status CsvReader::init_reader(bool is_load) {
     _file_description.start_offset = start_offset;
 
     if (_params.file_type == TFileType::FILE_STREAM) {
-        RETURN_IF_ERROR(FileFactory::create_pipe_reader(_range.load_id, &_file_reader, _state));
+        if (_file_reader == nullptr) {
+            RETURN_IF_ERROR(
+                    FileFactory::create_pipe_reader(_range.load_id, &_file_reader, _state));
+        }
     } else {
         io::FileReaderOptions reader_options = FileFactory::get_reader_options(_state);
         _file_description.mtime = _range.__isset.modification_time ? _range.modification_time : 0;
@@ -223,12 +226,18 @@ Status CsvReader::init_reader(bool is_load) {
         [[fallthrough]];
     case TFileFormatType::FORMAT_CSV_LZOP:
         [[fallthrough]];
-    case TFileFormatType::FORMAT_CSV_DEFLATE:
-        _line_reader = NewPlainTextLineReader::create_unique(
+    case TFileFormatType::FORMAT_CSV_DEFLATE: {
+        auto text_line_reader = NewPlainTextLineReader::create_unique(
                 _profile, _file_reader, _decompressor.get(), _size, _line_delimiter,
                 _line_delimiter_length, start_offset);
-
+        if (_value_separator_length == 1 && _line_delimiter_length == 1 &&
+            _value_separator[0] != _line_delimiter[0]) {
+            text_line_reader->enable_field_pos(_value_separator[0]);
+            _field_pos = &text_line_reader->field_pos();
+        }
+        _line_reader = std::move(text_line_reader);
         break;
+    }
     case TFileFormatType::FORMAT_PROTO:
         _line_reader = NewPlainBinaryLineReader::create_unique(_file_reader);
         break;
@@ -453,7 +462,10 @@ Status CsvReader::_line_split_to_values(const Slice& line, bool* success) {
         }
     }
 
-    if (_value_separator_length == 1) {
+    if (_field_pos != nullptr) {
+        // the separators have been found by line reader
+        _split_line_by_field_pos(line);
+    } else if (_value_separator_length == 1) {
         _split_line_for_single_char_delimiter(line);
     } else {
         _split_line(line);
@@ -510,36 +522,40 @@ void CsvReader::_split_line_for_single_char_delimiter(const Slice& line) {
         const size_t size = line.size;
         for (; cur_pos < size; ++cur_pos) {
             if (*(value + cur_pos) == _value_separator[0]) {
-                size_t non_space = cur_pos;
-                if (_state != nullptr && _state->trim_tailing_spaces_for_external_table_query()) {
-                    while (non_space > start_field && *(value + non_space - 1) == ' ') {
-                        non_space--;
-                    }
-                }
-                if (_trim_double_quotes && non_space > (start_field + 1) &&
-                    *(value + start_field) == '\"' && *(value + non_space - 1) == '\"') {
-                    start_field++;
-                    non_space--;
-                }
-                _split_values.emplace_back(value + start_field, non_space - start_field);
+                _add_split_value(value, start_field, cur_pos);
                 start_field = cur_pos + 1;
             }
         }
 
         CHECK(cur_pos == line.size) << cur_pos << " vs " << line.size;
-        size_t non_space = cur_pos;
-        if (_state != nullptr && _state->trim_tailing_spaces_for_external_table_query()) {
-            while (non_space > start_field && *(value + non_space - 1) == ' ') {
-                non_space--;
-            }
-        }
-        if (_trim_double_quotes && non_space > (start_field + 1) &&
-            *(value + start_field) == '\"' && *(value + non_space - 1) == '\"') {
-            start_field++;
+        _add_split_value(value, start_field, cur_pos);
+    }
+}
+
+void CsvReader::_split_line_by_field_pos(const Slice& line) {
+    _split_values.clear();
+    size_t start_field = 0;
+    for (size_t pos : *_field_pos) {
+        DCHECK_LT(pos, line.size);
+        _add_split_value(line.data, start_field, pos);
+        start_field = pos + 1;
+    }
+    _add_split_value(line.data, start_field, line.size);
+}
+
+void CsvReader::_add_split_value(const char* value, size_t start_field, size_t end_field) {
+    size_t non_space = end_field;
+    if (_state != nullptr && _state->trim_tailing_spaces_for_external_table_query()) {
+        while (non_space > start_field && *(value + non_space - 1) == ' ') {
             non_space--;
         }
-        _split_values.emplace_back(value + start_field, non_space - start_field);
     }
+    if (_trim_double_quotes && non_space > (start_field + 1) && *(value + start_field) == '\"' &&
+        *(value + non_space - 1) == '\"') {
+        start_field++;
+        non_space--;
+    }
+    _split_values.emplace_back(value + start_field, non_space - start_field);
 }
 
 void CsvReader::_split_line(const Slice& line) {
@@ -25,6 +25,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "common/status.h"
@@ -67,6 +68,10 @@ public:
               io::IOContext* io_ctx);
     ~CsvReader() override;
 
+    // Read the data of stream load from `pipe_reader` instead of the pipe of the load.
+    // Must be called before init_reader.
+    void set_pipe_reader(io::FileReaderSPtr pipe_reader) { _file_reader = std::move(pipe_reader); }
+
     Status init_reader(bool is_query);
     Status get_next_block(Block* block, size_t* read_rows, bool* eof) override;
     Status get_columns(std::unordered_map<std::string, TypeDescriptor>* name_to_type,
@@ -89,6 +94,8 @@ private:
     void _split_line(const Slice& line);
     void _split_line_for_single_char_delimiter(const Slice& line);
     void _split_line_for_proto_format(const Slice& line);
+    void _split_line_by_field_pos(const Slice& line);
+    void _add_split_value(const char* value, size_t start_field, size_t end_field);
     Status _check_array_format(std::vector<Slice>& split_values, bool* is_success);
     bool _is_null(const Slice& slice);
     bool _is_array(const Slice& slice);
@@ -128,6 +135,9 @@ private:
     io::FileReaderSPtr _file_reader;
     std::unique_ptr<LineReader> _line_reader;
     bool _line_reader_eof;
+    // positions of the column separators in the current line, saved by the
+    // line reader when finding the line delimiter. nullptr if not supported.
+    const std::vector<size_t>* _field_pos = nullptr;
     std::unique_ptr<TextConverter> _text_converter;
     std::unique_ptr<Decompressor> _decompressor;
 
@@ -28,6 +28,7 @@
 #include "common/status.h"
 #include "exec/decompressor.h"
 #include "io/fs/file_reader.h"
+#include "util/simd/bits.h"
 #include "util/slice.h"
 
 // INPUT_CHUNK must
@@ -103,10 +104,49 @@ inline bool NewPlainTextLineReader::update_eof() {
     return _eof;
 }
 
+void NewPlainTextLineReader::enable_field_pos(char column_separator) {
+    DCHECK_EQ(_line_delimiter_length, 1);
+    DCHECK_NE(column_separator, _line_delimiter[0]);
+    _save_field_pos = true;
+    _column_separator = column_separator;
+}
+
 uint8_t* NewPlainTextLineReader::update_field_pos_and_find_line_delimiter(const uint8_t* start,
                                                                           size_t len) {
-    // TODO: meanwhile find and save field pos
-    return (uint8_t*)memmem(start, len, _line_delimiter.c_str(), _line_delimiter_length);
+    if (!_save_field_pos) {
+        return (uint8_t*)memmem(start, len, _line_delimiter.c_str(), _line_delimiter_length);
+    }
+
+    // find column separators and line delimiter 32 bytes at a time, the separators
+    // after the line delimiter belong to the next lines and are found again later
+    _field_pos.clear();
+    const uint8_t line_delimiter = _line_delimiter[0];
+    const uint8_t column_separator = _column_separator;
+    size_t pos = 0;
+    for (; pos + 32 <= len; pos += 32) {
+        uint32_t line_mask = simd::bytes32_eq_mask(start + pos, line_delimiter);
+        uint32_t separator_mask = simd::bytes32_eq_mask(start + pos, column_separator);
+        if (line_mask != 0) {
+            // keep the separators before the first line delimiter
+            separator_mask &= (line_mask & (~line_mask + 1)) - 1;
+        }
+        while (separator_mask != 0) {
+            _field_pos.push_back(pos + __builtin_ctz(separator_mask));
+            separator_mask &= separator_mask - 1;
+        }
+        if (line_mask != 0) {
+            return (uint8_t*)start + pos + __builtin_ctz(line_mask);
+        }
+    }
+    for (; pos < len; ++pos) {
+        if (start[pos] == line_delimiter) {
+            return (uint8_t*)start + pos;
+        }
+        if (start[pos] == column_separator) {
+            _field_pos.push_back(pos);
+        }
+    }
+    return nullptr;
 }
 
 // extend input buf if necessary only when _more_input_bytes > 0
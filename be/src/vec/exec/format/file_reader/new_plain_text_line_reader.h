@@ -21,6 +21,7 @@
 #include <stdint.h>
 
 #include <string>
+#include <vector>
 
 #include "exec/line_reader.h"
 #include "io/fs/file_reader_writer_fwd.h"
@@ -50,6 +51,14 @@ public:
 
     void close() override;
 
+    // Save the positions of `column_separator` in the line when finding the
+    // line delimiter, so the line needn't be scanned again to be split.
+    // Only works for single byte column separator and line delimiter.
+    void enable_field_pos(char column_separator);
+
+    // positions of the column separators in the last line read
+    const std::vector<size_t>& field_pos() const { return _field_pos; }
+
 private:
     bool update_eof();
 
@@ -61,8 +70,7 @@ private:
 
     // find line delimiter from 'start' to 'start' + len,
     // return line delimiter pos if found, otherwise return nullptr.
-    // TODO:
-    //  save to positions of field separator
+    // the positions of column separators are saved if enabled.
     uint8_t* update_field_pos_and_find_line_delimiter(const uint8_t* start, size_t len);
 
     void extend_input_buf();
@@ -99,6 +107,10 @@ private:
 
     size_t _current_offset;
 
+    bool _save_field_pos = false;
+    char _column_separator = 0;
+    std::vector<size_t> _field_pos;
+
     // Profile counters
     RuntimeProfile::Counter* _bytes_read_counter;
     RuntimeProfile::Counter* _read_timer;
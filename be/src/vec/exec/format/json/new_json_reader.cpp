@@ -383,7 +383,10 @@ Status NewJsonReader::_open_file_reader() {
     _file_description.start_offset = start_offset;
 
     if (_params.file_type == TFileType::FILE_STREAM) {
-        RETURN_IF_ERROR(FileFactory::create_pipe_reader(_range.load_id, &_file_reader, _state));
+        if (_file_reader == nullptr) {
+            RETURN_IF_ERROR(
+                    FileFactory::create_pipe_reader(_range.load_id, &_file_reader, _state));
+        }
     } else {
         io::FileReaderOptions reader_options = FileFactory::get_reader_options(_state);
         _file_description.mtime = _range.__isset.modification_time ? _range.modification_time : 0;
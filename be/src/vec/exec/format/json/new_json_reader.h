@@ -30,6 +30,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "common/status.h"
@@ -86,6 +87,10 @@ public:
                   io::IOContext* io_ctx);
     ~NewJsonReader() override = default;
 
+    // Read the data of stream load from `pipe_reader` instead of the pipe of the load.
+    // Must be called before init_reader.
+    void set_pipe_reader(io::FileReaderSPtr pipe_reader) { _file_reader = std::move(pipe_reader); }
+
     Status init_reader(const std::unordered_map<std::string, vectorized::VExprContextSPtr>&
                                col_default_value_ctx);
     Status get_next_block(Block* block, size_t* read_rows, bool* eof) override;
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <cstring>
+#include <string>
 #include <vector>
 
 #include "exec/olap_common.h"
@@ -375,7 +376,46 @@ private:
         return predicates;
     }
 
+    static void _append_digest_value(const std::string& value, std::string* digest) {
+        digest->append(std::to_string(value.size())).append(":").append(value);
+    }
+
+    template <PrimitiveType primitive_type>
+    static void _append_stats_predicate_digest(
+            const ColumnValueRange<primitive_type>& col_val_range, std::string* digest) {
+        using CppType = typename PrimitiveTypeTraits<primitive_type>::CppType;
+        int scale = col_val_range.scale();
+        _append_digest_value(col_val_range.column_name(), digest);
+        digest->append(std::to_string(scale)).append(":");
+        if (col_val_range.is_fixed_value_range()) {
+            digest->append("in:");
+            for (const auto& value : col_val_range.get_fixed_value_set()) {
+                _append_digest_value(cast_to_string<primitive_type, CppType>(value, scale),
+                                     digest);
+            }
+            return;
+        }
+        digest->append(std::to_string(static_cast<int>(col_val_range.get_range_low_op())));
+        digest->append(":");
+        _append_digest_value(
+                cast_to_string<primitive_type, CppType>(col_val_range.get_range_min_value(), scale),
+                digest);
+        digest->append(std::to_string(static_cast<int>(col_val_range.get_range_high_op())));
+        digest->append(":");
+        _append_digest_value(
+                cast_to_string<primitive_type, CppType>(col_val_range.get_range_max_value(), scale),
+                digest);
+    }
+
 public:
+    // Append the predicates evaluated by filter_by_stats on the column to digest,
+    // the ranges with the same digest filter the same statistics in the same way.
+    static void append_stats_predicate_digest(const ColumnValueRangeType& col_val_range,
+                                              std::string* digest) {
+        std::visit([&](auto&& range) { _append_stats_predicate_digest(range, digest); },
+                   col_val_range);
+    }
+
     static bool filter_by_stats(const ColumnValueRangeType& col_val_range,
                                 const FieldSchema* col_schema, bool is_set_min_max,
                                 const std::string& encoded_min, const std::string& encoded_max,
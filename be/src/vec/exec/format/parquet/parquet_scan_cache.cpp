@@ -0,0 +1,126 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/format/parquet/parquet_scan_cache.h"
+
+#include <fmt/format.h>
+#include <glog/logging.h>
+#include <string.h>
+
+#include "common/config.h"
+#include "olap/lru_cache.h"
+#include "util/time.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+std::string dict_key(const std::string& file_prefix, int64_t chunk_offset) {
+    return fmt::format("D{}:{}", chunk_offset, file_prefix);
+}
+
+std::string row_group_filter_key(const std::string& file_prefix, int32_t row_group_idx,
+                                 const std::string& predicate_digest) {
+    // the length of digest makes the key unambiguous
+    return fmt::format("R{}:{}:{}{}", row_group_idx, predicate_digest.size(), predicate_digest,
+                       file_prefix);
+}
+
+} // namespace
+
+ParquetScanCache* ParquetScanCache::_s_instance = nullptr;
+
+ParquetScanCache::ParquetScanCache(size_t capacity)
+        : LRUCachePolicy("ParquetScanCache", capacity, LRUCacheType::SIZE,
+                         config::parquet_scan_cache_stale_sweep_time_sec, 128) {}
+
+void ParquetScanCache::create_global_instance(size_t capacity) {
+    DCHECK(_s_instance == nullptr);
+    static ParquetScanCache instance(capacity);
+    _s_instance = &instance;
+}
+
+std::string ParquetScanCache::file_key_prefix(const std::string& path, int64_t mtime) {
+    if (_s_instance == nullptr || mtime <= 0) {
+        // the file may be overwritten with the same path if the modification time is unknown
+        return "";
+    }
+    return fmt::format("{}:{}", mtime, path);
+}
+
+bool ParquetScanCache::lookup_dict(const std::string& file_prefix, int64_t chunk_offset,
+                                   std::unique_ptr<uint8_t[]>* data, int32_t length) {
+    std::string key = dict_key(file_prefix, chunk_offset);
+    Cache::Handle* handle = _cache->lookup(CacheKey(key));
+    if (handle == nullptr) {
+        return false;
+    }
+    auto* value = reinterpret_cast<DictValue*>(_cache->value(handle));
+    bool hit = value->length == length;
+    if (hit) {
+        value->last_visit_time = UnixMillis();
+        memcpy(data->get(), value->data.get(), length);
+    }
+    _cache->release(handle);
+    return hit;
+}
+
+void ParquetScanCache::insert_dict(const std::string& file_prefix, int64_t chunk_offset,
+                                   const uint8_t* data, int32_t length) {
+    std::string key = dict_key(file_prefix, chunk_offset);
+    auto* value = new DictValue();
+    value->data.reset(new uint8_t[length]);
+    memcpy(value->data.get(), data, length);
+    value->length = length;
+    value->size = length + sizeof(DictValue) + key.size();
+    value->last_visit_time = UnixMillis();
+    auto deleter = [](const CacheKey& key, void* value) { delete (DictValue*)value; };
+    _cache->release(
+            _cache->insert(CacheKey(key), value, value->size, deleter, CachePriority::NORMAL));
+}
+
+bool ParquetScanCache::lookup_row_group_filter(const std::string& file_prefix,
+                                               int32_t row_group_idx,
+                                               const std::string& predicate_digest,
+                                               bool* filtered) {
+    std::string key = row_group_filter_key(file_prefix, row_group_idx, predicate_digest);
+    Cache::Handle* handle = _cache->lookup(CacheKey(key));
+    if (handle == nullptr) {
+        return false;
+    }
+    auto* value = reinterpret_cast<RowGroupFilterValue*>(_cache->value(handle));
+    value->last_visit_time = UnixMillis();
+    *filtered = value->filtered;
+    _cache->release(handle);
+    return true;
+}
+
+void ParquetScanCache::insert_row_group_filter(const std::string& file_prefix,
+                                               int32_t row_group_idx,
+                                               const std::string& predicate_digest,
+                                               bool filtered) {
+    std::string key = row_group_filter_key(file_prefix, row_group_idx, predicate_digest);
+    auto* value = new RowGroupFilterValue();
+    value->filtered = filtered;
+    value->size = sizeof(RowGroupFilterValue) + key.size();
+    value->last_visit_time = UnixMillis();
+    auto deleter = [](const CacheKey& key, void* value) { delete (RowGroupFilterValue*)value; };
+    _cache->release(
+            _cache->insert(CacheKey(key), value, value->size, deleter, CachePriority::NORMAL));
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,73 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "runtime/memory/lru_cache_policy.h"
+
+namespace doris::vectorized {
+
+// Cache the uncompressed dictionary pages and the results of row group filtering of
+// parquet files, so that the queries on the same files can skip reading the dictionary
+// pages and evaluating the statistics again.
+// The cache keys contain the modification time of the file, only the files with known
+// modification time can be cached.
+class ParquetScanCache : public LRUCachePolicy {
+public:
+    struct DictValue : public LRUCacheValueBase {
+        std::unique_ptr<uint8_t[]> data;
+        int32_t length = 0;
+    };
+
+    struct RowGroupFilterValue : public LRUCacheValueBase {
+        bool filtered = false;
+    };
+
+    static ParquetScanCache* instance() { return _s_instance; }
+
+    static void create_global_instance(size_t capacity);
+
+    // Return the prefix of the keys of the file, empty if the file can't be cached.
+    static std::string file_key_prefix(const std::string& path, int64_t mtime);
+
+    // Copy the uncompressed dictionary page of the column chunk starting at chunk_offset.
+    bool lookup_dict(const std::string& file_prefix, int64_t chunk_offset,
+                     std::unique_ptr<uint8_t[]>* data, int32_t length);
+
+    void insert_dict(const std::string& file_prefix, int64_t chunk_offset, const uint8_t* data,
+                     int32_t length);
+
+    // predicate_digest identifies the predicates the row group is filtered by.
+    bool lookup_row_group_filter(const std::string& file_prefix, int32_t row_group_idx,
+                                 const std::string& predicate_digest, bool* filtered);
+
+    void insert_row_group_filter(const std::string& file_prefix, int32_t row_group_idx,
+                                 const std::string& predicate_digest, bool filtered);
+
+private:
+    ParquetScanCache(size_t capacity);
+
+    static ParquetScanCache* _s_instance;
+};
+
+} // namespace doris::vectorized
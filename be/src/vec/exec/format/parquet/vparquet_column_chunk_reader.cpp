@@ -31,6 +31,7 @@
 #include "vec/columns/column.h"
 #include "vec/exec/format/parquet/decoder.h"
 #include "vec/exec/format/parquet/level_decoder.h"
+#include "vec/exec/format/parquet/parquet_scan_cache.h"
 #include "vec/exec/format/parquet/schema_desc.h"
 #include "vec/exec/format/parquet/vparquet_page_reader.h"
 
@@ -223,7 +224,18 @@ Status ColumnChunkReader::_decode_dict_page() {
     // Prepare dictionary data
     int32_t uncompressed_size = header.uncompressed_page_size;
     std::unique_ptr<uint8_t[]> dict_data(new uint8_t[uncompressed_size]);
-    if (_block_compress_codec != nullptr) {
+    ParquetScanCache* scan_cache = ParquetScanCache::instance();
+    int64_t chunk_offset = _metadata.__isset.dictionary_page_offset
+                                   ? _metadata.dictionary_page_offset
+                                   : _metadata.data_page_offset;
+    bool cache_hit = !_scan_cache_prefix.empty() &&
+                     scan_cache->lookup_dict(_scan_cache_prefix, chunk_offset, &dict_data,
+                                             uncompressed_size);
+    if (cache_hit) {
+        // skip reading and decompressing the page
+        RETURN_IF_ERROR(_page_reader->skip_page());
+        _statistics.dict_cache_hit_cnt++;
+    } else if (_block_compress_codec != nullptr) {
         Slice compressed_data;
         RETURN_IF_ERROR(_page_reader->get_page_data(compressed_data));
         Slice dict_slice(dict_data.get(), uncompressed_size);
@@ -234,6 +246,10 @@ Status ColumnChunkReader::_decode_dict_page() {
         // The data is stored by BufferedStreamReader, we should copy it out
         memcpy(dict_data.get(), dict_slice.data, dict_slice.size);
     }
+    if (!cache_hit && !_scan_cache_prefix.empty()) {
+        scan_cache->insert_dict(_scan_cache_prefix, chunk_offset, dict_data.get(),
+                                uncompressed_size);
+    }
 
     // Cache page decoder
     std::unique_ptr<Decoder> page_decoder;
@@ -22,6 +22,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -81,6 +82,11 @@ public:
         int64_t decode_value_time = 0;
         int64_t decode_dict_time = 0;
         int64_t decode_level_time = 0;
+        int64_t dict_cache_hit_cnt = 0;
+        // pages skipped after reading their headers
+        int64_t skip_page_cnt = 0;
+        // pages skipped by the offset index without reading their headers
+        int64_t skip_page_by_index_cnt = 0;
     };
 
     ColumnChunkReader(io::BufferedStreamReader* reader, tparquet::ColumnChunk* column_chunk,
@@ -90,6 +96,9 @@ public:
     // Initialize chunk reader, will generate the decoder and codec.
     Status init();
 
+    // The dictionary page is read from ParquetScanCache if the prefix is not empty.
+    void set_scan_cache_prefix(const std::string& prefix) { _scan_cache_prefix = prefix; }
+
     // Whether the chunk reader has a more page to read.
     bool has_next_page() { return _page_reader->has_next_page(); }
 
@@ -100,6 +109,13 @@ public:
         _state = INITIALIZED;
     }
 
+    // Skip the page before next_page_header_offset which is got from the offset index,
+    // the header of the skipped page is not read.
+    void skip_page_by_index(int64_t next_page_header_offset) {
+        seek_to_page(next_page_header_offset);
+        _statistics.skip_page_by_index_cnt++;
+    }
+
     // Seek to next page. Only read and parse the page header.
     Status next_page();
 
@@ -109,6 +125,7 @@ public:
         _remaining_num_values = 0;
         if (_state == HEADER_PARSED) {
             res = _page_reader->skip_page();
+            _statistics.skip_page_cnt++;
         }
         _state = PAGE_SKIPPED;
         return res;
@@ -208,6 +225,7 @@ private:
     Slice _v2_rep_levels;
     Slice _v2_def_levels;
     bool _has_dict = false;
+    std::string _scan_cache_prefix;
     Decoder* _page_decoder = nullptr;
     // Map: encoding -> Decoder
     // Plain or Dictionary encoding. If the dictionary grows too big, the encoding will fall back to the plain encoding
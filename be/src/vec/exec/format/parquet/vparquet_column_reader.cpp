@@ -120,7 +120,7 @@ Status ParquetColumnReader::create(io::FileReaderSPtr file, FieldSchema* field,
                                    const std::vector<RowRange>& row_ranges, cctz::time_zone* ctz,
                                    io::IOContext* io_ctx,
                                    std::unique_ptr<ParquetColumnReader>& reader,
-                                   size_t max_buf_size) {
+                                   size_t max_buf_size, const std::string& scan_cache_prefix) {
     if (field->type.type == TYPE_ARRAY) {
         std::unique_ptr<ParquetColumnReader> element_reader;
         if (field->children[0].type.type == TYPE_MAP ||
@@ -129,7 +129,7 @@ Status ParquetColumnReader::create(io::FileReaderSPtr file, FieldSchema* field,
                     "Array does not support nested map/struct type in column {}", field->name);
         }
         RETURN_IF_ERROR(create(file, &field->children[0], row_group, row_ranges, ctz, io_ctx,
-                               element_reader, max_buf_size));
+                               element_reader, max_buf_size, scan_cache_prefix));
         element_reader->set_nested_column();
         ArrayColumnReader* array_reader = new ArrayColumnReader(row_ranges, ctz, io_ctx);
         RETURN_IF_ERROR(array_reader->init(std::move(element_reader), field));
@@ -145,9 +145,9 @@ Status ParquetColumnReader::create(io::FileReaderSPtr file, FieldSchema* field,
         std::unique_ptr<ParquetColumnReader> key_reader;
         std::unique_ptr<ParquetColumnReader> value_reader;
         RETURN_IF_ERROR(create(file, &field->children[0].children[0], row_group, row_ranges, ctz,
-                               io_ctx, key_reader, max_buf_size));
+                               io_ctx, key_reader, max_buf_size, scan_cache_prefix));
         RETURN_IF_ERROR(create(file, &field->children[0].children[1], row_group, row_ranges, ctz,
-                               io_ctx, value_reader, max_buf_size));
+                               io_ctx, value_reader, max_buf_size, scan_cache_prefix));
         key_reader->set_nested_column();
         value_reader->set_nested_column();
         MapColumnReader* map_reader = new MapColumnReader(row_ranges, ctz, io_ctx);
@@ -163,7 +163,7 @@ Status ParquetColumnReader::create(io::FileReaderSPtr file, FieldSchema* field,
             }
             std::unique_ptr<ParquetColumnReader> child_reader;
             RETURN_IF_ERROR(create(file, &field->children[i], row_group, row_ranges, ctz, io_ctx,
-                                   child_reader, max_buf_size));
+                                   child_reader, max_buf_size, scan_cache_prefix));
             child_reader->set_nested_column();
             child_readers.emplace_back(std::move(child_reader));
         }
@@ -173,7 +173,7 @@ Status ParquetColumnReader::create(io::FileReaderSPtr file, FieldSchema* field,
     } else {
         const tparquet::ColumnChunk& chunk = row_group.columns[field->physical_column_index];
         ScalarColumnReader* scalar_reader = new ScalarColumnReader(row_ranges, chunk, ctz, io_ctx);
-        RETURN_IF_ERROR(scalar_reader->init(file, field, max_buf_size));
+        RETURN_IF_ERROR(scalar_reader->init(file, field, max_buf_size, scan_cache_prefix));
         reader.reset(scalar_reader);
     }
     return Status::OK();
@@ -203,7 +203,8 @@ void ParquetColumnReader::_generate_read_ranges(int64_t start_index, int64_t end
     }
 }
 
-Status ScalarColumnReader::init(io::FileReaderSPtr file, FieldSchema* field, size_t max_buf_size) {
+Status ScalarColumnReader::init(io::FileReaderSPtr file, FieldSchema* field, size_t max_buf_size,
+                                const std::string& scan_cache_prefix) {
     _field_schema = field;
     auto& chunk_meta = _chunk_meta.meta_data;
     int64_t chunk_start = chunk_meta.__isset.dictionary_page_offset
@@ -219,6 +220,7 @@ Status ScalarColumnReader::init(io::FileReaderSPtr file, FieldSchema* field, siz
                                                                     prefetch_buffer_size);
     _chunk_reader = std::make_unique<ColumnChunkReader>(_stream_reader.get(), &_chunk_meta, field,
                                                         _ctz, _io_ctx);
+    _chunk_reader->set_scan_cache_prefix(scan_cache_prefix);
     RETURN_IF_ERROR(_chunk_reader->init());
     return Status::OK();
 }
@@ -257,6 +259,62 @@ Status ScalarColumnReader::_skip_values(size_t num_values) {
     return Status::OK();
 }
 
+Status ScalarColumnReader::_skip_filtered_pages(ColumnSelectVector& select_vector,
+                                                size_t batch_size, size_t* skipped_rows) {
+    *skipped_rows = 0;
+    // Same as read_column_data, only try to skip pages when most rows are filtered.
+    if (_offset_index == nullptr || _offset_index->page_locations.empty() ||
+        !select_vector.has_filter() || select_vector.filter_ratio() <= 0.6) {
+        return Status::OK();
+    }
+    const std::vector<tparquet::PageLocation>& locations = _offset_index->page_locations;
+    auto& chunk_meta = _chunk_meta.meta_data;
+    int64_t chunk_start = chunk_meta.__isset.dictionary_page_offset
+                                  ? chunk_meta.dictionary_page_offset
+                                  : chunk_meta.data_page_offset;
+    if (locations[0].offset != chunk_start && !_chunk_reader->has_dict()) {
+        // the dictionary page should be decoded before skipping to the data pages
+        return Status::OK();
+    }
+    while (*skipped_rows < batch_size) {
+        // the page starts from the current row
+        auto page = std::upper_bound(locations.begin(), locations.end(), _current_row_index,
+                                     [](int64_t row, const tparquet::PageLocation& location) {
+                                         return row < location.first_row_index;
+                                     });
+        if (page == locations.begin()) {
+            break;
+        }
+        --page;
+        if (page->first_row_index != _current_row_index) {
+            break;
+        }
+        auto next_page = page + 1;
+        int64_t page_end_row =
+                next_page == locations.end() ? chunk_meta.num_values : next_page->first_row_index;
+        std::list<RowRange> read_ranges;
+        _generate_read_ranges(_current_row_index, page_end_row, read_ranges);
+        size_t page_read_rows = 0;
+        for (auto& range : read_ranges) {
+            page_read_rows += range.last_row - range.first_row;
+        }
+        if (page_read_rows > batch_size - *skipped_rows ||
+            !select_vector.can_filter_all(page_read_rows)) {
+            break;
+        }
+        select_vector.skip(page_read_rows);
+        *skipped_rows += page_read_rows;
+        _current_row_index = page_end_row;
+        _chunk_reader->skip_page_by_index(next_page == locations.end()
+                                                  ? page->offset + page->compressed_page_size
+                                                  : next_page->offset);
+        if (!_chunk_reader->has_next_page()) {
+            break;
+        }
+    }
+    return Status::OK();
+}
+
 Status ScalarColumnReader::_read_values(size_t num_values, ColumnPtr& doris_column,
                                         DataTypePtr& type, ColumnSelectVector& select_vector,
                                         bool is_dict_filter) {
@@ -468,6 +526,16 @@ Status ScalarColumnReader::read_column_data(ColumnPtr& doris_column, DataTypePtr
                                             ColumnSelectVector& select_vector, size_t batch_size,
                                             size_t* read_rows, bool* eof, bool is_dict_filter) {
     if (_chunk_reader->remaining_num_values() == 0) {
+        if (!_nested_column) {
+            // skip the pages whose rows are all filtered by the predicate columns
+            size_t skipped_rows = 0;
+            RETURN_IF_ERROR(_skip_filtered_pages(select_vector, batch_size, &skipped_rows));
+            if (skipped_rows > 0) {
+                *read_rows = skipped_rows;
+                *eof = !_chunk_reader->has_next_page();
+                return Status::OK();
+            }
+        }
         if (!_chunk_reader->has_next_page()) {
             *eof = true;
             *read_rows = 0;
@@ -25,6 +25,7 @@
 #include <list>
 #include <memory>
 #include <ostream>
+#include <string>
 #include <vector>
 
 #include "io/fs/buffered_reader.h"
@@ -63,7 +64,10 @@ public:
                   decode_value_time(0),
                   decode_dict_time(0),
                   decode_level_time(0),
-                  decode_null_map_time(0) {}
+                  decode_null_map_time(0),
+                  dict_cache_hit_cnt(0),
+                  skip_page_cnt(0),
+                  skip_page_by_index_cnt(0) {}
 
         Statistics(io::BufferedStreamReader::Statistics& fs, ColumnChunkReader::Statistics& cs,
                    int64_t null_map_time)
@@ -77,7 +81,10 @@ public:
                   decode_value_time(cs.decode_value_time),
                   decode_dict_time(cs.decode_dict_time),
                   decode_level_time(cs.decode_level_time),
-                  decode_null_map_time(null_map_time) {}
+                  decode_null_map_time(null_map_time),
+                  dict_cache_hit_cnt(cs.dict_cache_hit_cnt),
+                  skip_page_cnt(cs.skip_page_cnt),
+                  skip_page_by_index_cnt(cs.skip_page_by_index_cnt) {}
 
         int64_t read_time;
         int64_t read_calls;
@@ -90,6 +97,9 @@ public:
         int64_t decode_dict_time;
         int64_t decode_level_time;
         int64_t decode_null_map_time;
+        int64_t dict_cache_hit_cnt;
+        int64_t skip_page_cnt;
+        int64_t skip_page_by_index_cnt;
 
         void merge(Statistics& statistics) {
             read_time += statistics.read_time;
@@ -103,6 +113,9 @@ public:
             decode_dict_time += statistics.decode_dict_time;
             decode_level_time += statistics.decode_level_time;
             decode_null_map_time += statistics.decode_null_map_time;
+            dict_cache_hit_cnt += statistics.dict_cache_hit_cnt;
+            skip_page_cnt += statistics.skip_page_cnt;
+            skip_page_by_index_cnt += statistics.skip_page_by_index_cnt;
         }
     };
 
@@ -131,8 +144,10 @@ public:
                          const tparquet::RowGroup& row_group,
                          const std::vector<RowRange>& row_ranges, cctz::time_zone* ctz,
                          io::IOContext* io_ctx, std::unique_ptr<ParquetColumnReader>& reader,
-                         size_t max_buf_size);
-    void add_offset_index(tparquet::OffsetIndex* offset_index) { _offset_index = offset_index; }
+                         size_t max_buf_size, const std::string& scan_cache_prefix = "");
+    void add_offset_index(const tparquet::OffsetIndex& offset_index) {
+        _offset_index = std::make_unique<tparquet::OffsetIndex>(offset_index);
+    }
     void set_nested_column() { _nested_column = true; }
     virtual const std::vector<level_t>& get_rep_level() const = 0;
     virtual const std::vector<level_t>& get_def_level() const = 0;
@@ -149,7 +164,9 @@ protected:
     const std::vector<RowRange>& _row_ranges;
     cctz::time_zone* _ctz;
     io::IOContext* _io_ctx;
-    tparquet::OffsetIndex* _offset_index;
+    // Page locations of the column chunk, used to skip the filtered pages without reading
+    // their headers. Null if the file has no page index.
+    std::unique_ptr<tparquet::OffsetIndex> _offset_index;
     int64_t _current_row_index = 0;
     int _row_range_index = 0;
     int64_t _decode_null_map_time = 0;
@@ -162,7 +179,8 @@ public:
                        io::IOContext* io_ctx)
             : ParquetColumnReader(row_ranges, ctz, io_ctx), _chunk_meta(chunk_meta) {}
     ~ScalarColumnReader() override { close(); }
-    Status init(io::FileReaderSPtr file, FieldSchema* field, size_t max_buf_size);
+    Status init(io::FileReaderSPtr file, FieldSchema* field, size_t max_buf_size,
+                const std::string& scan_cache_prefix = "");
     Status read_column_data(ColumnPtr& doris_column, DataTypePtr& type,
                             ColumnSelectVector& select_vector, size_t batch_size, size_t* read_rows,
                             bool* eof, bool is_dict_filter) override;
@@ -186,6 +204,8 @@ private:
     std::vector<level_t> _def_levels;
 
     Status _skip_values(size_t num_values);
+    Status _skip_filtered_pages(ColumnSelectVector& select_vector, size_t batch_size,
+                                size_t* skipped_rows);
     Status _read_values(size_t num_values, ColumnPtr& doris_column, DataTypePtr& type,
                         ColumnSelectVector& select_vector, bool is_dict_filter);
     Status _read_nested_column(ColumnPtr& doris_column, DataTypePtr& type,
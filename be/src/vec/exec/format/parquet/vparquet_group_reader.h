@@ -159,6 +159,8 @@ public:
 
     ParquetColumnReader::Statistics statistics();
     void set_remaining_rows(int64_t rows) { _remaining_rows = rows; }
+    // Should be called before init(), see ParquetScanCache::file_key_prefix
+    void set_scan_cache_prefix(const std::string& prefix) { _scan_cache_prefix = prefix; }
     int64_t get_remaining_rows() { return _remaining_rows; }
 
 private:
@@ -197,6 +199,7 @@ private:
     int64_t _remaining_rows;
     cctz::time_zone* _ctz;
     io::IOContext* _io_ctx;
+    std::string _scan_cache_prefix;
     PositionDeleteContext _position_delete_ctx;
     // merge the row ranges generated from page index and position delete.
     std::vector<RowRange> _read_ranges;
@@ -17,6 +17,7 @@
 
 #include "vparquet_reader.h"
 
+#include <cctz/time_zone.h>
 #include <gen_cpp/Metrics_types.h>
 #include <gen_cpp/PlanNodes_types.h>
 #include <gen_cpp/Types_types.h>
@@ -25,6 +26,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <memory>
 #include <ostream>
 #include <utility>
 
@@ -37,6 +39,7 @@
 #include "util/slice.h"
 #include "vec/common/typeid_cast.h"
 #include "vec/exec/format/format_common.h"
+#include "vec/exec/format/parquet/parquet_scan_cache.h"
 #include "vec/exec/format/parquet/schema_desc.h"
 #include "vec/exec/format/parquet/vparquet_file_metadata.h"
 #include "vec/exec/format/parquet/vparquet_group_reader.h"
@@ -48,9 +51,6 @@
 #include "vec/exprs/vruntimefilter_wrapper.h"
 #include "vec/exprs/vslot_ref.h"
 
-namespace cctz {
-class time_zone;
-} // namespace cctz
 namespace doris {
 class RowDescriptor;
 class RuntimeState;
@@ -138,6 +138,8 @@ void ParquetReader::_init_profile() {
                 ADD_CHILD_TIMER(_profile, "PageIndexFilterTime", parquet_profile);
         _parquet_profile.row_group_filter_time =
                 ADD_CHILD_TIMER(_profile, "RowGroupFilterTime", parquet_profile);
+        _parquet_profile.row_group_filter_cache_hit_cnt = ADD_CHILD_COUNTER(
+                _profile, "RowGroupFilterCacheHitCount", TUnit::UNIT, parquet_profile);
 
         _parquet_profile.file_read_time = ADD_TIMER(_profile, "FileReadTime");
         _parquet_profile.file_read_calls = ADD_COUNTER(_profile, "FileReadCalls", TUnit::UNIT);
@@ -158,6 +160,12 @@ void ParquetReader::_init_profile() {
                 ADD_CHILD_TIMER(_profile, "DecodeLevelTime", parquet_profile);
         _parquet_profile.decode_null_map_time =
                 ADD_CHILD_TIMER(_profile, "DecodeNullMapTime", parquet_profile);
+        _parquet_profile.dict_cache_hit_cnt =
+                ADD_CHILD_COUNTER(_profile, "DictCacheHitCount", TUnit::UNIT, parquet_profile);
+        _parquet_profile.skip_page_cnt =
+                ADD_CHILD_COUNTER(_profile, "SkipPageCount", TUnit::UNIT, parquet_profile);
+        _parquet_profile.skip_page_by_index_cnt =
+                ADD_CHILD_COUNTER(_profile, "SkipPageByIndexCount", TUnit::UNIT, parquet_profile);
     }
 }
 
@@ -182,6 +190,8 @@ void ParquetReader::close() {
                            _statistics.page_index_filter_time);
             COUNTER_UPDATE(_parquet_profile.row_group_filter_time,
                            _statistics.row_group_filter_time);
+            COUNTER_UPDATE(_parquet_profile.row_group_filter_cache_hit_cnt,
+                           _statistics.row_group_filter_cache_hit_cnt);
 
             COUNTER_UPDATE(_parquet_profile.file_read_time, _column_statistics.read_time);
             COUNTER_UPDATE(_parquet_profile.file_read_calls, _column_statistics.read_calls);
@@ -199,6 +209,11 @@ void ParquetReader::close() {
                            _column_statistics.decode_level_time);
             COUNTER_UPDATE(_parquet_profile.decode_null_map_time,
                            _column_statistics.decode_null_map_time);
+            COUNTER_UPDATE(_parquet_profile.dict_cache_hit_cnt,
+                           _column_statistics.dict_cache_hit_cnt);
+            COUNTER_UPDATE(_parquet_profile.skip_page_cnt, _column_statistics.skip_page_cnt);
+            COUNTER_UPDATE(_parquet_profile.skip_page_by_index_cnt,
+                           _column_statistics.skip_page_by_index_cnt);
         }
         _closed = true;
     }
@@ -219,6 +234,8 @@ Status ParquetReader::_open_file() {
                 _profile, _system_properties, _file_description, reader_options, &_file_system,
                 &_file_reader, io::DelegateReader::AccessMode::RANDOM, _io_ctx));
     }
+    _scan_cache_prefix =
+            ParquetScanCache::file_key_prefix(_file_description.path, _file_description.mtime);
     if (_file_metadata == nullptr) {
         SCOPED_RAW_TIMER(&_statistics.parse_footer_time);
         if (_file_reader->size() == 0) {
@@ -593,6 +610,7 @@ Status ParquetReader::_next_row_group_reader() {
     // process page index and generate the ranges to read
     auto& row_group = _t_metadata->row_groups[row_group_index.row_group_id];
     std::vector<RowRange> candidate_row_ranges;
+    _col_offsets.clear();
     RETURN_IF_ERROR(_process_page_index(row_group, candidate_row_ranges));
 
     RowGroupReader::PositionDeleteContext position_delete_ctx =
@@ -615,6 +633,7 @@ Status ParquetReader::_next_row_group_reader() {
     _current_group_reader.reset(new RowGroupReader(
             group_file_reader, _read_columns, row_group_index.row_group_id, row_group, _ctz,
             _io_ctx, position_delete_ctx, _lazy_read_ctx, _state));
+    _current_group_reader->set_scan_cache_prefix(_scan_cache_prefix);
     _row_group_eof = false;
     return _current_group_reader->init(_file_metadata->schema(), candidate_row_ranges, _col_offsets,
                                        _tuple_descriptor, _row_descriptor, _colname_to_slot_id,
@@ -627,6 +646,9 @@ Status ParquetReader::_init_row_groups(const bool& is_filter_groups) {
     if (is_filter_groups && (_total_groups == 0 || _t_metadata->num_rows == 0 || _range_size < 0)) {
         return Status::EndOfFile("No row group to read");
     }
+    if (is_filter_groups && !_scan_cache_prefix.empty()) {
+        _row_group_filter_cache_digest = _row_group_filter_digest();
+    }
     int64_t row_index = 0;
     for (int32_t row_group_idx = 0; row_group_idx < _total_groups; row_group_idx++) {
         const tparquet::RowGroup& row_group = _t_metadata->row_groups[row_group_idx];
@@ -636,7 +658,7 @@ Status ParquetReader::_init_row_groups(const bool& is_filter_groups) {
         }
         bool filter_group = false;
         if (is_filter_groups) {
-            RETURN_IF_ERROR(_process_row_group_filter(row_group, &filter_group));
+            RETURN_IF_ERROR(_process_row_group_filter(row_group_idx, row_group, &filter_group));
         }
         int64_t group_size = 0; // only calculate the needed columns
         for (auto& read_col : _read_columns) {
@@ -736,8 +758,9 @@ Status ParquetReader::_process_page_index(const tparquet::RowGroup& row_group,
         _statistics.read_rows += row_group.num_rows;
     };
 
+    bool has_value_range = _colname_to_value_range != nullptr && !_colname_to_value_range->empty();
     if (_has_complex_type || _lazy_read_ctx.conjuncts.empty() ||
-        _colname_to_value_range == nullptr || _colname_to_value_range->empty()) {
+        (!has_value_range && !_lazy_read_ctx.can_lazy_read)) {
         read_whole_row_group();
         return Status::OK();
     }
@@ -746,54 +769,79 @@ Status ParquetReader::_process_page_index(const tparquet::RowGroup& row_group,
         read_whole_row_group();
         return Status::OK();
     }
-    uint8_t col_index_buff[page_index._column_index_size];
     size_t bytes_read = 0;
-    Slice result(col_index_buff, page_index._column_index_size);
-    RETURN_IF_ERROR(
-            _file_reader->read_at(page_index._column_index_start, result, &bytes_read, _io_ctx));
-    _column_statistics.read_bytes += bytes_read;
+    std::unique_ptr<uint8_t[]> col_index_buff;
+    if (has_value_range) {
+        col_index_buff.reset(new uint8_t[page_index._column_index_size]);
+        Slice result(col_index_buff.get(), page_index._column_index_size);
+        RETURN_IF_ERROR(_file_reader->read_at(page_index._column_index_start, result, &bytes_read,
+                                              _io_ctx));
+        _column_statistics.read_bytes += bytes_read;
+        _column_statistics.meta_read_calls += 1;
+    }
     auto& schema_desc = _file_metadata->schema();
     std::vector<RowRange> skipped_row_ranges;
-    uint8_t off_index_buff[page_index._offset_index_size];
-    Slice res(off_index_buff, page_index._offset_index_size);
+    std::unique_ptr<uint8_t[]> off_index_buff(new uint8_t[page_index._offset_index_size]);
+    Slice res(off_index_buff.get(), page_index._offset_index_size);
     RETURN_IF_ERROR(
             _file_reader->read_at(page_index._offset_index_start, res, &bytes_read, _io_ctx));
     _column_statistics.read_bytes += bytes_read;
-    // read twice: parse column index & parse offset index
-    _column_statistics.meta_read_calls += 2;
-    for (auto& read_col : _read_columns) {
-        auto conjunct_iter = _colname_to_value_range->find(read_col._file_slot_name);
-        if (_colname_to_value_range->end() == conjunct_iter) {
-            continue;
-        }
-        auto& chunk = row_group.columns[read_col._parquet_col_id];
-        if (chunk.column_index_offset == 0 && chunk.column_index_length == 0) {
-            continue;
-        }
-        tparquet::ColumnIndex column_index;
-        RETURN_IF_ERROR(page_index.parse_column_index(chunk, col_index_buff, &column_index));
-        const int num_of_pages = column_index.null_pages.size();
-        if (num_of_pages <= 0) {
-            continue;
-        }
-        auto& conjuncts = conjunct_iter->second;
-        std::vector<int> skipped_page_range;
-        const FieldSchema* col_schema = schema_desc.get_column(read_col._file_slot_name);
-        page_index.collect_skipped_page_range(&column_index, conjuncts, col_schema,
-                                              skipped_page_range, *_ctz);
-        if (skipped_page_range.empty()) {
-            continue;
+    _column_statistics.meta_read_calls += 1;
+    if (has_value_range) {
+        for (auto& read_col : _read_columns) {
+            auto conjunct_iter = _colname_to_value_range->find(read_col._file_slot_name);
+            if (_colname_to_value_range->end() == conjunct_iter) {
+                continue;
+            }
+            auto& chunk = row_group.columns[read_col._parquet_col_id];
+            if (chunk.column_index_offset == 0 && chunk.column_index_length == 0) {
+                continue;
+            }
+            tparquet::ColumnIndex column_index;
+            RETURN_IF_ERROR(
+                    page_index.parse_column_index(chunk, col_index_buff.get(), &column_index));
+            const int num_of_pages = column_index.null_pages.size();
+            if (num_of_pages <= 0) {
+                continue;
+            }
+            auto& conjuncts = conjunct_iter->second;
+            std::vector<int> skipped_page_range;
+            const FieldSchema* col_schema = schema_desc.get_column(read_col._file_slot_name);
+            page_index.collect_skipped_page_range(&column_index, conjuncts, col_schema,
+                                                  skipped_page_range, *_ctz);
+            if (skipped_page_range.empty()) {
+                continue;
+            }
+            tparquet::OffsetIndex offset_index;
+            RETURN_IF_ERROR(
+                    page_index.parse_offset_index(chunk, off_index_buff.get(), &offset_index));
+            for (int page_id : skipped_page_range) {
+                RowRange skipped_row_range;
+                page_index.create_skipped_row_range(offset_index, row_group.num_rows, page_id,
+                                                    &skipped_row_range);
+                // use the union row range
+                skipped_row_ranges.emplace_back(skipped_row_range);
+            }
+            _col_offsets.emplace(read_col._parquet_col_id, offset_index);
         }
-        tparquet::OffsetIndex offset_index;
-        RETURN_IF_ERROR(page_index.parse_offset_index(chunk, off_index_buff, &offset_index));
-        for (int page_id : skipped_page_range) {
-            RowRange skipped_row_range;
-            page_index.create_skipped_row_range(offset_index, row_group.num_rows, page_id,
-                                                &skipped_row_range);
-            // use the union row range
-            skipped_row_ranges.emplace_back(skipped_row_range);
+    }
+    if (_lazy_read_ctx.can_lazy_read) {
+        // the lazy read columns can skip the pages filtered by predicate columns
+        for (auto& read_col : _read_columns) {
+            auto& lazy_cols = _lazy_read_ctx.lazy_read_columns;
+            if (std::find(lazy_cols.begin(), lazy_cols.end(), read_col._file_slot_name) ==
+                lazy_cols.end()) {
+                continue;
+            }
+            auto& chunk = row_group.columns[read_col._parquet_col_id];
+            if (!chunk.__isset.offset_index_offset || chunk.offset_index_length == 0) {
+                continue;
+            }
+            tparquet::OffsetIndex offset_index;
+            RETURN_IF_ERROR(
+                    page_index.parse_offset_index(chunk, off_index_buff.get(), &offset_index));
+            _col_offsets.emplace(read_col._parquet_col_id, offset_index);
         }
-        _col_offsets.emplace(read_col._parquet_col_id, offset_index);
     }
     if (skipped_row_ranges.empty()) {
         read_whole_row_group();
@@ -829,16 +877,51 @@ Status ParquetReader::_process_page_index(const tparquet::RowGroup& row_group,
     return Status::OK();
 }
 
-Status ParquetReader::_process_row_group_filter(const tparquet::RowGroup& row_group,
+Status ParquetReader::_process_row_group_filter(int32_t row_group_idx,
+                                                const tparquet::RowGroup& row_group,
                                                 bool* filter_group) {
+    bool use_cache = !_scan_cache_prefix.empty() && !_row_group_filter_cache_digest.empty();
+    if (use_cache && ParquetScanCache::instance()->lookup_row_group_filter(
+                             _scan_cache_prefix, row_group_idx, _row_group_filter_cache_digest,
+                             filter_group)) {
+        _statistics.row_group_filter_cache_hit_cnt++;
+        return Status::OK();
+    }
     _process_column_stat_filter(row_group.columns, filter_group);
     _init_chunk_dicts();
     RETURN_IF_ERROR(_process_dict_filter(filter_group));
     _init_bloom_filter();
     RETURN_IF_ERROR(_process_bloom_filter(filter_group));
+    if (use_cache) {
+        ParquetScanCache::instance()->insert_row_group_filter(
+                _scan_cache_prefix, row_group_idx, _row_group_filter_cache_digest, *filter_group);
+    }
     return Status::OK();
 }
 
+std::string ParquetReader::_row_group_filter_digest() {
+    std::string digest;
+    if (_colname_to_value_range == nullptr || _colname_to_value_range->empty()) {
+        return digest;
+    }
+    // the same columns as _process_column_stat_filter
+    for (auto& col_name : *_column_names) {
+        if (_map_column.find(col_name) == _map_column.end()) {
+            continue;
+        }
+        auto slot_iter = _colname_to_value_range->find(col_name);
+        if (slot_iter == _colname_to_value_range->end()) {
+            continue;
+        }
+        ParquetPredicate::append_stats_predicate_digest(slot_iter->second, &digest);
+    }
+    if (!digest.empty()) {
+        // the statistics of datetime are converted by the time zone
+        digest.append(_ctz->name());
+    }
+    return digest;
+}
+
 Status ParquetReader::_process_column_stat_filter(const std::vector<tparquet::ColumnChunk>& columns,
                                                   bool* filter_group) {
     if (_colname_to_value_range == nullptr || _colname_to_value_range->empty()) {
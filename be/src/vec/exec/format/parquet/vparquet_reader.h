@@ -90,6 +90,7 @@ public:
         int64_t open_file_num = 0;
         int64_t row_group_filter_time = 0;
         int64_t page_index_filter_time = 0;
+        int64_t row_group_filter_cache_hit_cnt = 0;
     };
 
     ParquetReader(RuntimeProfile* profile, const TFileScanRangeParams& params,
@@ -166,6 +167,7 @@ private:
         RuntimeProfile::Counter* open_file_num;
         RuntimeProfile::Counter* row_group_filter_time;
         RuntimeProfile::Counter* page_index_filter_time;
+        RuntimeProfile::Counter* row_group_filter_cache_hit_cnt;
 
         RuntimeProfile::Counter* file_read_time;
         RuntimeProfile::Counter* file_read_calls;
@@ -178,6 +180,9 @@ private:
         RuntimeProfile::Counter* decode_dict_time;
         RuntimeProfile::Counter* decode_level_time;
         RuntimeProfile::Counter* decode_null_map_time;
+        RuntimeProfile::Counter* dict_cache_hit_cnt;
+        RuntimeProfile::Counter* skip_page_cnt;
+        RuntimeProfile::Counter* skip_page_by_index_cnt;
     };
 
     Status _open_file();
@@ -199,7 +204,10 @@ private:
     bool _is_misaligned_range_group(const tparquet::RowGroup& row_group);
     Status _process_column_stat_filter(const std::vector<tparquet::ColumnChunk>& column_meta,
                                        bool* filter_group);
-    Status _process_row_group_filter(const tparquet::RowGroup& row_group, bool* filter_group);
+    Status _process_row_group_filter(int32_t row_group_idx, const tparquet::RowGroup& row_group,
+                                     bool* filter_group);
+    // The predicates of row group filter, empty if no predicate.
+    std::string _row_group_filter_digest();
     void _init_chunk_dicts();
     Status _process_dict_filter(bool* filter_group);
     void _init_bloom_filter();
@@ -249,6 +257,9 @@ private:
 
     std::unordered_map<int, tparquet::OffsetIndex> _col_offsets;
     const std::vector<std::string>* _column_names;
+    // Key prefix of this file in ParquetScanCache, empty if the file is not cached.
+    std::string _scan_cache_prefix;
+    std::string _row_group_filter_cache_digest;
 
     std::vector<std::string> _missing_cols;
     Statistics _statistics;
@@ -17,15 +17,23 @@
 
 #include "vec/exec/scan/new_file_scan_node.h"
 
+#include <fmt/format.h>
 #include <gen_cpp/PlanNodes_types.h>
 #include <glog/logging.h>
 #include <stddef.h>
 
 #include <algorithm>
+#include <memory>
 #include <ostream>
+#include <string>
+#include <utility>
 
 #include "common/config.h"
 #include "common/object_pool.h"
+#include "io/file_factory.h"
+#include "io/fs/split_pipe_reader.h"
+#include "runtime/query_context.h"
+#include "runtime/runtime_state.h"
 #include "vec/exec/scan/vfile_scanner.h"
 #include "vec/exec/scan/vscanner.h"
 
@@ -116,6 +124,25 @@ Status NewFileScanNode::_init_scanners(std::list<VScannerSPtr>* scanners) {
     size_t shard_num =
             std::min<size_t>(config::doris_scanner_thread_pool_thread_num, _scan_ranges.size());
     _kv_cache.reset(new ShardedKVCache(shard_num));
+
+    std::shared_ptr<io::PipeSplitter> pipe_splitter;
+    RETURN_IF_ERROR(_create_pipe_splitter(&pipe_splitter));
+    if (pipe_splitter != nullptr) {
+        // all scanners read the same stream, each one parses a part of the chunks
+        auto& scan_range = _scan_ranges[0].scan_range.ext_scan_range.file_scan_range;
+        for (int i = 0; i < config::stream_load_parse_parallelism; ++i) {
+            std::unique_ptr<VFileScanner> scanner =
+                    VFileScanner::create_unique(_state, this, _limit_per_scanner, scan_range,
+                                                runtime_profile(), _kv_cache.get());
+            scanner->set_pipe_splitter(pipe_splitter, runtime_profile()->create_child(
+                                                              fmt::format("StreamParser{}", i)));
+            RETURN_IF_ERROR(
+                    scanner->prepare(_conjuncts, &_colname_to_value_range, &_colname_to_slot_id));
+            scanners->push_back(std::move(scanner));
+        }
+        return Status::OK();
+    }
+
     for (auto& scan_range : _scan_ranges) {
         std::unique_ptr<VFileScanner> scanner =
                 VFileScanner::create_unique(_state, this, _limit_per_scanner,
@@ -129,6 +156,74 @@ Status NewFileScanNode::_init_scanners(std::list<VScannerSPtr>* scanners) {
     return Status::OK();
 }
 
+Status NewFileScanNode::_create_pipe_splitter(std::shared_ptr<io::PipeSplitter>* splitter) {
+    // the rows parsed by different scanners are interleaved
+    if (config::stream_load_parse_parallelism <= 1 || !_state->load_order_insensitive() ||
+        _scan_ranges.size() != 1) {
+        return Status::OK();
+    }
+    const auto& scan_range = _scan_ranges[0].scan_range.ext_scan_range.file_scan_range;
+    if (scan_range.ranges.size() != 1) {
+        return Status::OK();
+    }
+    const TFileScanRangeParams* params = nullptr;
+    if (_state->get_query_ctx() != nullptr &&
+        _state->get_query_ctx()->file_scan_range_params_map.count(id()) > 0) {
+        params = &(_state->get_query_ctx()->file_scan_range_params_map[id()]);
+    } else if (scan_range.__isset.params) {
+        params = &scan_range.params;
+    } else {
+        return Status::OK();
+    }
+    if (params->file_type != TFileType::FILE_STREAM || !params->__isset.file_attributes) {
+        return Status::OK();
+    }
+
+    const auto& range = scan_range.ranges[0];
+    const auto& file_attributes = params->file_attributes;
+    switch (params->format_type) {
+    case TFileFormatType::FORMAT_CSV_PLAIN: {
+        auto compress_type =
+                range.__isset.compress_type ? range.compress_type : params->compress_type;
+        if (compress_type != TFileCompressType::UNKNOWN &&
+            compress_type != TFileCompressType::PLAIN) {
+            return Status::OK();
+        }
+        // the header lines are only in the first chunk
+        if ((file_attributes.__isset.header_type && !file_attributes.header_type.empty()) ||
+            (file_attributes.__isset.skip_lines && file_attributes.skip_lines > 0)) {
+            return Status::OK();
+        }
+        break;
+    }
+    case TFileFormatType::FORMAT_JSON:
+        if (!file_attributes.__isset.read_json_by_line || !file_attributes.read_json_by_line) {
+            return Status::OK();
+        }
+        break;
+    default:
+        return Status::OK();
+    }
+
+    std::string line_delimiter = "\n";
+    if (file_attributes.__isset.text_params &&
+        file_attributes.text_params.__isset.line_delimiter) {
+        line_delimiter = file_attributes.text_params.line_delimiter;
+    }
+    if (line_delimiter.size() != 1) {
+        return Status::OK();
+    }
+
+    io::FileReaderSPtr pipe;
+    RETURN_IF_ERROR(FileFactory::create_pipe_reader(range.load_id, &pipe, _state));
+    if (pipe == nullptr) {
+        return Status::OK();
+    }
+    *splitter = std::make_shared<io::PipeSplitter>(std::move(pipe), line_delimiter[0],
+                                                   config::stream_load_parse_chunk_size);
+    return Status::OK();
+}
+
 std::string NewFileScanNode::get_name() {
     return fmt::format("VFILE_SCAN_NODE({0})", _table_name);
 }
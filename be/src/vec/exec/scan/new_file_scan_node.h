@@ -32,6 +32,9 @@ class DescriptorTbl;
 class ObjectPool;
 class RuntimeState;
 class TPlanNode;
+namespace io {
+class PipeSplitter;
+} // namespace io
 namespace vectorized {
 class VScanner;
 } // namespace vectorized
@@ -57,6 +60,10 @@ protected:
     Status _init_scanners(std::list<VScannerSPtr>* scanners) override;
 
 private:
+    // Create the splitter of the stream load pipe if the single stream can be parsed by
+    // several scanners in parallel, otherwise *splitter is nullptr.
+    Status _create_pipe_splitter(std::shared_ptr<io::PipeSplitter>* splitter);
+
     std::vector<TScanRangeParams> _scan_ranges;
     // A in memory cache to save some common components
     // of the this scan node. eg:
@@ -28,6 +28,7 @@
 #include <algorithm>
 #include <charconv>
 #include <ostream>
+#include <set>
 #include <shared_mutex>
 #include <unordered_map>
 #include <utility>
@@ -39,21 +40,26 @@
 #include "common/status.h"
 #include "exec/exec_node.h"
 #include "olap/rowset/rowset.h"
+#include "olap/rowset/rowset_meta.h"
 #include "olap/rowset/rowset_reader.h"
 #include "olap/storage_engine.h"
 #include "olap/tablet.h"
 #include "olap/tablet_manager.h"
 #include "runtime/decimalv2_value.h"
+#include "runtime/descriptors.h"
 #include "runtime/query_statistics.h"
 #include "runtime/runtime_state.h"
 #include "runtime/types.h"
 #include "service/backend_options.h"
+#include "util/md5.h"
+#include "util/thrift_util.h"
 #include "util/time.h"
 #include "util/to_string.h"
 #include "vec/columns/column.h"
 #include "vec/columns/column_const.h"
 #include "vec/common/string_ref.h"
 #include "vec/exec/scan/new_olap_scanner.h"
+#include "vec/exec/scan/scan_result_cache.h"
 #include "vec/exprs/vectorized_fn_call.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/exprs/vexpr_context.h"
@@ -68,6 +74,42 @@ class VScanner;
 
 namespace doris::vectorized {
 
+namespace {
+
+// The functions whose results are different between queries, the scans with them can't be cached.
+const std::set<std::string> NONDETERMINISTIC_FUNCTIONS = {
+        "rand", "random", "uuid", "uuid_numeric", "now", "curtime", "current_time", "curdate",
+        "current_date", "current_timestamp", "localtime", "localtimestamp", "utc_timestamp",
+        "sleep"};
+
+// Replace the slot refs in the expr with the column names, because the slot ids of the same
+// column are different in the plans of different queries.
+// Return false if the expr can't be normalized.
+bool normalize_expr_for_result_cache(TExpr* expr, const DescriptorTbl& descs) {
+    for (auto& node : expr->nodes) {
+        if (node.node_type == TExprNodeType::TUPLE_IS_NULL_PRED) {
+            return false;
+        }
+        if (node.__isset.fn && NONDETERMINISTIC_FUNCTIONS.count(node.fn.name.function_name) > 0) {
+            return false;
+        }
+        if (node.node_type == TExprNodeType::SLOT_REF) {
+            const auto* slot = descs.get_slot_descriptor(node.slot_ref.slot_id);
+            if (slot == nullptr) {
+                return false;
+            }
+            node.slot_ref.slot_id = 0;
+            node.slot_ref.tuple_id = 0;
+            TColumnRef column_ref;
+            column_ref.__set_column_name(slot->col_name());
+            node.__set_column_ref(column_ref);
+        }
+    }
+    return true;
+}
+
+} // namespace
+
 NewOlapScanNode::NewOlapScanNode(ObjectPool* pool, const TPlanNode& tnode,
                                  const DescriptorTbl& descs)
         : VScanNode(pool, tnode, descs), _olap_scan_node(tnode.olap_scan_node) {
@@ -76,6 +118,85 @@ NewOlapScanNode::NewOlapScanNode(ObjectPool* pool, const TPlanNode& tnode,
     if (_olap_scan_node.__isset.sort_info && _olap_scan_node.__isset.sort_limit) {
         _limit_per_scanner = _olap_scan_node.sort_limit;
     }
+    if (ScanResultCache::instance() != nullptr) {
+        _result_cache_digest = _build_result_cache_digest(tnode, descs);
+    }
+}
+
+std::string NewOlapScanNode::_build_result_cache_digest(const TPlanNode& tnode,
+                                                        const DescriptorTbl& descs) {
+    // the results of the scans with limit, runtime filters or topn filter are not complete
+    if (tnode.limit >= 0 || !tnode.runtime_filters.empty() ||
+        tnode.olap_scan_node.__isset.sort_info || tnode.olap_scan_node.use_topn_opt) {
+        return "";
+    }
+    const auto* tuple_desc = descs.get_tuple_descriptor(tnode.olap_scan_node.tuple_id);
+    if (tuple_desc == nullptr) {
+        return "";
+    }
+
+    // the projections are applied to the output blocks of the scan, they are not a part of
+    // the digest, so that the queries with different projections can share the result
+    TPlanNode normalized;
+    normalized.__set_olap_scan_node(tnode.olap_scan_node);
+    normalized.olap_scan_node.tuple_id = 0;
+    if (tnode.__isset.push_down_agg_type_opt) {
+        normalized.__set_push_down_agg_type_opt(tnode.push_down_agg_type_opt);
+    }
+    if (tnode.__isset.conjuncts) {
+        normalized.__set_conjuncts(tnode.conjuncts);
+        for (auto& conjunct : normalized.conjuncts) {
+            if (!normalize_expr_for_result_cache(&conjunct, descs)) {
+                return "";
+            }
+        }
+    }
+    if (tnode.__isset.vconjunct) {
+        normalized.__set_vconjunct(tnode.vconjunct);
+        if (!normalize_expr_for_result_cache(&normalized.vconjunct, descs)) {
+            return "";
+        }
+    }
+    std::string plan;
+    ThriftSerializer serializer(false, 4096);
+    if (!serializer.serialize(&normalized, &plan).ok()) {
+        return "";
+    }
+
+    // the columns of the output blocks
+    for (const auto* slot : tuple_desc->slots()) {
+        plan += fmt::format("|{}:{}:{}:{}", slot->col_name(), slot->type().debug_string(),
+                            slot->is_nullable(), slot->is_materialized());
+    }
+    Md5Digest digest;
+    digest.update(plan.data(), plan.size());
+    digest.digest();
+    return digest.hex();
+}
+
+std::string NewOlapScanNode::_get_result_cache_prefix() {
+    if (_result_cache_digest.empty()) {
+        return "";
+    }
+    return fmt::format("{}|{}|{}{}{}|{}", _result_cache_digest, _state->timezone(),
+                       _state->skip_storage_engine_merge(), _state->skip_delete_predicate(),
+                       _state->skip_delete_bitmap(), _state->be_exec_version());
+}
+
+std::string NewOlapScanNode::_get_result_cache_key() {
+    std::string key = _get_result_cache_prefix();
+    if (key.empty()) {
+        return "";
+    }
+    std::vector<std::pair<int64_t, std::string>> tablet_versions;
+    for (const auto& scan_range : _scan_ranges) {
+        tablet_versions.emplace_back(scan_range->tablet_id, scan_range->version);
+    }
+    std::sort(tablet_versions.begin(), tablet_versions.end());
+    for (const auto& [tablet_id, version] : tablet_versions) {
+        key += fmt::format("|{}:{}", tablet_id, version);
+    }
+    return key;
 }
 
 Status NewOlapScanNode::collect_query_statistics(QueryStatistics* statistics) {
@@ -168,6 +289,10 @@ Status NewOlapScanNode::_init_profile() {
             ADD_COUNTER(_segment_profile, "InvertedIndexQueryCacheHit", TUnit::UNIT);
     _inverted_index_query_cache_miss_counter =
             ADD_COUNTER(_segment_profile, "InvertedIndexQueryCacheMiss", TUnit::UNIT);
+    _inverted_index_term_cache_hit_counter =
+            ADD_COUNTER(_segment_profile, "InvertedIndexTermCacheHit", TUnit::UNIT);
+    _inverted_index_term_cache_miss_counter =
+            ADD_COUNTER(_segment_profile, "InvertedIndexTermCacheMiss", TUnit::UNIT);
     _inverted_index_query_timer = ADD_TIMER(_segment_profile, "InvertedIndexQueryTime");
     _inverted_index_query_bitmap_copy_timer =
             ADD_TIMER(_segment_profile, "InvertedIndexQueryBitmapCopyTime");
@@ -451,6 +576,18 @@ Status NewOlapScanNode::_init_scanners(std::list<VScannerSPtr>* scanners) {
     }
     int scanners_per_tablet = std::max(1, 64 / (int)_scan_ranges.size());
 
+    // no result can be cached if the cache is full of spilled results
+    if (!_shared_scan_opt && ScanResultCache::instance() != nullptr &&
+        config::enable_scan_result_cache_by_rowset &&
+        ScanResultCache::instance()->max_entry_bytes() > 0) {
+        bool used = false;
+        RETURN_IF_ERROR(
+                _init_rowset_result_cache_scanners(scanners, scanners_per_tablet, &used));
+        if (used) {
+            return Status::OK();
+        }
+    }
+
     bool is_duplicate_key = false;
     size_t segment_count = 0;
     std::vector<std::vector<RowSetSplits>> rowset_splits_vector(_scan_ranges.size());
@@ -639,6 +776,121 @@ Status NewOlapScanNode::_init_scanners(std::list<VScannerSPtr>* scanners) {
     return Status::OK();
 }
 
+Status NewOlapScanNode::_init_rowset_result_cache_scanners(std::list<VScannerSPtr>* scanners,
+                                                           int scanners_per_tablet, bool* used) {
+    *used = false;
+    std::string prefix = _get_result_cache_prefix();
+    if (prefix.empty()) {
+        return Status::OK();
+    }
+
+    std::vector<std::vector<RowSetSplits>> rowset_splits_vector(_scan_ranges.size());
+    for (int i = 0; i < _scan_ranges.size(); ++i) {
+        auto& scan_range = _scan_ranges[i];
+        auto [tablet, status] = StorageEngine::instance()->tablet_manager()->get_tablet_and_status(
+                scan_range->tablet_id, true);
+        RETURN_IF_ERROR(status);
+        // the rows of the rowsets of the other keys types are merged with each other
+        if (tablet->keys_type() != DUP_KEYS) {
+            return Status::OK();
+        }
+
+        int64_t version = 0;
+        std::from_chars(scan_range->version.c_str(),
+                        scan_range->version.c_str() + scan_range->version.size(), version);
+        std::shared_lock rdlock(tablet->get_header_lock());
+        Status acquire_reader_st =
+                tablet->capture_rs_readers({0, version}, &rowset_splits_vector[i]);
+        if (!acquire_reader_st.ok()) {
+            LOG(WARNING) << "fail to init reader.res=" << acquire_reader_st;
+            std::stringstream ss;
+            ss << "failed to initialize storage reader. tablet=" << tablet->full_name()
+               << ", res=" << acquire_reader_st << ", backend=" << BackendOptions::get_localhost();
+            return Status::InternalError(ss.str());
+        }
+        // the delete predicates are applied to the rows of the earlier rowsets
+        for (const auto& rowset_splits : rowset_splits_vector[i]) {
+            if (rowset_splits.rs_reader->rowset()->rowset_meta()->has_delete_predicate()) {
+                return Status::OK();
+            }
+        }
+    }
+    *used = true;
+    // the result is cached by rowsets instead
+    _result_cache_key.clear();
+
+    // the key ranges are split as the scans of other tablets, adjacent ranges of a scanner
+    // have the same end_include
+    auto split_key_ranges = [&](int ranges_per_scanner) {
+        std::vector<std::vector<doris::OlapScanRange*>> range_groups;
+        int num_ranges = _cond_ranges.size();
+        for (int i = 0; i < num_ranges;) {
+            range_groups.emplace_back();
+            range_groups.back().push_back(_cond_ranges[i].get());
+            ++i;
+            for (int j = 1; i < num_ranges && j < ranges_per_scanner &&
+                            _cond_ranges[i]->end_include == _cond_ranges[i - 1]->end_include;
+                 ++j, ++i) {
+                range_groups.back().push_back(_cond_ranges[i].get());
+            }
+        }
+        return range_groups;
+    };
+    for (int i = 0; i < _scan_ranges.size(); ++i) {
+        for (auto& rowset_splits : rowset_splits_vector[i]) {
+            auto rowset = rowset_splits.rs_reader->rowset();
+            int num_segments = rowset->num_segments();
+            if (num_segments == 0) {
+                continue;
+            }
+            auto reader = ScanResultCache::instance()->lookup(
+                    ScanResultCache::rowset_key(prefix, rowset->rowset_id()),
+                    _runtime_profile.get());
+            if (reader) {
+                COUNTER_UPDATE(_rowset_result_cache_hit_counter, 1);
+                _rowset_cache_readers.push_back(std::move(reader));
+                continue;
+            }
+
+            // split the large rowsets by segments first, then by key ranges, the scanners
+            // of a rowset add their results to the parts of the result on the rowset
+            int scanners_per_rowset = 1;
+            if (config::doris_scan_range_max_mb > 0) {
+                scanners_per_rowset =
+                        std::max(1, (int)(rowset->data_disk_size() /
+                                          (config::doris_scan_range_max_mb << 20)));
+            }
+            scanners_per_rowset = std::min(scanners_per_tablet, scanners_per_rowset);
+            int num_segment_groups = std::min(num_segments, scanners_per_rowset);
+            int ranges_per_scanner =
+                    std::max(1, (int)_cond_ranges.size() /
+                                        std::max(1, scanners_per_rowset / num_segment_groups));
+            auto range_groups = split_key_ranges(ranges_per_scanner);
+            auto parts = std::make_shared<ScanResultCache::RowsetResultParts>(
+                    prefix, rowset->rowset_id(), num_segment_groups * range_groups.size());
+            size_t part_id = 0;
+            for (int group = 0; group < num_segment_groups; ++group) {
+                std::pair<int, int> segment_offsets = {
+                        group * num_segments / num_segment_groups,
+                        (group + 1) * num_segments / num_segment_groups};
+                for (const auto& scanner_ranges : range_groups) {
+                    RowSetSplits segment_splits(rowset_splits.rs_reader->clone());
+                    segment_splits.segment_offsets = segment_offsets;
+                    std::shared_ptr<NewOlapScanner> scanner = NewOlapScanner::create_shared(
+                            _state, this, _limit_per_scanner, _olap_scan_node.is_preaggregation,
+                            *_scan_ranges[i], scanner_ranges,
+                            std::vector<RowSetSplits> {segment_splits}, _scanner_profile.get());
+                    RETURN_IF_ERROR(scanner->prepare(_state, _conjuncts));
+                    scanner->set_compound_filters(_compound_filters);
+                    scanner->set_rowset_result_cache(parts, part_id++);
+                    scanners->push_back(scanner);
+                }
+            }
+        }
+    }
+    return Status::OK();
+}
+
 bool NewOlapScanNode::_is_key_column(const std::string& key_name) {
     // all column in dup_keys table or unique_keys with merge on write table olap scan node threat
     // as key column
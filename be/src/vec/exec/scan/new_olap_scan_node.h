@@ -89,11 +89,28 @@ protected:
 
     Status _init_scanners(std::list<VScannerSPtr>* scanners) override;
 
+    std::string _get_result_cache_key() override;
+
     void add_filter_info(int id, const PredicateFilterInfo& info);
 
 private:
     Status _build_key_ranges_and_filters();
 
+    // Digest of the scan in the plan, empty if the result of the scan can't be cached.
+    static std::string _build_result_cache_digest(const TPlanNode& tnode,
+                                                  const DescriptorTbl& descs);
+
+    // The prefix of the keys of the results of this scan in ScanResultCache, it identifies the
+    // scan regardless of the tablets. Empty if the result can't be cached.
+    std::string _get_result_cache_prefix();
+
+    // Read the cached results of the rowsets of the duplicate key tablets, and create the
+    // scanners of the other rowsets to cache their results, a rowset is split by segments and
+    // key ranges into about `scanners_per_tablet` scanners. `used` is false if the tablets
+    // can't be scanned by rowsets, e.g. there are delete predicates.
+    Status _init_rowset_result_cache_scanners(std::list<VScannerSPtr>* scanners,
+                                              int scanners_per_tablet, bool* used);
+
 private:
     TOlapScanNode _olap_scan_node;
     std::vector<std::unique_ptr<TPaloScanRange>> _scan_ranges;
@@ -105,6 +122,7 @@ private:
     std::vector<TCondition> _compound_filters;
     // If column id in this set, indicate that we need to read data after index filtering
     std::set<int32_t> _maybe_read_column_ids;
+    std::string _result_cache_digest;
 
 private:
     std::unique_ptr<RuntimeProfile> _segment_profile;
@@ -175,6 +193,8 @@ private:
     RuntimeProfile::Counter* _inverted_index_filter_timer = nullptr;
     RuntimeProfile::Counter* _inverted_index_query_cache_hit_counter = nullptr;
     RuntimeProfile::Counter* _inverted_index_query_cache_miss_counter = nullptr;
+    RuntimeProfile::Counter* _inverted_index_term_cache_hit_counter = nullptr;
+    RuntimeProfile::Counter* _inverted_index_term_cache_miss_counter = nullptr;
     RuntimeProfile::Counter* _inverted_index_query_timer = nullptr;
     RuntimeProfile::Counter* _inverted_index_query_bitmap_copy_timer = nullptr;
     RuntimeProfile::Counter* _inverted_index_query_bitmap_op_timer = nullptr;
@@ -54,6 +54,7 @@
 #include "util/runtime_profile.h"
 #include "vec/core/block.h"
 #include "vec/exec/scan/new_olap_scan_node.h"
+#include "vec/exec/scan/scan_result_cache.h"
 #include "vec/exec/scan/vscan_node.h"
 #include "vec/exprs/vexpr_context.h"
 #include "vec/olap/block_reader.h"
@@ -241,6 +242,20 @@ void NewOlapScanner::set_compound_filters(const std::vector<TCondition>& compoun
     _compound_filters = compound_filters;
 }
 
+void NewOlapScanner::set_rowset_result_cache(
+        std::shared_ptr<ScanResultCache::RowsetResultParts> parts, size_t part_id) {
+    _result_cache_parts = std::move(parts);
+    _result_cache_part_id = part_id;
+    _collect_result_cache = true;
+}
+
+void NewOlapScanner::_insert_result_cache() {
+    _result_cache_parts->add(_result_cache_part_id, std::move(_result_cache_blocks),
+                             _result_cache_bytes, _profile);
+    _result_cache_parts.reset();
+    _result_cache_blocks.clear();
+}
+
 // it will be called under tablet read lock because capture rs readers need
 Status NewOlapScanner::_init_tablet_reader_params(
         const std::vector<OlapScanRange*>& key_ranges, const std::vector<TCondition>& filters,
@@ -487,6 +502,11 @@ Status NewOlapScanner::close(RuntimeState* state) {
     // so that it will core
     _tablet_reader_params.rs_splits.clear();
     _tablet_reader.reset();
+    // the scanner stopped before eof, or its result was too large to cache
+    if (_result_cache_parts != nullptr) {
+        _result_cache_parts->abort();
+        _result_cache_parts.reset();
+    }
 
     RETURN_IF_ERROR(VScanner::close(state));
     return Status::OK();
@@ -581,6 +601,10 @@ void NewOlapScanner::_update_counters_before_close() {
                    stats.inverted_index_query_cache_hit);
     COUNTER_UPDATE(olap_parent->_inverted_index_query_cache_miss_counter,
                    stats.inverted_index_query_cache_miss);
+    COUNTER_UPDATE(olap_parent->_inverted_index_term_cache_hit_counter,
+                   stats.inverted_index_term_cache_hit);
+    COUNTER_UPDATE(olap_parent->_inverted_index_term_cache_miss_counter,
+                   stats.inverted_index_term_cache_miss);
     COUNTER_UPDATE(olap_parent->_inverted_index_query_timer, stats.inverted_index_query_timer);
     COUNTER_UPDATE(olap_parent->_inverted_index_query_bitmap_copy_timer,
                    stats.inverted_index_query_bitmap_copy_timer);
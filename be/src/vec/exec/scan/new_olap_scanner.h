@@ -33,6 +33,7 @@
 #include "olap/rowset/rowset_reader.h"
 #include "olap/tablet.h"
 #include "olap/tablet_schema.h"
+#include "vec/exec/scan/scan_result_cache.h"
 #include "vec/exec/scan/vscanner.h"
 
 namespace doris {
@@ -73,11 +74,17 @@ public:
 
     void set_compound_filters(const std::vector<TCondition>& compound_filters);
 
+    // Add the output blocks to `parts` as the part `part_id` of the result on a rowset, the
+    // scanner must read the segments and key ranges of the part only.
+    void set_rowset_result_cache(std::shared_ptr<ScanResultCache::RowsetResultParts> parts,
+                                 size_t part_id);
+
     doris::TabletStorageType get_storage_type() override;
 
 protected:
     Status _get_block_impl(RuntimeState* state, Block* block, bool* eos) override;
     void _update_counters_before_close() override;
+    void _insert_result_cache() override;
 
 private:
     void _update_realtime_counters();
@@ -104,6 +111,9 @@ private:
     std::unordered_set<uint32_t> _tablet_columns_convert_to_null_set;
     std::vector<TCondition> _compound_filters;
 
+    std::shared_ptr<ScanResultCache::RowsetResultParts> _result_cache_parts;
+    size_t _result_cache_part_id = 0;
+
     // ========= profiles ==========
     int64_t _compressed_bytes_read = 0;
     int64_t _raw_rows_read = 0;
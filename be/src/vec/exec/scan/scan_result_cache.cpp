@@ -0,0 +1,338 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/scan/scan_result_cache.h"
+
+#include <fmt/format.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "common/config.h"
+#include "common/consts.h"
+#include "io/fs/local_file_system.h"
+#include "runtime/block_spill_manager.h"
+#include "runtime/exec_env.h"
+#include "util/time.h"
+#include "vec/core/block_spill_writer.h"
+#include "vec/core/column_with_type_and_name.h"
+
+namespace doris::vectorized {
+
+ScanResultCache* ScanResultCache::_s_instance = nullptr;
+
+ScanResultCache::ScanResultCache(size_t capacity)
+        : LRUCachePolicy("ScanResultCache", capacity, LRUCacheType::SIZE,
+                         config::scan_result_cache_stale_sweep_time_sec, 16) {}
+
+void ScanResultCache::create_global_instance(size_t capacity) {
+    DCHECK(_s_instance == nullptr);
+    static ScanResultCache instance(capacity);
+    _s_instance = &instance;
+}
+
+ScanResultCache::CacheValue::~CacheValue() {
+    if (spill_stream_id >= 0) {
+        auto st = io::global_local_filesystem()->delete_file(spill_path);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to delete spilled scan result " << spill_path << ": " << st;
+        }
+        total_spilled_bytes->fetch_sub(spill_bytes, std::memory_order_relaxed);
+    }
+    if (cache != nullptr) {
+        cache->_remove_rowset_prefix(rowset_id, prefix);
+    }
+}
+
+ScanResultCache::Reader::~Reader() {
+    if (_spill_reader) {
+        static_cast<void>(_spill_reader->close());
+    }
+    _cache->release(_handle);
+}
+
+Status ScanResultCache::Reader::open(RuntimeProfile* profile) {
+    auto* value = reinterpret_cast<CacheValue*>(_cache->value(_handle));
+    if (value->spill_stream_id >= 0) {
+        _spill_reader.reset(new BlockSpillReader(value->spill_stream_id, value->spill_path,
+                                                 profile, false));
+        RETURN_IF_ERROR(_spill_reader->open());
+    }
+    return Status::OK();
+}
+
+Status ScanResultCache::Reader::read(Block* block, bool* eos) {
+    if (_spill_reader) {
+        return _spill_reader->read(block, eos);
+    }
+    auto* value = reinterpret_cast<CacheValue*>(_cache->value(_handle));
+    if (_block_index == value->blocks.size()) {
+        *eos = true;
+        return Status::OK();
+    }
+    // the cached columns are shared by the queries, the caller may modify the output block
+    ColumnsWithTypeAndName columns;
+    for (const auto& column : value->blocks[_block_index++]) {
+        columns.emplace_back(column.column->clone_resized(column.column->size()), column.type,
+                             column.name);
+    }
+    *block = Block(columns);
+    *eos = false;
+    return Status::OK();
+}
+
+std::unique_ptr<ScanResultCache::Reader> ScanResultCache::lookup(const std::string& key,
+                                                                 RuntimeProfile* profile) {
+    Cache::Handle* handle = _cache->lookup(CacheKey(key));
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    reinterpret_cast<CacheValue*>(_cache->value(handle))->last_visit_time = UnixMillis();
+    auto reader = std::make_unique<Reader>(_cache.get(), handle);
+    auto st = reader->open(profile);
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to read cached scan result: " << st;
+        return nullptr;
+    }
+    return reader;
+}
+
+Status ScanResultCache::_spill(std::vector<Block>& blocks, RuntimeProfile* profile,
+                               CacheValue* value) {
+    size_t max_rows = 1;
+    for (const auto& block : blocks) {
+        max_rows = std::max(max_rows, block.rows());
+    }
+    auto* spill_mgr = ExecEnv::GetInstance()->block_spill_mgr();
+    BlockSpillWriterUPtr writer;
+    RETURN_IF_ERROR(spill_mgr->get_writer(max_rows, writer, profile));
+    value->spill_stream_id = writer->get_id();
+    value->spill_path = spill_mgr->get_path(writer->get_id());
+    // the file is owned by the cache value from now on
+    spill_mgr->remove(writer->get_id());
+    value->total_spilled_bytes = &_spilled_bytes;
+    for (const auto& block : blocks) {
+        RETURN_IF_ERROR(writer->write(block));
+    }
+    RETURN_IF_ERROR(writer->close());
+    value->spill_bytes = writer->get_written_bytes();
+    _spilled_bytes.fetch_add(value->spill_bytes, std::memory_order_relaxed);
+    return Status::OK();
+}
+
+Status ScanResultCache::insert(const std::string& key, std::vector<Block>&& blocks, size_t bytes,
+                               RuntimeProfile* profile) {
+    return _insert(key, std::move(blocks), bytes, profile, std::make_unique<CacheValue>());
+}
+
+Status ScanResultCache::_insert(const std::string& key, std::vector<Block>&& blocks, size_t bytes,
+                                RuntimeProfile* profile, std::unique_ptr<CacheValue> value) {
+    if (bytes > config::scan_result_cache_max_memory_entry_bytes) {
+        // the written bytes are about the allocated bytes
+        if (_spilled_bytes.load(std::memory_order_relaxed) + bytes >
+            config::scan_result_cache_disk_capacity) {
+            return Status::OK();
+        }
+        RETURN_IF_ERROR(_spill(blocks, profile, value.get()));
+        value->size = sizeof(CacheValue) + key.size();
+    } else {
+        value->blocks = std::move(blocks);
+        value->size = bytes + sizeof(CacheValue) + key.size();
+    }
+    value->last_visit_time = UnixMillis();
+    size_t charge = value->size;
+    auto deleter = [](const CacheKey& key, void* value) { delete (CacheValue*)value; };
+    _cache->release(_cache->insert(CacheKey(key), value.release(), charge, deleter,
+                                   CachePriority::NORMAL));
+    return Status::OK();
+}
+
+std::string ScanResultCache::rowset_key(const std::string& prefix, const RowsetId& rowset_id) {
+    return fmt::format("{}|rowset:{}", prefix, rowset_id.to_string());
+}
+
+Status ScanResultCache::insert_rowset_result(const std::string& prefix, const RowsetId& rowset_id,
+                                             std::vector<Block>&& blocks, size_t bytes,
+                                             RuntimeProfile* profile) {
+    auto value = std::make_unique<CacheValue>();
+    value->rowset_id = rowset_id.to_string();
+    value->prefix = prefix;
+    {
+        std::lock_guard<std::mutex> l(_rowset_lock);
+        _rowset_prefixes[value->rowset_id][prefix]++;
+    }
+    // the prefix is removed by the destructor of the value if it is not inserted
+    value->cache = this;
+    return _insert(rowset_key(prefix, rowset_id), std::move(blocks), bytes, profile,
+                   std::move(value));
+}
+
+void ScanResultCache::RowsetResultParts::add(size_t part_id, std::vector<Block>&& blocks,
+                                             size_t bytes, RuntimeProfile* profile) {
+    std::vector<Block> result;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        DCHECK_LT(part_id, _parts.size());
+        if (_aborted) {
+            return;
+        }
+        _bytes += bytes;
+        if (_bytes > ScanResultCache::instance()->max_entry_bytes()) {
+            _aborted = true;
+            _parts.clear();
+            return;
+        }
+        _parts[part_id] = std::move(blocks);
+        if (++_num_added < _parts.size()) {
+            return;
+        }
+        for (auto& part : _parts) {
+            std::move(part.begin(), part.end(), std::back_inserter(result));
+        }
+        _parts.clear();
+    }
+    auto st = ScanResultCache::instance()->insert_rowset_result(_prefix, _rowset_id,
+                                                                std::move(result), _bytes, profile);
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to cache the scan result of rowset " << _rowset_id << ": " << st;
+    }
+}
+
+void ScanResultCache::RowsetResultParts::abort() {
+    std::lock_guard<std::mutex> l(_lock);
+    _aborted = true;
+    _parts.clear();
+}
+
+void ScanResultCache::_remove_rowset_prefix(const std::string& rowset_id,
+                                            const std::string& prefix) {
+    std::lock_guard<std::mutex> l(_rowset_lock);
+    auto it = _rowset_prefixes.find(rowset_id);
+    if (it == _rowset_prefixes.end()) {
+        return;
+    }
+    auto prefix_it = it->second.find(prefix);
+    if (prefix_it != it->second.end() && --prefix_it->second == 0) {
+        it->second.erase(prefix_it);
+    }
+    if (it->second.empty()) {
+        _rowset_prefixes.erase(it);
+    }
+}
+
+void ScanResultCache::carry_over_rowset_results(const std::vector<RowsetSharedPtr>& input_rowsets,
+                                                const RowsetSharedPtr& output_rowset,
+                                                RuntimeProfile* profile) {
+    if (input_rowsets.empty()) {
+        return;
+    }
+    // the scans whose results on all the input rowsets are cached
+    std::vector<std::string> prefixes;
+    {
+        std::lock_guard<std::mutex> l(_rowset_lock);
+        auto it = _rowset_prefixes.find(input_rowsets[0]->rowset_id().to_string());
+        if (it == _rowset_prefixes.end()) {
+            return;
+        }
+        for (const auto& [prefix, _] : it->second) {
+            bool cached = true;
+            for (size_t i = 1; i < input_rowsets.size() && cached; ++i) {
+                auto input_it = _rowset_prefixes.find(input_rowsets[i]->rowset_id().to_string());
+                cached = input_it != _rowset_prefixes.end() && input_it->second.count(prefix) > 0;
+            }
+            if (cached) {
+                prefixes.push_back(prefix);
+            }
+        }
+    }
+
+    for (const auto& prefix : prefixes) {
+        // the entries may be evicted after the index is checked
+        std::vector<std::unique_ptr<Reader>> readers;
+        for (const auto& rowset : input_rowsets) {
+            auto reader = lookup(rowset_key(prefix, rowset->rowset_id()), profile);
+            if (!reader) {
+                break;
+            }
+            readers.push_back(std::move(reader));
+        }
+        if (readers.size() != input_rowsets.size()) {
+            continue;
+        }
+        std::vector<Block> blocks;
+        size_t bytes = 0;
+        size_t max_bytes = max_entry_bytes();
+        Status st;
+        for (auto& reader : readers) {
+            bool eos = false;
+            // stop copying the cached blocks once the result is too large to cache
+            while (st.ok() && !eos && bytes <= max_bytes) {
+                Block block;
+                st = reader->read(&block, &eos);
+                if (st.ok() && !eos && block.rows() > 0) {
+                    bytes += block.allocated_bytes();
+                    blocks.push_back(std::move(block));
+                }
+            }
+        }
+        if (st.ok() && bytes <= max_bytes) {
+            st = insert_rowset_result(prefix, output_rowset->rowset_id(), std::move(blocks), bytes,
+                                      profile);
+        }
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to carry over the cached scan results to rowset "
+                         << output_rowset->rowset_id() << ": " << st;
+        }
+    }
+}
+
+size_t ScanResultCache::max_entry_bytes() const {
+    // the results in memory are limited by the capacity of the cache, the spilled ones by
+    // the free disk capacity, the larger results would be rejected by _insert()
+    int64_t max_memory_bytes = std::min<int64_t>(config::scan_result_cache_max_memory_entry_bytes,
+                                                 _cache->get_total_capacity());
+    int64_t max_spill_bytes = config::scan_result_cache_disk_capacity - spilled_bytes();
+    int64_t max_bytes = std::min<int64_t>(config::scan_result_cache_max_entry_bytes,
+                                          std::max(max_memory_bytes, max_spill_bytes));
+    return std::max<int64_t>(max_bytes, 0);
+}
+
+bool ScanResultCache::collect_block(const Block& block, std::vector<Block>* blocks,
+                                    size_t* bytes) {
+    // check before copying, the copied blocks are freed as soon as the bound is exceeded
+    *bytes += block.allocated_bytes();
+    if (*bytes > max_entry_bytes()) {
+        blocks->clear();
+        blocks->shrink_to_fit();
+        return false;
+    }
+    // copy the columns, the output block may be modified by the parent nodes
+    ColumnsWithTypeAndName columns;
+    for (const auto& column : block) {
+        if (column.name.rfind(BeConsts::BLOCK_TEMP_COLUMN_PREFIX, 0) == 0) {
+            continue;
+        }
+        columns.emplace_back(column.column->clone_resized(column.column->size()), column.type,
+                             column.name);
+    }
+    blocks->emplace_back(columns);
+    return true;
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,173 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/status.h"
+#include "olap/lru_cache.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/rowset.h"
+#include "runtime/memory/lru_cache_policy.h"
+#include "util/runtime_profile.h"
+#include "vec/core/block.h"
+#include "vec/core/block_spill_reader.h"
+
+namespace doris::vectorized {
+
+// Cache the output blocks of scan nodes, so that the queries sharing an identical scan of
+// the same tablet versions can return the blocks without creating scanners.
+//
+// The key is built by the scan node from the digest of its plan and the versions of the
+// tablets it reads. The results larger than config::scan_result_cache_max_memory_entry_bytes
+// are spilled to the local disk, the total size of the spilled results is limited by
+// config::scan_result_cache_disk_capacity.
+//
+// The results of the scans of duplicate key tablets are also cached by rowsets, the rowsets
+// are immutable, so a scan of a partition with new loads only reads the new rowsets and the
+// cached results of the others. The results of the input rowsets of a compaction are carried
+// over to its output rowset.
+class ScanResultCache : public LRUCachePolicy {
+public:
+    // Reads the blocks of a cached result one by one.
+    // The cache entry and its spilled file are kept until the reader is destructed.
+    class Reader {
+    public:
+        Reader(Cache* cache, Cache::Handle* handle) : _cache(cache), _handle(handle) {}
+        ~Reader();
+
+        Status open(RuntimeProfile* profile);
+
+        // Read the next block. eos is true if all blocks have been read.
+        Status read(Block* block, bool* eos);
+
+    private:
+        Cache* _cache;
+        Cache::Handle* _handle;
+        size_t _block_index = 0;
+        BlockSpillReaderUPtr _spill_reader;
+    };
+
+    // Gathers the results of the scanners that split the scan of a rowset by segments and
+    // key ranges, the result on the rowset is cached when the results of all the parts are
+    // added. Nothing is cached if any part is aborted.
+    class RowsetResultParts {
+    public:
+        RowsetResultParts(std::string prefix, const RowsetId& rowset_id, size_t num_parts)
+                : _prefix(std::move(prefix)), _rowset_id(rowset_id), _parts(num_parts) {}
+
+        void add(size_t part_id, std::vector<Block>&& blocks, size_t bytes,
+                 RuntimeProfile* profile);
+
+        // The scanner of a part stopped before its eof or its result was too large.
+        void abort();
+
+    private:
+        std::mutex _lock;
+        const std::string _prefix;
+        const RowsetId _rowset_id;
+        std::vector<std::vector<Block>> _parts;
+        size_t _num_added = 0;
+        size_t _bytes = 0;
+        bool _aborted = false;
+    };
+
+    static ScanResultCache* instance() { return _s_instance; }
+
+    static void create_global_instance(size_t capacity);
+
+    // Return nullptr if the result of the key is not cached.
+    std::unique_ptr<Reader> lookup(const std::string& key, RuntimeProfile* profile);
+
+    // Cache all the output blocks of a scan, `bytes` is the allocated bytes of the blocks.
+    Status insert(const std::string& key, std::vector<Block>&& blocks, size_t bytes,
+                  RuntimeProfile* profile);
+
+    // The key of the result of the scan identified by `prefix` on a rowset.
+    static std::string rowset_key(const std::string& prefix, const RowsetId& rowset_id);
+
+    // Cache the result of the scan identified by `prefix` on a rowset.
+    Status insert_rowset_result(const std::string& prefix, const RowsetId& rowset_id,
+                                std::vector<Block>&& blocks, size_t bytes,
+                                RuntimeProfile* profile);
+
+    // Cache the results of the scans on all the input rowsets of a compaction as the results
+    // on the output rowset. The rowsets must be of a duplicate key tablet without delete
+    // predicates, whose output rowset has exactly the rows of the input rowsets.
+    void carry_over_rowset_results(const std::vector<RowsetSharedPtr>& input_rowsets,
+                                   const RowsetSharedPtr& output_rowset,
+                                   RuntimeProfile* profile);
+
+    // The max bytes of a result that can be cached now, bounded by
+    // config::scan_result_cache_max_entry_bytes, the capacity of the cache and the free disk
+    // capacity for spilling.
+    size_t max_entry_bytes() const;
+
+    // Copy the columns of the block into `blocks` to cache them later, the temporary
+    // columns are skipped. Return false and free the copied blocks if `bytes` exceeds
+    // max_entry_bytes(), the result should not be cached and no more blocks are copied.
+    bool collect_block(const Block& block, std::vector<Block>* blocks, size_t* bytes);
+
+    int64_t spilled_bytes() const { return _spilled_bytes.load(std::memory_order_relaxed); }
+
+private:
+    struct CacheValue : public LRUCacheValueBase {
+        ~CacheValue();
+
+        // the blocks of the result if it is in memory
+        std::vector<Block> blocks;
+        // the spill stream of the result, -1 if the result is in memory
+        int64_t spill_stream_id = -1;
+        std::string spill_path;
+        size_t spill_bytes = 0;
+        std::atomic<int64_t>* total_spilled_bytes = nullptr;
+        // set if this is the result on a rowset
+        ScanResultCache* cache = nullptr;
+        std::string rowset_id;
+        std::string prefix;
+    };
+
+    ScanResultCache(size_t capacity);
+
+    Status _spill(std::vector<Block>& blocks, RuntimeProfile* profile, CacheValue* value);
+
+    Status _insert(const std::string& key, std::vector<Block>&& blocks, size_t bytes,
+                   RuntimeProfile* profile, std::unique_ptr<CacheValue> value);
+
+    void _remove_rowset_prefix(const std::string& rowset_id, const std::string& prefix);
+
+    static ScanResultCache* _s_instance;
+
+    std::atomic<int64_t> _spilled_bytes = 0;
+
+    std::mutex _rowset_lock;
+    // rowset id -> the prefixes of the cached results on the rowset and their entry counts,
+    // to find the results to carry over in compactions
+    std::unordered_map<std::string, std::map<std::string, int>> _rowset_prefixes;
+};
+
+} // namespace doris::vectorized
@@ -39,6 +39,7 @@
 #include "common/logging.h"
 #include "common/object_pool.h"
 #include "io/cache/block/block_file_cache_profile.h"
+#include "io/fs/split_pipe_reader.h"
 #include "runtime/descriptors.h"
 #include "runtime/runtime_state.h"
 #include "runtime/types.h"
@@ -339,23 +340,30 @@ Status VFileScanner::_cast_to_input_block(Block* block) {
             // skip variant type
             continue;
         }
-        auto& arg = _src_block_ptr->get_by_name(slot_desc->col_name());
-        auto return_type = slot_desc->get_data_type_ptr();
-        // remove nullable here, let the get_function decide whether nullable
-        auto data_type = vectorized::DataTypeFactory::instance().create_data_type(
-                remove_nullable(return_type)->get_type_id());
-        ColumnsWithTypeAndName arguments {
-                arg, {data_type->create_column(), data_type, slot_desc->col_name()}};
-        auto func_cast =
-                SimpleFunctionFactory::instance().get_function("CAST", arguments, return_type);
         idx = _src_block_name_to_idx[slot_desc->col_name()];
-        RETURN_IF_ERROR(
-                func_cast->execute(nullptr, *_src_block_ptr, {idx}, idx, arg.column->size()));
-        _src_block_ptr->get_by_position(idx).type = std::move(return_type);
+        RETURN_IF_ERROR(cast_to_input_column(_src_block_ptr, idx, slot_desc->get_data_type_ptr()));
     }
     return Status::OK();
 }
 
+Status VFileScanner::cast_to_input_column(Block* block, size_t idx,
+                                          const DataTypePtr& return_type) {
+    auto& arg = block->get_by_position(idx);
+    if (is_string(remove_nullable(arg.type)) && arg.type->equals(*return_type)) {
+        // the reader has already materialized the strings with the expected type,
+        // eg. varchar columns of csv, no need to cast
+        return Status::OK();
+    }
+    // remove nullable here, let the get_function decide whether nullable
+    auto data_type = vectorized::DataTypeFactory::instance().create_data_type(
+            remove_nullable(return_type)->get_type_id());
+    ColumnsWithTypeAndName arguments {arg, {data_type->create_column(), data_type, arg.name}};
+    auto func_cast = SimpleFunctionFactory::instance().get_function("CAST", arguments, return_type);
+    RETURN_IF_ERROR(func_cast->execute(nullptr, *block, {idx}, idx, arg.column->size()));
+    block->get_by_position(idx).type = return_type;
+    return Status::OK();
+}
+
 Status VFileScanner::_fill_columns_from_path(size_t rows) {
     for (auto& kv : *_partition_columns) {
         auto doris_column = _src_block_ptr->get_by_name(kv.first).column;
@@ -673,6 +681,11 @@ Status VFileScanner::_get_next_reader() {
         case TFileFormatType::FORMAT_PROTO: {
             _cur_reader = CsvReader::create_unique(_state, _profile, &_counter, *_params, range,
                                                    _file_slot_descs, _io_ctx.get());
+            if (_pipe_splitter != nullptr) {
+                ((CsvReader*)(_cur_reader.get()))
+                        ->set_pipe_reader(std::make_shared<io::SplitPipeReader>(_pipe_splitter,
+                                                                                _parser_profile));
+            }
             init_status = ((CsvReader*)(_cur_reader.get()))->init_reader(_is_load);
             break;
         }
@@ -680,6 +693,11 @@ Status VFileScanner::_get_next_reader() {
             _cur_reader = NewJsonReader::create_unique(_state, _profile, &_counter, *_params, range,
                                                        _file_slot_descs, &_scanner_eof,
                                                        _io_ctx.get(), _is_dynamic_schema);
+            if (_pipe_splitter != nullptr) {
+                ((NewJsonReader*)(_cur_reader.get()))
+                        ->set_pipe_reader(std::make_shared<io::SplitPipeReader>(_pipe_splitter,
+                                                                                _parser_profile));
+            }
             init_status =
                     ((NewJsonReader*)(_cur_reader.get()))->init_reader(_col_default_value_ctx);
             break;
@@ -913,6 +931,10 @@ Status VFileScanner::close(RuntimeState* state) {
         cache_profile.update(_file_cache_statistics.get());
     }
 
+    if (_parser_profile != nullptr) {
+        COUNTER_UPDATE(ADD_COUNTER(_parser_profile, "RowsRead", TUnit::UNIT), _num_rows_read);
+    }
+
     RETURN_IF_ERROR(VScanner::close(state));
     return Status::OK();
 }
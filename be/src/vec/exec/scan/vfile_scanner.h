@@ -24,6 +24,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "common/factory_creator.h"
@@ -45,6 +46,10 @@ class TFileRangeDesc;
 class TFileScanRange;
 class TFileScanRangeParams;
 
+namespace io {
+class PipeSplitter;
+} // namespace io
+
 namespace vectorized {
 class ShardedKVCache;
 class VExpr;
@@ -79,6 +84,20 @@ public:
 
     std::string get_current_scan_range_name() override { return _current_range_path; }
 
+    // Cast the column at `idx` of the source block to the type of its input slot. Only the
+    // string columns of the same type are not cast, the others take the precision and the
+    // scale of the slot even if their types are equal.
+    static Status cast_to_input_column(Block* block, size_t idx, const DataTypePtr& return_type);
+
+    // Read the chunks split from the stream load pipe, the scanner is one of the
+    // scanners parsing the same stream in parallel. parser_profile saves the
+    // counters of this scanner.
+    void set_pipe_splitter(std::shared_ptr<io::PipeSplitter> pipe_splitter,
+                           RuntimeProfile* parser_profile) {
+        _pipe_splitter = std::move(pipe_splitter);
+        _parser_profile = parser_profile;
+    }
+
 protected:
     Status _get_block_impl(RuntimeState* state, Block* block, bool* eof) override;
 
@@ -160,6 +179,9 @@ protected:
             _partition_columns;
     std::unique_ptr<std::unordered_map<std::string, VExprContextSPtr>> _missing_columns;
 
+    std::shared_ptr<io::PipeSplitter> _pipe_splitter;
+    RuntimeProfile* _parser_profile = nullptr;
+
 private:
     RuntimeProfile::Counter* _get_block_timer = nullptr;
     RuntimeProfile::Counter* _open_reader_timer = nullptr;
@@ -59,6 +59,7 @@
 #include "vec/exprs/vexpr.h"
 #include "vec/exprs/vexpr_context.h"
 #include "vec/exprs/vin_predicate.h"
+#include "vec/exprs/vshared_expr.h"
 #include "vec/exprs/vslot_ref.h"
 #include "vec/functions/in.h"
 #include "vec/runtime/vdatetime_value.h"
@@ -183,6 +184,10 @@ Status VScanNode::alloc_resource(RuntimeState* state) {
     RETURN_IF_ERROR(ExecNode::alloc_resource(state));
     RETURN_IF_ERROR(_acquire_runtime_filter());
     RETURN_IF_ERROR(_process_conjuncts());
+    // after the conjuncts are pushed down, the rest are evaluated by the scanners
+    if (config::enable_shared_common_exprs) {
+        _num_shared_expr_results = VSharedExpr::share_common_exprs(_conjuncts);
+    }
 
     if (_is_pipeline_scan) {
         if (_should_create_scanner) {
@@ -253,10 +258,41 @@ Status VScanNode::get_next(RuntimeState* state, vectorized::Block* block, bool*
         return Status::OK();
     }
 
+    if (_result_cache_reader) {
+        RETURN_IF_ERROR(_result_cache_reader->read(block, eos));
+        if (*eos) {
+            _eos = true;
+            return Status::OK();
+        }
+        reached_limit(block, eos);
+        return Status::OK();
+    }
+
+    // the cached results of the rowsets are read before the blocks of the scanners
+    while (!_rowset_cache_readers.empty()) {
+        RETURN_IF_ERROR(_rowset_cache_readers.front()->read(block, eos));
+        if (!*eos) {
+            reached_limit(block, eos);
+            if (*eos && _scanner_ctx) {
+                _scanner_ctx->set_should_stop();
+            }
+            return Status::OK();
+        }
+        _rowset_cache_readers.pop_front();
+        *eos = false;
+        if (_rowset_cache_readers.empty() && !_scanner_ctx) {
+            // all the rowsets are cached
+            _eos = true;
+            *eos = true;
+            return Status::OK();
+        }
+    }
+
     vectorized::BlockUPtr scan_block = nullptr;
     RETURN_IF_ERROR(_scanner_ctx->get_block_from_queue(state, &scan_block, eos, _context_queue_id));
     if (*eos) {
         DCHECK(scan_block == nullptr);
+        _insert_result_cache();
         return Status::OK();
     }
 
@@ -264,6 +300,9 @@ Status VScanNode::get_next(RuntimeState* state, vectorized::Block* block, bool*
     block->swap(*scan_block);
     _scanner_ctx->return_free_block(std::move(scan_block));
 
+    if (!_result_cache_key.empty()) {
+        _collect_result_cache_block(*block);
+    }
     reached_limit(block, eos);
     if (*eos) {
         // reach limit, stop the scanners.
@@ -273,9 +312,34 @@ Status VScanNode::get_next(RuntimeState* state, vectorized::Block* block, bool*
     return Status::OK();
 }
 
+void VScanNode::_collect_result_cache_block(const Block& block) {
+    if (!ScanResultCache::instance()->collect_block(block, &_result_cache_blocks,
+                                                    &_result_cache_bytes)) {
+        // too large to cache
+        _result_cache_key.clear();
+    }
+}
+
+void VScanNode::_insert_result_cache() {
+    if (_result_cache_key.empty() || _state->is_cancelled()) {
+        return;
+    }
+    auto st = ScanResultCache::instance()->insert(_result_cache_key,
+                                                  std::move(_result_cache_blocks),
+                                                  _result_cache_bytes, _runtime_profile.get());
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to cache the result of scan node " << id() << ": " << st;
+    }
+    _result_cache_key.clear();
+    _result_cache_blocks.clear();
+}
+
 Status VScanNode::_init_profile() {
     // 1. counters for scan node
     _rows_read_counter = ADD_COUNTER(_runtime_profile, "RowsRead", TUnit::UNIT);
+    _result_cache_hit_counter = ADD_COUNTER(_runtime_profile, "ResultCacheHit", TUnit::UNIT);
+    _rowset_result_cache_hit_counter =
+            ADD_COUNTER(_runtime_profile, "RowsetResultCacheHit", TUnit::UNIT);
     _total_throughput_counter =
             runtime_profile()->add_rate_counter("TotalReadThroughput", _rows_read_counter);
     _num_scanners = ADD_COUNTER(_runtime_profile, "NumScanners", TUnit::UNIT);
@@ -1281,10 +1345,24 @@ VScanNode::PushDownType VScanNode::_should_push_down_in_predicate(VInPredicate*
 }
 
 Status VScanNode::_prepare_scanners(const int query_parallel_instance_num) {
+    // the instances sharing the scanners read a part of the result each
+    if (ScanResultCache::instance() != nullptr && !_shared_scan_opt) {
+        std::string key = _get_result_cache_key();
+        if (!key.empty()) {
+            _result_cache_reader =
+                    ScanResultCache::instance()->lookup(key, _runtime_profile.get());
+            if (_result_cache_reader) {
+                COUNTER_UPDATE(_result_cache_hit_counter, 1);
+                return Status::OK();
+            }
+            _result_cache_key = std::move(key);
+        }
+    }
+
     std::list<VScannerSPtr> scanners;
     RETURN_IF_ERROR(_init_scanners(&scanners));
     if (scanners.empty()) {
-        _eos = true;
+        _eos = _rowset_cache_readers.empty();
     } else {
         COUNTER_SET(_num_scanners, static_cast<int64_t>(scanners.size()));
         RETURN_IF_ERROR(_start_scanners(scanners, query_parallel_instance_num));
@@ -44,6 +44,7 @@
 #include "util/lock.h"
 #include "util/runtime_profile.h"
 #include "vec/exec/runtime_filter_consumer.h"
+#include "vec/exec/scan/scan_result_cache.h"
 #include "vec/exec/scan/scanner_context.h"
 #include "vec/exec/scan/vscanner.h"
 #include "vec/runtime/shared_scanner_controller.h"
@@ -147,6 +148,9 @@ public:
 
     int runtime_filter_num() const { return (int)_runtime_filter_ctxs.size(); }
 
+    // The number of the results of the subexprs shared by the conjuncts, see VSharedExpr.
+    size_t num_shared_expr_results() const { return _num_shared_expr_results; }
+
     TupleId input_tuple_id() const { return _input_tuple_id; }
     TupleId output_tuple_id() const { return _output_tuple_id; }
     const TupleDescriptor* input_tuple_desc() const { return _input_tuple_desc; }
@@ -237,6 +241,10 @@ protected:
     // Only predicate on key column can be pushed down.
     virtual bool _is_key_column(const std::string& col_name) { return false; }
 
+    // Return the key of the result of this scan in ScanResultCache,
+    // empty if the result can't be cached.
+    virtual std::string _get_result_cache_key() { return ""; }
+
     Status _prepare_scanners(const int query_parallel_instance_num);
 
     bool _is_pipeline_scan = false;
@@ -262,6 +270,7 @@ protected:
     // indicate this scan node has no more data to return
     bool _eos = false;
     bool _opened = false;
+    size_t _num_shared_expr_results = 0;
 
     FilterPredicates _filter_predicates {};
 
@@ -354,7 +363,21 @@ protected:
 
     TPushAggOp::type _push_down_agg_type;
 
+    // Set if the result of this scan is read from ScanResultCache instead of scanners.
+    std::unique_ptr<ScanResultCache::Reader> _result_cache_reader;
+    // The key to cache the result of this scan with, empty if the result is not to be cached.
+    std::string _result_cache_key;
+    std::vector<Block> _result_cache_blocks;
+    size_t _result_cache_bytes = 0;
+    RuntimeProfile::Counter* _result_cache_hit_counter = nullptr;
+    // The cached results of the rowsets which are not read by the scanners.
+    std::list<std::unique_ptr<ScanResultCache::Reader>> _rowset_cache_readers;
+    RuntimeProfile::Counter* _rowset_result_cache_hit_counter = nullptr;
+
 private:
+    void _collect_result_cache_block(const Block& block);
+    void _insert_result_cache();
+
     Status _normalize_conjuncts();
     Status _normalize_predicate(const VExprSPtr& conjunct_expr_root, VExprContext* context,
                                 VExprSPtr& output_expr);
@@ -23,6 +23,7 @@
 #include "runtime/descriptors.h"
 #include "util/runtime_profile.h"
 #include "vec/core/column_with_type_and_name.h"
+#include "vec/exec/scan/scan_result_cache.h"
 #include "vec/exec/scan/vscan_node.h"
 #include "vec/exprs/vexpr_context.h"
 
@@ -47,6 +48,10 @@ Status VScanner::prepare(RuntimeState* state, const VExprContextSPtrs& conjuncts
             RETURN_IF_ERROR(conjuncts[i]->clone(state, _conjuncts[i]));
         }
     }
+    if (size_t num_results = _parent->num_shared_expr_results()) {
+        _shared_expr_results = std::make_unique<VSharedExprResults>(num_results);
+        _shared_expr_results->attach_to(_conjuncts);
+    }
 
     return Status::OK();
 }
@@ -79,6 +84,10 @@ Status VScanner::get_block(RuntimeState* state, Block* block, bool* eof) {
                 RETURN_IF_ERROR(_get_block_impl(state, block, eof));
                 if (*eof) {
                     DCHECK(block->rows() == 0);
+                    if (_collect_result_cache && !state->is_cancelled()) {
+                        _insert_result_cache();
+                    }
+                    _collect_result_cache = false;
                     break;
                 }
                 _num_rows_read += block->rows();
@@ -89,6 +98,10 @@ Status VScanner::get_block(RuntimeState* state, Block* block, bool* eof) {
                 SCOPED_TIMER(_parent->_filter_timer);
                 RETURN_IF_ERROR(_filter_output_block(block));
             }
+            if (_collect_result_cache && block->rows() > 0) {
+                _collect_result_cache = ScanResultCache::instance()->collect_block(
+                        *block, &_result_cache_blocks, &_result_cache_bytes);
+            }
             // record rows return (after filter) for _limit check
             _num_rows_return += block->rows();
         } while (!state->is_cancelled() && block->rows() == 0 && !(*eof) &&
@@ -114,6 +127,9 @@ Status VScanner::_filter_output_block(Block* block) {
         return Status::OK();
     }
     auto old_rows = block->rows();
+    if (_shared_expr_results) {
+        _shared_expr_results->reset(block);
+    }
     Status st = VExprContext::filter_block(_conjuncts, block, block->columns());
     _counter.num_rows_unselected += old_rows - block->rows();
     return st;
@@ -141,6 +157,9 @@ Status VScanner::try_append_late_arrival_runtime_filter() {
     // Notice that the number of runtime filters may be larger than _applied_rf_num.
     // But it is ok because it will be updated at next time.
     RETURN_IF_ERROR(_parent->clone_conjunct_ctxs(_conjuncts));
+    if (_shared_expr_results) {
+        _shared_expr_results->attach_to(_conjuncts);
+    }
     _applied_rf_num = arrived_rf_num;
     return Status::OK();
 }
@@ -151,6 +170,10 @@ Status VScanner::close(RuntimeState* state) {
     }
 
     COUNTER_UPDATE(_parent->_scanner_wait_worker_timer, _scanner_wait_worker_timer);
+    auto conjuncts_info = VExprContext::conjuncts_stats_string(_conjuncts);
+    if (!conjuncts_info.empty()) {
+        _parent->_runtime_profile->add_info_string("ConjunctsOrder", conjuncts_info);
+    }
     _is_closed = true;
     return Status::OK();
 }
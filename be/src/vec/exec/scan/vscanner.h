@@ -28,6 +28,7 @@
 #include "runtime/runtime_state.h"
 #include "util/stopwatch.hpp"
 #include "vec/core/block.h"
+#include "vec/exprs/vshared_expr.h"
 
 namespace doris {
 class RuntimeProfile;
@@ -80,6 +81,9 @@ protected:
     // Filter the output block finally.
     Status _filter_output_block(Block* block);
 
+    // Insert the collected output blocks into ScanResultCache after all the blocks are read.
+    virtual void _insert_result_cache() {}
+
     // Not virtual, all child will call this method explictly
     Status prepare(RuntimeState* state, const VExprContextSPtrs& conjuncts);
 
@@ -184,6 +188,8 @@ protected:
     // Cloned from _conjuncts of scan node.
     // It includes predicate in SQL and runtime filters.
     VExprContextSPtrs _conjuncts;
+    // The results of the subexprs shared by the conjuncts.
+    std::unique_ptr<VSharedExprResults> _shared_expr_results;
 
     VExprContextSPtrs _common_expr_ctxs_push_down;
     // Late arriving runtime filters will update _conjuncts.
@@ -208,6 +214,10 @@ protected:
     int64_t _scan_cpu_timer = 0;
 
     bool _is_load = false;
+    // Set if the output blocks are collected to be cached in ScanResultCache.
+    bool _collect_result_cache = false;
+    std::vector<Block> _result_cache_blocks;
+    size_t _result_cache_bytes = 0;
     // set to true after decrease the "_num_unfinished_scanners" in scanner context
     bool _is_counted_down = false;
 
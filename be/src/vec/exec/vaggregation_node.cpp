@@ -21,21 +21,26 @@
 #include <gen_cpp/Exprs_types.h>
 #include <gen_cpp/Metrics_types.h>
 #include <gen_cpp/PlanNodes_types.h>
+#include <gen_cpp/Types_types.h>
 #include <opentelemetry/nostd/shared_ptr.h>
+#include <string.h>
 
 #include <array>
 #include <atomic>
 #include <memory>
 #include <string>
+#include <unordered_set>
 
 #include "exec/exec_node.h"
 #include "runtime/block_spill_manager.h"
 #include "runtime/define_primitive_type.h"
 #include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
 #include "runtime/memory/mem_tracker.h"
 #include "runtime/runtime_state.h"
 #include "runtime/thread_context.h"
 #include "util/telemetry/telemetry.h"
+#include "util/threadpool.h"
 #include "vec/common/hash_table/hash_table_key_holder.h"
 #include "vec/common/hash_table/hash_table_utils.h"
 #include "vec/common/hash_table/string_hash_table.h"
@@ -58,6 +63,30 @@ namespace doris::vectorized {
 // Here is an empirical value.
 static constexpr size_t HASH_MAP_PREFETCH_DIST = 16;
 
+// The max size of a state created by copying the template, e.g. the sum of decimal256 or the
+// min/max of a 128 bit value with its flag, the larger states are created by their functions.
+static constexpr size_t MAX_FIXED_SIZE_STATE_BYTES = 32;
+
+// count/sum/min/max of fixed width values, whose states are a few bytes of plain data and can
+// be created by copying a created state. The states stay in the rows of the aggregate data
+// container like the others instead of the cells of the hash tables, which the spilling and
+// the serialization of the states rely on.
+static bool is_fixed_size_state(AggFnEvaluator* evaluator) {
+    static const std::unordered_set<std::string> FIXED_SIZE_STATE_FUNCTIONS = {"count", "sum",
+                                                                               "min", "max"};
+    const auto& function = evaluator->function();
+    if (evaluator->fn().binary_type != TFunctionBinaryType::BUILTIN ||
+        FIXED_SIZE_STATE_FUNCTIONS.count(function->get_name()) == 0 ||
+        !function->has_trivial_destructor() ||
+        function->size_of_data() > MAX_FIXED_SIZE_STATE_BYTES) {
+        return false;
+    }
+    const auto& argument_types = function->get_argument_types();
+    return std::all_of(argument_types.begin(), argument_types.end(), [](const auto& type) {
+        return remove_nullable(type)->have_maximum_size_of_value();
+    });
+}
+
 /// The minimum reduction factor (input rows divided by output rows) to grow hash tables
 /// in a streaming preaggregation, given that the hash tables are currently the given
 /// size or above. The sizes roughly correspond to hash table sizes where the bucket
@@ -125,6 +154,7 @@ AggregationNode::AggregationNode(ObjectPool* pool, const TPlanNode& tnode,
           _insert_keys_to_column_timer(nullptr),
           _streaming_agg_timer(nullptr),
           _hash_table_size_counter(nullptr),
+          _string_key_dict_size_counter(nullptr),
           _max_row_size_counter(nullptr) {
     if (tnode.agg_node.__isset.use_streaming_preaggregation) {
         _is_streaming_preagg = tnode.agg_node.use_streaming_preaggregation;
@@ -183,8 +213,49 @@ Status AggregationNode::init(const TPlanNode& tnode, RuntimeState* state) {
     return Status::OK();
 }
 
+void AggregationNode::_init_string_key_dicts(const VExprContextSPtrs& probe_exprs) {
+    _string_key_dicts.clear();
+    _has_string_key_dicts = false;
+    // a single string key is hashed by the string key hash table, which costs less than the
+    // dictionary lookup plus the fixed key hash table, the codes only pay off if they turn the
+    // serialized keys of multiple columns into fixed size keys
+    if (_string_key_dicts_checked || config::agg_string_key_dict_max_ratio <= 0 ||
+        probe_exprs.size() < 2) {
+        return;
+    }
+    size_t key_byte_size = 0;
+    std::vector<std::unique_ptr<StringKeyDictionary>> dicts;
+    for (const auto& ctx : probe_exprs) {
+        std::unique_ptr<StringKeyDictionary> dict;
+        const auto& data_type = ctx->root()->data_type();
+        switch (ctx->root()->result_type()) {
+        case TYPE_CHAR:
+        case TYPE_VARCHAR:
+        case TYPE_STRING:
+            dict = std::make_unique<StringKeyDictionary>();
+            key_byte_size += sizeof(UInt32);
+            break;
+        default:
+            if (!data_type->have_maximum_size_of_value()) {
+                return;
+            }
+            key_byte_size += data_type->get_maximum_size_of_value_in_memory() -
+                             (data_type->is_nullable() ? 1 : 0);
+            break;
+        }
+        _has_string_key_dicts |= dict != nullptr;
+        dicts.push_back(std::move(dict));
+    }
+    if (std::tuple_size<KeysNullMap<UInt256>>::value + key_byte_size > sizeof(UInt256)) {
+        _has_string_key_dicts = false;
+        return;
+    }
+    _string_key_dicts = std::move(dicts);
+}
+
 void AggregationNode::_init_hash_method(const VExprContextSPtrs& probe_exprs) {
     DCHECK(probe_exprs.size() >= 1);
+    _init_string_key_dicts(probe_exprs);
     if (probe_exprs.size() == 1) {
         auto is_nullable = probe_exprs[0]->root()->is_nullable();
         switch (probe_exprs[0]->root()->result_type()) {
@@ -267,6 +338,13 @@ void AggregationNode::_init_hash_method(const VExprContextSPtrs& probe_exprs) {
             const auto& expr = _probe_expr_ctxs[i]->root();
             const auto& data_type = expr->data_type();
 
+            if (_has_string_key_dicts && _string_key_dicts[i]) {
+                has_null |= data_type->is_nullable();
+                _probe_key_sz[i] = sizeof(UInt32);
+                key_byte_size += _probe_key_sz[i];
+                continue;
+            }
+
             if (!data_type->have_maximum_size_of_value()) {
                 use_fixed_key = false;
                 break;
@@ -347,6 +425,8 @@ Status AggregationNode::prepare_profile(RuntimeState* state) {
     _insert_keys_to_column_timer = ADD_TIMER(runtime_profile(), "InsertKeysToColumnTime");
     _streaming_agg_timer = ADD_TIMER(runtime_profile(), "StreamingAggTime");
     _hash_table_size_counter = ADD_COUNTER(runtime_profile(), "HashTableSize", TUnit::UNIT);
+    _string_key_dict_size_counter =
+            ADD_COUNTER(runtime_profile(), "StringKeyDictSize", TUnit::UNIT);
     _hash_table_input_counter = ADD_COUNTER(runtime_profile(), "HashTableInputCount", TUnit::UNIT);
     _max_row_size_counter = ADD_COUNTER(runtime_profile(), "MaxRowSizeInBytes", TUnit::UNIT);
     COUNTER_SET(_max_row_size_counter, (int64_t)0);
@@ -380,18 +460,40 @@ Status AggregationNode::prepare_profile(RuntimeState* state) {
 
     _offsets_of_aggregate_states.resize(_aggregate_evaluators.size());
 
+    // the fixed size states come first, the ones with larger alignment before the others to
+    // leave less padding between them
+    std::vector<size_t> layout_order;
     for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
+        if (is_fixed_size_state(_aggregate_evaluators[i])) {
+            layout_order.push_back(i);
+        } else {
+            _non_fixed_state_evaluators.push_back(i);
+        }
+    }
+    std::stable_sort(layout_order.begin(), layout_order.end(), [&](size_t lhs, size_t rhs) {
+        return _aggregate_evaluators[lhs]->function()->align_of_data() >
+               _aggregate_evaluators[rhs]->function()->align_of_data();
+    });
+    const size_t num_fixed_states = layout_order.size();
+    layout_order.insert(layout_order.end(), _non_fixed_state_evaluators.begin(),
+                        _non_fixed_state_evaluators.end());
+
+    for (size_t k = 0; k < layout_order.size(); ++k) {
+        size_t i = layout_order[k];
         _offsets_of_aggregate_states[i] = _total_size_of_aggregate_states;
 
         const auto& agg_function = _aggregate_evaluators[i]->function();
         // aggreate states are aligned based on maximum requirement
         _align_aggregate_states = std::max(_align_aggregate_states, agg_function->align_of_data());
         _total_size_of_aggregate_states += agg_function->size_of_data();
+        if (k + 1 == num_fixed_states) {
+            _size_of_fixed_states = _total_size_of_aggregate_states;
+        }
 
         // If not the last aggregate_state, we need pad it so that next aggregate_state will be aligned.
-        if (i + 1 < _aggregate_evaluators.size()) {
+        if (k + 1 < layout_order.size()) {
             size_t alignment_of_next_state =
-                    _aggregate_evaluators[i + 1]->function()->align_of_data();
+                    _aggregate_evaluators[layout_order[k + 1]]->function()->align_of_data();
             if ((alignment_of_next_state & (alignment_of_next_state - 1)) != 0) {
                 return Status::RuntimeError("Logical error: align_of_data is not 2^N");
             }
@@ -404,6 +506,17 @@ Status AggregationNode::prepare_profile(RuntimeState* state) {
         }
     }
 
+    if (_size_of_fixed_states > 0) {
+        _fixed_states_template =
+                _agg_profile_arena->aligned_alloc(_size_of_fixed_states, _align_aggregate_states);
+        memset(_fixed_states_template, 0, _size_of_fixed_states);
+        for (size_t k = 0; k < num_fixed_states; ++k) {
+            size_t i = layout_order[k];
+            _aggregate_evaluators[i]->create(_fixed_states_template +
+                                             _offsets_of_aggregate_states[i]);
+        }
+    }
+
     if (_probe_expr_ctxs.empty()) {
         _agg_data->init(AggregatedDataVariants::Type::without_key);
 
@@ -495,6 +608,19 @@ Status AggregationNode::prepare(RuntimeState* state) {
 
     RETURN_IF_ERROR(ExecNode::prepare(state));
     RETURN_IF_ERROR(prepare_profile(state));
+    if (config::enable_shared_common_exprs) {
+        // the group by exprs and the arguments of the agg functions are evaluated on the same
+        // input block
+        VExprContextSPtrs ctxs = _probe_expr_ctxs;
+        for (auto* evaluator : _aggregate_evaluators) {
+            const auto& input_ctxs = evaluator->input_exprs_ctxs();
+            ctxs.insert(ctxs.end(), input_ctxs.begin(), input_ctxs.end());
+        }
+        if (size_t num_results = VSharedExpr::share_common_exprs(ctxs)) {
+            _shared_expr_results = std::make_unique<VSharedExprResults>(num_results);
+            _shared_expr_results->attach_to(ctxs);
+        }
+    }
     return Status::OK();
 }
 
@@ -546,6 +672,9 @@ Status AggregationNode::open(RuntimeState* state) {
 
 Status AggregationNode::do_pre_agg(vectorized::Block* input_block,
                                    vectorized::Block* output_block) {
+    if (_shared_expr_results) {
+        _shared_expr_results->reset(input_block);
+    }
     RETURN_IF_ERROR(_executor.pre_agg(input_block, output_block));
 
     // pre stream agg need use _num_row_return to decide whether to do pre stream agg
@@ -595,6 +724,9 @@ Status AggregationNode::pull(doris::RuntimeState* state, vectorized::Block* bloc
 
 Status AggregationNode::sink(doris::RuntimeState* state, vectorized::Block* in_block, bool eos) {
     if (in_block->rows() > 0) {
+        if (_shared_expr_results) {
+            _shared_expr_results->reset(in_block);
+        }
         RETURN_IF_ERROR(_executor.execute(in_block));
         RETURN_IF_ERROR(_try_spill_disk());
         _executor.update_memusage();
@@ -620,6 +752,13 @@ void AggregationNode::release_resource(RuntimeState* state) {
                     COUNTER_SET(_hash_table_size_counter, int64_t(agg_method.data.size()));
                 },
                 _agg_data->_aggregated_method_variant);
+        int64_t dict_size = 0;
+        for (const auto& dict : _string_key_dicts) {
+            if (dict) {
+                dict_size = std::max(dict_size, int64_t(dict->size()));
+            }
+        }
+        COUNTER_SET(_string_key_dict_size_counter, dict_size);
     }
     _release_mem();
     ExecNode::release_resource(state);
@@ -631,12 +770,18 @@ Status AggregationNode::close(RuntimeState* state) {
 }
 
 Status AggregationNode::_create_agg_status(AggregateDataPtr data) {
-    for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+    if (_size_of_fixed_states > 0) {
+        memcpy(data, _fixed_states_template, _size_of_fixed_states);
+    }
+    for (size_t k = 0; k < _non_fixed_state_evaluators.size(); ++k) {
+        size_t i = _non_fixed_state_evaluators[k];
         try {
             _aggregate_evaluators[i]->create(data + _offsets_of_aggregate_states[i]);
         } catch (...) {
-            for (int j = 0; j < i; ++j) {
-                _aggregate_evaluators[j]->destroy(data + _offsets_of_aggregate_states[j]);
+            for (size_t j = 0; j < k; ++j) {
+                size_t created = _non_fixed_state_evaluators[j];
+                _aggregate_evaluators[created]->destroy(data +
+                                                        _offsets_of_aggregate_states[created]);
             }
             throw;
         }
@@ -645,7 +790,8 @@ Status AggregationNode::_create_agg_status(AggregateDataPtr data) {
 }
 
 Status AggregationNode::_destroy_agg_status(AggregateDataPtr data) {
-    for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+    // the fixed size states have trivial destructors
+    for (size_t i : _non_fixed_state_evaluators) {
         _aggregate_evaluators[i]->function()->destroy(data + _offsets_of_aggregate_states[i]);
     }
     return Status::OK();
@@ -875,6 +1021,12 @@ size_t AggregationNode::_memory_usage() const {
         usage += _aggregate_data_container->memory_usage();
     }
 
+    for (const auto& dict : _string_key_dicts) {
+        if (dict) {
+            usage += dict->memory_usage();
+        }
+    }
+
     return usage;
 }
 
@@ -890,12 +1042,14 @@ Status AggregationNode::_reset_hash_table() {
                     agg_method.reset();
                 }
 
-                hash_table.for_each_mapped([&](auto& mapped) {
-                    if (mapped) {
-                        _destroy_agg_status(mapped);
-                        mapped = nullptr;
-                    }
-                });
+                if (!_non_fixed_state_evaluators.empty()) {
+                    hash_table.for_each_mapped([&](auto& mapped) {
+                        if (mapped) {
+                            _destroy_agg_status(mapped);
+                            mapped = nullptr;
+                        }
+                    });
+                }
 
                 _aggregate_data_container.reset(new AggregateDataContainer(
                         sizeof(typename HashTableType::key_type),
@@ -914,8 +1068,69 @@ size_t AggregationNode::_get_hash_table_size() {
                       _agg_data->_aggregated_method_variant);
 }
 
-void AggregationNode::_emplace_into_hash_table(AggregateDataPtr* places, ColumnRawPtrs& key_columns,
+ColumnRawPtrs AggregationNode::_encode_dict_keys(const ColumnRawPtrs& key_columns,
+                                                size_t num_rows) {
+    if (!_has_string_key_dicts) {
+        return key_columns;
+    }
+    _dict_code_columns.resize(key_columns.size());
+    ColumnRawPtrs code_columns(key_columns);
+    for (size_t i = 0; i < key_columns.size(); ++i) {
+        if (_string_key_dicts[i]) {
+            _dict_code_columns[i] = _string_key_dicts[i]->encode(*key_columns[i]);
+            code_columns[i] = _dict_code_columns[i].get();
+        }
+    }
+    if (_string_key_dicts_checked || num_rows == 0) {
+        return code_columns;
+    }
+
+    // nothing is in the hash table yet, so the keys can be aggregated as they are if they
+    // are not of low cardinality
+    _string_key_dicts_checked = true;
+    for (const auto& dict : _string_key_dicts) {
+        if (dict && dict->size() > num_rows * config::agg_string_key_dict_max_ratio) {
+            _dict_code_columns.clear();
+            _init_hash_method(_probe_expr_ctxs);
+            static_cast<void>(_reset_hash_table());
+            return key_columns;
+        }
+    }
+    return code_columns;
+}
+
+MutableColumns AggregationNode::_swap_in_dict_code_columns(MutableColumns& key_columns) {
+    MutableColumns output_columns(key_columns.size());
+    if (!_has_string_key_dicts) {
+        return output_columns;
+    }
+    for (size_t i = 0; i < key_columns.size(); ++i) {
+        if (_string_key_dicts[i]) {
+            output_columns[i] = std::move(key_columns[i]);
+            key_columns[i] = StringKeyDictionary::create_code_column(
+                    _probe_expr_ctxs[i]->root()->data_type()->is_nullable());
+        }
+    }
+    return output_columns;
+}
+
+void AggregationNode::_decode_dict_code_columns(MutableColumns& key_columns,
+                                                MutableColumns& output_columns) {
+    if (!_has_string_key_dicts) {
+        return;
+    }
+    for (size_t i = 0; i < key_columns.size(); ++i) {
+        if (output_columns[i]) {
+            _string_key_dicts[i]->decode(*key_columns[i], *output_columns[i]);
+            key_columns[i] = std::move(output_columns[i]);
+        }
+    }
+}
+
+void AggregationNode::_emplace_into_hash_table(AggregateDataPtr* places,
+                                               ColumnRawPtrs& input_key_columns,
                                                const size_t num_rows) {
+    auto key_columns = _encode_dict_keys(input_key_columns, num_rows);
     std::visit(
             [&](auto&& agg_method) -> void {
                 SCOPED_TIMER(_hash_table_compute_timer);
@@ -998,13 +1213,17 @@ void AggregationNode::_emplace_into_hash_table(AggregateDataPtr* places, ColumnR
 
                     places[i] = mapped;
                     assert(places[i] != nullptr);
+                    // the states are updated after all the rows are emplaced, load the state of
+                    // an existing group meanwhile
+                    __builtin_prefetch(mapped, 1, 1);
                 }
             },
             _agg_data->_aggregated_method_variant);
 }
 
-void AggregationNode::_find_in_hash_table(AggregateDataPtr* places, ColumnRawPtrs& key_columns,
-                                          size_t num_rows) {
+void AggregationNode::_find_in_hash_table(AggregateDataPtr* places,
+                                          ColumnRawPtrs& input_key_columns, size_t num_rows) {
+    auto key_columns = _encode_dict_keys(input_key_columns, num_rows);
     std::visit(
             [&](auto&& agg_method) -> void {
                 using HashMethodType = std::decay_t<decltype(agg_method)>;
@@ -1208,6 +1427,7 @@ Status AggregationNode::_serialize_hash_table_to_block(HashTableCtxType& context
         }
     }
 
+    auto output_key_columns = _swap_in_dict_code_columns(key_columns);
     { context.insert_keys_into_columns(keys, key_columns, num_rows, _probe_key_sz); }
 
     if (hash_table.has_null_key_data()) {
@@ -1221,6 +1441,7 @@ Status AggregationNode::_serialize_hash_table_to_block(HashTableCtxType& context
         _values[num_rows] = hash_table.get_null_key_data();
         ++num_rows;
     }
+    _decode_dict_code_columns(key_columns, output_key_columns);
 
     for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
         _aggregate_evaluators[i]->function()->serialize_to_column(
@@ -1406,8 +1627,112 @@ Status AggregationNode::_get_with_serialized_key_result(RuntimeState* state, Blo
     }
 }
 
+Status AggregationNode::_get_result_in_range(uint32_t begin, size_t num_rows, Block* block) {
+    auto columns_with_schema = VectorizedUtils::create_columns_with_type_and_name(_row_descriptor);
+    int key_size = _probe_expr_ctxs.size();
+    MutableColumns columns;
+    for (const auto& column : columns_with_schema) {
+        columns.emplace_back(column.type->create_column());
+    }
+    MutableColumns key_columns;
+    for (int i = 0; i < key_size; ++i) {
+        key_columns.emplace_back(std::move(columns[i]));
+    }
+
+    std::vector<AggregateDataPtr> values(num_rows);
+    std::visit(
+            [&](auto&& agg_method) -> void {
+                using KeyType = std::decay_t<decltype(agg_method.iterator->get_first())>;
+                std::vector<KeyType> keys(num_rows);
+                AggregateDataContainer::Iterator iter(_aggregate_data_container.get(), begin);
+                for (size_t i = 0; i < num_rows; ++i, ++iter) {
+                    keys[i] = iter.get_key<KeyType>();
+                    values[i] = iter.get_aggregate_data();
+                }
+                auto output_key_columns = _swap_in_dict_code_columns(key_columns);
+                agg_method.insert_keys_into_columns(keys, key_columns, num_rows, _probe_key_sz);
+                _decode_dict_code_columns(key_columns, output_key_columns);
+            },
+            _agg_data->_aggregated_method_variant);
+
+    for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
+        _aggregate_evaluators[i]->insert_result_info_vec(
+                values, _offsets_of_aggregate_states[i], columns[i + key_size].get(), num_rows);
+    }
+    for (int i = 0; i < key_size; ++i) {
+        columns[i] = std::move(key_columns[i]);
+    }
+    *block = columns_with_schema;
+    block->set_columns(std::move(columns));
+    return Status::OK();
+}
+
+Status AggregationNode::_get_result_with_serialized_key_in_parallel(RuntimeState* state) {
+    int parallelism = config::agg_finalize_parallelism;
+    ThreadPool* thread_pool = state->exec_env()->agg_finalize_thread_pool();
+    if (parallelism <= 1 || thread_pool == nullptr) {
+        return Status::OK();
+    }
+    for (auto* evaluator : _aggregate_evaluators) {
+        if (!evaluator->function()->is_insert_result_thread_safe()) {
+            return Status::OK();
+        }
+    }
+    _aggregate_data_container->init_once();
+    auto& iter = _aggregate_data_container->iterator;
+    uint32_t begin = iter.get_index();
+    size_t batch_size = state->batch_size();
+    // only the full batches, the rest and the null key are output by the serial path
+    size_t num_blocks = std::min(size_t(parallelism),
+                                 (_aggregate_data_container->total_count() - begin) / batch_size);
+    if (num_blocks <= 1) {
+        return Status::OK();
+    }
+
+    SCOPED_TIMER(_get_results_timer);
+    std::vector<Block> blocks(num_blocks);
+    std::vector<Status> statuses(num_blocks);
+    // the exceptions thrown by the tasks must not escape the threads of the pool
+    auto get_result = [&](size_t i) -> Status {
+        RETURN_IF_ERROR_OR_CATCH_EXCEPTION(
+                _get_result_in_range(begin + i * batch_size, batch_size, &blocks[i]));
+        return Status::OK();
+    };
+    auto token = thread_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+    for (size_t i = 0; i < num_blocks; ++i) {
+        auto st = token->submit_func([&, i]() {
+            SCOPED_ATTACH_TASK(state);
+            statuses[i] = get_result(i);
+        });
+        if (!st.ok()) {
+            statuses[i] = get_result(i);
+        }
+    }
+    // the tasks reference the local variables, wait them before return
+    token->wait();
+    for (const auto& st : statuses) {
+        RETURN_IF_ERROR(st);
+    }
+
+    iter = AggregateDataContainer::Iterator(_aggregate_data_container.get(),
+                                            begin + num_blocks * batch_size);
+    for (auto& block : blocks) {
+        _finalized_blocks.push_back(std::move(block));
+    }
+    return Status::OK();
+}
+
 Status AggregationNode::_get_result_with_serialized_key_non_spill(RuntimeState* state, Block* block,
                                                                   bool* eos) {
+    if (_finalized_blocks.empty()) {
+        RETURN_IF_ERROR(_get_result_with_serialized_key_in_parallel(state));
+    }
+    if (!_finalized_blocks.empty()) {
+        block->swap(_finalized_blocks.front());
+        _finalized_blocks.pop_front();
+        return Status::OK();
+    }
+
     // non-nullable column(id in `_make_nullable_keys`) will be converted to nullable.
     bool mem_reuse = _make_nullable_keys.empty() && block->mem_reuse();
 
@@ -1458,6 +1783,7 @@ Status AggregationNode::_get_result_with_serialized_key_non_spill(RuntimeState*
                     }
                 }
 
+                auto output_key_columns = _swap_in_dict_code_columns(key_columns);
                 {
                     SCOPED_TIMER(_insert_keys_to_column_timer);
                     agg_method.insert_keys_into_columns(keys, key_columns, num_rows, _probe_key_sz);
@@ -1488,6 +1814,7 @@ Status AggregationNode::_get_result_with_serialized_key_non_spill(RuntimeState*
                         *eos = true;
                     }
                 }
+                _decode_dict_code_columns(key_columns, output_key_columns);
             },
             _agg_data->_aggregated_method_variant);
 
@@ -1585,6 +1912,7 @@ Status AggregationNode::_serialize_with_serialized_key_result_non_spill(RuntimeS
                     }
                 }
 
+                auto output_key_columns = _swap_in_dict_code_columns(key_columns);
                 {
                     SCOPED_TIMER(_insert_keys_to_column_timer);
                     agg_method.insert_keys_into_columns(keys, key_columns, num_rows, _probe_key_sz);
@@ -1606,6 +1934,7 @@ Status AggregationNode::_serialize_with_serialized_key_result_non_spill(RuntimeS
                         *eos = true;
                     }
                 }
+                _decode_dict_code_columns(key_columns, output_key_columns);
 
                 {
                     SCOPED_TIMER(_serialize_data_timer);
@@ -1676,12 +2005,15 @@ void AggregationNode::_close_with_serialized_key() {
     std::visit(
             [&](auto&& agg_method) -> void {
                 auto& data = agg_method.data;
-                data.for_each_mapped([&](auto& mapped) {
-                    if (mapped) {
-                        _destroy_agg_status(mapped);
-                        mapped = nullptr;
-                    }
-                });
+                // nothing to destroy if all the states are of fixed size
+                if (!_non_fixed_state_evaluators.empty()) {
+                    data.for_each_mapped([&](auto& mapped) {
+                        if (mapped) {
+                            _destroy_agg_status(mapped);
+                            mapped = nullptr;
+                        }
+                    });
+                }
                 if (data.has_null_key_data()) {
                     _destroy_agg_status(data.get_null_key_data());
                 }
@@ -1700,6 +2032,7 @@ void AggregationNode::_release_mem() {
     _agg_profile_arena = nullptr;
     _agg_arena_pool = nullptr;
     _preagg_block.clear();
+    _finalized_blocks.clear();
 
     PODArray<AggregateDataPtr> tmp_places;
     _places.swap(tmp_places);
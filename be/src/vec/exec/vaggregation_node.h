@@ -23,6 +23,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <ostream>
@@ -56,6 +57,7 @@
 #include "vec/common/hash_table/ph_hash_map.h"
 #include "vec/common/hash_table/string_hash_map.h"
 #include "vec/common/pod_array.h"
+#include "vec/common/string_key_dictionary.h"
 #include "vec/common/string_ref.h"
 #include "vec/common/uint128.h"
 #include "vec/core/block.h"
@@ -66,6 +68,7 @@
 #include "vec/exprs/vectorized_agg_fn.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/exprs/vexpr_context.h"
+#include "vec/exprs/vshared_expr.h"
 #include "vec/exprs/vslot_ref.h"
 
 namespace doris {
@@ -702,6 +705,8 @@ public:
             index_in_sub_container = index % SUB_CONTAINER_CAPACITY;
         }
 
+        uint32_t get_index() const { return index; }
+
         bool operator==(const IteratorBase& rhs) const { return index == rhs.index; }
         bool operator!=(const IteratorBase& rhs) const { return index != rhs.index; }
 
@@ -746,6 +751,8 @@ public:
     ConstIterator cend() const { return end(); }
     Iterator end() { return Iterator(this, _total_count); }
 
+    uint32_t total_count() const { return _total_count; }
+
     void init_once() {
         if (_inited) {
             return;
@@ -846,10 +853,19 @@ protected:
     ArenaUPtr _agg_arena_pool;
     // group by k1,k2
     VExprContextSPtrs _probe_expr_ctxs;
+    // The results of the subexprs shared by the group by exprs and the agg function arguments.
+    std::unique_ptr<VSharedExprResults> _shared_expr_results;
     AggregatedDataVariantsUPtr _agg_data;
 
     std::vector<size_t> _probe_key_sz;
     std::vector<size_t> _hash_values;
+    // The dictionaries of the string keys, null for the other keys. The low cardinality
+    // string keys are aggregated by their codes, as the fixed size keys.
+    std::vector<std::unique_ptr<StringKeyDictionary>> _string_key_dicts;
+    bool _has_string_key_dicts = false;
+    // the cardinality of the keys is checked on the first block
+    bool _string_key_dicts_checked = false;
+    Columns _dict_code_columns;
     // left / full join will change the key nullable make output/input solt
     // nullable diff. so we need make nullable of it.
     std::vector<size_t> _make_nullable_keys;
@@ -864,6 +880,8 @@ private:
     friend class pipeline::StreamingAggSinkOperator;
     friend class pipeline::AggSourceOperator;
     friend class pipeline::StreamingAggSourceOperator;
+    // exposes the states and the exprs to the unit tests
+    friend class TestAggregationNode;
 
     std::vector<AggFnEvaluator*> _aggregate_evaluators;
     bool _can_short_circuit = false;
@@ -885,6 +903,12 @@ private:
     Sizes _offsets_of_aggregate_states;
     /// The total size of the row from the aggregate functions.
     size_t _total_size_of_aggregate_states = 0;
+    /// The states of count/sum/min/max of fixed width values are packed at the beginning of
+    /// the row, and created by copying the bytes of the template created once. The other
+    /// states follow them and are created and destroyed by their functions.
+    size_t _size_of_fixed_states = 0;
+    AggregateDataPtr _fixed_states_template = nullptr;
+    std::vector<size_t> _non_fixed_state_evaluators;
 
     size_t _external_agg_bytes_threshold;
     size_t _partitioned_threshold = 0;
@@ -903,6 +927,7 @@ private:
     RuntimeProfile::Counter* _insert_keys_to_column_timer;
     RuntimeProfile::Counter* _streaming_agg_timer;
     RuntimeProfile::Counter* _hash_table_size_counter;
+    RuntimeProfile::Counter* _string_key_dict_size_counter;
     RuntimeProfile::Counter* _max_row_size_counter;
     RuntimeProfile::Counter* _memory_usage_counter;
     RuntimeProfile::Counter* _hash_table_memory_usage;
@@ -917,6 +942,8 @@ private:
     std::vector<char> _deserialize_buffer;
     std::vector<AggregateDataPtr> _values;
     std::unique_ptr<AggregateDataContainer> _aggregate_data_container;
+    // the output blocks finalized in parallel, in the order of the container
+    std::deque<Block> _finalized_blocks;
 
     void _release_self_resource(RuntimeState* state);
     /// Return true if we should keep expanding hash tables in the preagg. If false,
@@ -937,6 +964,11 @@ private:
 
     Status _get_with_serialized_key_result(RuntimeState* state, Block* block, bool* eos);
     Status _get_result_with_serialized_key_non_spill(RuntimeState* state, Block* block, bool* eos);
+    // Finalize the next batches of the container concurrently into `_finalized_blocks`, unless
+    // some functions can't insert their results concurrently.
+    Status _get_result_with_serialized_key_in_parallel(RuntimeState* state);
+    // Throws the exceptions of the aggregate functions, the caller catches them.
+    Status _get_result_in_range(uint32_t begin, size_t num_rows, Block* block);
 
     Status _merge_spilt_data();
 
@@ -954,8 +986,16 @@ private:
     void _update_memusage_with_serialized_key();
     void _close_with_serialized_key();
     void _init_hash_method(const VExprContextSPtrs& probe_exprs);
+    void _init_string_key_dicts(const VExprContextSPtrs& probe_exprs);
 
 protected:
+    // Replace the string key columns by their dictionary codes to be hashed.
+    ColumnRawPtrs _encode_dict_keys(const ColumnRawPtrs& key_columns, size_t num_rows);
+    // Replace the output string key columns by the code columns to insert the keys of the
+    // hash table into, and return the output columns, then decode the codes into them.
+    MutableColumns _swap_in_dict_code_columns(MutableColumns& key_columns);
+    void _decode_dict_code_columns(MutableColumns& key_columns, MutableColumns& output_columns);
+
     template <typename AggState, typename AggMethod>
     void _pre_serialize_key_if_need(AggState& state, AggMethod& agg_method,
                                     const ColumnRawPtrs& key_columns, const size_t num_rows) {
@@ -26,8 +26,10 @@
 #include "runtime/runtime_state.h"
 #include "util/runtime_profile.h"
 #include "util/telemetry/telemetry.h"
+#include "common/config.h"
 #include "vec/core/block.h"
 #include "vec/exprs/vexpr_context.h"
+#include "vec/exprs/vshared_expr.h"
 
 namespace doris {
 class DescriptorTbl;
@@ -39,12 +41,24 @@ namespace vectorized {
 VSelectNode::VSelectNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
         : ExecNode(pool, tnode, descs), _child_eos(false) {}
 
+VSelectNode::~VSelectNode() = default;
+
 Status VSelectNode::init(const TPlanNode& tnode, RuntimeState* state) {
     return ExecNode::init(tnode, state);
 }
 
 Status VSelectNode::prepare(RuntimeState* state) {
-    return ExecNode::prepare(state);
+    RETURN_IF_ERROR(ExecNode::prepare(state));
+    if (config::enable_shared_common_exprs) {
+        // the projections are evaluated on the block filtered by the conjuncts
+        VExprContextSPtrs ctxs = _conjuncts;
+        ctxs.insert(ctxs.end(), _projections.begin(), _projections.end());
+        if (size_t num_results = VSharedExpr::share_common_exprs(ctxs)) {
+            _shared_expr_results = std::make_unique<VSharedExprResults>(num_results);
+            _shared_expr_results->attach_to(ctxs);
+        }
+    }
+    return Status::OK();
 }
 
 Status VSelectNode::open(RuntimeState* state) {
@@ -75,6 +89,9 @@ Status VSelectNode::get_next(RuntimeState* state, vectorized::Block* block, bool
 
 Status VSelectNode::pull(RuntimeState* state, vectorized::Block* output_block, bool* eos) {
     RETURN_IF_CANCELLED(state);
+    if (_shared_expr_results) {
+        _shared_expr_results->reset(output_block);
+    }
     RETURN_IF_ERROR(VExprContext::filter_block(_conjuncts, output_block, output_block->columns()));
     reached_limit(output_block, eos);
 
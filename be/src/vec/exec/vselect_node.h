@@ -16,6 +16,8 @@
 // under the License.
 
 #pragma once
+#include <memory>
+
 #include "common/status.h"
 #include "exec/exec_node.h"
 
@@ -27,10 +29,12 @@ class TPlanNode;
 
 namespace vectorized {
 class Block;
+class VSharedExprResults;
 
 class VSelectNode final : public ExecNode {
 public:
     VSelectNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
+    ~VSelectNode() override;
     Status init(const TPlanNode& tnode, RuntimeState* state = nullptr) override;
     Status prepare(RuntimeState* state) override;
     Status open(RuntimeState* state) override;
@@ -41,6 +45,9 @@ public:
 private:
     // true if last get_next() call on child signalled eos
     bool _child_eos;
+
+    // The results of the subexprs shared by the conjuncts and the projections.
+    std::unique_ptr<VSharedExprResults> _shared_expr_results;
 };
 } // namespace vectorized
 } // namespace doris
\ No newline at end of file
@@ -153,6 +153,17 @@ Status VSortNode::sink(RuntimeState* state, vectorized::Block* input_block, bool
                         query_ctx->get_runtime_predicate().update(new_top, col.name, is_reverse));
                 old_top = std::move(new_top);
             }
+            // share the whole top row with the other instances, they compare all the sort
+            // columns to filter the input
+            auto& runtime_predicate = state->get_query_ctx()->get_runtime_predicate();
+            Block top_row = _sorter->get_top_row();
+            if (top_row.rows() > 0) {
+                runtime_predicate.update_top_row(top_row, _sorter->get_sort_description());
+            }
+            Block shared_top_row = runtime_predicate.get_top_row(&_shared_top_row_version);
+            if (shared_top_row.rows() > 0) {
+                _sorter->set_shared_top_row(std::move(shared_top_row));
+            }
         }
         if (!_reuse_mem) {
             input_block->clear();
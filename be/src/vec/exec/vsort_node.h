@@ -92,6 +92,7 @@ private:
     bool _use_topn_opt = false;
     // topn top value
     Field old_top {Field::Types::Null};
+    int64_t _shared_top_row_version = 0;
 
     bool _reuse_mem;
 
@@ -0,0 +1,453 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/fused_expr_kernel.h"
+
+#include <fmt/format.h>
+#include <gen_cpp/Exprs_types.h>
+#include <gen_cpp/Types_types.h>
+#include <string.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/assert_cast.h"
+#include "vec/common/pod_array.h"
+#include "vec/core/accurate_comparison.h"
+#include "vec/core/block.h"
+#include "vec/exprs/vectorized_fn_call.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vliteral.h"
+#include "vec/exprs/vshared_expr.h"
+#include "vec/exprs/vslot_ref.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+// the widest type is Int128
+constexpr size_t MAX_TYPE_SIZE = 16;
+
+template <typename F>
+bool dispatch_type(TypeIndex type, F&& f) {
+    switch (type) {
+    case TypeIndex::UInt8:
+        f(UInt8());
+        return true;
+    case TypeIndex::Int8:
+        f(Int8());
+        return true;
+    case TypeIndex::Int16:
+        f(Int16());
+        return true;
+    case TypeIndex::Int32:
+        f(Int32());
+        return true;
+    case TypeIndex::Int64:
+        f(Int64());
+        return true;
+    case TypeIndex::Int128:
+        f(Int128());
+        return true;
+    case TypeIndex::Float32:
+        f(Float32());
+        return true;
+    case TypeIndex::Float64:
+        f(Float64());
+        return true;
+    default:
+        return false;
+    }
+}
+
+int int_rank(TypeIndex type) {
+    switch (type) {
+    case TypeIndex::Int8:
+        return 1;
+    case TypeIndex::Int16:
+        return 2;
+    case TypeIndex::Int32:
+        return 3;
+    case TypeIndex::Int64:
+        return 4;
+    case TypeIndex::Int128:
+        return 5;
+    default:
+        return 0;
+    }
+}
+
+// The types of the numbers, UInt8 is the type of the results of the comparisons.
+bool is_number(TypeIndex type) {
+    return int_rank(type) > 0 || type == TypeIndex::Float32 || type == TypeIndex::Float64;
+}
+
+// The cast between the types is a static_cast, no value overflows.
+bool can_widen(TypeIndex from, TypeIndex to) {
+    if (from == to) {
+        return true;
+    }
+    if (int_rank(from) > 0 && int_rank(to) > 0) {
+        return int_rank(from) <= int_rank(to);
+    }
+    if (to == TypeIndex::Float64) {
+        return int_rank(from) > 0 || from == TypeIndex::Float32;
+    }
+    return to == TypeIndex::Float32 && int_rank(from) > 0;
+}
+
+// The result types of the arithmetic of the same types, which are the types the arithmetic
+// functions compute in, see NumberTraits::ResultOfAdditionMultiplication.
+bool is_arithmetic_result(TypeIndex type) {
+    return type == TypeIndex::Int64 || type == TypeIndex::Int128 || type == TypeIndex::Float64;
+}
+
+size_t type_size(TypeIndex type) {
+    size_t size = 0;
+    dispatch_type(type, [&](auto value) { size = sizeof(value); });
+    return size;
+}
+
+template <typename T, typename Op>
+void binary_kernel(const T* __restrict lhs, const T* __restrict rhs, T* __restrict output,
+                   size_t num_rows, Op op) {
+    for (size_t i = 0; i < num_rows; ++i) {
+        output[i] = op(lhs[i], rhs[i]);
+    }
+}
+
+template <typename T, typename Op>
+void compare_kernel(const T* __restrict lhs, const T* __restrict rhs, UInt8* __restrict output,
+                    size_t num_rows) {
+    for (size_t i = 0; i < num_rows; ++i) {
+        output[i] = Op::apply(lhs[i], rhs[i]);
+    }
+}
+
+template <typename From, typename To>
+void cast_kernel(const From* __restrict input, To* __restrict output, size_t num_rows) {
+    for (size_t i = 0; i < num_rows; ++i) {
+        output[i] = static_cast<To>(input[i]);
+    }
+}
+
+} // namespace
+
+void FusedExprKernel::fuse(const VExprSPtr& root) {
+    if (auto* fn_call = dynamic_cast<VectorizedFnCall*>(root.get())) {
+        if (fn_call->fused_kernel() != nullptr) {
+            return;
+        }
+        if (auto kernel = create(root)) {
+            fn_call->set_fused_kernel(std::move(kernel));
+            return;
+        }
+    }
+    for (const auto& child : root->children()) {
+        fuse(child);
+    }
+}
+
+static void drop_kernels(const VExprSPtr& root) {
+    if (auto* fn_call = dynamic_cast<VectorizedFnCall*>(root.get())) {
+        fn_call->set_fused_kernel(nullptr);
+    }
+    for (const auto& child : root->children()) {
+        drop_kernels(child);
+    }
+}
+
+void FusedExprKernel::refuse(const VExprSPtr& root) {
+    drop_kernels(root);
+    fuse(root);
+}
+
+std::unique_ptr<FusedExprKernel> FusedExprKernel::create(const VExprSPtr& root) {
+    std::unique_ptr<FusedExprKernel> kernel(new FusedExprKernel());
+    int num_ops = 0;
+    int num_arithmetics = 0;
+    // a single node doesn't have intermediate results to save
+    if (kernel->_compile(root, true, &num_ops, &num_arithmetics) < 0 || num_ops < 2 ||
+        num_arithmetics == 0) {
+        return nullptr;
+    }
+    return kernel;
+}
+
+int FusedExprKernel::_add_step(Step&& step) {
+    step.type_size = type_size(step.type);
+    _steps.push_back(std::move(step));
+    return _steps.size() - 1;
+}
+
+int FusedExprKernel::_cast_if_needed(int input, TypeIndex type) {
+    TypeIndex input_type = _steps[input].type;
+    if (input_type == type) {
+        return input;
+    }
+    Step step {Op::CAST, type, input_type};
+    step.lhs = input;
+    return _add_step(std::move(step));
+}
+
+int FusedExprKernel::_compile(const VExprSPtr& expr, bool is_root, int* num_ops,
+                              int* num_arithmetics) {
+    // the result of a shared expr is reused by the other trees, it must be executed by itself
+    if (expr->is_nullable() || dynamic_cast<VSharedExpr*>(expr.get()) != nullptr) {
+        return -1;
+    }
+    TypeIndex type = expr->data_type()->get_type_id();
+
+    if (auto* slot_ref = dynamic_cast<VSlotRef*>(expr.get())) {
+        if (!is_number(type) || slot_ref->column_id() < 0) {
+            return -1;
+        }
+        Step step {Op::SLOT, type, type};
+        step.column_id = slot_ref->column_id();
+        return _add_step(std::move(step));
+    }
+
+    if (auto* literal = dynamic_cast<VLiteral*>(expr.get())) {
+        const auto& column = literal->get_column_ptr();
+        if (!is_number(type) || !is_column_const(*column)) {
+            return -1;
+        }
+        StringRef value =
+                assert_cast<const ColumnConst&>(*column).get_data_column().get_raw_data();
+        if (value.size != type_size(type)) {
+            return -1;
+        }
+        Step step {Op::LITERAL, type, type};
+        step.literal.assign(value.data, value.size);
+        return _add_step(std::move(step));
+    }
+
+    if (expr->node_type() == TExprNodeType::CAST_EXPR) {
+        if (expr->children().size() != 1 || !is_number(type)) {
+            return -1;
+        }
+        const auto& child = expr->children()[0];
+        int input = _compile(child, false, num_ops, num_arithmetics);
+        if (input < 0 || !can_widen(_steps[input].type, type)) {
+            return -1;
+        }
+        ++*num_ops;
+        return _cast_if_needed(input, type);
+    }
+
+    if (dynamic_cast<VectorizedFnCall*>(expr.get()) == nullptr || expr->children().size() != 2 ||
+        expr->fn().binary_type != TFunctionBinaryType::BUILTIN) {
+        return -1;
+    }
+    static const std::unordered_map<std::string, Op> arithmetic_ops {
+            {"add", Op::ADD}, {"subtract", Op::SUBTRACT}, {"multiply", Op::MULTIPLY}};
+    static const std::unordered_map<std::string, Op> comparison_ops {
+            {"eq", Op::EQ}, {"ne", Op::NE}, {"lt", Op::LT},
+            {"le", Op::LE}, {"gt", Op::GT}, {"ge", Op::GE}};
+    const auto& function_name = expr->fn().name.function_name;
+    if (auto it = arithmetic_ops.find(function_name); it != arithmetic_ops.end()) {
+        if (!is_arithmetic_result(type)) {
+            return -1;
+        }
+        int lhs = _compile(expr->children()[0], false, num_ops, num_arithmetics);
+        if (lhs < 0 || !can_widen(_steps[lhs].type, type)) {
+            return -1;
+        }
+        lhs = _cast_if_needed(lhs, type);
+        int rhs = _compile(expr->children()[1], false, num_ops, num_arithmetics);
+        if (rhs < 0 || !can_widen(_steps[rhs].type, type)) {
+            return -1;
+        }
+        rhs = _cast_if_needed(rhs, type);
+        ++*num_ops;
+        ++*num_arithmetics;
+        Step step {it->second, type, type};
+        step.lhs = lhs;
+        step.rhs = rhs;
+        return _add_step(std::move(step));
+    }
+    if (auto it = comparison_ops.find(function_name); it != comparison_ops.end()) {
+        // the result of the comparison is not an input of the other nodes
+        if (!is_root || type != TypeIndex::UInt8) {
+            return -1;
+        }
+        int lhs = _compile(expr->children()[0], false, num_ops, num_arithmetics);
+        if (lhs < 0) {
+            return -1;
+        }
+        int rhs = _compile(expr->children()[1], false, num_ops, num_arithmetics);
+        if (rhs < 0 || _steps[lhs].type != _steps[rhs].type) {
+            return -1;
+        }
+        ++*num_ops;
+        Step step {it->second, type, _steps[lhs].type};
+        step.lhs = lhs;
+        step.rhs = rhs;
+        return _add_step(std::move(step));
+    }
+    return -1;
+}
+
+void FusedExprKernel::_execute_step(const Step& step, const char* lhs, const char* rhs,
+                                    char* output, size_t num_rows) {
+    switch (step.op) {
+    case Op::CAST:
+        dispatch_type(step.input_type, [&](auto from) {
+            using From = decltype(from);
+            dispatch_type(step.type, [&](auto to) {
+                using To = decltype(to);
+                cast_kernel((const From*)lhs, (To*)output, num_rows);
+            });
+        });
+        break;
+    case Op::ADD:
+    case Op::SUBTRACT:
+    case Op::MULTIPLY:
+        dispatch_type(step.type, [&](auto value) {
+            using T = decltype(value);
+            if (step.op == Op::ADD) {
+                binary_kernel((const T*)lhs, (const T*)rhs, (T*)output, num_rows,
+                              [](T a, T b) -> T { return a + b; });
+            } else if (step.op == Op::SUBTRACT) {
+                binary_kernel((const T*)lhs, (const T*)rhs, (T*)output, num_rows,
+                              [](T a, T b) -> T { return a - b; });
+            } else {
+                binary_kernel((const T*)lhs, (const T*)rhs, (T*)output, num_rows,
+                              [](T a, T b) -> T { return a * b; });
+            }
+        });
+        break;
+    default:
+        dispatch_type(step.input_type, [&](auto value) {
+            using T = decltype(value);
+            auto* result = (UInt8*)output;
+            switch (step.op) {
+            case Op::EQ:
+                compare_kernel<T, EqualsOp<T, T>>((const T*)lhs, (const T*)rhs, result, num_rows);
+                break;
+            case Op::NE:
+                compare_kernel<T, NotEqualsOp<T, T>>((const T*)lhs, (const T*)rhs, result,
+                                                     num_rows);
+                break;
+            case Op::LT:
+                compare_kernel<T, LessOp<T, T>>((const T*)lhs, (const T*)rhs, result, num_rows);
+                break;
+            case Op::LE:
+                compare_kernel<T, LessOrEqualsOp<T, T>>((const T*)lhs, (const T*)rhs, result,
+                                                        num_rows);
+                break;
+            case Op::GT:
+                compare_kernel<T, GreaterOp<T, T>>((const T*)lhs, (const T*)rhs, result,
+                                                   num_rows);
+                break;
+            case Op::GE:
+                compare_kernel<T, GreaterOrEqualsOp<T, T>>((const T*)lhs, (const T*)rhs, result,
+                                                           num_rows);
+                break;
+            default:
+                break;
+            }
+        });
+        break;
+    }
+}
+
+ColumnPtr FusedExprKernel::execute(const Block& block) const {
+    const size_t num_rows = block.rows();
+    std::vector<const char*> columns(_steps.size(), nullptr);
+    for (size_t i = 0; i < _steps.size(); ++i) {
+        const auto& step = _steps[i];
+        if (step.op != Op::SLOT) {
+            continue;
+        }
+        if (step.column_id >= block.columns()) {
+            return nullptr;
+        }
+        const auto& column = block.get_by_position(step.column_id);
+        if (column.type->get_type_id() != step.type || is_column_const(*column.column) ||
+            column.column->is_nullable() || column.column->size() != num_rows) {
+            return nullptr;
+        }
+        columns[i] = column.column->get_raw_data().data;
+    }
+
+    const auto& root = _steps.back();
+    MutableColumnPtr result;
+    char* result_data = nullptr;
+    dispatch_type(root.type, [&](auto value) {
+        using T = decltype(value);
+        auto column = ColumnVector<T>::create(num_rows);
+        result_data = reinterpret_cast<char*>(column->get_data().data());
+        result = std::move(column);
+    });
+
+    PaddedPODArray<char> buffers(_steps.size() * CHUNK_SIZE * MAX_TYPE_SIZE);
+    for (size_t i = 0; i < _steps.size(); ++i) {
+        const auto& step = _steps[i];
+        if (step.op != Op::LITERAL) {
+            continue;
+        }
+        char* buffer = buffers.data() + i * CHUNK_SIZE * MAX_TYPE_SIZE;
+        for (size_t j = 0; j < CHUNK_SIZE; ++j) {
+            memcpy(buffer + j * step.type_size, step.literal.data(), step.type_size);
+        }
+    }
+
+    // the input of the steps in the current chunk
+    std::vector<const char*> inputs(_steps.size(), nullptr);
+    for (size_t begin = 0; begin < num_rows; begin += CHUNK_SIZE) {
+        size_t chunk_rows = std::min(CHUNK_SIZE, num_rows - begin);
+        for (size_t i = 0; i < _steps.size(); ++i) {
+            const auto& step = _steps[i];
+            char* buffer = buffers.data() + i * CHUNK_SIZE * MAX_TYPE_SIZE;
+            if (step.op == Op::SLOT) {
+                inputs[i] = columns[i] + begin * step.type_size;
+            } else if (step.op == Op::LITERAL) {
+                inputs[i] = buffer;
+            } else {
+                // the root writes to the result column directly
+                char* output = i + 1 == _steps.size() ? result_data + begin * step.type_size
+                                                      : buffer;
+                _execute_step(step, inputs[step.lhs], step.rhs < 0 ? nullptr : inputs[step.rhs],
+                              output, chunk_rows);
+                inputs[i] = output;
+            }
+        }
+    }
+    return result;
+}
+
+std::string FusedExprKernel::debug_string() const {
+    static const char* op_names[] = {"slot", "literal", "cast", "add", "subtract", "multiply",
+                                     "eq",   "ne",      "lt",   "le",  "gt",       "ge"};
+    std::string res = "FusedExprKernel(";
+    for (size_t i = 0; i < _steps.size(); ++i) {
+        const auto& step = _steps[i];
+        res += fmt::format("{}{}:{}[{}]", i == 0 ? "" : ", ", i, op_names[int(step.op)],
+                           getTypeName(step.type));
+        if (step.lhs >= 0) {
+            res += fmt::format("({}{})", step.lhs,
+                               step.rhs >= 0 ? fmt::format(", {}", step.rhs) : "");
+        }
+    }
+    return res + ")";
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,90 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "vec/columns/column.h"
+#include "vec/core/types.h"
+#include "vec/exprs/vexpr_fwd.h"
+
+namespace doris::vectorized {
+class Block;
+
+// Evaluates a tree of numeric arithmetic, comparison and cast exprs over slot refs and literals,
+// e.g. `a * 2 + b > c`, in one pass over the input columns. The rows are evaluated by chunks,
+// the intermediate results of a chunk stay in small buffers instead of a full column in the
+// block for each node of the tree.
+class FusedExprKernel {
+public:
+    static constexpr size_t CHUNK_SIZE = 1024;
+
+    // Attach the kernels to the roots of the largest subtrees of the expr tree which can be
+    // fused, the tree itself is not changed.
+    static void fuse(const VExprSPtr& root);
+
+    // Drop the kernels of the tree and fuse it again, after some subtrees are replaced, e.g. by
+    // VSharedExpr which is never fused into the kernel of its parent.
+    static void refuse(const VExprSPtr& root);
+
+    // Returns nullptr if the tree can't be fused or has too few nodes to gain from fusing.
+    static std::unique_ptr<FusedExprKernel> create(const VExprSPtr& root);
+
+    // Returns nullptr if the input columns are not the expected ones, e.g. const columns, the
+    // caller executes the tree as usual then.
+    ColumnPtr execute(const Block& block) const;
+
+    std::string debug_string() const;
+
+private:
+    enum class Op { SLOT, LITERAL, CAST, ADD, SUBTRACT, MULTIPLY, EQ, NE, LT, LE, GT, GE };
+
+    struct Step {
+        Op op;
+        // the type of the result
+        TypeIndex type;
+        // the type of the inputs, differs from the type of the result for cast and comparisons
+        TypeIndex input_type;
+        size_t type_size = 0;
+        int lhs = -1;
+        int rhs = -1;
+        // the position of the column in the block for slot refs
+        int column_id = -1;
+        // the bytes of the value for literals
+        std::string literal;
+    };
+
+    // Append the steps of the expr in post order, return the index of the step of the expr or
+    // -1 if it can't be fused.
+    int _compile(const VExprSPtr& expr, bool is_root, int* num_ops, int* num_arithmetics);
+
+    int _add_step(Step&& step);
+
+    int _cast_if_needed(int input, TypeIndex type);
+
+    static void _execute_step(const Step& step, const char* lhs, const char* rhs, char* output,
+                              size_t num_rows);
+
+    std::vector<Step> _steps;
+};
+
+} // namespace doris::vectorized
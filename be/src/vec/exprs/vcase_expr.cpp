@@ -20,6 +20,7 @@
 #include <gen_cpp/Exprs_types.h>
 #include <gen_cpp/Types_types.h>
 #include <stddef.h>
+#include <string.h>
 
 #include <algorithm>
 #include <memory>
@@ -29,6 +30,8 @@
 #include "common/status.h"
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/columns/column.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
 #include "vec/core/block.h"
 #include "vec/core/column_numbers.h"
 #include "vec/core/column_with_type_and_name.h"
@@ -89,12 +92,69 @@ void VCaseExpr::close(VExprContext* context, FunctionContext::FunctionStateScope
     VExpr::close(context, scope);
 }
 
+Status VCaseExpr::_execute_branches(VExprContext* context, Block* block,
+                                    ColumnNumbers& arguments) {
+    size_t rows = block->rows();
+    // the rows not taking any WHEN before
+    IColumn::Filter undecided(rows, 1);
+    size_t undecided_rows = rows;
+    IColumn::Filter branch(rows);
+    int i = 0;
+    for (; i + 1 < _children.size(); i += 2) {
+        int when_id = -1;
+        RETURN_IF_ERROR(_children[i]->execute_on_selection(context, block, undecided,
+                                                           undecided_rows, &when_id));
+        arguments[i] = when_id;
+
+        ColumnPtr when_column =
+                block->get_by_position(when_id).column->convert_to_full_column_if_const();
+        const NullMap* null_map = nullptr;
+        if (const auto* nullable = check_and_get_column<ColumnNullable>(*when_column)) {
+            null_map = &nullable->get_null_map_data();
+            when_column = nullable->get_nested_column_ptr();
+        }
+        const auto* when_data = check_and_get_column<ColumnUInt8>(*when_column);
+        size_t branch_rows = undecided_rows;
+        if (when_data == nullptr) {
+            // the rows of the WHEN are unknown, THEN is executed on all the undecided rows
+            memcpy(branch.data(), undecided.data(), rows);
+        } else {
+            branch_rows = 0;
+            const auto* __restrict data = when_data->get_data().data();
+            for (size_t j = 0; j < rows; j++) {
+                uint8 taken = undecided[j] & (data[j] != 0) &
+                              (null_map == nullptr || (*null_map)[j] == 0);
+                branch[j] = taken;
+                undecided[j] &= !taken;
+                branch_rows += taken;
+            }
+            undecided_rows -= branch_rows;
+        }
+
+        int then_id = -1;
+        RETURN_IF_ERROR(_children[i + 1]->execute_on_selection(context, block, branch,
+                                                               branch_rows, &then_id));
+        arguments[i + 1] = then_id;
+    }
+    if (_has_else_expr) {
+        int else_id = -1;
+        RETURN_IF_ERROR(_children[i]->execute_on_selection(context, block, undecided,
+                                                           undecided_rows, &else_id));
+        arguments[i] = else_id;
+    }
+    return Status::OK();
+}
+
 Status VCaseExpr::execute(VExprContext* context, Block* block, int* result_column_id) {
     ColumnNumbers arguments(_children.size());
-    for (int i = 0; i < _children.size(); i++) {
-        int column_id = -1;
-        RETURN_IF_ERROR(_children[i]->execute(context, block, &column_id));
-        arguments[i] = column_id;
+    if (_has_case_expr) {
+        for (int i = 0; i < _children.size(); i++) {
+            int column_id = -1;
+            RETURN_IF_ERROR(_children[i]->execute(context, block, &column_id));
+            arguments[i] = column_id;
+        }
+    } else {
+        RETURN_IF_ERROR(_execute_branches(context, block, arguments));
     }
     RETURN_IF_ERROR(check_constant(*block, arguments));
 
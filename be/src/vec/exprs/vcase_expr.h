@@ -22,6 +22,7 @@
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "udf/udf.h"
+#include "vec/core/column_numbers.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/functions/function.h"
 
@@ -52,6 +53,9 @@ public:
     std::string debug_string() const override;
 
 private:
+    // Execute the WHEN, THEN and ELSE children, each THEN and ELSE only on the rows taking it.
+    Status _execute_branches(VExprContext* context, Block* block, ColumnNumbers& arguments);
+
     bool _has_case_expr;
     bool _has_else_expr;
 
@@ -21,6 +21,7 @@
 #include "common/status.h"
 #include "util/simd/bits.h"
 #include "vec/columns/column.h"
+#include "vec/columns/column_nullable.h"
 #include "vec/columns/columns_number.h"
 #include "vec/common/assert_cast.h"
 #include "vec/exprs/vectorized_fn_call.h"
@@ -52,107 +53,147 @@ public:
     const std::string& expr_name() const override { return _expr_name; }
 
     Status execute(VExprContext* context, Block* block, int* result_column_id) override {
-        if (children().size() == 1 || !_all_child_is_compound_and_not_const() ||
-            _children[0]->is_nullable() || _children[1]->is_nullable()) {
-            // TODO:
-            // When the child is nullable, make the optimization also take effect, and the processing of this piece may be more complicated
-            // https://dev.mysql.com/doc/refman/8.0/en/logical-operators.html
+        if (children().size() == 1) {
             return VectorizedFnCall::execute(context, block, result_column_id);
         }
+        if (_op != TExprOpcode::COMPOUND_AND && _op != TExprOpcode::COMPOUND_OR) {
+            return Status::InternalError("Compound operator must be AND or OR.");
+        }
+        bool is_and = _op == TExprOpcode::COMPOUND_AND;
 
+        size_t num_columns = block->columns();
         int lhs_id = -1;
-        int rhs_id = -1;
         RETURN_IF_ERROR(_children[0]->execute(context, block, &lhs_id));
+        // the result column of lhs is allowed to be modified locally if it is only owned by
+        // the block, and not an input column
+        const auto& lhs_result = block->get_by_position(lhs_id).column;
+        bool lhs_exclusive = lhs_id >= num_columns && !is_column_const(*lhs_result) &&
+                             lhs_result->is_exclusive();
         ColumnPtr lhs_column =
                 block->get_by_position(lhs_id).column->convert_to_full_column_if_const();
-
         size_t size = lhs_column->size();
         uint8* __restrict data = _get_raw_data(lhs_column);
-        int filted = simd::count_zero_num((int8_t*)data, size);
-        bool full = filted == 0;
-        bool empty = filted == size;
-
-        ColumnPtr rhs_column = nullptr;
-        uint8* __restrict data_rhs = nullptr;
-        bool full_rhs = false;
-        bool empty_rhs = false;
-
-        auto get_rhs_colum = [&]() {
-            if (rhs_id == -1) {
-                RETURN_IF_ERROR(_children[1]->execute(context, block, &rhs_id));
-                rhs_column =
-                        block->get_by_position(rhs_id).column->convert_to_full_column_if_const();
-                data_rhs = _get_raw_data(rhs_column);
-                int filted = simd::count_zero_num((int8_t*)data_rhs, size);
-                full_rhs = filted == 0;
-                empty_rhs = filted == size;
+        const uint8* __restrict null_map = _get_null_map(lhs_column);
+
+        // https://dev.mysql.com/doc/refman/8.0/en/logical-operators.html
+        // the rhs is only needed by the rows whose lhs is not false for AND, not true for OR
+        IColumn::Filter selection(size);
+        auto* __restrict selected = selection.data();
+        for (size_t i = 0; i < size; i++) {
+            uint8 is_true = (data[i] != 0) & (null_map == nullptr || null_map[i] == 0);
+            uint8 is_null = null_map != nullptr && null_map[i] != 0;
+            selected[i] = is_and ? (is_true | is_null) : !is_true;
+        }
+        size_t selected_rows = size - simd::count_zero_num((int8_t*)selected, size);
+        if (selected_rows == 0) {
+            // empty and any = empty, full or any = full, return lhs
+            return _return_column(block, lhs_id, result_column_id);
+        }
+        // lhs is all true for AND, all false for OR
+        bool lhs_no_effect = null_map == nullptr && selected_rows == size;
+
+        int rhs_id = -1;
+        RETURN_IF_ERROR(_children[1]->execute_on_selection(context, block, selection,
+                                                           selected_rows, &rhs_id));
+        ColumnPtr rhs_column =
+                block->get_by_position(rhs_id).column->convert_to_full_column_if_const();
+        uint8* __restrict data_rhs = _get_raw_data(rhs_column);
+        const uint8* __restrict null_map_rhs = _get_null_map(rhs_column);
+        // the unselected rows of rhs are default values, which don't change the results of them
+        int filted = simd::count_zero_num((int8_t*)data_rhs, size);
+        bool rhs_full = null_map_rhs == nullptr && filted == 0;
+        bool rhs_empty = null_map_rhs == nullptr && filted == size;
+
+        if (is_and) {
+            if (lhs_no_effect || rhs_empty) {
+                // full and any = any, any and empty = empty, return rhs
+                return _return_column(block, rhs_id, result_column_id);
+            } else if (rhs_full) {
+                // any and full = any, return lhs
+                return _return_column(block, lhs_id, result_column_id);
             }
-            return Status::OK();
-        };
+        } else {
+            if (lhs_no_effect || rhs_full) {
+                // empty or any = any, any or full = full, return rhs
+                return _return_column(block, rhs_id, result_column_id);
+            } else if (rhs_empty) {
+                // any or empty = any, return lhs
+                return _return_column(block, lhs_id, result_column_id);
+            }
+        }
 
-        if (_op == TExprOpcode::COMPOUND_AND) {
-            if (empty) {
-                // empty and any = empty, return lhs
-                *result_column_id = lhs_id;
-            } else {
-                RETURN_IF_ERROR(get_rhs_colum());
-
-                if (full) {
-                    // full and any = any, return rhs
-                    *result_column_id = rhs_id;
-                } else if (empty_rhs) {
-                    // any and empty = empty, return rhs
-                    *result_column_id = rhs_id;
-                } else if (full_rhs) {
-                    // any and full = any, return lhs
-                    *result_column_id = lhs_id;
-                } else {
-                    *result_column_id = lhs_id;
-                    for (size_t i = 0; i < size; i++) {
-                        data[i] &= data_rhs[i];
-                    }
+        if (null_map == nullptr && null_map_rhs == nullptr && lhs_exclusive) {
+            if (is_and) {
+                for (size_t i = 0; i < size; i++) {
+                    data[i] &= data_rhs[i];
                 }
-            }
-        } else if (_op == TExprOpcode::COMPOUND_OR) {
-            if (full) {
-                // full or any = full, return lhs
-                *result_column_id = lhs_id;
             } else {
-                RETURN_IF_ERROR(get_rhs_colum());
-                if (empty) {
-                    // empty or any = any, return rhs
-                    *result_column_id = rhs_id;
-                } else if (full_rhs) {
-                    // any or full = full, return rhs
-                    *result_column_id = rhs_id;
-                } else if (empty_rhs) {
-                    // any or empty = any, return lhs
-                    *result_column_id = lhs_id;
-                } else {
-                    *result_column_id = lhs_id;
-                    for (size_t i = 0; i < size; i++) {
-                        data[i] |= data_rhs[i];
-                    }
+                for (size_t i = 0; i < size; i++) {
+                    data[i] |= data_rhs[i];
                 }
             }
-        } else {
-            return Status::InternalError("Compound operator must be AND or OR.");
+            return _return_column(block, lhs_id, result_column_id);
         }
 
-        return Status::OK();
+        auto result_column = ColumnUInt8::create(size);
+        auto* __restrict res = result_column->get_data().data();
+        if (null_map == nullptr && null_map_rhs == nullptr) {
+            for (size_t i = 0; i < size; i++) {
+                res[i] = is_and ? (data[i] != 0) & (data_rhs[i] != 0)
+                                : (data[i] != 0) | (data_rhs[i] != 0);
+            }
+            return _return_column(block, std::move(result_column), nullptr, result_column_id);
+        }
+
+        auto result_null_map = ColumnUInt8::create(size);
+        auto* __restrict res_null = result_null_map->get_data().data();
+        for (size_t i = 0; i < size; i++) {
+            uint8 lhs_null = null_map != nullptr && null_map[i] != 0;
+            uint8 rhs_null = null_map_rhs != nullptr && null_map_rhs[i] != 0;
+            uint8 lhs_true = (data[i] != 0) & !lhs_null;
+            uint8 rhs_true = (data_rhs[i] != 0) & !rhs_null;
+            if (is_and) {
+                // null unless either is false or both are true
+                res[i] = lhs_true & rhs_true;
+                res_null[i] = (lhs_true | lhs_null) & (rhs_true | rhs_null) & (lhs_null | rhs_null);
+            } else {
+                // null unless either is true or both are false
+                res[i] = lhs_true | rhs_true;
+                res_null[i] = !res[i] & (lhs_null | rhs_null);
+            }
+        }
+        return _return_column(block, std::move(result_column), std::move(result_null_map),
+                              result_column_id);
     }
 
     bool is_compound_predicate() const override { return true; }
 
 private:
-    bool _all_child_is_compound_and_not_const() const {
-        for (auto child : _children) {
-            // we can make sure non const compound predicate's return column is allow modifyied locally.
-            if (child->is_constant() || !child->is_compound_predicate()) {
-                return false;
+    // Return the column of a child, which is nullable if the result is nullable.
+    Status _return_column(Block* block, int column_id, int* result_column_id) const {
+        const auto& column = block->get_by_position(column_id).column;
+        if (!_data_type->is_nullable() || column->is_nullable()) {
+            *result_column_id = column_id;
+            return Status::OK();
+        }
+        block->insert({make_nullable(column), _data_type, _expr_name});
+        *result_column_id = block->columns() - 1;
+        return Status::OK();
+    }
+
+    Status _return_column(Block* block, ColumnUInt8::MutablePtr column,
+                          ColumnUInt8::MutablePtr null_map, int* result_column_id) const {
+        if (_data_type->is_nullable()) {
+            if (null_map == nullptr) {
+                null_map = ColumnUInt8::create(column->size(), 0);
             }
+            block->insert({ColumnNullable::create(std::move(column), std::move(null_map)),
+                           _data_type, _expr_name});
+        } else {
+            block->insert({std::move(column), _data_type, _expr_name});
         }
-        return true;
+        *result_column_id = block->columns() - 1;
+        return Status::OK();
     }
 
     uint8* _get_raw_data(ColumnPtr column) const {
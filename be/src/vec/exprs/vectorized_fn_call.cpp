@@ -133,6 +133,13 @@ void VectorizedFnCall::close(VExprContext* context, FunctionContext::FunctionSta
 
 Status VectorizedFnCall::execute(VExprContext* context, vectorized::Block* block,
                                  int* result_column_id) {
+    if (_fused_kernel != nullptr) {
+        if (auto result = _fused_kernel->execute(*block)) {
+            block->insert({std::move(result), _data_type, _expr_name});
+            *result_column_id = block->columns() - 1;
+            return Status::OK();
+        }
+    }
     // TODO: not execute const expr again, but use the const column in function context
     vectorized::ColumnNumbers arguments(_children.size());
     for (int i = 0; i < _children.size(); ++i) {
@@ -18,6 +18,7 @@
 #pragma once
 #include <stddef.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,7 @@
 #include "common/status.h"
 #include "udf/udf.h"
 #include "vec/core/column_numbers.h"
+#include "vec/exprs/fused_expr_kernel.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/functions/function.h"
 
@@ -63,10 +65,17 @@ public:
     bool fast_execute(FunctionContext* context, Block& block, const ColumnNumbers& arguments,
                       size_t result, size_t input_rows_count);
 
+    // Execute the tree under this node by the kernel, see FusedExprKernel::fuse.
+    void set_fused_kernel(std::unique_ptr<FusedExprKernel> kernel) {
+        _fused_kernel = std::move(kernel);
+    }
+    const FusedExprKernel* fused_kernel() const { return _fused_kernel.get(); }
+
 protected:
     FunctionBasePtr _function;
     bool _can_fast_execute = false;
     std::string _expr_name;
     std::string _function_name;
+    std::unique_ptr<FusedExprKernel> _fused_kernel;
 };
 } // namespace doris::vectorized
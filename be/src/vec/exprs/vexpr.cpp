@@ -23,9 +23,11 @@
 #include <algorithm>
 #include <boost/iterator/iterator_facade.hpp>
 #include <memory>
+#include <set>
 #include <stack>
 
 #include "common/config.h"
+#include "common/consts.h"
 #include "common/exception.h"
 #include "common/object_pool.h"
 #include "common/status.h"
@@ -449,4 +451,80 @@ Status VExpr::check_constant(const Block& block, ColumnNumbers arguments) const
     return Status::OK();
 }
 
+bool VExpr::_collect_slot_column_ids(std::set<int>* column_ids) const {
+    switch (_node_type) {
+    case TExprNodeType::SLOT_REF:
+        column_ids->insert(static_cast<const VSlotRef*>(this)->column_id());
+        return true;
+    // read the block by the positions or the names of the columns
+    case TExprNodeType::COLUMN_REF:
+    case TExprNodeType::LAMBDA_FUNCTION_EXPR:
+    case TExprNodeType::LAMBDA_FUNCTION_CALL_EXPR:
+    case TExprNodeType::MATCH_PRED:
+    case TExprNodeType::TUPLE_IS_NULL_PRED:
+    case TExprNodeType::SCHEMA_CHANGE_EXPR:
+        return false;
+    default:
+        break;
+    }
+    for (const auto& child : children()) {
+        if (!child->_collect_slot_column_ids(column_ids)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status VExpr::execute_on_selection(VExprContext* context, Block* block,
+                                   const IColumn::Filter& selection, size_t selected_rows,
+                                   int* result_column_id) {
+    size_t rows = block->rows();
+    std::set<int> column_ids;
+    if (is_constant() || selected_rows == rows ||
+        selected_rows > rows * config::expr_selection_max_ratio ||
+        !_collect_slot_column_ids(&column_ids) || column_ids.empty() ||
+        *column_ids.begin() < 0 || *column_ids.rbegin() >= block->columns()) {
+        return execute(context, block, result_column_id);
+    }
+
+    if (selected_rows == 0) {
+        auto column = _data_type->create_column();
+        column->insert_many_defaults(rows);
+        block->insert({std::move(column), _data_type, expr_name()});
+        *result_column_id = block->columns() - 1;
+        return Status::OK();
+    }
+
+    // keep the positions of the columns, the columns not read by the expr are left null and
+    // skipped by Block::rows(). The temporary columns of the inverted index results are
+    // looked up by names.
+    Block selected_block;
+    for (int i = 0; i < block->columns(); ++i) {
+        const auto& column = block->get_by_position(i);
+        bool read = column_ids.count(i) > 0 ||
+                    column.name.rfind(BeConsts::BLOCK_TEMP_COLUMN_PREFIX, 0) == 0;
+        selected_block.insert({read ? column.column->filter(selection, selected_rows) : nullptr,
+                               column.type, column.name});
+    }
+    int selected_column_id = -1;
+    RETURN_IF_ERROR(execute(context, &selected_block, &selected_column_id));
+
+    auto& result = selected_block.get_by_position(selected_column_id);
+    ColumnPtr column = std::move(result.column);
+    column = column->convert_to_full_column_if_const();
+    auto selected_column = IColumn::mutate(std::move(column));
+    // the unselected rows take the default value appended to the end
+    selected_column->insert_default();
+    std::vector<int> indices(rows);
+    for (int i = 0, j = 0; i < rows; ++i) {
+        indices[i] = selection[i] ? j : selected_rows;
+        j += selection[i] != 0;
+    }
+    auto full_column = selected_column->clone_empty();
+    full_column->insert_indices_from(*selected_column, indices.data(), indices.data() + rows);
+    block->insert({std::move(full_column), result.type, expr_name()});
+    *result_column_id = block->columns() - 1;
+    return Status::OK();
+}
+
 } // namespace doris::vectorized
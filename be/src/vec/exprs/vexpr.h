@@ -25,6 +25,7 @@
 
 #include <memory>
 #include <ostream>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -103,6 +104,14 @@ public:
 
     virtual Status execute(VExprContext* context, Block* block, int* result_column_id) = 0;
 
+    /// Execute the expr only on the rows whose `selection` is not zero, `selected_rows` is the
+    /// number of them. The result column still has all the rows of the block, the unselected
+    /// rows are default values. Fall back to execute() on all the rows if the selected rows are
+    /// not few enough or the expr reads the block other than by slot refs.
+    Status execute_on_selection(VExprContext* context, Block* block,
+                                const IColumn::Filter& selection, size_t selected_rows,
+                                int* result_column_id);
+
     /// Subclasses overriding this function should call VExpr::Close().
     //
     /// If scope if FRAGMENT_LOCAL, both fragment- and thread-local state should be torn
@@ -217,6 +226,10 @@ protected:
 
     Status check_constant(const Block& block, ColumnNumbers arguments) const;
 
+    /// Collect the block positions of the slot refs in the tree. Return false if the tree has
+    /// an expr which may not be executed on a part of the rows.
+    bool _collect_slot_column_ids(std::set<int>* column_ids) const;
+
     /// Helper function that calls ctx->register(), sets fn_context_index_, and returns the
     /// registered FunctionContext
     void register_function_context(RuntimeState* state, VExprContext* context);
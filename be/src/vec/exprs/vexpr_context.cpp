@@ -18,21 +18,27 @@
 #include "vec/exprs/vexpr_context.h"
 
 #include <algorithm>
+#include <numeric>
 #include <ostream>
 #include <string>
 
 // IWYU pragma: no_include <opentelemetry/common/threadlocal.h>
 #include "common/compiler_util.h" // IWYU pragma: keep
+#include "common/config.h"
 #include "common/exception.h"
 #include "common/object_pool.h"
 #include "runtime/runtime_state.h"
 #include "runtime/thread_context.h"
 #include "udf/udf.h"
+#include "util/simd/bits.h"
 #include "util/stack_util.h"
+#include "util/time.h"
 #include "vec/columns/column_const.h"
 #include "vec/core/column_with_type_and_name.h"
 #include "vec/core/columns_with_type_and_name.h"
+#include "vec/exprs/fused_expr_kernel.h"
 #include "vec/exprs/vexpr.h"
+#include "vec/exprs/vshared_expr.h"
 
 namespace doris {
 class RowDescriptor;
@@ -65,10 +71,24 @@ Status VExprContext::execute(vectorized::Block* block, int* result_column_id) {
     return st;
 }
 
+Status VExprContext::execute_on_selection(Block* block, const IColumn::Filter& selection,
+                                          size_t selected_rows, int* result_column_id) {
+    Status st;
+    RETURN_IF_CATCH_EXCEPTION({
+        st = _root->execute_on_selection(this, block, selection, selected_rows,
+                                         result_column_id);
+        _last_result_column_id = *result_column_id;
+    });
+    return st;
+}
+
 Status VExprContext::prepare(RuntimeState* state, const RowDescriptor& row_desc) {
     _prepared = true;
     Status st;
     RETURN_IF_CATCH_EXCEPTION({ st = _root->prepare(state, row_desc, this); });
+    if (st.ok() && config::enable_fused_expr_kernel) {
+        FusedExprKernel::fuse(_root);
+    }
     return st;
 }
 
@@ -155,7 +175,21 @@ Status VExprContext::execute_conjuncts(const VExprContextSPtrs& ctxs,
     return execute_conjuncts(ctxs, filters, false, block, result_filter, can_filter_all);
 }
 
-// TODO Performance Optimization
+// The conjuncts not measured yet are evaluated first, then in the ascending order of the
+// measured cost to filter out a row.
+static std::vector<size_t> conjuncts_order(const VExprContextSPtrs& ctxs, bool reorder) {
+    if (!reorder) {
+        std::vector<size_t> order(ctxs.size());
+        std::iota(order.begin(), order.end(), 0);
+        return order;
+    }
+    std::vector<const PredicateStats*> stats;
+    for (const auto& ctx : ctxs) {
+        stats.push_back(&ctx->conjunct_stats());
+    }
+    return order_by_rank(stats);
+}
+
 Status VExprContext::execute_conjuncts(const VExprContextSPtrs& ctxs,
                                        const std::vector<IColumn::Filter*>* filters,
                                        const bool accept_null, Block* block,
@@ -163,9 +197,20 @@ Status VExprContext::execute_conjuncts(const VExprContextSPtrs& ctxs,
     DCHECK(result_filter->size() == block->rows());
     *can_filter_all = false;
     auto* __restrict result_filter_data = result_filter->data();
-    for (auto& ctx : ctxs) {
+    const size_t rows = result_filter->size();
+    size_t selected_rows = rows - simd::count_zero_num((int8_t*)result_filter_data, rows);
+    const int sample_interval = config::conjuncts_reorder_sample_interval;
+    const bool reorder = sample_interval > 0 && ctxs.size() > 1;
+    for (size_t index : conjuncts_order(ctxs, reorder)) {
+        auto& ctx = ctxs[index];
+        bool sample = reorder && ctx->_conjunct_executed_times++ % sample_interval == 0;
+        int64_t start_ns = sample ? MonotonicNanos() : 0;
+        size_t input_rows = selected_rows;
+
+        // the rows filtered out by the former conjuncts are skipped
         int result_column_id = -1;
-        RETURN_IF_ERROR(ctx->execute(block, &result_column_id));
+        RETURN_IF_ERROR(
+                ctx->execute_on_selection(block, *result_filter, selected_rows, &result_column_id));
         ColumnPtr& filter_column = block->get_by_position(result_column_id).column;
         if (auto* nullable_column = check_and_get_column<ColumnNullable>(*filter_column)) {
             size_t column_size = nullable_column->size();
@@ -189,18 +234,11 @@ Status VExprContext::execute_conjuncts(const VExprContextSPtrs& ctxs,
                         result_filter_data[i] &= (!null_map_data[i]) & filter_data[i];
                     }
                 }
-
-                if (memchr(result_filter_data, 0x1, size) == nullptr) {
-                    *can_filter_all = true;
-                    return Status::OK();
-                }
             }
         } else if (auto* const_column = check_and_get_column<ColumnConst>(*filter_column)) {
             // filter all
             if (!const_column->get_bool(0)) {
-                *can_filter_all = true;
                 memset(result_filter_data, 0, result_filter->size());
-                return Status::OK();
             }
         } else {
             const IColumn::Filter& filter =
@@ -211,11 +249,15 @@ Status VExprContext::execute_conjuncts(const VExprContextSPtrs& ctxs,
             for (size_t i = 0; i < size; ++i) {
                 result_filter_data[i] &= filter_data[i];
             }
+        }
 
-            if (memchr(result_filter_data, 0x1, size) == nullptr) {
-                *can_filter_all = true;
-                return Status::OK();
-            }
+        selected_rows = rows - simd::count_zero_num((int8_t*)result_filter_data, rows);
+        if (sample) {
+            ctx->_conjunct_stats.update(MonotonicNanos() - start_ns, input_rows, selected_rows);
+        }
+        if (selected_rows == 0) {
+            *can_filter_all = true;
+            return Status::OK();
         }
     }
     if (filters != nullptr) {
@@ -234,8 +276,6 @@ Status VExprContext::execute_conjuncts(const VExprContextSPtrs& ctxs,
     return Status::OK();
 }
 
-// TODO Performance Optimization
-// need exception safety
 Status VExprContext::execute_conjuncts_and_filter_block(
         const VExprContextSPtrs& ctxs, const std::vector<IColumn::Filter*>* filters, Block* block,
         std::vector<uint32_t>& columns_to_filter, int column_to_keep) {
@@ -243,10 +283,14 @@ Status VExprContext::execute_conjuncts_and_filter_block(
     bool can_filter_all;
     RETURN_IF_ERROR(
             execute_conjuncts(ctxs, filters, false, block, &result_filter, &can_filter_all));
+    VSharedExprResults* shared_results = ctxs.empty() ? nullptr : ctxs[0]->_shared_expr_results;
     if (can_filter_all) {
         for (auto& col : columns_to_filter) {
             std::move(*block->get_by_position(col).column).assume_mutable()->clear();
         }
+        if (shared_results != nullptr) {
+            shared_results->clear();
+        }
     } else {
         try {
             Block::filter_block_internal(block, columns_to_filter, result_filter);
@@ -263,6 +307,9 @@ Status VExprContext::execute_conjuncts_and_filter_block(
                     "filter_block_internal meet exception, exprs=[{}], exception={}", str,
                     e.what());
         }
+        if (shared_results != nullptr) {
+            shared_results->filter(block, result_filter);
+        }
     }
     Block::erase_useless_column(block, column_to_keep);
     return Status::OK();
@@ -275,18 +322,39 @@ Status VExprContext::execute_conjuncts_and_filter_block(const VExprContextSPtrs&
     filter.resize_fill(block->rows(), 1);
     bool can_filter_all;
     RETURN_IF_ERROR(execute_conjuncts(ctxs, nullptr, false, block, &filter, &can_filter_all));
+    VSharedExprResults* shared_results = ctxs.empty() ? nullptr : ctxs[0]->_shared_expr_results;
     if (can_filter_all) {
         for (auto& col : columns_to_filter) {
             std::move(*block->get_by_position(col).column).assume_mutable()->clear();
         }
+        if (shared_results != nullptr) {
+            shared_results->clear();
+        }
     } else {
         RETURN_IF_CATCH_EXCEPTION(Block::filter_block_internal(block, columns_to_filter, filter));
+        if (shared_results != nullptr) {
+            shared_results->filter(block, filter);
+        }
     }
 
     Block::erase_useless_column(block, column_to_keep);
     return Status::OK();
 }
 
+std::string VExprContext::conjuncts_stats_string(const VExprContextSPtrs& ctxs) {
+    if (std::all_of(ctxs.begin(), ctxs.end(),
+                    [](const auto& ctx) { return ctx->conjunct_stats().input_rows == 0; })) {
+        return "";
+    }
+    std::string info;
+    for (size_t index :
+         conjuncts_order(ctxs, config::conjuncts_reorder_sample_interval > 0 && ctxs.size() > 1)) {
+        info += fmt::format("\n{}: {}", ctxs[index]->root()->expr_name(),
+                            ctxs[index]->conjunct_stats().debug_string());
+    }
+    return info;
+}
+
 Status VExprContext::get_output_block_after_execute_exprs(
         const VExprContextSPtrs& output_vexpr_ctxs, const Block& input_block, Block* output_block) {
     vectorized::Block tmp_block(input_block.get_columns_with_type_and_name());
@@ -20,12 +20,14 @@
 #include <glog/logging.h>
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "common/factory_creator.h"
 #include "common/status.h"
 #include "runtime/types.h"
 #include "udf/udf.h"
+#include "util/predicate_stats.h"
 #include "vec/core/block.h"
 #include "vec/exprs/vexpr_fwd.h"
 
@@ -35,6 +37,7 @@ class RuntimeState;
 } // namespace doris
 
 namespace doris::vectorized {
+class VSharedExprResults;
 
 class VExprContext {
     ENABLE_FACTORY_CREATOR(VExprContext);
@@ -46,6 +49,9 @@ public:
     [[nodiscard]] Status open(RuntimeState* state);
     [[nodiscard]] Status clone(RuntimeState* state, VExprContextSPtr& new_ctx);
     [[nodiscard]] Status execute(Block* block, int* result_column_id);
+    // Execute only on the rows whose `selection` is not zero, see VExpr::execute_on_selection.
+    [[nodiscard]] Status execute_on_selection(Block* block, const IColumn::Filter& selection,
+                                              size_t selected_rows, int* result_column_id);
 
     VExprSPtr root() { return _root; }
     void set_root(const VExprSPtr& expr) { _root = expr; }
@@ -92,6 +98,10 @@ public:
                                                      std::vector<uint32_t>& columns_to_filter,
                                                      int column_to_keep, IColumn::Filter& filter);
 
+    // The conjuncts in the order they are evaluated, with their measured cost and selectivity.
+    // Return an empty string if none of them is measured.
+    static std::string conjuncts_stats_string(const VExprContextSPtrs& ctxs);
+
     [[nodiscard]] static Status get_output_block_after_execute_exprs(const VExprContextSPtrs&,
                                                                      const Block&, Block*);
 
@@ -108,8 +118,16 @@ public:
 
     bool force_materialize_slot() const { return _force_materialize_slot; }
 
+    const PredicateStats& conjunct_stats() const { return _conjunct_stats; }
+
     void set_force_materialize_slot() { _force_materialize_slot = true; }
 
+    /// The results of the subexprs shared with the other contexts of the operator, see
+    /// VSharedExpr. Not copied to the clones.
+    VSharedExprResults* shared_expr_results() const { return _shared_expr_results; }
+
+    void set_shared_expr_results(VSharedExprResults* results) { _shared_expr_results = results; }
+
     VExprContext& operator=(const VExprContext& other) {
         if (this == &other) {
             return *this;
@@ -169,5 +187,13 @@ private:
     // This flag only works on VSlotRef.
     // Force to materialize even if the slot need_materialize is false, we just ignore need_materialize flag
     bool _force_materialize_slot = false;
+
+    /// The cost and the selectivity of this context as a conjunct, measured on one of every
+    /// config::conjuncts_reorder_sample_interval blocks.
+    PredicateStats _conjunct_stats;
+    int64_t _conjunct_executed_times = 0;
+
+    /// Owned by the operator evaluating the exprs, nullptr if no subexpr is shared.
+    VSharedExprResults* _shared_expr_results = nullptr;
 };
 } // namespace doris::vectorized
@@ -0,0 +1,246 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vshared_expr.h"
+
+#include <fmt/format.h>
+#include <gen_cpp/Types_types.h>
+#include <glog/logging.h>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "common/config.h"
+#include "util/simd/bits.h"
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/common/assert_cast.h"
+#include "vec/core/block.h"
+#include "vec/exprs/vcast_expr.h"
+#include "vec/exprs/fused_expr_kernel.h"
+#include "vec/exprs/vectorized_fn_call.h"
+#include "vec/exprs/vexpr_context.h"
+#include "vec/exprs/vliteral.h"
+#include "vec/exprs/vslot_ref.h"
+
+namespace doris::vectorized {
+
+void VSharedExprResults::reset(const Block* block) {
+    _block = block;
+    clear();
+}
+
+void VSharedExprResults::filter(const Block* block, const IColumn::Filter& filter) {
+    if (block != _block) {
+        return;
+    }
+    size_t count = filter.size() - simd::count_zero_num((int8_t*)filter.data(), filter.size());
+    if (count == filter.size()) {
+        return;
+    }
+    for (auto& result : _results) {
+        if (result.column == nullptr) {
+            continue;
+        }
+        if (result.column->size() != filter.size()) {
+            result.column = nullptr;
+            continue;
+        }
+        result.column = result.column->filter(filter, count);
+    }
+}
+
+void VSharedExprResults::clear() {
+    for (auto& result : _results) {
+        result.column = nullptr;
+    }
+}
+
+const ColumnWithTypeAndName* VSharedExprResults::get(size_t id, const Block* block) const {
+    DCHECK_LT(id, _results.size());
+    const auto& result = _results[id];
+    if (block != _block || result.column == nullptr || result.column->size() != block->rows()) {
+        return nullptr;
+    }
+    return &result;
+}
+
+void VSharedExprResults::set(size_t id, const Block* block, const ColumnWithTypeAndName& result) {
+    DCHECK_LT(id, _results.size());
+    if (block == _block) {
+        _results[id] = result;
+    }
+}
+
+void VSharedExprResults::attach_to(const VExprContextSPtrs& ctxs) {
+    for (const auto& ctx : ctxs) {
+        ctx->set_shared_expr_results(this);
+    }
+}
+
+VSharedExpr::VSharedExpr(const VExprSPtr& expr, size_t result_id)
+        : VExpr(*expr), _result_id(result_id) {
+    _children = {expr};
+}
+
+Status VSharedExpr::execute(VExprContext* context, Block* block, int* result_column_id) {
+    auto* results = context->shared_expr_results();
+    if (results != nullptr) {
+        if (const auto* result = results->get(_result_id, block)) {
+            block->insert(*result);
+            *result_column_id = block->columns() - 1;
+            return Status::OK();
+        }
+    }
+    RETURN_IF_ERROR(_children[0]->execute(context, block, result_column_id));
+    if (results != nullptr) {
+        results->set(_result_id, block, block->get_by_position(*result_column_id));
+    }
+    return Status::OK();
+}
+
+std::string VSharedExpr::debug_string() const {
+    return fmt::format("SharedExpr(result_id={} {})", _result_id, _children[0]->debug_string());
+}
+
+// The functions which may return different results on the same arguments.
+static const std::unordered_set<std::string> NON_DETERMINISTIC_FUNCTIONS = {
+        "rand", "random", "random_bytes", "uuid", "uuid_numeric", "sleep"};
+
+static bool append_literal_key(VLiteral* literal, std::string* key) {
+    const IColumn* column = literal->get_column_ptr().get();
+    if (const auto* const_column = check_and_get_column<ColumnConst>(*column)) {
+        column = &const_column->get_data_column();
+    }
+    key->append("l").append(literal->data_type()->get_name()).append("|");
+    if (column->is_null_at(0)) {
+        key->append("null;");
+        return true;
+    }
+    if (const auto* nullable_column = check_and_get_column<ColumnNullable>(*column)) {
+        column = &nullable_column->get_nested_column();
+    }
+    if (!column->is_fixed_and_contiguous() && !check_and_get_column<ColumnString>(*column)) {
+        return false;
+    }
+    // the bytes of the value, the string form of floating point values may lose precision
+    StringRef value = column->get_data_at(0);
+    key->append(std::to_string(value.size)).append(":").append(value.data, value.size);
+    key->append(";");
+    return true;
+}
+
+// Append the key identifying the result of the expr on a block, return false if the result
+// of the expr can't be shared.
+static bool append_key(const VExprSPtr& expr, std::string* key) {
+    if (auto* slot_ref = dynamic_cast<VSlotRef*>(expr.get())) {
+        key->append(fmt::format("s{};", slot_ref->column_id()));
+        return true;
+    }
+    if (auto* literal = dynamic_cast<VLiteral*>(expr.get())) {
+        return append_literal_key(literal, key);
+    }
+    if (dynamic_cast<VectorizedFnCall*>(expr.get()) != nullptr) {
+        const auto& fn = expr->fn();
+        if (fn.binary_type != TFunctionBinaryType::BUILTIN ||
+            NON_DETERMINISTIC_FUNCTIONS.count(fn.name.function_name) > 0) {
+            return false;
+        }
+        key->append("f").append(fn.name.function_name);
+    } else if (dynamic_cast<VCastExpr*>(expr.get()) != nullptr) {
+        key->append("c");
+    } else {
+        return false;
+    }
+    key->append("|").append(expr->data_type()->get_name()).append("(");
+    for (const auto& child : expr->children()) {
+        if (!append_key(child, key)) {
+            return false;
+        }
+    }
+    key->append(")");
+    return true;
+}
+
+static bool is_shareable(const VExprSPtr& expr, std::string* key) {
+    return !expr->children().empty() && !expr->is_constant() && append_key(expr, key);
+}
+
+// The shared exprs and the runtime filters are not looked into.
+static bool skip_subtrees(const VExprSPtr& expr) {
+    return dynamic_cast<VSharedExpr*>(expr.get()) != nullptr || expr->get_impl() != nullptr;
+}
+
+static void count_subtrees(const VExprSPtr& expr, std::unordered_map<std::string, int>* counts) {
+    if (skip_subtrees(expr)) {
+        return;
+    }
+    std::string key;
+    if (is_shareable(expr, &key)) {
+        ++(*counts)[key];
+    }
+    for (const auto& child : expr->children()) {
+        count_subtrees(child, counts);
+    }
+}
+
+static VExprSPtr share_subtrees(const VExprSPtr& expr,
+                                const std::unordered_map<std::string, int>& counts,
+                                std::unordered_map<std::string, size_t>* result_ids) {
+    if (skip_subtrees(expr)) {
+        return expr;
+    }
+    std::string key;
+    if (is_shareable(expr, &key) && counts.at(key) > 1) {
+        auto it = result_ids->emplace(key, result_ids->size()).first;
+        return VSharedExpr::create_shared(expr, it->second);
+    }
+    auto children = expr->children();
+    bool changed = false;
+    for (auto& child : children) {
+        auto shared = share_subtrees(child, counts, result_ids);
+        changed |= shared != child;
+        child = std::move(shared);
+    }
+    if (changed) {
+        expr->set_children(std::move(children));
+    }
+    return expr;
+}
+
+size_t VSharedExpr::share_common_exprs(const VExprContextSPtrs& ctxs) {
+    std::unordered_map<std::string, int> counts;
+    for (const auto& ctx : ctxs) {
+        count_subtrees(ctx->root(), &counts);
+    }
+    std::unordered_map<std::string, size_t> result_ids;
+    for (const auto& ctx : ctxs) {
+        ctx->set_root(share_subtrees(ctx->root(), counts, &result_ids));
+    }
+    // the trees are fused when they are prepared, the kernels across the shared exprs would
+    // evaluate the subtrees without populating the shared results
+    if (!result_ids.empty() && config::enable_fused_expr_kernel) {
+        for (const auto& ctx : ctxs) {
+            FusedExprKernel::refuse(ctx->root());
+        }
+    }
+    return result_ids.size();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,88 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include "common/factory_creator.h"
+#include "common/status.h"
+#include "vec/columns/column.h"
+#include "vec/core/column_with_type_and_name.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_fwd.h"
+
+namespace doris::vectorized {
+class Block;
+
+// The results of the shared subexprs on the block being evaluated by an operator. Each
+// operator instance, or each scanner for the conjuncts of a scan node, owns one and sets it
+// to all of its expr contexts whose trees share the subexprs.
+class VSharedExprResults {
+public:
+    explicit VSharedExprResults(size_t num_results) : _results(num_results) {}
+
+    // Start evaluating the exprs on a new block, the results of the former block are dropped.
+    void reset(const Block* block);
+
+    // Keep the results of the rows selected by `filter`, called after the block is filtered.
+    void filter(const Block* block, const IColumn::Filter& filter);
+
+    // Drop the results, e.g. all the rows of the block are filtered out.
+    void clear();
+
+    // Returns nullptr if the result is not evaluated on the rows of the block yet.
+    const ColumnWithTypeAndName* get(size_t id, const Block* block) const;
+
+    void set(size_t id, const Block* block, const ColumnWithTypeAndName& result);
+
+    void attach_to(const VExprContextSPtrs& ctxs);
+
+private:
+    const Block* _block = nullptr;
+    std::vector<ColumnWithTypeAndName> _results;
+};
+
+// Wraps an occurrence of a deterministic subtree which appears more than once in the exprs of
+// an operator. The first occurrence executed on a block evaluates the subtree, the others
+// reuse its result column. Each occurrence keeps its own subtree, whose function contexts are
+// registered in its own expr context.
+class VSharedExpr final : public VExpr {
+    ENABLE_FACTORY_CREATOR(VSharedExpr);
+
+public:
+    VSharedExpr(const VExprSPtr& expr, size_t result_id);
+
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override;
+
+    const std::string& expr_name() const override { return _children[0]->expr_name(); }
+
+    std::string debug_string() const override;
+
+    // Replace the identical subtrees of the prepared exprs by VSharedExpr, return the number of
+    // the shared results, 0 if none of the subtrees is shared. Slot refs, literals and constant
+    // subtrees are not shared.
+    static size_t share_common_exprs(const VExprContextSPtrs& ctxs);
+
+private:
+    size_t _result_id;
+};
+
+} // namespace doris::vectorized
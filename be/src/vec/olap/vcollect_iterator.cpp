@@ -322,6 +322,20 @@ Status VCollectIterator::_topn_next(Block* block) {
                 }
             }
 
+            // the rows of the rowset are in the order of the key, the rest of the rowset is not
+            // in the result if the first row is out of the threshold of all the topn instances
+            if (_reader->_reader_context.use_topn_opt && block->rows() > 0) {
+                auto query_ctx = _reader->_reader_context.runtime_state->get_query_ctx();
+                Field top = query_ctx->get_runtime_predicate().get_orderby_extrem();
+                Field first;
+                block->get_by_position(first_sort_column_idx).column->get(0, first);
+                if (!top.is_null() && !first.is_null() &&
+                    (_is_reverse ? first < top : first > top)) {
+                    VLOG_DEBUG << "topn debug skip the rest of rowset " << i;
+                    break;
+                }
+            }
+
             // update read rows
             read_rows += block->rows();
 
@@ -367,6 +381,10 @@ Status VCollectIterator::_topn_next(Block* block) {
                         break;
                     }
                 }
+                // the rest rows of the rowset are not less than the last row
+                if (rows_to_copy < block->rows()) {
+                    eof = true;
+                }
             }
 
             if (rows_to_copy > 0) {
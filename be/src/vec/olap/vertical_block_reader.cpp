@@ -70,26 +70,32 @@ Status VerticalBlockReader::_get_segment_iterators(const ReaderParams& read_para
         // In vertical compaction, every group will load segment so we should cache
         // segment to avoid tot many s3 head request
         RETURN_IF_ERROR(rs_split.rs_reader->get_segment_iterators(&_reader_context, segment_iters,
-                                                                  {}, true));
+                                                                  rs_split, true));
+        // only segments [seg_start, seg_end) are read if the rowset is split
+        auto [seg_start, seg_end] = rs_split.segment_offsets;
+        if (seg_start == seg_end) {
+            seg_start = 0;
+            seg_end = rs_split.rs_reader->rowset()->num_segments();
+        }
         // if segments overlapping, all segment iterator should be inited in
         // heap merge iterator. If segments are none overlapping, only first segment of this
         // rowset will be inited and push to heap, other segment will be inited later when current
         // segment reached it's end.
         // Use this iterator_init_flag so we can load few segments in HeapMergeIterator to save memory
         if (rs_split.rs_reader->rowset()->is_segments_overlapping()) {
-            for (int i = 0; i < rs_split.rs_reader->rowset()->num_segments(); ++i) {
+            for (int i = seg_start; i < seg_end; ++i) {
                 iterator_init_flag->push_back(true);
             }
         } else {
-            for (int i = 0; i < rs_split.rs_reader->rowset()->num_segments(); ++i) {
-                if (i == 0) {
+            for (int i = seg_start; i < seg_end; ++i) {
+                if (i == seg_start) {
                     iterator_init_flag->push_back(true);
                     continue;
                 }
                 iterator_init_flag->push_back(false);
             }
         }
-        for (int i = 0; i < rs_split.rs_reader->rowset()->num_segments(); ++i) {
+        for (int i = seg_start; i < seg_end; ++i) {
             rowset_ids->push_back(rs_split.rs_reader->rowset()->rowset_id());
         }
         rs_split.rs_reader->reset_read_options();
@@ -18,6 +18,7 @@
 #include "vec/runtime/vparquet_writer.h"
 
 #include <arrow/io/type_fwd.h>
+#include <fmt/format.h>
 #include <glog/logging.h>
 #include <math.h>
 #include <parquet/column_writer.h>
@@ -30,9 +31,12 @@
 #include <algorithm>
 #include <cstdint>
 #include <exception>
+#include <iterator>
 #include <ostream>
 #include <string>
+#include <vector>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "io/fs/file_writer.h"
 #include "olap/olap_common.h"
@@ -316,86 +320,122 @@ Status VParquetWriterWrapper::parse_schema() {
 #define RETURN_WRONG_TYPE \
     return Status::InvalidArgument("Invalid column type: {}", raw_column->get_name());
 
-#define DISPATCH_PARQUET_NUMERIC_WRITER(WRITER, COLUMN_TYPE, NATIVE_TYPE)                         \
-    parquet::RowGroupWriter* rgWriter = get_rg_writer();                                          \
-    parquet::WRITER* col_writer = static_cast<parquet::WRITER*>(rgWriter->column(i));             \
-    if (null_map != nullptr) {                                                                    \
-        auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();                  \
-        for (size_t row_id = 0; row_id < sz; row_id++) {                                          \
-            def_level[row_id] = null_data[row_id] == 0;                                           \
-        }                                                                                         \
-        col_writer->WriteBatch(sz, def_level.data(), nullptr,                                     \
-                               reinterpret_cast<const NATIVE_TYPE*>(                              \
-                                       assert_cast<const COLUMN_TYPE&>(*col).get_data().data())); \
-    } else if (const auto* not_nullable_column = check_and_get_column<const COLUMN_TYPE>(col)) {  \
-        col_writer->WriteBatch(                                                                   \
-                sz, nullable ? def_level.data() : nullptr, nullptr,                               \
-                reinterpret_cast<const NATIVE_TYPE*>(not_nullable_column->get_data().data()));    \
-    } else {                                                                                      \
-        RETURN_WRONG_TYPE                                                                         \
+namespace {
+
+// Write the values of all the rows of a column in one batch. For the nullable column,
+// only the values of not null rows are passed to parquet, def_levels marks the nulls.
+template <typename WriterType, typename ValueType, typename Converter>
+Status write_converted_batch(parquet::RowGroupWriter* rg_writer, int col_id, size_t sz,
+                             const int16_t* def_levels, const NullMap* null_map,
+                             Converter&& convert) {
+    auto* col_writer = static_cast<WriterType*>(rg_writer->column(col_id));
+    std::vector<ValueType> values;
+    values.reserve(sz);
+    for (size_t row_id = 0; row_id < sz; row_id++) {
+        if (null_map != nullptr && (*null_map)[row_id] != 0) {
+            continue;
+        }
+        ValueType value;
+        RETURN_IF_ERROR(convert(row_id, &value));
+        values.push_back(value);
+    }
+    col_writer->WriteBatch(sz, def_levels, nullptr, values.data());
+    return Status::OK();
+}
+
+template <typename WriterType, typename ValueType, typename ColumnType>
+void write_numeric_batch(parquet::RowGroupWriter* rg_writer, int col_id, size_t sz,
+                         const int16_t* def_levels, const NullMap* null_map,
+                         const ColumnType& column) {
+    const auto& data = column.get_data();
+    if (null_map == nullptr && sizeof(ValueType) == sizeof(typename ColumnType::value_type)) {
+        // the data can be written directly
+        auto* col_writer = static_cast<WriterType*>(rg_writer->column(col_id));
+        col_writer->WriteBatch(sz, def_levels, nullptr,
+                               reinterpret_cast<const ValueType*>(data.data()));
+        return;
+    }
+    static_cast<void>(write_converted_batch<WriterType, ValueType>(
+            rg_writer, col_id, sz, def_levels, null_map, [&](size_t row_id, ValueType* value) {
+                *value = static_cast<ValueType>(data[row_id]);
+                return Status::OK();
+            }));
+}
+
+// Write the byte array values of a column in one batch.
+// `append` appends the value of a row to the buffer, the values refer to the buffer.
+template <typename Appender>
+Status write_byte_array_batch(parquet::RowGroupWriter* rg_writer, int col_id, size_t sz,
+                              const int16_t* def_levels, const NullMap* null_map,
+                              Appender&& append) {
+    auto* col_writer = static_cast<parquet::ByteArrayWriter*>(rg_writer->column(col_id));
+    std::string buffer;
+    std::vector<uint32_t> lengths;
+    lengths.reserve(sz);
+    for (size_t row_id = 0; row_id < sz; row_id++) {
+        if (null_map != nullptr && (*null_map)[row_id] != 0) {
+            continue;
+        }
+        size_t old_size = buffer.size();
+        RETURN_IF_ERROR(append(row_id, buffer));
+        lengths.push_back(buffer.size() - old_size);
+    }
+    std::vector<parquet::ByteArray> values(lengths.size());
+    const auto* ptr = reinterpret_cast<const uint8_t*>(buffer.data());
+    for (size_t i = 0; i < lengths.size(); i++) {
+        values[i].len = lengths[i];
+        values[i].ptr = ptr;
+        ptr += lengths[i];
+    }
+    col_writer->WriteBatch(sz, def_levels, nullptr, values.data());
+    return Status::OK();
+}
+
+// Write the values of a string like column in one batch, the values refer to the column.
+template <typename ColumnType>
+void write_string_batch(parquet::RowGroupWriter* rg_writer, int col_id, size_t sz,
+                        const int16_t* def_levels, const NullMap* null_map,
+                        const ColumnType& column) {
+    auto* col_writer = static_cast<parquet::ByteArrayWriter*>(rg_writer->column(col_id));
+    std::vector<parquet::ByteArray> values;
+    values.reserve(sz);
+    for (size_t row_id = 0; row_id < sz; row_id++) {
+        if (null_map != nullptr && (*null_map)[row_id] != 0) {
+            continue;
+        }
+        const auto& tmp = column.get_data_at(row_id);
+        values.emplace_back(tmp.size, reinterpret_cast<const uint8_t*>(tmp.data));
+    }
+    col_writer->WriteBatch(sz, def_levels, nullptr, values.data());
+}
+
+} // namespace
+
+#define DISPATCH_PARQUET_NUMERIC_WRITER(WRITER, COLUMN_TYPE, NATIVE_TYPE)                      \
+    if (const auto* not_nullable_column = check_and_get_column<const COLUMN_TYPE>(col)) {      \
+        write_numeric_batch<parquet::WRITER, NATIVE_TYPE>(get_rg_writer(), i, sz, def_levels,  \
+                                                          null_data, *not_nullable_column);    \
+    } else {                                                                                   \
+        RETURN_WRONG_TYPE                                                                      \
     }
 
 #define DISPATCH_PARQUET_DECIMAL_WRITER(DECIMAL_TYPE)                                            \
-    parquet::RowGroupWriter* rgWriter = get_rg_writer();                                         \
-    parquet::ByteArrayWriter* col_writer =                                                       \
-            static_cast<parquet::ByteArrayWriter*>(rgWriter->column(i));                         \
-    parquet::ByteArray value;                                                                    \
     auto decimal_type =                                                                          \
             check_and_get_data_type<DataTypeDecimal<DECIMAL_TYPE>>(remove_nullable(type).get()); \
     DCHECK(decimal_type);                                                                        \
-    if (null_map != nullptr) {                                                                   \
-        auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();                 \
-        for (size_t row_id = 0; row_id < sz; row_id++) {                                         \
-            if (null_data[row_id] != 0) {                                                        \
-                single_def_level = 0;                                                            \
-                col_writer->WriteBatch(1, &single_def_level, nullptr, &value);                   \
-                single_def_level = 1;                                                            \
-            } else {                                                                             \
-                auto s = decimal_type->to_string(*col, row_id);                                  \
-                value.ptr = reinterpret_cast<const uint8_t*>(s.data());                          \
-                value.len = s.size();                                                            \
-                col_writer->WriteBatch(1, &single_def_level, nullptr, &value);                   \
-            }                                                                                    \
-        }                                                                                        \
-    } else {                                                                                     \
-        for (size_t row_id = 0; row_id < sz; row_id++) {                                         \
-            auto s = decimal_type->to_string(*col, row_id);                                      \
-            value.ptr = reinterpret_cast<const uint8_t*>(s.data());                              \
-            value.len = s.size();                                                                \
-            col_writer->WriteBatch(1, nullable ? def_level.data() : nullptr, nullptr, &value);   \
-        }                                                                                        \
-    }
-
-#define DISPATCH_PARQUET_COMPLEX_WRITER(COLUMN_TYPE)                                             \
-    parquet::RowGroupWriter* rgWriter = get_rg_writer();                                         \
-    parquet::ByteArrayWriter* col_writer =                                                       \
-            static_cast<parquet::ByteArrayWriter*>(rgWriter->column(i));                         \
-    if (null_map != nullptr) {                                                                   \
-        auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();                 \
-        for (size_t row_id = 0; row_id < sz; row_id++) {                                         \
-            if (null_data[row_id] != 0) {                                                        \
-                single_def_level = 0;                                                            \
-                parquet::ByteArray value;                                                        \
-                col_writer->WriteBatch(1, &single_def_level, nullptr, &value);                   \
-                single_def_level = 1;                                                            \
-            } else {                                                                             \
-                const auto& tmp = col->get_data_at(row_id);                                      \
-                parquet::ByteArray value;                                                        \
-                value.ptr = reinterpret_cast<const uint8_t*>(tmp.data);                          \
-                value.len = tmp.size;                                                            \
-                col_writer->WriteBatch(1, &single_def_level, nullptr, &value);                   \
-            }                                                                                    \
-        }                                                                                        \
-    } else if (const auto* not_nullable_column = check_and_get_column<const COLUMN_TYPE>(col)) { \
-        for (size_t row_id = 0; row_id < sz; row_id++) {                                         \
-            const auto& tmp = not_nullable_column->get_data_at(row_id);                          \
-            parquet::ByteArray value;                                                            \
-            value.ptr = reinterpret_cast<const uint8_t*>(tmp.data);                              \
-            value.len = tmp.size;                                                                \
-            col_writer->WriteBatch(1, nullable ? &single_def_level : nullptr, nullptr, &value);  \
-        }                                                                                        \
-    } else {                                                                                     \
-        RETURN_WRONG_TYPE                                                                        \
+    RETURN_IF_ERROR(write_byte_array_batch(get_rg_writer(), i, sz, def_levels, null_data,        \
+                                           [&](size_t row_id, std::string& buffer) {             \
+                                               buffer.append(decimal_type->to_string(*col,       \
+                                                                                     row_id));   \
+                                               return Status::OK();                              \
+                                           }));
+
+#define DISPATCH_PARQUET_COMPLEX_WRITER(COLUMN_TYPE)                                           \
+    if (const auto* not_nullable_column = check_and_get_column<const COLUMN_TYPE>(col)) {      \
+        write_string_batch(get_rg_writer(), i, sz, def_levels, null_data,                      \
+                           *not_nullable_column);                                              \
+    } else {                                                                                   \
+        RETURN_WRONG_TYPE                                                                      \
     }
 
 Status VParquetWriterWrapper::write(const Block& block) {
@@ -403,7 +443,11 @@ Status VParquetWriterWrapper::write(const Block& block) {
         return Status::OK();
     }
     size_t sz = block.rows();
+    std::vector<int16_t> def_level(sz);
     try {
+        // Roll over to a new row group only between blocks, so that every column of a row
+        // group has the same number of rows.
+        RETURN_IF_ERROR(roll_over_row_group_if_needed());
         for (size_t i = 0; i < block.columns(); i++) {
             auto& raw_column = block.get_by_position(i).column;
             auto nullable = raw_column->is_nullable();
@@ -421,10 +465,17 @@ Status VParquetWriterWrapper::write(const Block& block) {
                                     : nullptr;
             auto& type = block.get_by_position(i).type;
 
-            std::vector<int16_t> def_level(sz);
             // For scalar type, definition level == 1 means this value is not NULL.
-            std::fill(def_level.begin(), def_level.end(), 1);
-            int16_t single_def_level = 1;
+            const NullMap* null_data = nullptr;
+            if (null_map != nullptr) {
+                null_data = &assert_cast<const ColumnUInt8&>(*null_map).get_data();
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    def_level[row_id] = (*null_data)[row_id] == 0;
+                }
+            } else {
+                std::fill(def_level.begin(), def_level.end(), 1);
+            }
+            const int16_t* def_levels = nullable ? def_level.data() : nullptr;
             switch (_output_vexpr_ctxs[i]->root()->type().type) {
             case TYPE_BOOLEAN: {
                 DISPATCH_PARQUET_NUMERIC_WRITER(BoolWriter, ColumnVector<UInt8>, bool)
@@ -435,36 +486,15 @@ Status VParquetWriterWrapper::write(const Block& block) {
                 break;
             }
             case TYPE_LARGEINT: {
-                parquet::RowGroupWriter* rgWriter = get_rg_writer();
-                parquet::ByteArrayWriter* col_writer =
-                        static_cast<parquet::ByteArrayWriter*>(rgWriter->column(i));
-                parquet::ByteArray value;
-                if (null_map != nullptr) {
-                    auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        if (null_data[row_id] != 0) {
-                            single_def_level = 0;
-                            col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
-                            single_def_level = 1;
-                        } else {
-                            const int128_t tmp = assert_cast<const ColumnVector<Int128>&>(*col)
-                                                         .get_data()[row_id];
-                            std::string value_str = fmt::format("{}", tmp);
-                            value.ptr = reinterpret_cast<const uint8_t*>(value_str.data());
-                            value.len = value_str.length();
-                            col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
-                        }
-                    }
-                } else if (const auto* not_nullable_column =
-                                   check_and_get_column<const ColumnVector<Int128>>(col)) {
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        const int128_t tmp = not_nullable_column->get_data()[row_id];
-                        std::string value_str = fmt::format("{}", tmp);
-                        value.ptr = reinterpret_cast<const uint8_t*>(value_str.data());
-                        value.len = value_str.length();
-                        col_writer->WriteBatch(1, nullable ? &single_def_level : nullptr, nullptr,
-                                               &value);
-                    }
+                if (const auto* not_nullable_column =
+                            check_and_get_column<const ColumnVector<Int128>>(col)) {
+                    const auto& data = not_nullable_column->get_data();
+                    RETURN_IF_ERROR(write_byte_array_batch(
+                            get_rg_writer(), i, sz, def_levels, null_data,
+                            [&](size_t row_id, std::string& buffer) {
+                                fmt::format_to(std::back_inserter(buffer), "{}", data[row_id]);
+                                return Status::OK();
+                            }));
                 } else {
                     RETURN_WRONG_TYPE
                 }
@@ -480,50 +510,14 @@ Status VParquetWriterWrapper::write(const Block& block) {
             }
             case TYPE_TINYINT:
             case TYPE_SMALLINT: {
-                parquet::RowGroupWriter* rgWriter = get_rg_writer();
-                parquet::Int32Writer* col_writer =
-                        static_cast<parquet::Int32Writer*>(rgWriter->column(i));
-                if (null_map != nullptr) {
-                    auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
-                    if (const auto* int16_column =
-                                check_and_get_column<const ColumnVector<Int16>>(col)) {
-                        for (size_t row_id = 0; row_id < sz; row_id++) {
-                            if (null_data[row_id] != 0) {
-                                single_def_level = 0;
-                            }
-                            const int32_t tmp = int16_column->get_data()[row_id];
-                            col_writer->WriteBatch(1, &single_def_level, nullptr,
-                                                   reinterpret_cast<const int32_t*>(&tmp));
-                            single_def_level = 1;
-                        }
-                    } else if (const auto* int8_column =
-                                       check_and_get_column<const ColumnVector<Int8>>(col)) {
-                        for (size_t row_id = 0; row_id < sz; row_id++) {
-                            if (null_data[row_id] != 0) {
-                                single_def_level = 0;
-                            }
-                            const int32_t tmp = int8_column->get_data()[row_id];
-                            col_writer->WriteBatch(1, &single_def_level, nullptr,
-                                                   reinterpret_cast<const int32_t*>(&tmp));
-                            single_def_level = 1;
-                        }
-                    } else {
-                        RETURN_WRONG_TYPE
-                    }
-                } else if (const auto& int16_column =
-                                   check_and_get_column<const ColumnVector<Int16>>(col)) {
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        const int32_t tmp = int16_column->get_data()[row_id];
-                        col_writer->WriteBatch(1, nullable ? def_level.data() : nullptr, nullptr,
-                                               reinterpret_cast<const int32_t*>(&tmp));
-                    }
-                } else if (const auto& int8_column =
+                if (const auto* int16_column =
+                            check_and_get_column<const ColumnVector<Int16>>(col)) {
+                    write_numeric_batch<parquet::Int32Writer, int32_t>(
+                            get_rg_writer(), i, sz, def_levels, null_data, *int16_column);
+                } else if (const auto* int8_column =
                                    check_and_get_column<const ColumnVector<Int8>>(col)) {
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        const int32_t tmp = int8_column->get_data()[row_id];
-                        col_writer->WriteBatch(1, nullable ? def_level.data() : nullptr, nullptr,
-                                               reinterpret_cast<const int32_t*>(&tmp));
-                    }
+                    write_numeric_batch<parquet::Int32Writer, int32_t>(
+                            get_rg_writer(), i, sz, def_levels, null_data, *int8_column);
                 } else {
                     RETURN_WRONG_TYPE
                 }
@@ -534,193 +528,91 @@ Status VParquetWriterWrapper::write(const Block& block) {
                 break;
             }
             case TYPE_DATETIME: {
-                parquet::RowGroupWriter* rgWriter = get_rg_writer();
-                parquet::Int64Writer* col_writer =
-                        static_cast<parquet::Int64Writer*>(rgWriter->column(i));
-                uint64_t default_int64 = 0;
-                if (null_map != nullptr) {
-                    auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        def_level[row_id] = null_data[row_id] == 0;
-                    }
-                    int64_t tmp_data[sz];
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        if (null_data[row_id] != 0) {
-                            tmp_data[row_id] = default_int64;
-                        } else {
-                            VecDateTimeValue datetime_value = binary_cast<Int64, VecDateTimeValue>(
-                                    assert_cast<const ColumnVector<Int64>&>(*col)
-                                            .get_data()[row_id]);
-                            if (!datetime_value.unix_timestamp(&tmp_data[row_id],
-                                                               TimezoneUtils::default_time_zone)) {
-                                return Status::InternalError("get unix timestamp error.");
-                            }
-                            // -2177481943 represent '1900-12-31 23:54:17'
-                            // but -2177481944 represent '1900-12-31 23:59:59'
-                            // so for timestamp <= -2177481944, we subtract 343 (5min 43s)
-                            if (tmp_data[row_id] < timestamp_threshold) {
-                                tmp_data[row_id] -= timestamp_diff;
-                            }
-                            // convert seconds to MILLIS seconds
-                            tmp_data[row_id] *= 1000;
-                        }
-                    }
-                    col_writer->WriteBatch(sz, def_level.data(), nullptr,
-                                           reinterpret_cast<const int64_t*>(tmp_data));
-                } else if (const auto* not_nullable_column =
-                                   check_and_get_column<const ColumnVector<Int64>>(col)) {
-                    std::vector<int64_t> res(sz);
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        VecDateTimeValue datetime_value = binary_cast<Int64, VecDateTimeValue>(
-                                not_nullable_column->get_data()[row_id]);
-
-                        if (!datetime_value.unix_timestamp(&res[row_id],
-                                                           TimezoneUtils::default_time_zone)) {
-                            return Status::InternalError("get unix timestamp error.");
-                        };
-                        // -2177481943 represent '1900-12-31 23:54:17'
-                        // but -2177481944 represent '1900-12-31 23:59:59'
-                        // so for timestamp <= -2177481944, we subtract 343 (5min 43s)
-                        if (res[row_id] < timestamp_threshold) {
-                            res[row_id] -= timestamp_diff;
-                        }
-                        // convert seconds to MILLIS seconds
-                        res[row_id] *= 1000;
-                    }
-                    col_writer->WriteBatch(sz, nullable ? def_level.data() : nullptr, nullptr,
-                                           reinterpret_cast<const int64_t*>(res.data()));
+                if (const auto* not_nullable_column =
+                            check_and_get_column<const ColumnVector<Int64>>(col)) {
+                    const auto& data = not_nullable_column->get_data();
+                    RETURN_IF_ERROR((write_converted_batch<parquet::Int64Writer, int64_t>(
+                            get_rg_writer(), i, sz, def_levels, null_data,
+                            [&](size_t row_id, int64_t* value) {
+                                VecDateTimeValue datetime_value =
+                                        binary_cast<Int64, VecDateTimeValue>(data[row_id]);
+                                if (!datetime_value.unix_timestamp(
+                                            value, TimezoneUtils::default_time_zone)) {
+                                    return Status::InternalError("get unix timestamp error.");
+                                }
+                                // -2177481943 represent '1900-12-31 23:54:17'
+                                // but -2177481944 represent '1900-12-31 23:59:59'
+                                // so for timestamp <= -2177481944, we subtract 343 (5min 43s)
+                                if (*value < timestamp_threshold) {
+                                    *value -= timestamp_diff;
+                                }
+                                // convert seconds to MILLIS seconds
+                                *value *= 1000;
+                                return Status::OK();
+                            })));
                 } else {
                     RETURN_WRONG_TYPE
                 }
                 break;
             }
             case TYPE_DATE: {
-                parquet::RowGroupWriter* rgWriter = get_rg_writer();
-                parquet::Int64Writer* col_writer =
-                        static_cast<parquet::Int64Writer*>(rgWriter->column(i));
-                uint64_t default_int64 = 0;
-                if (null_map != nullptr) {
-                    auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        def_level[row_id] = null_data[row_id] == 0;
-                    }
-                    VecDateTimeValue epoch_date;
-                    if (!epoch_date.from_date_str(epoch_date_str.c_str(),
-                                                  epoch_date_str.length())) {
-                        return Status::InternalError("create epoch date from string error");
-                    }
-                    int32_t days_from_epoch = epoch_date.daynr();
-                    int32_t tmp_data[sz];
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        if (null_data[row_id] != 0) {
-                            tmp_data[row_id] = default_int64;
-                        } else {
-                            int32_t days = binary_cast<Int64, VecDateTimeValue>(
-                                                   assert_cast<const ColumnVector<Int64>&>(*col)
-                                                           .get_data()[row_id])
-                                                   .daynr();
-                            tmp_data[row_id] = days - days_from_epoch;
-                        }
-                    }
-                    col_writer->WriteBatch(sz, def_level.data(), nullptr,
-                                           reinterpret_cast<const int64_t*>(tmp_data));
-                } else if (check_and_get_column<const ColumnVector<Int64>>(col)) {
+                if (const auto* not_nullable_column =
+                            check_and_get_column<const ColumnVector<Int64>>(col)) {
                     VecDateTimeValue epoch_date;
                     if (!epoch_date.from_date_str(epoch_date_str.c_str(),
                                                   epoch_date_str.length())) {
                         return Status::InternalError("create epoch date from string error");
                     }
                     int32_t days_from_epoch = epoch_date.daynr();
-                    std::vector<int32_t> res(sz);
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        int32_t days = binary_cast<Int64, VecDateTimeValue>(
-                                               assert_cast<const ColumnVector<Int64>&>(*col)
-                                                       .get_data()[row_id])
-                                               .daynr();
-                        res[row_id] = days - days_from_epoch;
-                    }
-                    col_writer->WriteBatch(sz, nullable ? def_level.data() : nullptr, nullptr,
-                                           reinterpret_cast<const int64_t*>(res.data()));
+                    const auto& data = not_nullable_column->get_data();
+                    RETURN_IF_ERROR((write_converted_batch<parquet::Int32Writer, int32_t>(
+                            get_rg_writer(), i, sz, def_levels, null_data,
+                            [&](size_t row_id, int32_t* value) {
+                                int32_t days =
+                                        binary_cast<Int64, VecDateTimeValue>(data[row_id]).daynr();
+                                *value = days - days_from_epoch;
+                                return Status::OK();
+                            })));
                 } else {
                     RETURN_WRONG_TYPE
                 }
                 break;
             }
             case TYPE_DATEV2: {
-                parquet::RowGroupWriter* rgWriter = get_rg_writer();
-                parquet::ByteArrayWriter* col_writer =
-                        static_cast<parquet::ByteArrayWriter*>(rgWriter->column(i));
-                parquet::ByteArray value;
-                if (null_map != nullptr) {
-                    auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        if (null_data[row_id] != 0) {
-                            single_def_level = 0;
-                            col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
-                            single_def_level = 1;
-                        } else {
-                            char buffer[30];
-                            int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
-                            value.ptr = reinterpret_cast<const uint8_t*>(buffer);
-                            value.len = binary_cast<UInt32, DateV2Value<DateV2ValueType>>(
-                                                assert_cast<const ColumnVector<UInt32>&>(*col)
-                                                        .get_data()[row_id])
-                                                .to_buffer(buffer, output_scale);
-                            col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
-                        }
-                    }
-                } else if (const auto* not_nullable_column =
-                                   check_and_get_column<const ColumnVector<UInt32>>(col)) {
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        char buffer[30];
-                        int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
-                        value.ptr = reinterpret_cast<const uint8_t*>(buffer);
-                        value.len = binary_cast<UInt32, DateV2Value<DateV2ValueType>>(
-                                            not_nullable_column->get_data()[row_id])
-                                            .to_buffer(buffer, output_scale);
-                        col_writer->WriteBatch(1, nullable ? &single_def_level : nullptr, nullptr,
-                                               &value);
-                    }
+                if (const auto* not_nullable_column =
+                            check_and_get_column<const ColumnVector<UInt32>>(col)) {
+                    const auto& data = not_nullable_column->get_data();
+                    int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
+                    RETURN_IF_ERROR(write_byte_array_batch(
+                            get_rg_writer(), i, sz, def_levels, null_data,
+                            [&](size_t row_id, std::string& buffer) {
+                                char tmp[30];
+                                auto len = binary_cast<UInt32, DateV2Value<DateV2ValueType>>(
+                                                   data[row_id])
+                                                   .to_buffer(tmp, output_scale);
+                                buffer.append(tmp, len);
+                                return Status::OK();
+                            }));
                 } else {
                     RETURN_WRONG_TYPE
                 }
                 break;
             }
             case TYPE_DATETIMEV2: {
-                parquet::RowGroupWriter* rgWriter = get_rg_writer();
-                parquet::ByteArrayWriter* col_writer =
-                        static_cast<parquet::ByteArrayWriter*>(rgWriter->column(i));
-                parquet::ByteArray value;
-                if (null_map != nullptr) {
-                    auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        if (null_data[row_id] != 0) {
-                            single_def_level = 0;
-                            col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
-                            single_def_level = 1;
-                        } else {
-                            char buffer[30];
-                            int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
-                            value.ptr = reinterpret_cast<const uint8_t*>(buffer);
-                            value.len = binary_cast<UInt64, DateV2Value<DateTimeV2ValueType>>(
-                                                assert_cast<const ColumnVector<UInt64>&>(*col)
-                                                        .get_data()[row_id])
-                                                .to_buffer(buffer, output_scale);
-                            col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
-                        }
-                    }
-                } else if (const auto* not_nullable_column =
-                                   check_and_get_column<const ColumnVector<UInt64>>(col)) {
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        char buffer[30];
-                        int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
-                        value.ptr = reinterpret_cast<const uint8_t*>(buffer);
-                        value.len = binary_cast<UInt64, DateV2Value<DateTimeV2ValueType>>(
-                                            not_nullable_column->get_data()[row_id])
-                                            .to_buffer(buffer, output_scale);
-                        col_writer->WriteBatch(1, nullable ? &single_def_level : nullptr, nullptr,
-                                               &value);
-                    }
+                if (const auto* not_nullable_column =
+                            check_and_get_column<const ColumnVector<UInt64>>(col)) {
+                    const auto& data = not_nullable_column->get_data();
+                    int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
+                    RETURN_IF_ERROR(write_byte_array_batch(
+                            get_rg_writer(), i, sz, def_levels, null_data,
+                            [&](size_t row_id, std::string& buffer) {
+                                char tmp[30];
+                                auto len = binary_cast<UInt64, DateV2Value<DateTimeV2ValueType>>(
+                                                   data[row_id])
+                                                   .to_buffer(tmp, output_scale);
+                                buffer.append(tmp, len);
+                                return Status::OK();
+                            }));
                 } else {
                     RETURN_WRONG_TYPE
                 }
@@ -749,42 +641,21 @@ Status VParquetWriterWrapper::write(const Block& block) {
                 break;
             }
             case TYPE_DECIMALV2: {
-                parquet::RowGroupWriter* rgWriter = get_rg_writer();
-                parquet::ByteArrayWriter* col_writer =
-                        static_cast<parquet::ByteArrayWriter*>(rgWriter->column(i));
-                parquet::ByteArray value;
-                if (null_map != nullptr) {
-                    auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        if (null_data[row_id] != 0) {
-                            single_def_level = 0;
-                            col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
-                            single_def_level = 1;
-                        } else {
-                            const DecimalV2Value decimal_val(reinterpret_cast<const PackedInt128*>(
-                                                                     col->get_data_at(row_id).data)
-                                                                     ->value);
-                            char decimal_buffer[MAX_DECIMAL_WIDTH];
-                            int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
-                            value.ptr = reinterpret_cast<const uint8_t*>(decimal_buffer);
-                            value.len = decimal_val.to_buffer(decimal_buffer, output_scale);
-                            col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
-                        }
-                    }
-                } else if (const auto* not_nullable_column =
-                                   check_and_get_column<const ColumnDecimal128>(col)) {
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        const DecimalV2Value decimal_val(
-                                reinterpret_cast<const PackedInt128*>(
-                                        not_nullable_column->get_data_at(row_id).data)
-                                        ->value);
-                        char decimal_buffer[MAX_DECIMAL_WIDTH];
-                        int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
-                        value.ptr = reinterpret_cast<const uint8_t*>(decimal_buffer);
-                        value.len = decimal_val.to_buffer(decimal_buffer, output_scale);
-                        col_writer->WriteBatch(1, nullable ? &single_def_level : nullptr, nullptr,
-                                               &value);
-                    }
+                if (const auto* not_nullable_column =
+                            check_and_get_column<const ColumnDecimal128>(col)) {
+                    int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
+                    RETURN_IF_ERROR(write_byte_array_batch(
+                            get_rg_writer(), i, sz, def_levels, null_data,
+                            [&](size_t row_id, std::string& buffer) {
+                                const DecimalV2Value decimal_val(
+                                        reinterpret_cast<const PackedInt128*>(
+                                                not_nullable_column->get_data_at(row_id).data)
+                                                ->value);
+                                char decimal_buffer[MAX_DECIMAL_WIDTH];
+                                auto len = decimal_val.to_buffer(decimal_buffer, output_scale);
+                                buffer.append(decimal_buffer, len);
+                                return Status::OK();
+                            }));
                 } else {
                     RETURN_WRONG_TYPE
                 }
@@ -832,16 +703,19 @@ Status VParquetWriterWrapper::prepare() {
     return Status::OK();
 }
 
-parquet::RowGroupWriter* VParquetWriterWrapper::get_rg_writer() {
+Status VParquetWriterWrapper::roll_over_row_group_if_needed() {
     if (_rg_writer == nullptr) {
         _rg_writer = _writer->AppendBufferedRowGroup();
+        return Status::OK();
     }
-    if (_cur_written_rows > _max_row_per_group) {
+    if (_cur_written_rows > 0 &&
+        _rg_writer->total_bytes_written() + _rg_writer->total_compressed_bytes() >=
+                config::parquet_writer_row_group_max_buffer_mb * 1024L * 1024L) {
         _rg_writer->Close();
         _rg_writer = _writer->AppendBufferedRowGroup();
         _cur_written_rows = 0;
     }
-    return _rg_writer;
+    return Status::OK();
 }
 
 int64_t VParquetWriterWrapper::written_len() {
@@ -133,7 +133,11 @@ public:
     int64_t written_len() override;
 
 private:
-    parquet::RowGroupWriter* get_rg_writer();
+    parquet::RowGroupWriter* get_rg_writer() { return _rg_writer; }
+
+    // Close the current row group and start a new one if the buffered data of the current
+    // row group reaches parquet_writer_row_group_max_buffer_mb.
+    Status roll_over_row_group_if_needed();
 
     Status parse_schema();
 
@@ -145,7 +149,6 @@ private:
     std::shared_ptr<parquet::schema::GroupNode> _schema;
     std::unique_ptr<parquet::ParquetFileWriter> _writer;
     parquet::RowGroupWriter* _rg_writer;
-    const int64_t _max_row_per_group = 10;
 
     const std::vector<TParquetSchema>& _parquet_schemas;
     const TParquetCompressionType::type& _compression_type;
@@ -75,11 +75,7 @@ Status VSortedRunMerger::prepare(const vector<BlockSupplier>& input_runs) {
         }
     }
 
-    for (auto& _cursor : _cursors) {
-        if (!_cursor._is_eof) {
-            _priority_queue.push(MergeSortCursor(&_cursor));
-        }
-    }
+    _build_loser_tree();
 
     for (const auto& cursor : _cursors) {
         if (!cursor._is_eof) {
@@ -93,15 +89,19 @@ Status VSortedRunMerger::prepare(const vector<BlockSupplier>& input_runs) {
 
 Status VSortedRunMerger::get_next(Block* output_block, bool* eos) {
     ScopedTimer<MonotonicStopWatch> timer(_get_next_timer);
+    if (_num_active_cursors == 0) {
+        *eos = true;
+        return Status::OK();
+    }
     // Only have one receive data queue of data, no need to do merge and
     // copy the data of block.
     // return the data in receive data directly
-    if (_priority_queue.size() == 1) {
-        auto current = _priority_queue.top();
+    if (_num_active_cursors == 1) {
+        auto* current = &_cursors[_loser_tree[0]];
         while (_offset != 0 && current->block_ptr() != nullptr) {
             if (_offset >= current->rows - current->pos) {
                 _offset -= (current->rows - current->pos);
-                has_next_block(current);
+                has_next_block(*current);
             } else {
                 current->pos += _offset;
                 _offset = 0;
@@ -111,7 +111,7 @@ Status VSortedRunMerger::get_next(Block* output_block, bool* eos) {
         if (current->isFirst()) {
             if (current->block_ptr() != nullptr) {
                 current->block_ptr()->swap(*output_block);
-                *eos = !has_next_block(current);
+                *eos = !has_next_block(*current);
             } else {
                 *eos = true;
             }
@@ -123,7 +123,7 @@ Status VSortedRunMerger::get_next(Block* output_block, bool* eos) {
                             current->pos, current->rows - current->pos);
                 }
                 current->block_ptr()->swap(*output_block);
-                *eos = !has_next_block(current);
+                *eos = !has_next_block(*current);
             } else {
                 *eos = true;
             }
@@ -134,20 +134,24 @@ Status VSortedRunMerger::get_next(Block* output_block, bool* eos) {
                 VectorizedUtils::build_mutable_mem_reuse_block(output_block, _empty_block);
         MutableColumns& merged_columns = m_block.mutable_columns();
 
-        /// Take rows from queue in right order and push to 'merged'.
+        /// Take rows from the loser tree in right order and push to 'merged'.
         size_t merged_rows = 0;
-        while (!_priority_queue.empty()) {
-            auto current = _priority_queue.top();
-            _priority_queue.pop();
+        while (_num_active_cursors > 0) {
+            size_t winner = _loser_tree[0];
+            auto& current = _cursors[winner];
 
             if (_offset > 0) {
                 _offset--;
             } else {
                 for (size_t i = 0; i < num_columns; ++i)
-                    merged_columns[i]->insert_from(*current->all_columns[i], current->pos);
+                    merged_columns[i]->insert_from(*current.all_columns[i], current.pos);
                 ++merged_rows;
             }
-            next_heap(current);
+            if (!_next(winner)) {
+                _cursor_eos[winner] = true;
+                --_num_active_cursors;
+            }
+            _adjust_loser_tree(winner);
             if (merged_rows == _batch_size) break;
         }
 
@@ -165,18 +169,68 @@ Status VSortedRunMerger::get_next(Block* output_block, bool* eos) {
     return Status::OK();
 }
 
-void VSortedRunMerger::next_heap(MergeSortCursor& current) {
-    if (!current->isLast()) {
-        current->next();
-        _priority_queue.push(current);
-    } else if (has_next_block(current)) {
-        _priority_queue.push(current);
+bool VSortedRunMerger::_cursor_less(size_t lhs, size_t rhs) {
+    if (_cursor_eos[lhs] || _cursor_eos[rhs]) {
+        return !_cursor_eos[lhs] && _cursor_eos[rhs];
+    }
+    MergeSortCursor lhs_cursor(&_cursors[lhs]);
+    MergeSortCursor rhs_cursor(&_cursors[rhs]);
+    int8_t res = lhs_cursor.greater_at(rhs_cursor, _cursors[lhs].pos, _cursors[rhs].pos);
+    // the ties are output in the order of the runs
+    return res < 0 || (res == 0 && lhs < rhs);
+}
+
+void VSortedRunMerger::_build_loser_tree() {
+    size_t num_cursors = _cursors.size();
+    _cursor_eos.resize(num_cursors);
+    _num_active_cursors = 0;
+    for (size_t i = 0; i < num_cursors; ++i) {
+        _cursor_eos[i] = _cursors[i]._is_eof;
+        _num_active_cursors += !_cursor_eos[i];
+    }
+    _loser_tree.assign(num_cursors, 0);
+    if (num_cursors <= 1) {
+        return;
+    }
+    // the winners of the subtrees
+    std::vector<size_t> winners(2 * num_cursors);
+    for (size_t i = 0; i < num_cursors; ++i) {
+        winners[i + num_cursors] = i;
+    }
+    for (size_t node = num_cursors - 1; node > 0; --node) {
+        size_t winner = winners[2 * node];
+        size_t loser = winners[2 * node + 1];
+        if (_cursor_less(loser, winner)) {
+            std::swap(winner, loser);
+        }
+        winners[node] = winner;
+        _loser_tree[node] = loser;
+    }
+    _loser_tree[0] = winners[1];
+}
+
+void VSortedRunMerger::_adjust_loser_tree(size_t cursor) {
+    size_t winner = cursor;
+    for (size_t node = (cursor + _cursors.size()) / 2; node > 0; node /= 2) {
+        if (_cursor_less(_loser_tree[node], winner)) {
+            std::swap(_loser_tree[node], winner);
+        }
+    }
+    _loser_tree[0] = winner;
+}
+
+bool VSortedRunMerger::_next(size_t cursor) {
+    auto& current = _cursors[cursor];
+    if (!current.isLast()) {
+        current.next();
+        return true;
     }
+    return has_next_block(current);
 }
 
-inline bool VSortedRunMerger::has_next_block(doris::vectorized::MergeSortCursor& current) {
+inline bool VSortedRunMerger::has_next_block(BlockSupplierSortCursorImpl& current) {
     ScopedTimer<MonotonicStopWatch> timer(_get_next_block_timer);
-    return current->has_next_block();
+    return current.has_next_block();
 }
 
 } // namespace doris::vectorized
\ No newline at end of file
@@ -20,7 +20,6 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#include <queue>
 #include <vector>
 
 #include "common/status.h"
@@ -75,7 +74,12 @@ protected:
     size_t _offset = 0;
 
     std::vector<BlockSupplierSortCursorImpl> _cursors;
-    std::priority_queue<MergeSortCursor> _priority_queue;
+    // A loser tree of the cursors: the node 0 is the index of the least cursor, the node i
+    // (0 < i < _cursors.size()) is the loser of its two subtrees, and the cursor i is the leaf
+    // i + _cursors.size(). A row is output by one comparison per level.
+    std::vector<size_t> _loser_tree;
+    std::vector<uint8_t> _cursor_eos;
+    size_t _num_active_cursors = 0;
 
     Block _empty_block;
 
@@ -87,8 +91,13 @@ protected:
 
 private:
     void init_timers(RuntimeProfile* profile);
-    void next_heap(MergeSortCursor& current);
-    bool has_next_block(MergeSortCursor& current);
+    void _build_loser_tree();
+    // Replay the matches from the leaf of the cursor after it moved.
+    void _adjust_loser_tree(size_t cursor);
+    bool _cursor_less(size_t lhs, size_t rhs);
+    // Move the cursor to the next row, return false if it is at the end.
+    bool _next(size_t cursor);
+    bool has_next_block(BlockSupplierSortCursorImpl& current);
 };
 
 } // namespace vectorized
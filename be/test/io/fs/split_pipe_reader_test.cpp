@@ -0,0 +1,98 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/split_pipe_reader.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest_pred_impl.h"
+#include "io/fs/stream_load_pipe.h"
+#include "util/runtime_profile.h"
+
+namespace doris {
+using namespace doris::io;
+
+class SplitPipeReaderTest : public testing::Test {};
+
+TEST_F(SplitPipeReaderTest, split_by_line) {
+    auto pipe = std::make_shared<StreamLoadPipe>();
+    std::string data = "a,1\nbb,22\nccc,333\ndddd,4444\nlong line without delimiter";
+    EXPECT_TRUE(pipe->append_and_flush(data.data(), data.size()).ok());
+    EXPECT_TRUE(pipe->finish().ok());
+
+    // smaller than one line, the chunk is extended to contain a whole line
+    auto splitter = std::make_shared<PipeSplitter>(pipe, '\n', 2);
+    std::string all;
+    std::unique_ptr<uint8_t[]> chunk;
+    size_t size = 0;
+    while (true) {
+        EXPECT_TRUE(splitter->next_chunk(&chunk, &size).ok());
+        if (size == 0) {
+            break;
+        }
+        std::string chunk_str((char*)chunk.get(), size);
+        if (all.size() + size < data.size()) {
+            EXPECT_EQ('\n', chunk_str.back());
+        }
+        all.append(chunk_str);
+    }
+    EXPECT_EQ(data, all);
+}
+
+TEST_F(SplitPipeReaderTest, read_chunks) {
+    auto pipe = std::make_shared<StreamLoadPipe>();
+    std::string data;
+    for (int i = 0; i < 1000; ++i) {
+        data.append(std::to_string(i)).append("\n");
+    }
+    EXPECT_TRUE(pipe->append_and_flush(data.data(), data.size()).ok());
+    EXPECT_TRUE(pipe->finish().ok());
+
+    auto splitter = std::make_shared<PipeSplitter>(pipe, '\n', 100);
+    RuntimeProfile profile1("reader1");
+    RuntimeProfile profile2("reader2");
+    SplitPipeReader reader1(splitter, &profile1);
+    SplitPipeReader reader2(splitter, &profile2);
+
+    // read by two readers in turn, every line is read by only one reader
+    std::string all;
+    char buf[64];
+    bool eof1 = false;
+    bool eof2 = false;
+    while (!eof1 || !eof2) {
+        size_t bytes_read = 0;
+        if (!eof1) {
+            EXPECT_TRUE(reader1.read_at(0, Slice(buf, sizeof(buf)), &bytes_read).ok());
+            all.append(buf, bytes_read);
+            eof1 = bytes_read == 0;
+        }
+        if (!eof2) {
+            EXPECT_TRUE(reader2.read_at(0, Slice(buf, sizeof(buf)), &bytes_read).ok());
+            all.append(buf, bytes_read);
+            eof2 = bytes_read == 0;
+        }
+    }
+    EXPECT_EQ(data.size(), all.size());
+    EXPECT_EQ(data.size(), profile1.get_counter("SplitPipeReadBytes")->value() +
+                                   profile2.get_counter("SplitPipeReadBytes")->value());
+}
+
+} // end namespace doris
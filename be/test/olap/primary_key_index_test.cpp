@@ -121,6 +121,20 @@ TEST_F(PrimaryKeyIndexTest, builder) {
         EXPECT_EQ(3850, row_id);
     }
 
+    // check a batch of existing and non-existing keys
+    {
+        std::vector<std::string> batch_keys {"1000", "8701", "87", "9998"};
+        std::vector<Slice> slices(batch_keys.begin(), batch_keys.end());
+        std::vector<uint8_t> present;
+        index_reader.check_present(slices, &present);
+        EXPECT_EQ(4, present.size());
+        for (size_t i = 0; i < slices.size(); i++) {
+            EXPECT_EQ(index_reader.check_present(slices[i]), present[i]);
+        }
+        EXPECT_TRUE(present[0]);
+        EXPECT_TRUE(present[3]);
+    }
+
     // find prefix "9999"
     {
         string key("9999");
@@ -549,6 +549,69 @@ TEST_F(TestRowIdConversion, Basic) {
     EXPECT_EQ(res, -1);
 }
 
+TEST_F(TestRowIdConversion, Merge) {
+    RowsetId src_rowset;
+    src_rowset.init(0);
+    RowsetId dst_rowset;
+    dst_rowset.init(3);
+
+    // segment 0 of src rowset is merged into the 1st key range, segment 1
+    // into the 2nd key range, which starts from dst segment 2
+    RowIdConversion range0;
+    range0.init_segment_map(src_rowset, {4});
+    range0.add({{src_rowset, 0, 0}, {src_rowset, 0, 2}, {src_rowset, 0, 3}}, {2, 1});
+    RowIdConversion range1;
+    range1.init_segment_map(src_rowset, {3}, 1);
+    range1.add({{src_rowset, 1, 1}, {src_rowset, 1, 0}}, {2});
+
+    RowIdConversion rowid_conversion;
+    rowid_conversion.set_dst_rowset_id(dst_rowset);
+    rowid_conversion.merge(range0, 0);
+    rowid_conversion.merge(range1, 2);
+
+    RowLocation dst;
+    EXPECT_EQ(0, rowid_conversion.get({src_rowset, 0, 3}, &dst));
+    EXPECT_EQ(dst_rowset, dst.rowset_id);
+    EXPECT_EQ(1, dst.segment_id);
+    EXPECT_EQ(0, dst.row_id);
+    EXPECT_EQ(-1, rowid_conversion.get({src_rowset, 0, 1}, &dst));
+    EXPECT_EQ(0, rowid_conversion.get({src_rowset, 1, 0}, &dst));
+    EXPECT_EQ(2, dst.segment_id);
+    EXPECT_EQ(1, dst.row_id);
+    EXPECT_EQ(-1, rowid_conversion.get({src_rowset, 1, 2}, &dst));
+}
+
+TEST_F(TestRowIdConversion, SplitKeyRanges) {
+    TabletSchemaSPtr tablet_schema = create_schema(DUP_KEYS);
+    std::vector<std::vector<std::vector<std::tuple<int64_t, int64_t>>>> input_data;
+    generate_input_data(2, 10, 100, OVERLAPPING, input_data);
+    // keys of rowset 0 are [0, 1000)
+    std::vector<RowsetSharedPtr> rowsets {
+            create_rowset(tablet_schema, NONOVERLAPPING, input_data[0])};
+
+    std::vector<Merger::KeyRange> key_ranges;
+    Merger::split_key_ranges(rowsets, 4, 100, &key_ranges);
+    std::vector<std::pair<int, int>> expected_offsets {{0, 3}, {3, 6}, {6, 9}, {9, 10}};
+    ASSERT_EQ(expected_offsets.size(), key_ranges.size());
+    for (size_t i = 0; i < key_ranges.size(); ++i) {
+        EXPECT_EQ(expected_offsets[i], key_ranges[i].segment_offsets[0]);
+    }
+
+    // too few rows to split
+    Merger::split_key_ranges(rowsets, 4, 1000, &key_ranges);
+    ASSERT_EQ(1, key_ranges.size());
+
+    // keys of the segments overlapping rowset 1 start from 500, so it must be
+    // merged with the segments of rowset 0 in the same range
+    rowsets.push_back(create_rowset(tablet_schema, OVERLAPPING, input_data[1]));
+    Merger::split_key_ranges(rowsets, 4, 100, &key_ranges);
+    ASSERT_EQ(2, key_ranges.size());
+    EXPECT_EQ(std::make_pair(0, 5), key_ranges[0].segment_offsets[0]);
+    EXPECT_EQ(key_ranges[0].segment_offsets[1].first, key_ranges[0].segment_offsets[1].second);
+    EXPECT_EQ(std::make_pair(5, 10), key_ranges[1].segment_offsets[0]);
+    EXPECT_EQ(std::make_pair(0, 10), key_ranges[1].segment_offsets[1]);
+}
+
 INSTANTIATE_TEST_SUITE_P(
         Parameters, TestRowIdConversion,
         ::testing::ValuesIn(std::vector<std::tuple<KeysType, bool, bool, bool>> {
@@ -128,6 +128,9 @@ TEST_F(TestRowsetTree, TestTree) {
 
     vec.erase(vec.begin() + 3);
     ASSERT_TRUE(tree.Init(vec).ok());
+    ASSERT_EQ(0, tree.rs_ordinal_by_id(rowset1->rowset_id()));
+    ASSERT_EQ(2, tree.rs_ordinal_by_id(rowset3->rowset_id()));
+    ASSERT_EQ(-1, tree.rs_ordinal_by_id(rowset4->rowset_id()));
 
     // "2" overlaps 0-5
     vector<std::pair<RowsetSharedPtr, int32_t>> out;
@@ -0,0 +1,254 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gen_cpp/olap_file.pb.h>
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <memory>
+#include <roaring/roaring.hh>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "gtest/gtest_pred_impl.h"
+#include "io/fs/local_file_system.h"
+#include "olap/field.h"
+#include "olap/inverted_index_parser.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/segment_v2/inverted_index_cache.h"
+#include "olap/rowset/segment_v2/inverted_index_desc.h"
+#include "olap/rowset/segment_v2/inverted_index_reader.h"
+#include "olap/rowset/segment_v2/inverted_index_writer.h"
+#include "olap/tablet_schema.h"
+#include "util/slice.h"
+#include "vec/common/string_ref.h"
+
+namespace doris {
+namespace segment_v2 {
+
+TEST(InvertedIndexQueryCacheTest, term_cache) {
+    InvertedIndexTermCache term_cache(1024 * 1024, 1);
+    InvertedIndexQueryCache query_cache(1024 * 1024, 1);
+    InvertedIndexQueryCache::CacheKey term_key {"/segment_0.idx", "c1",
+                                                InvertedIndexQueryType::EQUAL_QUERY, L"doris"};
+
+    // a dense range of rows
+    auto bitmap = std::make_shared<roaring::Roaring>();
+    bitmap->addRange(0, 10000);
+    size_t origin_size = bitmap->getSizeInBytes();
+    InvertedIndexQueryCacheHandle handle;
+    term_cache.insert(term_key, bitmap, &handle);
+    // compressed to a run container
+    EXPECT_LT(handle.get_bitmap()->getSizeInBytes(), origin_size);
+    EXPECT_EQ(10000, handle.get_bitmap()->cardinality());
+
+    InvertedIndexQueryCacheHandle lookup_handle;
+    EXPECT_TRUE(term_cache.lookup(term_key, &lookup_handle));
+    EXPECT_EQ(10000, lookup_handle.get_bitmap()->cardinality());
+    // the levels don't share entries
+    EXPECT_FALSE(query_cache.lookup(term_key, &lookup_handle));
+
+    // the terms of the composite query are joined by '\x1f'
+    InvertedIndexQueryCache::CacheKey query_key {"/segment_0.idx", "c1",
+                                                 InvertedIndexQueryType::MATCH_ALL_QUERY,
+                                                 L"apache\x1f"
+                                                 L"doris"};
+    auto result = std::make_shared<roaring::Roaring>();
+    result->add(1);
+    query_cache.insert(query_key, result, &handle);
+    EXPECT_TRUE(query_cache.lookup(query_key, &lookup_handle));
+    EXPECT_EQ(1, lookup_handle.get_bitmap()->cardinality());
+    EXPECT_FALSE(term_cache.lookup(query_key, &lookup_handle));
+}
+
+class InvertedIndexMatchQueryTest : public testing::Test {
+public:
+    const std::string kTestDir = "./ut_dir/inverted_index_query_cache_test";
+    const std::string kSegmentPath = kTestDir + "/segment_0.dat";
+
+    void SetUp() override {
+        EXPECT_TRUE(io::global_local_filesystem()->delete_and_create_directory(kTestDir).ok());
+        _searcher_cache = std::make_unique<InvertedIndexSearcherCache>(1024 * 1024, 1);
+        InvertedIndexSearcherCache::_s_instance = _searcher_cache.get();
+        reset_query_caches();
+
+        TabletIndexPB index_pb;
+        index_pb.set_index_id(1);
+        index_pb.set_index_name("idx_c1");
+        index_pb.set_index_type(IndexType::INVERTED);
+        index_pb.add_col_unique_id(1);
+        (*index_pb.mutable_properties())[INVERTED_INDEX_PARSER_KEY] =
+                INVERTED_INDEX_PARSER_ENGLISH;
+        (*index_pb.mutable_properties())[INVERTED_INDEX_PARSER_PHRASE_SUPPORT_KEY] =
+                INVERTED_INDEX_PARSER_PHRASE_SUPPORT_YES;
+        _index_meta.init_from_pb(index_pb);
+
+        // the row id is the position of the text
+        std::vector<std::string> texts {"apache doris", "doris apache",      "apache spark",
+                                        "doris",        "apache doris olap", "spark olap"};
+        std::vector<Slice> values(texts.begin(), texts.end());
+        TabletColumn column(FieldAggregationMethod::OLAP_FIELD_AGGREGATION_NONE,
+                            FieldType::OLAP_FIELD_TYPE_STRING);
+        column.set_unique_id(1);
+        column.set_name("c1");
+        std::unique_ptr<Field> field(FieldFactory::create(column));
+        std::unique_ptr<InvertedIndexColumnWriter> writer;
+        EXPECT_TRUE(InvertedIndexColumnWriter::create(field.get(), &writer, "segment_0.dat",
+                                                      kTestDir, &_index_meta,
+                                                      io::global_local_filesystem())
+                            .ok());
+        EXPECT_TRUE(writer->init().ok());
+        EXPECT_TRUE(writer->add_values("c1", values.data(), values.size()).ok());
+        EXPECT_TRUE(writer->finish().ok());
+
+        // the searchers aren't opened by the cache in the tests, replace the one inserted by
+        // the writer with an opened searcher
+        _index_file_name = InvertedIndexDescriptor::get_index_file_name("segment_0.dat", 1);
+        auto* searcher = new InvertedIndexSearcherCache::CacheValue();
+        searcher->index_searcher = InvertedIndexSearcherCache::build_index_searcher(
+                io::global_local_filesystem(), kTestDir, _index_file_name);
+        searcher->size = 1;
+        _searcher_cache->_cache->release(
+                _searcher_cache->_insert(kTestDir + "/" + _index_file_name, searcher));
+
+        _reader = FullTextIndexReader::create_shared(io::global_local_filesystem(), kSegmentPath,
+                                                     &_index_meta);
+    }
+
+    void TearDown() override {
+        _reader.reset();
+        InvertedIndexSearcherCache::_s_instance = nullptr;
+        InvertedIndexQueryCache::_s_instance = nullptr;
+        InvertedIndexTermCache::_s_instance = nullptr;
+        _searcher_cache.reset();
+        _query_cache.reset();
+        _term_cache.reset();
+        EXPECT_TRUE(io::global_local_filesystem()->delete_directory(kTestDir).ok());
+    }
+
+    void reset_query_caches() {
+        reset_query_cache();
+        _term_cache = std::make_unique<InvertedIndexTermCache>(1024 * 1024, 1);
+        InvertedIndexTermCache::_s_instance = _term_cache.get();
+    }
+
+    void reset_query_cache() {
+        _query_cache = std::make_unique<InvertedIndexQueryCache>(1024 * 1024, 1);
+        InvertedIndexQueryCache::_s_instance = _query_cache.get();
+    }
+
+    Status query(InvertedIndexQueryType query_type, const std::string& value,
+                 roaring::Roaring* result, OlapReaderStatistics* stats) {
+        StringRef query_value(value.data(), value.size());
+        return _reader->query(stats, "c1", &query_value, query_type, result);
+    }
+
+    roaring::Roaring query(InvertedIndexQueryType query_type, const std::string& value) {
+        OlapReaderStatistics stats;
+        roaring::Roaring result;
+        EXPECT_TRUE(query(query_type, value, &result, &stats).ok());
+        return result;
+    }
+
+protected:
+    TabletIndex _index_meta;
+    std::string _index_file_name;
+    std::unique_ptr<InvertedIndexSearcherCache> _searcher_cache;
+    std::unique_ptr<InvertedIndexQueryCache> _query_cache;
+    std::unique_ptr<InvertedIndexTermCache> _term_cache;
+    std::shared_ptr<FullTextIndexReader> _reader;
+};
+
+TEST_F(InvertedIndexMatchQueryTest, match_queries) {
+    struct MatchQuery {
+        InvertedIndexQueryType query_type;
+        std::string value;
+        roaring::Roaring expected;
+    };
+    std::vector<MatchQuery> queries {
+            {InvertedIndexQueryType::MATCH_ANY_QUERY, "spark olap",
+             roaring::Roaring::bitmapOf(3, 2, 4, 5)},
+            {InvertedIndexQueryType::MATCH_ALL_QUERY, "doris apache",
+             roaring::Roaring::bitmapOf(3, 0, 1, 4)},
+            {InvertedIndexQueryType::MATCH_ALL_QUERY, "doris spark", roaring::Roaring()},
+            {InvertedIndexQueryType::MATCH_PHRASE_QUERY, "apache doris",
+             roaring::Roaring::bitmapOf(2, 0, 4)},
+            {InvertedIndexQueryType::MATCH_PHRASE_QUERY, "doris apache",
+             roaring::Roaring::bitmapOf(1, 1)},
+            {InvertedIndexQueryType::MATCH_PHRASE_QUERY, "spark doris", roaring::Roaring()},
+            {InvertedIndexQueryType::MATCH_PHRASE_QUERY, "doris",
+             roaring::Roaring::bitmapOf(4, 0, 1, 3, 4)},
+    };
+    for (const auto& q : queries) {
+        SCOPED_TRACE(q.value);
+        const auto expected = q.expected.toString();
+        // without the cached results
+        reset_query_caches();
+        OlapReaderStatistics stats;
+        roaring::Roaring result;
+        EXPECT_TRUE(query(q.query_type, q.value, &result, &stats).ok());
+        EXPECT_EQ(expected, result.toString());
+        EXPECT_EQ(0, stats.inverted_index_term_cache_hit);
+
+        // the result of the whole query
+        EXPECT_EQ(expected, query(q.query_type, q.value).toString());
+
+        // the postings of all the terms, a match any query searches all of them
+        reset_query_caches();
+        query(InvertedIndexQueryType::MATCH_ANY_QUERY, q.value);
+        reset_query_cache();
+        stats = OlapReaderStatistics();
+        EXPECT_TRUE(query(q.query_type, q.value, &result, &stats).ok());
+        EXPECT_EQ(expected, result.toString());
+        EXPECT_EQ(0, stats.inverted_index_term_cache_miss);
+
+        // the postings of a part of the terms
+        for (const auto* term : {"apache", "doris", "spark", "olap"}) {
+            reset_query_caches();
+            query(InvertedIndexQueryType::MATCH_ANY_QUERY, term);
+            EXPECT_EQ(expected, query(q.query_type, q.value).toString());
+        }
+    }
+}
+
+TEST_F(InvertedIndexMatchQueryTest, skip_search_of_empty_intersection) {
+    // cache the postings of "doris" and "spark"
+    EXPECT_EQ(6, query(InvertedIndexQueryType::MATCH_ANY_QUERY, "doris spark").cardinality());
+    // the index isn't searched anymore
+    EXPECT_TRUE(io::global_local_filesystem()->delete_file(kTestDir + "/" + _index_file_name).ok());
+
+    OlapReaderStatistics stats;
+    roaring::Roaring result;
+    // the cached postings don't intersect, neither the phrase nor "apache" is searched
+    EXPECT_TRUE(query(InvertedIndexQueryType::MATCH_PHRASE_QUERY, "spark doris", &result, &stats)
+                        .ok());
+    EXPECT_TRUE(result.isEmpty());
+    EXPECT_TRUE(query(InvertedIndexQueryType::MATCH_ALL_QUERY, "apache doris spark", &result,
+                      &stats)
+                        .ok());
+    EXPECT_TRUE(result.isEmpty());
+    EXPECT_EQ(1, stats.inverted_index_term_cache_miss);
+
+    // the phrase of the intersecting postings is searched
+    EXPECT_EQ(ErrorCode::INVERTED_INDEX_FILE_NOT_FOUND,
+              query(InvertedIndexQueryType::MATCH_PHRASE_QUERY, "doris doris", &result, &stats)
+                      .code());
+}
+
+} // namespace segment_v2
+} // namespace doris
@@ -0,0 +1,409 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gen_cpp/AgentService_types.h>
+#include <gen_cpp/Types_types.h>
+#include <gen_cpp/olap_file.pb.h>
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "common/config.h"
+#include "common/status.h"
+#include "gtest/gtest_pred_impl.h"
+#include "io/fs/local_file_system.h"
+#include "olap/calc_delete_bitmap_executor.h"
+#include "olap/data_dir.h"
+#include "olap/key_coder.h"
+#include "olap/olap_common.h"
+#include "olap/options.h"
+#include "olap/rowset/rowset.h"
+#include "olap/rowset/rowset_factory.h"
+#include "olap/rowset/rowset_meta.h"
+#include "olap/rowset/rowset_writer.h"
+#include "olap/rowset/rowset_writer_context.h"
+#include "olap/segment_loader.h"
+#include "olap/storage_engine.h"
+#include "olap/tablet.h"
+#include "olap/tablet_manager.h"
+#include "olap/tablet_meta.h"
+#include "olap/tablet_schema.h"
+#include "olap/utils.h"
+#include "util/defer_op.h"
+#include "util/key_util.h"
+#include "vec/core/block.h"
+
+namespace doris {
+using namespace ErrorCode;
+
+static StorageEngine* k_engine = nullptr;
+static const std::string kTestDir = "/ut_dir/tablet_lookup_row_key_test";
+static const uint32_t MAX_PATH_LEN = 1024;
+
+class TabletLookupRowKeyTest : public testing::Test {
+protected:
+    void SetUp() override {
+        char buffer[MAX_PATH_LEN];
+        EXPECT_NE(getcwd(buffer, MAX_PATH_LEN), nullptr);
+        _absolute_dir = std::string(buffer) + kTestDir;
+        EXPECT_TRUE(io::global_local_filesystem()->delete_and_create_directory(_absolute_dir).ok());
+        _data_dir = std::make_unique<DataDir>(_absolute_dir, 100000000);
+        EXPECT_TRUE(_data_dir->init().ok());
+        doris::EngineOptions options;
+        k_engine = new StorageEngine(options);
+        StorageEngine::_s_instance = k_engine;
+
+        _tablet_schema = create_schema();
+        _tablet = create_tablet(*_tablet_schema);
+    }
+
+    void TearDown() override {
+        _tablet.reset();
+        if (k_engine != nullptr) {
+            k_engine->stop();
+            delete k_engine;
+            k_engine = nullptr;
+        }
+        _data_dir.reset();
+        EXPECT_TRUE(io::global_local_filesystem()->delete_directory(_absolute_dir).ok());
+    }
+
+    TabletSchemaSPtr create_schema() {
+        TabletSchemaSPtr tablet_schema = std::make_shared<TabletSchema>();
+        TabletSchemaPB tablet_schema_pb;
+        tablet_schema_pb.set_keys_type(UNIQUE_KEYS);
+        tablet_schema_pb.set_num_short_key_columns(1);
+        tablet_schema_pb.set_num_rows_per_row_block(1024);
+        tablet_schema_pb.set_compress_kind(COMPRESS_NONE);
+        tablet_schema_pb.set_next_column_unique_id(4);
+
+        ColumnPB* column_1 = tablet_schema_pb.add_column();
+        column_1->set_unique_id(1);
+        column_1->set_name("c1");
+        column_1->set_type("INT");
+        column_1->set_is_key(true);
+        column_1->set_length(4);
+        column_1->set_index_length(4);
+        column_1->set_is_nullable(false);
+        column_1->set_is_bf_column(false);
+
+        ColumnPB* column_2 = tablet_schema_pb.add_column();
+        column_2->set_unique_id(2);
+        column_2->set_name("c2");
+        column_2->set_type("INT");
+        column_2->set_length(4);
+        column_2->set_index_length(4);
+        column_2->set_is_key(false);
+        column_2->set_is_nullable(false);
+        column_2->set_is_bf_column(false);
+
+        ColumnPB* column_3 = tablet_schema_pb.add_column();
+        column_3->set_unique_id(3);
+        column_3->set_name(DELETE_SIGN);
+        column_3->set_type("TINYINT");
+        column_3->set_length(1);
+        column_3->set_index_length(1);
+        column_3->set_is_key(false);
+        column_3->set_is_nullable(false);
+        column_3->set_is_bf_column(false);
+
+        tablet_schema->init_from_pb(tablet_schema_pb);
+        return tablet_schema;
+    }
+
+    TabletSharedPtr create_tablet(const TabletSchema& tablet_schema) {
+        std::vector<TColumn> cols;
+        std::unordered_map<uint32_t, uint32_t> col_ordinal_to_unique_id;
+        for (auto i = 0; i < tablet_schema.num_columns(); i++) {
+            const TabletColumn& column = tablet_schema.column(i);
+            TColumn col;
+            col.column_type.type = column.name() == DELETE_SIGN ? TPrimitiveType::TINYINT
+                                                                : TPrimitiveType::INT;
+            col.__set_column_name(column.name());
+            col.__set_is_key(column.is_key());
+            cols.push_back(col);
+            col_ordinal_to_unique_id[i] = column.unique_id();
+        }
+
+        TTabletSchema t_tablet_schema;
+        t_tablet_schema.__set_short_key_column_count(tablet_schema.num_short_key_columns());
+        t_tablet_schema.__set_schema_hash(3333);
+        t_tablet_schema.__set_keys_type(TKeysType::UNIQUE_KEYS);
+        t_tablet_schema.__set_storage_type(TStorageType::COLUMN);
+        t_tablet_schema.__set_columns(cols);
+        TabletMetaSharedPtr tablet_meta(
+                new TabletMeta(1, 1, 1, 1, 1, 1, t_tablet_schema, 1, col_ordinal_to_unique_id,
+                               UniqueId(1, 2), TTabletType::TABLET_TYPE_DISK,
+                               TCompressionType::LZ4F, 0, true));
+
+        TabletSharedPtr tablet(new Tablet(tablet_meta, _data_dir.get()));
+        tablet->init();
+        return tablet;
+    }
+
+    // Write a rowset of `version` whose i-th segment holds the sorted keys of `segment_keys[i]`,
+    // the value of every row is the version.
+    RowsetSharedPtr build_rowset(int64_t version,
+                                 const std::vector<std::vector<int32_t>>& segment_keys) {
+        static int64_t inc_id = 1000;
+        RowsetWriterContext writer_context;
+        RowsetId rowset_id;
+        rowset_id.init(inc_id++);
+        writer_context.rowset_id = rowset_id;
+        writer_context.rowset_type = BETA_ROWSET;
+        writer_context.rowset_state = VISIBLE;
+        writer_context.tablet_schema = _tablet_schema;
+        writer_context.rowset_dir = _absolute_dir;
+        writer_context.version = Version(version, version);
+        writer_context.segments_overlap = NONOVERLAPPING;
+        writer_context.max_rows_per_segment = UINT32_MAX;
+        writer_context.enable_unique_key_merge_on_write = true;
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        Status st = RowsetFactory::create_rowset_writer(writer_context, false, &rowset_writer);
+        EXPECT_TRUE(st.ok());
+        for (auto& keys : segment_keys) {
+            vectorized::Block block = _tablet_schema->create_block();
+            auto columns = block.mutate_columns();
+            for (int32_t key : keys) {
+                int32_t value = version;
+                uint8_t delete_sign = 0;
+                columns[0]->insert_data((const char*)&key, sizeof(key));
+                columns[1]->insert_data((const char*)&value, sizeof(value));
+                columns[2]->insert_data((const char*)&delete_sign, sizeof(delete_sign));
+            }
+            EXPECT_TRUE(rowset_writer->add_block(&block).ok());
+            EXPECT_TRUE(rowset_writer->flush().ok());
+        }
+        RowsetSharedPtr rowset = rowset_writer->build();
+        EXPECT_TRUE(rowset != nullptr);
+        EXPECT_EQ(segment_keys.size(), rowset->num_segments());
+        return rowset;
+    }
+
+    RowsetSharedPtr add_rowset(int64_t version,
+                               const std::vector<std::vector<int32_t>>& segment_keys) {
+        RowsetSharedPtr rowset = build_rowset(version, segment_keys);
+        EXPECT_TRUE(_tablet->add_rowset(rowset).ok());
+        return rowset;
+    }
+
+    static std::string encode_key(int32_t key) {
+        std::string encoded_key;
+        encoded_key.push_back(KEY_NORMAL_MARKER);
+        get_key_coder(FieldType::OLAP_FIELD_TYPE_INT)->full_encode_ascending(&key, &encoded_key);
+        return encoded_key;
+    }
+
+    void delete_row(const RowsetSharedPtr& rowset, uint32_t segment_id, uint32_t row_id,
+                    int64_t version) {
+        _tablet->tablet_meta()->delete_bitmap().add({rowset->rowset_id(), segment_id, version},
+                                                    row_id);
+    }
+
+    std::string _absolute_dir;
+    std::unique_ptr<DataDir> _data_dir;
+    TabletSchemaSPtr _tablet_schema;
+    TabletSharedPtr _tablet;
+};
+
+TEST_F(TabletLookupRowKeyTest, lookup_row_keys) {
+    // version 2: [0, 100)
+    std::vector<int32_t> keys_v2(100);
+    for (int32_t i = 0; i < 100; ++i) {
+        keys_v2[i] = i;
+    }
+    auto rowset_v2 = add_rowset(2, {keys_v2});
+    // version 3: [50, 60) and [200, 210) in two segments
+    auto rowset_v3 = add_rowset(3, {{50, 51, 52, 53, 54, 55, 56, 57, 58, 59},
+                                    {200, 201, 202, 203, 204, 205, 206, 207, 208, 209}});
+    // version 4: 0, 10, 20
+    auto rowset_v4 = add_rowset(4, {{0, 10, 20}});
+
+    // the rows of version 2 overwritten by the later versions
+    for (uint32_t row_id : {0, 10, 20, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59}) {
+        delete_row(rowset_v2, 0, row_id, 3);
+    }
+    // 20 is deleted in version 4
+    delete_row(rowset_v4, 0, 2, 4);
+
+    std::vector<RowsetSharedPtr> specified_rowsets = _tablet->get_rowset_by_ids(nullptr);
+    ASSERT_EQ(3, specified_rowsets.size());
+
+    // the keys are not sorted, and a key may be looked up more than once
+    std::vector<int32_t> keys {205, 77, 20, 0, 300, 55, 150, 10, 0, 59, -1};
+    std::vector<std::string> encoded_keys;
+    for (int32_t key : keys) {
+        encoded_keys.push_back(encode_key(key));
+    }
+    std::vector<Slice> key_slices(encoded_keys.begin(), encoded_keys.end());
+
+    std::vector<std::unique_ptr<SegmentCacheHandle>> segment_caches(specified_rowsets.size());
+    std::vector<Status> statuses;
+    std::vector<RowLocation> row_locations;
+    std::vector<RowsetSharedPtr> rowsets;
+    ASSERT_TRUE(_tablet->lookup_row_keys(key_slices, false, specified_rowsets, 4, segment_caches,
+                                         &statuses, &row_locations, &rowsets)
+                        .ok());
+    ASSERT_EQ(keys.size(), statuses.size());
+
+    // key -> (rowset, segment id, row id), nullptr rowset if the key is not found
+    std::map<int32_t, std::tuple<RowsetSharedPtr, uint32_t, uint32_t>> expected {
+            {205, {rowset_v3, 1, 5}}, {77, {rowset_v2, 0, 77}}, {20, {nullptr, 0, 0}},
+            {0, {rowset_v4, 0, 0}},   {300, {nullptr, 0, 0}},   {55, {rowset_v3, 0, 5}},
+            {150, {nullptr, 0, 0}},   {10, {rowset_v4, 0, 1}},  {59, {rowset_v3, 0, 9}},
+            {-1, {nullptr, 0, 0}}};
+    for (size_t i = 0; i < keys.size(); ++i) {
+        auto& [rowset, segment_id, row_id] = expected[keys[i]];
+        if (rowset == nullptr) {
+            EXPECT_TRUE(statuses[i].is<NOT_FOUND>()) << "key " << keys[i];
+            EXPECT_EQ(nullptr, rowsets[i]) << "key " << keys[i];
+            continue;
+        }
+        EXPECT_TRUE(statuses[i].ok()) << "key " << keys[i] << ", " << statuses[i];
+        ASSERT_EQ(rowset, rowsets[i]) << "key " << keys[i];
+        EXPECT_EQ(rowset->rowset_id(), row_locations[i].rowset_id);
+        EXPECT_EQ(segment_id, row_locations[i].segment_id) << "key " << keys[i];
+        EXPECT_EQ(row_id, row_locations[i].row_id) << "key " << keys[i];
+
+        // the same as looking up the keys one by one
+        RowLocation loc;
+        RowsetSharedPtr rowset_found;
+        EXPECT_TRUE(_tablet->lookup_row_key(key_slices[i], false, specified_rowsets, &loc, 4,
+                                            segment_caches, &rowset_found)
+                            .ok());
+        EXPECT_EQ(rowset, rowset_found);
+        EXPECT_EQ(row_locations[i].segment_id, loc.segment_id);
+        EXPECT_EQ(row_locations[i].row_id, loc.row_id);
+    }
+
+    // the deletion of 20 in version 4 is not visible to version 3
+    ASSERT_TRUE(_tablet->lookup_row_keys({key_slices[2]}, false, specified_rowsets, 3,
+                                         segment_caches, &statuses, &row_locations, &rowsets)
+                        .ok());
+    ASSERT_EQ(1, statuses.size());
+    EXPECT_TRUE(statuses[0].ok());
+    EXPECT_EQ(rowset_v4, rowsets[0]);
+}
+
+TEST_F(TabletLookupRowKeyTest, rowset_tree) {
+    int32_t min_segments = config::pk_lookup_rowset_tree_min_segments;
+    config::pk_lookup_rowset_tree_min_segments = 1;
+    Defer defer {[&]() { config::pk_lookup_rowset_tree_min_segments = min_segments; }};
+
+    auto rowset_v2 = add_rowset(2, {{0, 1, 2, 3, 4}, {10, 11, 12, 13, 14}});
+    auto rowset_v3 = add_rowset(3, {{3, 4, 5}, {12, 20}});
+    auto rowset_v4 = add_rowset(4, {{1, 21}});
+    const long base_use_count = rowset_v2.use_count();
+
+    std::vector<RowsetSharedPtr> specified_rowsets = _tablet->get_rowset_by_ids(nullptr);
+    auto rowset_tree = _tablet->get_rowset_tree(specified_rowsets);
+    ASSERT_NE(nullptr, rowset_tree);
+    // the tree of the same rowsets is cached
+    EXPECT_EQ(rowset_tree, _tablet->get_rowset_tree(specified_rowsets));
+    // the rowsets of an earlier version are cached separately
+    std::vector<RowsetSharedPtr> rowsets_v3 {rowset_v3, rowset_v2};
+    auto rowset_tree_v3 = _tablet->get_rowset_tree(rowsets_v3);
+    ASSERT_NE(nullptr, rowset_tree_v3);
+    EXPECT_NE(rowset_tree, rowset_tree_v3);
+    EXPECT_EQ(rowset_tree, _tablet->get_rowset_tree(specified_rowsets));
+
+    // the candidate segments picked by the tree are the ones whose key bounds contain the key
+    std::vector<std::unique_ptr<SegmentCacheHandle>> segment_caches(specified_rowsets.size());
+    for (int32_t key = -1; key <= 22; ++key) {
+        std::string encoded_key = encode_key(key);
+        RowLocation loc;
+        RowsetSharedPtr rowset;
+        Status st = _tablet->lookup_row_key(encoded_key, false, specified_rowsets, &loc, 4,
+                                            segment_caches, &rowset);
+        RowLocation tree_loc;
+        RowsetSharedPtr tree_rowset;
+        Status tree_st = _tablet->lookup_row_key(encoded_key, false, specified_rowsets, &tree_loc,
+                                                 4, segment_caches, &tree_rowset,
+                                                 rowset_tree.get());
+        EXPECT_EQ(st.code(), tree_st.code()) << "key " << key;
+        EXPECT_EQ(rowset, tree_rowset) << "key " << key;
+        if (st.ok()) {
+            EXPECT_EQ(loc.segment_id, tree_loc.segment_id) << "key " << key;
+            EXPECT_EQ(loc.row_id, tree_loc.row_id) << "key " << key;
+        }
+    }
+
+    // the cached trees keep the rowsets
+    segment_caches.clear();
+    specified_rowsets.clear();
+    rowsets_v3.clear();
+    rowset_tree.reset();
+    rowset_tree_v3.reset();
+    EXPECT_LT(base_use_count, rowset_v2.use_count());
+
+    // once a rowset is removed from the tablet, e.g. by compaction, no tree keeps it
+    std::vector<RowsetSharedPtr> to_add;
+    std::vector<RowsetSharedPtr> to_delete {rowset_v2};
+    ASSERT_TRUE(_tablet->modify_rowsets(to_add, to_delete).ok());
+    to_delete.clear();
+    EXPECT_EQ(base_use_count, rowset_v2.use_count());
+}
+
+TEST_F(TabletLookupRowKeyTest, update_delete_bitmap_with_concurrent_rowset) {
+    // the delete bitmap is calculated by the tablet got from the storage engine
+    k_engine->_calc_delete_bitmap_executor.reset(new CalcDeleteBitmapExecutor());
+    k_engine->_calc_delete_bitmap_executor->init();
+    ASSERT_TRUE(k_engine->tablet_manager()
+                        ->_add_tablet_to_map_unlocked(_tablet->tablet_id(), _tablet, false, false,
+                                                      false)
+                        .ok());
+
+    // version 2: [0, 10)
+    auto rowset_v2 = add_rowset(2, {{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}});
+    // the rowset to publish in version 4
+    auto rowset_v4 = build_rowset(4, {{1, 5, 12, 30}});
+    // version 3 is added after the delete bitmap of version 4 is calculated against version 2
+    // without the lock, e.g. by a compaction
+    RowsetSharedPtr rowset_v3;
+    _tablet->set_update_delete_bitmap_hook([&]() { rowset_v3 = add_rowset(3, {{5, 12, 20}}); });
+    auto delete_bitmap = std::make_shared<DeleteBitmap>(_tablet->tablet_id());
+    ASSERT_TRUE(_tablet->update_delete_bitmap(rowset_v4, {}, delete_bitmap, 1).ok());
+    _tablet->set_update_delete_bitmap_hook(nullptr);
+    ASSERT_NE(nullptr, rowset_v3);
+
+    const DeleteBitmap& tablet_delete_bitmap = _tablet->tablet_meta()->delete_bitmap();
+    // the rows of version 2 found by the calculation against the snapshot
+    for (uint32_t row_id = 0; row_id < 10; ++row_id) {
+        EXPECT_EQ(row_id == 1 || row_id == 5,
+                  tablet_delete_bitmap.contains({rowset_v2->rowset_id(), 0, 4}, row_id))
+                << "row " << row_id;
+    }
+    // the rows of 5 and 12 in the concurrently added version 3 are found by the catch-up
+    EXPECT_TRUE(tablet_delete_bitmap.contains({rowset_v3->rowset_id(), 0, 4}, 0));
+    EXPECT_TRUE(tablet_delete_bitmap.contains({rowset_v3->rowset_id(), 0, 4}, 1));
+    EXPECT_FALSE(tablet_delete_bitmap.contains({rowset_v3->rowset_id(), 0, 4}, 2));
+    // no row of the published rowset is deleted
+    for (uint32_t row_id = 0; row_id < 4; ++row_id) {
+        EXPECT_FALSE(tablet_delete_bitmap.contains({rowset_v4->rowset_id(), 0, 4}, row_id));
+    }
+}
+
+} // namespace doris
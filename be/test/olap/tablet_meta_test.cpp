@@ -245,4 +245,34 @@ TEST(TabletMetaTest, TestDeleteBitmap) {
     }
 }
 
+TEST(TabletMetaTest, TestDeleteBitmapCompactVersions) {
+    DeleteBitmap dbmp(10087);
+    RowsetId rs1 {2, 0, 1, 1};
+    RowsetId rs2 {2, 0, 1, 2};
+    dbmp.add({rs1, 0, 1}, 1);
+    dbmp.add({rs1, 0, 3}, 3);
+    dbmp.add({rs1, 0, 5}, 5);
+    dbmp.add({rs1, 1, 2}, 2);
+    dbmp.add({rs1, 1, 6}, 6);
+    dbmp.add({rs2, 0, 7}, 7);
+    ASSERT_EQ(6, dbmp.delete_bitmap.size());
+    uint64_t cardinality = dbmp.get_agg({rs1, 0, 6})->cardinality();
+
+    // only the bitmaps of rs1 seg0 at version 1 and 3 can be merged
+    ASSERT_EQ(1, dbmp.compact_versions(4));
+    ASSERT_EQ(5, dbmp.delete_bitmap.size());
+    ASSERT_FALSE(dbmp.contains({rs1, 0, 1}, 1));
+    ASSERT_TRUE(dbmp.contains({rs1, 0, 3}, 1));
+    ASSERT_TRUE(dbmp.contains({rs1, 0, 3}, 3));
+    ASSERT_TRUE(dbmp.contains({rs1, 1, 2}, 2));
+    ASSERT_EQ(cardinality, dbmp.get_agg({rs1, 0, 1000})->cardinality());
+
+    ASSERT_EQ(2, dbmp.compact_versions(10));
+    ASSERT_EQ(3, dbmp.delete_bitmap.size());
+    ASSERT_TRUE(dbmp.contains({rs1, 0, 5}, 1));
+    ASSERT_TRUE(dbmp.contains({rs1, 1, 6}, 2));
+    ASSERT_TRUE(dbmp.contains({rs2, 0, 7}, 7));
+    ASSERT_GT(dbmp.get_size_in_bytes(), 0);
+}
+
 } // namespace doris
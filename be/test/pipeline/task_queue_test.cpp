@@ -0,0 +1,125 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "pipeline/task_queue.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <cmath>
+#include <vector>
+
+#include "common/config.h"
+#include "gtest/gtest_pred_impl.h"
+#include "testutil/cpu_test_util.h"
+#include "util/cpu_info.h"
+
+namespace doris::pipeline {
+
+class MultiCoreTaskQueueTest : public testing::Test {
+public:
+    void SetUp() override {
+        _old_numa_affinity = config::enable_pipeline_numa_affinity;
+        _old_num_numa_nodes = CpuInfo::get_max_num_numa_nodes();
+        _old_numa_nodes = CpuTestUtil::numa_nodes_of_cores();
+        config::enable_pipeline_numa_affinity = true;
+    }
+
+    void TearDown() override {
+        config::enable_pipeline_numa_affinity = _old_numa_affinity;
+        CpuTestUtil::setup_fake_numa(_old_num_numa_nodes, _old_numa_nodes);
+    }
+
+    // Fake `num_nodes` NUMA nodes of about the same number of cores, return false if the
+    // machine doesn't have 2 cores for every node.
+    static bool fake_numa(int num_nodes) {
+        int num_cores = CpuInfo::get_max_num_cores();
+        if (num_cores < 2 * num_nodes) {
+            return false;
+        }
+        std::vector<int> core_to_numa_node;
+        for (int core = 0; core < num_cores; ++core) {
+            core_to_numa_node.push_back(core * num_nodes / num_cores);
+        }
+        CpuTestUtil::setup_fake_numa(num_nodes, core_to_numa_node);
+        return true;
+    }
+
+    static std::vector<int> numa_nodes(size_t num_workers) {
+        MultiCoreTaskQueue queue(num_workers);
+        std::vector<int> nodes;
+        for (size_t i = 0; i < num_workers; ++i) {
+            nodes.push_back(queue.numa_node(i));
+        }
+        return nodes;
+    }
+
+    // Every node has workers in proportion to its cores, and the workers of a node have
+    // adjacent ids.
+    static void check_spread(size_t num_workers) {
+        auto nodes = numa_nodes(num_workers);
+        std::vector<int> workers_of_nodes(CpuInfo::get_max_num_numa_nodes());
+        for (size_t i = 0; i < num_workers; ++i) {
+            ASSERT_GE(nodes[i], 0);
+            if (i > 0) {
+                EXPECT_LE(nodes[i - 1], nodes[i]) << i;
+            }
+            workers_of_nodes[nodes[i]]++;
+        }
+        for (int node = 0; node < CpuInfo::get_max_num_numa_nodes(); ++node) {
+            double expected = 1.0 * num_workers * CpuInfo::get_cores_of_numa_node(node).size() /
+                              CpuInfo::get_max_num_cores();
+            EXPECT_LT(std::abs(workers_of_nodes[node] - expected), 1.0)
+                    << "num_workers " << num_workers << ", node " << node;
+        }
+    }
+
+private:
+    bool _old_numa_affinity;
+    int _old_num_numa_nodes;
+    std::vector<int> _old_numa_nodes;
+};
+
+TEST_F(MultiCoreTaskQueueTest, spread_workers_over_numa_nodes) {
+    if (!fake_numa(2)) {
+        return;
+    }
+    int num_cores = CpuInfo::get_max_num_cores();
+    // fewer workers than cores, the workers are not all in the first node
+    EXPECT_EQ(std::vector<int>({0, 1}), numa_nodes(2));
+    for (size_t num_workers : {2, 3, 4, num_cores / 2, num_cores - 1, num_cores, 2 * num_cores}) {
+        check_spread(num_workers);
+    }
+
+    if (!fake_numa(3)) {
+        return;
+    }
+    EXPECT_EQ(std::vector<int>({0, 1, 2}), numa_nodes(3));
+    for (size_t num_workers : {3, 4, 5, num_cores, 3 * num_cores + 1}) {
+        check_spread(num_workers);
+    }
+}
+
+TEST_F(MultiCoreTaskQueueTest, no_numa_affinity) {
+    config::enable_pipeline_numa_affinity = false;
+    if (!fake_numa(2)) {
+        return;
+    }
+    EXPECT_EQ(std::vector<int>({-1, -1, -1}), numa_nodes(3));
+}
+
+} // namespace doris::pipeline
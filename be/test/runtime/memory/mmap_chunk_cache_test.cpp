@@ -0,0 +1,63 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/memory/mmap_chunk_cache.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+#include <sys/mman.h>
+
+#include "gtest/gtest_pred_impl.h"
+
+namespace doris {
+
+static void* mmap_chunk(size_t size) {
+    void* chunk = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    EXPECT_NE(MAP_FAILED, chunk);
+    return chunk;
+}
+
+TEST(MmapChunkCacheTest, push_pop) {
+    MmapChunkCache cache(4 * 4096);
+    EXPECT_EQ(nullptr, cache.pop(4096));
+
+    void* chunk1 = mmap_chunk(4096);
+    EXPECT_TRUE(cache.push(chunk1, 4096));
+    EXPECT_EQ(4096, cache.cached_bytes());
+    // different size class
+    EXPECT_EQ(nullptr, cache.pop(2 * 4096));
+    // same size class after aligned to the page size
+    EXPECT_EQ(chunk1, cache.pop(4000));
+    EXPECT_EQ(0, cache.cached_bytes());
+
+    // exceed the capacity
+    void* chunk2 = mmap_chunk(3 * 4096);
+    void* chunk3 = mmap_chunk(2 * 4096);
+    EXPECT_TRUE(cache.push(chunk2, 3 * 4096));
+    EXPECT_FALSE(cache.push(chunk3, 2 * 4096));
+    EXPECT_TRUE(cache.push(chunk1, 4096));
+    EXPECT_EQ(4 * 4096, cache.cached_bytes());
+    EXPECT_EQ(0, munmap(chunk3, 2 * 4096));
+
+    cache.prune_stale();
+    EXPECT_EQ(4 * 4096, cache.cached_bytes());
+    cache.prune_all();
+    EXPECT_EQ(0, cache.cached_bytes());
+    EXPECT_EQ(nullptr, cache.pop(3 * 4096));
+}
+
+} // namespace doris
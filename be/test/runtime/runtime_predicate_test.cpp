@@ -0,0 +1,99 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/runtime_predicate.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest_pred_impl.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+
+static Block create_row(int32_t c0, int64_t c1) {
+    auto col0 = ColumnInt32::create();
+    col0->insert_value(c0);
+    auto col1 = ColumnInt64::create();
+    col1->insert_value(c1);
+    return Block({{std::move(col0), std::make_shared<DataTypeInt32>(), "c0"},
+                  {std::move(col1), std::make_shared<DataTypeInt64>(), "c1"}});
+}
+
+static std::pair<int32_t, int64_t> get_row(const Block& block, size_t row = 0) {
+    return {int32_t(block.get_by_position(0).column->get_int(row)),
+            block.get_by_position(1).column->get_int(row)};
+}
+
+TEST(RuntimePredicateTest, top_row) {
+    RuntimePredicate predicate;
+    // order by c0 asc, c1 desc
+    SortDescription description {{0, 1, 1}, {1, -1, -1}};
+    int64_t version = 0;
+    EXPECT_EQ(0, predicate.get_top_row(&version).rows());
+
+    predicate.update_top_row(create_row(10, 5), description);
+    auto top_row = predicate.get_top_row(&version);
+    EXPECT_EQ(std::make_pair(10, int64_t(5)), get_row(top_row));
+    // not changed since the version
+    EXPECT_EQ(0, predicate.get_top_row(&version).rows());
+
+    // the looser rows don't change the top row
+    predicate.update_top_row(create_row(11, 100), description);
+    predicate.update_top_row(create_row(10, 4), description);
+    predicate.update_top_row(create_row(10, 5), description);
+    EXPECT_EQ(0, predicate.get_top_row(&version).rows());
+
+    // the tie on the first column is decided by the second one
+    predicate.update_top_row(create_row(10, 6), description);
+    EXPECT_EQ(std::make_pair(10, int64_t(6)), get_row(predicate.get_top_row(&version)));
+    predicate.update_top_row(create_row(9, 0), description);
+    EXPECT_EQ(std::make_pair(9, int64_t(0)), get_row(predicate.get_top_row(&version)));
+}
+
+TEST(RuntimePredicateTest, filter_by_top_row) {
+    // order by c1 desc, c0 asc, the sort columns are in the other order in the block
+    SortDescription description {{1, -1, -1}, {0, 1, 1}};
+    auto top_c1 = ColumnInt64::create();
+    top_c1->insert_value(5);
+    auto top_c0 = ColumnInt32::create();
+    top_c0->insert_value(10);
+    Block top_row({{std::move(top_c1), std::make_shared<DataTypeInt64>(), "c1"},
+                   {std::move(top_c0), std::make_shared<DataTypeInt32>(), "c0"}});
+
+    Block block = create_row(9, 5);
+    auto columns = block.mutate_columns();
+    for (auto [c0, c1] : std::vector<std::pair<int32_t, int64_t>> {
+                 {10, 5}, {11, 5}, {0, 6}, {100, 4}, {10, 4}}) {
+        columns[0]->insert(c0);
+        columns[1]->insert(c1);
+    }
+    block.set_columns(std::move(columns));
+    RuntimePredicate::filter_by_top_row(&block, {1, 0}, top_row, description);
+
+    // only the rows less than (c1 = 5, c0 = 10) are kept
+    ASSERT_EQ(2U, block.rows());
+    EXPECT_EQ(std::make_pair(9, int64_t(5)), get_row(block, 0));
+    EXPECT_EQ(std::make_pair(0, int64_t(6)), get_row(block, 1));
+}
+
+} // namespace doris::vectorized
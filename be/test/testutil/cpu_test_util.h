@@ -0,0 +1,44 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <vector>
+
+#include "util/cpu_info.h"
+
+namespace doris {
+
+// Fake the NUMA nodes of the cores in tests.
+class CpuTestUtil {
+public:
+    // Simulate `max_num_numa_nodes` NUMA nodes, core i is in node core_to_numa_node[i].
+    static void setup_fake_numa(int max_num_numa_nodes, const std::vector<int>& core_to_numa_node) {
+        CpuInfo::_init_fake_numa_for_test(max_num_numa_nodes, core_to_numa_node);
+    }
+
+    // The NUMA node of every core, to restore the nodes after faking them.
+    static std::vector<int> numa_nodes_of_cores() {
+        std::vector<int> nodes;
+        for (int core = 0; core < CpuInfo::get_max_num_cores(); ++core) {
+            nodes.push_back(CpuInfo::get_numa_node_of_core(core));
+        }
+        return nodes;
+    }
+};
+
+} // namespace doris
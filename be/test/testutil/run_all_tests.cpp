@@ -26,6 +26,7 @@
 #include "gtest/gtest_pred_impl.h"
 #include "olap/page_cache.h"
 #include "olap/segment_loader.h"
+#include "olap/tablet_meta.h"
 #include "olap/tablet_schema_cache.h"
 #include "runtime/exec_env.h"
 #include "runtime/memory/thread_mem_tracker_mgr.h"
@@ -34,6 +35,8 @@
 #include "util/cpu_info.h"
 #include "util/disk_info.h"
 #include "util/mem_info.h"
+#include "vec/exec/format/parquet/parquet_scan_cache.h"
+#include "vec/exec/scan/scan_result_cache.h"
 
 int main(int argc, char** argv) {
     doris::ExecEnv::GetInstance()->init_mem_tracker();
@@ -42,6 +45,9 @@ int main(int argc, char** argv) {
     doris::TabletSchemaCache::create_global_schema_cache();
     doris::StoragePageCache::create_global_cache(1 << 30, 10, 0);
     doris::SegmentLoader::create_global_instance(1000);
+    doris::DeleteBitmap::AggCache::create_global_instance(1 << 30);
+    doris::vectorized::ParquetScanCache::create_global_instance(1 << 30);
+    doris::vectorized::ScanResultCache::create_global_instance(1 << 30);
     std::string conf = std::string(getenv("DORIS_HOME")) + "/conf/be.conf";
     if (!doris::config::init(conf.c_str(), false)) {
         fprintf(stderr, "error read config file. \n");
@@ -16,7 +16,14 @@
 // under the License.
 
 #include <benchmark/benchmark.h>
+#include <gen_cpp/DataSinks_types.h>
+#include <gen_cpp/Exprs_types.h>
+#include <gen_cpp/PaloInternalService_types.h>
+#include <gen_cpp/PlanNodes_types.h>
+#include <gen_cpp/Types_types.h>
 #include <gflags/gflags.h>
+#include <pthread.h>
+#include <sched.h>
 
 #include <algorithm>
 #include <chrono>
@@ -27,14 +34,18 @@
 #include <random>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "common/compiler_util.h"
+#include "common/config.h"
 #include "common/logging.h"
+#include "common/object_pool.h"
 #include "gutil/strings/split.h"
 #include "gutil/strings/substitute.h"
 #include "io/fs/file_system.h"
 #include "io/fs/file_writer.h"
+#include "exec/exec_node.h"
 #include "io/fs/local_file_system.h"
 #include "olap/comparison_predicate.h"
 #include "olap/data_dir.h"
@@ -50,20 +61,49 @@
 #include "olap/tablet_schema.h"
 #include "olap/tablet_schema_helper.h"
 #include "olap/types.h"
+#include "runtime/descriptors.h"
+#include "runtime/memory/cache_manager.h"
+#include "runtime/memory/mmap_chunk_cache.h"
+#include "runtime/runtime_state.h"
+#include "testutil/desc_tbl_builder.h"
 #include "testutil/test_util.h"
+#include "util/cpu_info.h"
 #include "util/debug_util.h"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/allocator.h"
+#include "vec/common/hash_table/hash.h"
+#include "vec/common/hash_table/hash_map.h"
+#include "vec/common/pod_array.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_decimal.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/exec/vaggregation_node.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
+#include "vec/runtime/vparquet_writer.h"
 
 DEFINE_string(operation, "Custom",
               "valid operation: Custom, BinaryDictPageEncode, BinaryDictPageDecode, SegmentScan, "
               "SegmentWrite, "
-              "SegmentScanByFile, SegmentWriteByFile");
+              "SegmentScanByFile, SegmentWriteByFile, LargeAlloc, NumaHashProbe, FusedExpr, "
+              "ParquetWrite, AggStringKey");
 DEFINE_string(input_file, "./sample.dat", "input file directory");
 DEFINE_string(column_type, "int,varchar", "valid type: int, char, varchar, string");
 DEFINE_string(rows_number, "10000", "rows number");
 DEFINE_string(iterations, "10",
               "run times, this is set to 0 means the number of iterations is automatically set ");
+DEFINE_bool(mmap_chunk_cache, true, "whether to cache the large mmap chunks for LargeAlloc");
+DEFINE_bool(fused_expr, true, "whether to fuse the arithmetic exprs for FusedExpr");
+DEFINE_bool(string_key_dict, true, "whether to use the string key dictionary for AggStringKey");
+DEFINE_string(agg_keys, "string,int", "group by keys for AggStringKey: string or string,int");
 
 const std::string kSegmentDir = "./segment_benchmark";
+const std::string kParquetFile = "./parquet_benchmark.parquet";
 
 std::string get_usage(const std::string& progname) {
     std::stringstream ss;
@@ -84,6 +124,16 @@ std::string get_usage(const std::string& progname) {
           "--iterations=10\n";
     ss << "./benchmark_tool --operation=SegmentWriteByFile --input_file=./sample.dat "
           "--iterations=10\n";
+    ss << "./benchmark_tool --operation=LargeAlloc --mmap_chunk_cache=true "
+          "--iterations=100\n";
+    ss << "./benchmark_tool --operation=NumaHashProbe --rows_number=10000000 "
+          "--iterations=10\n";
+    ss << "./benchmark_tool --operation=FusedExpr --fused_expr=true --rows_number=4096 "
+          "--iterations=1000\n";
+    ss << "./benchmark_tool --operation=ParquetWrite --rows_number=1000000 "
+          "--iterations=10\n";
+    ss << "./benchmark_tool --operation=AggStringKey --string_key_dict=true "
+          "--agg_keys=string,int --rows_number=1000000 --iterations=10\n";
 
     ss << "Sampe data file format: \n"
        << "The first line defines Shcema\n"
@@ -263,6 +313,491 @@ void custom_run_mod() {
     }
 }
 
+// Allocate and free the large buffers above mmap_threshold, like the hash tables of agg/join
+// and the big columns built by high QPS queries.
+// Call method: ./benchmark_tool --operation=LargeAlloc --mmap_chunk_cache=false
+class LargeAllocBenchmark : public BaseBenchmark {
+public:
+    LargeAllocBenchmark(const std::string& name, int iterations)
+            : BaseBenchmark(name + (FLAGS_mmap_chunk_cache ? "/cache" : "/no_cache"), iterations) {}
+    ~LargeAllocBenchmark() override = default;
+
+    void run() override {
+        size_t size = config::mmap_threshold;
+        // hash table, zeroed and populated
+        Allocator<true, true, true> hash_table_allocator;
+        auto* buf = reinterpret_cast<uint64_t*>(hash_table_allocator.alloc(size));
+        for (size_t i = 0; i < size / sizeof(uint64_t); i += 512) {
+            buf[i] = i;
+        }
+        hash_table_allocator.free(buf, size);
+
+        // column, grows by realloc
+        vectorized::PODArray<uint64_t, 4096, Allocator<false, false, true>> column;
+        column.resize(size / sizeof(uint64_t));
+        for (size_t i = 0; i < column.size(); i += 512) {
+            column[i] = i;
+        }
+        benchmark::DoNotOptimize(column.data());
+    }
+};
+
+// Probe a hash table built in NUMA node 0 from a thread in node 0 and from a thread in the last
+// node, to show the cost of the cross node memory access of hash join probe.
+// Call method: ./benchmark_tool --operation=NumaHashProbe --rows_number=10000000
+class NumaHashProbeBenchmark : public BaseBenchmark {
+public:
+    NumaHashProbeBenchmark(const std::string& name, int iterations, int rows_number, int probe_node)
+            : BaseBenchmark(name + "/rows_number:" + std::to_string(rows_number) +
+                                    "/probe_node:" + std::to_string(probe_node),
+                            iterations),
+              _rows_number(rows_number),
+              _probe_node(probe_node) {}
+    ~NumaHashProbeBenchmark() override = default;
+
+    void init() override {
+        if (_hash_table.size() > 0) {
+            return;
+        }
+        // the pages of the hash table are allocated in node 0 by the first touch policy
+        std::thread([this]() {
+            bind_numa_node(0);
+            for (uint64_t i = 0; i < _rows_number; ++i) {
+                HashTable::LookupResult it;
+                bool inserted;
+                _hash_table.emplace(i * 7, it, inserted);
+                it->get_second() = i;
+            }
+        }).join();
+    }
+
+    void run() override {
+        uint64_t sum = 0;
+        std::thread([this, &sum]() {
+            bind_numa_node(_probe_node);
+            std::mt19937_64 rng(0);
+            for (uint64_t i = 0; i < _rows_number; ++i) {
+                auto it = _hash_table.find(rng() % _rows_number * 7);
+                sum += it->get_second();
+            }
+        }).join();
+        benchmark::DoNotOptimize(sum);
+    }
+
+private:
+    static void bind_numa_node(int node) {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        for (int core : CpuInfo::get_cores_of_numa_node(node)) {
+            CPU_SET(core, &cpu_set);
+        }
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    }
+
+    using HashTable = HashMap<uint64_t, uint64_t, HashCRC32<uint64_t>>;
+    HashTable _hash_table;
+    uint64_t _rows_number;
+    int _probe_node;
+};
+
+// Evaluate the arithmetic exprs of TPC-H Q1/Q6 on a block, with the columns of the decimals
+// as doubles:
+//   Q1: l_extendedprice * (1 - l_discount) * (1 + l_tax)
+//   Q6: l_extendedprice * l_discount >= 100
+// Call method: ./benchmark_tool --operation=FusedExpr --fused_expr=false --rows_number=4096
+class FusedExprBenchmark : public BaseBenchmark {
+public:
+    FusedExprBenchmark(const std::string& name, int iterations, int rows_number)
+            : BaseBenchmark(name + (FLAGS_fused_expr ? "/fused" : "/not_fused") +
+                                    "/rows_number:" + std::to_string(rows_number),
+                            iterations),
+              _rows_number(rows_number) {}
+    ~FusedExprBenchmark() override = default;
+
+    void init() override {
+        if (_state) {
+            return;
+        }
+        DescriptorTblBuilder builder(&_pool);
+        builder.declare_tuple() << TYPE_DOUBLE << TYPE_DOUBLE << TYPE_DOUBLE;
+        DescriptorTbl* desc_tbl = builder.build();
+        _row_desc = std::make_unique<RowDescriptor>(
+                const_cast<TupleDescriptor*>(desc_tbl->get_tuple_descriptor(0)), false);
+        _state = std::make_unique<RuntimeState>(TUniqueId(), TQueryOptions(), TQueryGlobals(),
+                                                nullptr);
+        _state->init_mem_trackers();
+        _state->set_desc_tbl(desc_tbl);
+
+        config::enable_fused_expr_kernel = FLAGS_fused_expr;
+        _q1_ctx = _prepare({_fn_node(TExprNodeType::ARITHMETIC_EXPR, "multiply", TYPE_DOUBLE),
+                            _fn_node(TExprNodeType::ARITHMETIC_EXPR, "multiply", TYPE_DOUBLE),
+                            _slot_ref(0),
+                            _fn_node(TExprNodeType::ARITHMETIC_EXPR, "subtract", TYPE_DOUBLE),
+                            _literal(1), _slot_ref(1),
+                            _fn_node(TExprNodeType::ARITHMETIC_EXPR, "add", TYPE_DOUBLE),
+                            _literal(1), _slot_ref(2)});
+        _q6_ctx = _prepare({_fn_node(TExprNodeType::BINARY_PRED, "ge", TYPE_BOOLEAN),
+                            _fn_node(TExprNodeType::ARITHMETIC_EXPR, "multiply", TYPE_DOUBLE),
+                            _slot_ref(0), _slot_ref(1), _literal(100)});
+
+        std::mt19937 rng(0);
+        vectorized::ColumnsWithTypeAndName columns;
+        for (const auto* name : {"l_extendedprice", "l_discount", "l_tax"}) {
+            auto column = vectorized::ColumnFloat64::create();
+            for (int i = 0; i < _rows_number; ++i) {
+                column->insert_value(rng() % 1000000 / 100.0);
+            }
+            columns.emplace_back(std::move(column),
+                                 std::make_shared<vectorized::DataTypeFloat64>(), name);
+        }
+        _block = vectorized::Block(columns);
+    }
+
+    void run() override {
+        vectorized::Block block = _block;
+        int result_id = -1;
+        static_cast<void>(_q1_ctx->execute(&block, &result_id));
+        static_cast<void>(_q6_ctx->execute(&block, &result_id));
+        benchmark::DoNotOptimize(block.get_by_position(result_id).column->get_raw_data().data);
+    }
+
+private:
+    static TExprNode _node(TExprNodeType::type node_type, PrimitiveType type, int num_children) {
+        TExprNode node;
+        node.node_type = node_type;
+        node.type = TypeDescriptor(type).to_thrift();
+        node.__set_is_nullable(false);
+        node.num_children = num_children;
+        return node;
+    }
+
+    static TExprNode _fn_node(TExprNodeType::type node_type, const std::string& name,
+                              PrimitiveType type) {
+        TExprNode node = _node(node_type, type, 2);
+        TFunction fn;
+        fn.name.function_name = name;
+        fn.binary_type = TFunctionBinaryType::BUILTIN;
+        node.__set_fn(fn);
+        return node;
+    }
+
+    static TExprNode _slot_ref(int slot_id) {
+        TExprNode node = _node(TExprNodeType::SLOT_REF, TYPE_DOUBLE, 0);
+        TSlotRef slot_ref;
+        slot_ref.slot_id = slot_id;
+        slot_ref.tuple_id = 0;
+        node.__set_slot_ref(slot_ref);
+        return node;
+    }
+
+    static TExprNode _literal(double value) {
+        TExprNode node = _node(TExprNodeType::FLOAT_LITERAL, TYPE_DOUBLE, 0);
+        TFloatLiteral float_literal;
+        float_literal.value = value;
+        node.__set_float_literal(float_literal);
+        return node;
+    }
+
+    vectorized::VExprContextSPtr _prepare(const std::vector<TExprNode>& nodes) {
+        TExpr texpr;
+        texpr.nodes = nodes;
+        vectorized::VExprContextSPtr ctx;
+        CHECK(vectorized::VExpr::create_expr_tree(texpr, ctx).ok());
+        CHECK(ctx->prepare(_state.get(), *_row_desc).ok());
+        CHECK(ctx->open(_state.get()).ok());
+        return ctx;
+    }
+
+    int _rows_number;
+    ObjectPool _pool;
+    std::unique_ptr<RowDescriptor> _row_desc;
+    std::unique_ptr<RuntimeState> _state;
+    vectorized::VExprContextSPtr _q1_ctx;
+    vectorized::VExprContextSPtr _q6_ctx;
+    vectorized::Block _block;
+};
+
+// Write a parquet file of an int column, a nullable string column and a nullable decimal column
+// in blocks of 4096 rows, to show the throughput of VParquetWriterWrapper.
+// Call method: ./benchmark_tool --operation=ParquetWrite --rows_number=1000000
+class ParquetWriteBenchmark : public BaseBenchmark {
+public:
+    ParquetWriteBenchmark(const std::string& name, int iterations, int rows_number)
+            : BaseBenchmark(name + "/rows_number:" + std::to_string(rows_number), iterations),
+              _rows_number(rows_number) {}
+    ~ParquetWriteBenchmark() override = default;
+
+    void init() override {
+        if (!_output_vexpr_ctxs.empty()) {
+            return;
+        }
+        _output_vexpr_ctxs.push_back(_slot_ref(0, TypeDescriptor(TYPE_INT), false));
+        _output_vexpr_ctxs.push_back(_slot_ref(1, TypeDescriptor::create_string_type(), true));
+        _output_vexpr_ctxs.push_back(
+                _slot_ref(2, TypeDescriptor::create_decimalv3_type(18, 2), true));
+        _parquet_schemas.push_back(
+                _schema("id", TParquetRepetitionType::REQUIRED, TParquetDataType::INT32));
+        _parquet_schemas.push_back(
+                _schema("name", TParquetRepetitionType::OPTIONAL, TParquetDataType::BYTE_ARRAY));
+        _parquet_schemas.push_back(
+                _schema("price", TParquetRepetitionType::OPTIONAL, TParquetDataType::BYTE_ARRAY));
+
+        std::mt19937 rng(0);
+        auto id = vectorized::ColumnInt32::create();
+        auto name = vectorized::ColumnString::create();
+        auto name_null_map = vectorized::ColumnUInt8::create();
+        auto price = vectorized::ColumnDecimal<vectorized::Decimal64>::create(0, 2);
+        auto price_null_map = vectorized::ColumnUInt8::create();
+        for (int i = 0; i < BLOCK_ROWS; ++i) {
+            id->insert_value(i);
+            std::string name_value = "name_" + std::to_string(rng() % 100000);
+            name->insert_data(name_value.data(), name_value.size());
+            name_null_map->insert_value(rng() % 10 == 0);
+            price->insert_value(vectorized::Decimal64(rng() % 10000000));
+            price_null_map->insert_value(rng() % 10 == 0);
+        }
+        _block = vectorized::Block(
+                {{std::move(id), std::make_shared<vectorized::DataTypeInt32>(), "id"},
+                 {vectorized::ColumnNullable::create(std::move(name), std::move(name_null_map)),
+                  vectorized::make_nullable(std::make_shared<vectorized::DataTypeString>()),
+                  "name"},
+                 {vectorized::ColumnNullable::create(std::move(price), std::move(price_null_map)),
+                  vectorized::make_nullable(
+                          std::make_shared<vectorized::DataTypeDecimal<vectorized::Decimal64>>(
+                                  18, 2)),
+                  "price"}});
+    }
+
+    void run() override {
+        io::FileWriterPtr file_writer;
+        CHECK(io::global_local_filesystem()->create_file(kParquetFile, &file_writer).ok());
+        vectorized::VParquetWriterWrapper writer(file_writer.get(), _output_vexpr_ctxs,
+                                                 _parquet_schemas, _compression_type,
+                                                 _disable_dictionary, _parquet_version, false);
+        CHECK(writer.prepare().ok());
+        for (int rows = 0; rows < _rows_number; rows += BLOCK_ROWS) {
+            CHECK(writer.write(_block).ok());
+        }
+        writer.close();
+        benchmark::DoNotOptimize(writer.written_len());
+    }
+
+private:
+    static vectorized::VExprContextSPtr _slot_ref(int slot_id, const TypeDescriptor& type,
+                                                  bool nullable) {
+        TExprNode node;
+        node.node_type = TExprNodeType::SLOT_REF;
+        node.type = type.to_thrift();
+        node.num_children = 0;
+        node.__set_is_nullable(nullable);
+        TSlotRef slot_ref;
+        slot_ref.slot_id = slot_id;
+        slot_ref.tuple_id = 0;
+        node.__set_slot_ref(slot_ref);
+        TExpr texpr;
+        texpr.nodes.push_back(node);
+        vectorized::VExprContextSPtr ctx;
+        CHECK(vectorized::VExpr::create_expr_tree(texpr, ctx).ok());
+        return ctx;
+    }
+
+    static TParquetSchema _schema(const std::string& name, TParquetRepetitionType::type repetition,
+                                  TParquetDataType::type data_type) {
+        TParquetSchema schema;
+        schema.__set_schema_column_name(name);
+        schema.__set_schema_repetition_type(repetition);
+        schema.__set_schema_data_type(data_type);
+        schema.__set_schema_data_logical_type(TParquetDataLogicalType::UNDEFINED);
+        return schema;
+    }
+
+    static constexpr int BLOCK_ROWS = 4096;
+    int _rows_number;
+    vectorized::VExprContextSPtrs _output_vexpr_ctxs;
+    std::vector<TParquetSchema> _parquet_schemas;
+    TParquetCompressionType::type _compression_type = TParquetCompressionType::SNAPPY;
+    bool _disable_dictionary = false;
+    TParquetVersion::type _parquet_version = TParquetVersion::PARQUET_1_0;
+    vectorized::Block _block;
+};
+
+// Aggregate sum(v) of the rows of a low cardinality string key, grouped by the string key alone
+// or by the string key and an int key, with or without the string key dictionary of
+// AggregationNode.
+// Call method: ./benchmark_tool --operation=AggStringKey --string_key_dict=true
+//              --agg_keys=string,int --rows_number=1000000
+class AggStringKeyBenchmark : public BaseBenchmark {
+public:
+    AggStringKeyBenchmark(const std::string& name, int iterations, int rows_number)
+            : BaseBenchmark(name + (FLAGS_string_key_dict ? "/dict" : "/no_dict") + "/keys:" +
+                                    FLAGS_agg_keys + "/rows_number:" + std::to_string(rows_number),
+                            iterations),
+              _rows_number(rows_number) {}
+    ~AggStringKeyBenchmark() override = default;
+
+    void init() override {
+        if (_state) {
+            return;
+        }
+        bool with_int_key = FLAGS_agg_keys == "string,int";
+        // the input tuple of (k1 string, k2 int, v bigint), the intermediate and output tuples
+        // of the keys and sum(v)
+        DescriptorTblBuilder builder(&_pool);
+        builder.declare_tuple() << TypeDescriptor::create_string_type() << TYPE_INT
+                                << TYPE_BIGINT;
+        for (int i = 0; i < 2; ++i) {
+            auto& tuple = builder.declare_tuple() << TypeDescriptor::create_string_type();
+            if (with_int_key) {
+                tuple << TYPE_INT;
+            }
+            tuple << TYPE_BIGINT;
+        }
+        _desc_tbl = builder.build();
+        _state = std::make_unique<RuntimeState>(TUniqueId(), TQueryOptions(), TQueryGlobals(),
+                                                nullptr);
+        _state->init_mem_trackers();
+        _state->set_desc_tbl(_desc_tbl);
+        config::agg_string_key_dict_max_ratio = FLAGS_string_key_dict ? 0.25 : 0;
+
+        _child_tnode.__set_node_id(0);
+        _child_tnode.__set_node_type(TPlanNodeType::EXCHANGE_NODE);
+        _child_tnode.__set_num_children(0);
+        _child_tnode.__set_limit(-1);
+        _child_tnode.__set_row_tuples({0});
+        _child_tnode.__set_nullable_tuples({false});
+
+        TAggregationNode agg_node;
+        agg_node.grouping_exprs.push_back(_slot_ref(0, TypeDescriptor::create_string_type()));
+        if (with_int_key) {
+            agg_node.grouping_exprs.push_back(_slot_ref(1, TypeDescriptor(TYPE_INT)));
+        }
+        agg_node.__isset.grouping_exprs = true;
+        agg_node.aggregate_functions.push_back(_sum(2));
+        agg_node.__set_intermediate_tuple_id(1);
+        agg_node.__set_output_tuple_id(2);
+        agg_node.__set_need_finalize(true);
+        agg_node.__set_use_streaming_preaggregation(false);
+        agg_node.__set_is_first_phase(true);
+        _tnode.__set_node_id(1);
+        _tnode.__set_node_type(TPlanNodeType::AGGREGATION_NODE);
+        _tnode.__set_num_children(1);
+        _tnode.__set_limit(-1);
+        _tnode.__set_row_tuples({2});
+        _tnode.__set_nullable_tuples({false});
+        _tnode.__set_agg_node(agg_node);
+
+        std::mt19937 rng(0);
+        for (int start = 0; start < _rows_number; start += 4096) {
+            auto k1 = vectorized::ColumnString::create();
+            auto k2 = vectorized::ColumnInt32::create();
+            auto v = vectorized::ColumnInt64::create();
+            for (int i = start; i < std::min(start + 4096, _rows_number); ++i) {
+                std::string key = "dashboard_key_" + std::to_string(rng() % 1000);
+                k1->insert_data(key.data(), key.size());
+                k2->insert_value(rng() % 8);
+                v->insert_value(i);
+            }
+            auto make_nullable = [](vectorized::MutableColumnPtr column) {
+                auto null_map = vectorized::ColumnUInt8::create(column->size(), 0);
+                return vectorized::ColumnNullable::create(std::move(column), std::move(null_map));
+            };
+            _blocks.emplace_back(vectorized::ColumnsWithTypeAndName {
+                    {make_nullable(std::move(k1)),
+                     vectorized::make_nullable(std::make_shared<vectorized::DataTypeString>()),
+                     "k1"},
+                    {make_nullable(std::move(k2)),
+                     vectorized::make_nullable(std::make_shared<vectorized::DataTypeInt32>()),
+                     "k2"},
+                    {make_nullable(std::move(v)),
+                     vectorized::make_nullable(std::make_shared<vectorized::DataTypeInt64>()),
+                     "v"}});
+        }
+    }
+
+    void run() override {
+        ObjectPool pool;
+        auto* child = pool.add(new ExecNode(&pool, _child_tnode, *_desc_tbl));
+        CHECK(child->init(_child_tnode, _state.get()).ok());
+        auto* node = pool.add(new BenchmarkAggregationNode(&pool, _tnode, *_desc_tbl));
+        node->add_child(child);
+        CHECK(node->init(_tnode, _state.get()).ok());
+        CHECK(node->prepare(_state.get()).ok());
+        CHECK(node->alloc_resource(_state.get()).ok());
+        for (const auto& input_block : _blocks) {
+            vectorized::Block block = input_block;
+            CHECK(node->sink(_state.get(), &block, false).ok());
+        }
+        vectorized::Block empty;
+        CHECK(node->sink(_state.get(), &empty, true).ok());
+        bool eos = false;
+        size_t rows = 0;
+        while (!eos) {
+            vectorized::Block block;
+            CHECK(node->pull(_state.get(), &block, &eos).ok());
+            rows += block.rows();
+        }
+        benchmark::DoNotOptimize(rows);
+        CHECK(node->close(_state.get()).ok());
+    }
+
+private:
+    class BenchmarkAggregationNode : public vectorized::AggregationNode {
+    public:
+        using vectorized::AggregationNode::AggregationNode;
+
+        void add_child(ExecNode* child) { _children.push_back(child); }
+    };
+
+    static TExprNode _slot_ref_node(int slot_id, const TypeDescriptor& type) {
+        TExprNode node;
+        node.node_type = TExprNodeType::SLOT_REF;
+        node.type = type.to_thrift();
+        node.__set_is_nullable(true);
+        node.num_children = 0;
+        TSlotRef slot_ref;
+        slot_ref.slot_id = slot_id;
+        slot_ref.tuple_id = 0;
+        node.__set_slot_ref(slot_ref);
+        return node;
+    }
+
+    static TExpr _slot_ref(int slot_id, const TypeDescriptor& type) {
+        TExpr expr;
+        expr.nodes.push_back(_slot_ref_node(slot_id, type));
+        return expr;
+    }
+
+    static TExpr _sum(int slot_id) {
+        TFunction fn;
+        fn.name.function_name = "sum";
+        fn.binary_type = TFunctionBinaryType::BUILTIN;
+        fn.arg_types = {TypeDescriptor(TYPE_BIGINT).to_thrift()};
+        fn.ret_type = TypeDescriptor(TYPE_BIGINT).to_thrift();
+        TAggregateExpr agg_expr;
+        agg_expr.is_merge_agg = false;
+        agg_expr.__set_param_types({TypeDescriptor(TYPE_BIGINT).to_thrift()});
+        TExprNode node;
+        node.node_type = TExprNodeType::AGG_EXPR;
+        node.type = TypeDescriptor(TYPE_BIGINT).to_thrift();
+        node.__set_is_nullable(true);
+        node.num_children = 1;
+        node.__set_fn(fn);
+        node.__set_agg_expr(agg_expr);
+        TExpr expr;
+        expr.nodes.push_back(node);
+        expr.nodes.push_back(_slot_ref_node(slot_id, TypeDescriptor(TYPE_BIGINT)));
+        return expr;
+    }
+
+    int _rows_number;
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    std::unique_ptr<RuntimeState> _state;
+    TPlanNode _child_tnode;
+    TPlanNode _tnode;
+    std::vector<vectorized::Block> _blocks;
+};
+
 class MultiBenchmark {
 public:
     MultiBenchmark() {}
@@ -286,6 +821,26 @@ public:
         } else if (equal_ignore_case(FLAGS_operation, "BinaryDictPageDecode")) {
             benchmarks.emplace_back(new doris::BinaryDictPageDecodeBenchmark(
                     FLAGS_operation, std::stoi(FLAGS_iterations), std::stoi(FLAGS_rows_number)));
+        } else if (equal_ignore_case(FLAGS_operation, "LargeAlloc")) {
+            benchmarks.emplace_back(
+                    new doris::LargeAllocBenchmark(FLAGS_operation, std::stoi(FLAGS_iterations)));
+        } else if (equal_ignore_case(FLAGS_operation, "NumaHashProbe")) {
+            // probe in the same node and in the remote node
+            benchmarks.emplace_back(new doris::NumaHashProbeBenchmark(
+                    FLAGS_operation, std::stoi(FLAGS_iterations), std::stoi(FLAGS_rows_number),
+                    0));
+            benchmarks.emplace_back(new doris::NumaHashProbeBenchmark(
+                    FLAGS_operation, std::stoi(FLAGS_iterations), std::stoi(FLAGS_rows_number),
+                    CpuInfo::get_max_num_numa_nodes() - 1));
+        } else if (equal_ignore_case(FLAGS_operation, "FusedExpr")) {
+            benchmarks.emplace_back(new doris::FusedExprBenchmark(
+                    FLAGS_operation, std::stoi(FLAGS_iterations), std::stoi(FLAGS_rows_number)));
+        } else if (equal_ignore_case(FLAGS_operation, "ParquetWrite")) {
+            benchmarks.emplace_back(new doris::ParquetWriteBenchmark(
+                    FLAGS_operation, std::stoi(FLAGS_iterations), std::stoi(FLAGS_rows_number)));
+        } else if (equal_ignore_case(FLAGS_operation, "AggStringKey")) {
+            benchmarks.emplace_back(new doris::AggStringKeyBenchmark(
+                    FLAGS_operation, std::stoi(FLAGS_iterations), std::stoi(FLAGS_rows_number)));
         } else {
             std::cout << "operation invalid!" << std::endl;
         }
@@ -306,7 +861,13 @@ int main(int argc, char** argv) {
     gflags::SetUsageMessage(usage);
     google::ParseCommandLineFlags(&argc, &argv, true);
 
+    doris::CpuInfo::init();
+    doris::CacheManager::create_global_instance();
     doris::StoragePageCache::create_global_cache(1 << 30, 10, 0);
+    if (FLAGS_mmap_chunk_cache) {
+        // the cache is disabled in BE by default, cache up to 16 chunks of mmap_threshold
+        doris::MmapChunkCache::create_global_instance(16 * doris::config::mmap_threshold);
+    }
 
     doris::MultiBenchmark multi_bm;
     multi_bm.add_bm();
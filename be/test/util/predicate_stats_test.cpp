@@ -0,0 +1,62 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/predicate_stats.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest_pred_impl.h"
+
+namespace doris {
+
+TEST(PredicateStatsTest, reorder_by_rank) {
+    std::vector<std::string> predicates {"like", "eq", "not_measured", "always_true"};
+    std::vector<PredicateStats> stats(predicates.size());
+    // expensive and not selective
+    stats[0].update(100000, 1000, 900);
+    // cheap and selective
+    stats[1].update(1000, 1000, 10);
+    // filters nothing
+    stats[3].update(10, 1000, 1000);
+
+    EXPECT_DOUBLE_EQ(100, stats[0].ns_per_row());
+    EXPECT_DOUBLE_EQ(0.9, stats[0].pass_ratio());
+    EXPECT_LT(stats[1].rank(), stats[0].rank());
+    EXPECT_LT(stats[0].rank(), stats[3].rank());
+
+    reorder_by_rank(predicates, stats);
+    std::vector<std::string> expected {"not_measured", "eq", "like", "always_true"};
+    EXPECT_EQ(expected, predicates);
+    EXPECT_EQ(0, stats[0].input_rows);
+    EXPECT_EQ(10, stats[1].passed_rows);
+
+    // the older samples decay, "eq" becomes not selective and "like" becomes selective
+    for (int i = 0; i < 100; ++i) {
+        stats[1].update(1000, 1000, 1000);
+    }
+    EXPECT_GT(stats[1].pass_ratio(), 0.99);
+    stats[2].update(1000, 1000, 0);
+    reorder_by_rank(predicates, stats);
+    std::vector<std::string> reordered {"not_measured", "like", "eq", "always_true"};
+    EXPECT_EQ(reordered, predicates);
+}
+
+} // namespace doris
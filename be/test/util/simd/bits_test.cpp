@@ -0,0 +1,59 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/simd/bits.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest_pred_impl.h"
+
+namespace doris {
+
+static uint32_t bytes32_eq_mask_naive(const uint8_t* data, uint8_t byte) {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < 32; ++i) {
+        mask |= static_cast<uint32_t>(data[i] == byte) << i;
+    }
+    return mask;
+}
+
+TEST(SimdBitsTest, bytes32_eq_mask) {
+    // unaligned data, the matched byte at every position of both halves
+    std::vector<uint8_t> data(33, 'a');
+    const uint8_t* start = data.data() + 1;
+    EXPECT_EQ(0U, simd::bytes32_eq_mask(start, ','));
+    for (size_t i = 0; i < 32; ++i) {
+        data[i + 1] = ',';
+        EXPECT_EQ(1U << i, simd::bytes32_eq_mask(start, ',')) << i;
+        data[i + 1] = 'a';
+    }
+    EXPECT_EQ(0xffffffffU, simd::bytes32_eq_mask(start, 'a'));
+
+    // bytes with the highest bit set are not taken as negative numbers
+    for (size_t i = 0; i < 32; ++i) {
+        data[i + 1] = static_cast<uint8_t>(i * 37 % 7 == 0 ? 0xe4 : i * 8);
+    }
+    for (uint8_t byte : {uint8_t(0), uint8_t(8), uint8_t(0xe4), uint8_t(0xff)}) {
+        EXPECT_EQ(bytes32_eq_mask_naive(start, byte), simd::bytes32_eq_mask(start, byte));
+    }
+}
+
+} // namespace doris
@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/common/string_key_dictionary.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest_pred_impl.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
+
+namespace doris::vectorized {
+
+TEST(StringKeyDictionaryTest, encode_and_decode) {
+    StringKeyDictionary dict;
+    auto strings = ColumnString::create();
+    auto null_map = ColumnUInt8::create();
+    std::vector<std::string> values {"b", "a", "b", "", "c", "a"};
+    for (size_t i = 0; i < values.size(); ++i) {
+        strings->insert_data(values[i].data(), values[i].size());
+        null_map->insert_value(i == 3);
+    }
+    auto column = ColumnNullable::create(std::move(strings), std::move(null_map));
+
+    auto codes = dict.encode(*column);
+    ASSERT_EQ(values.size(), codes->size());
+    EXPECT_TRUE(codes->is_null_at(3));
+    const auto& data = assert_cast<const ColumnUInt32&>(
+                               assert_cast<const ColumnNullable&>(*codes).get_nested_column())
+                               .get_data();
+    EXPECT_EQ(data[0], data[2]);
+    EXPECT_EQ(data[1], data[5]);
+    EXPECT_NE(data[0], data[1]);
+
+    // the codes are the same across the blocks
+    auto next = ColumnString::create();
+    next->insert_data("a", 1);
+    next->insert_data("d", 1);
+    auto next_codes = dict.encode(*next);
+    EXPECT_EQ(data[1], assert_cast<const ColumnUInt32&>(*next_codes).get_data()[0]);
+    EXPECT_EQ(5, dict.size());
+
+    auto decoded = column->clone_empty();
+    dict.decode(*codes, *decoded);
+    ASSERT_EQ(values.size(), decoded->size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i == 3) {
+            EXPECT_TRUE(decoded->is_null_at(i));
+        } else {
+            EXPECT_EQ(values[i], decoded->get_data_at(i).to_string());
+        }
+    }
+
+    // decode the not nullable codes into a nullable column
+    auto nullable_decoded = column->clone_empty();
+    dict.decode(*next_codes, *nullable_decoded);
+    EXPECT_FALSE(nullable_decoded->is_null_at(1));
+    EXPECT_EQ("d", nullable_decoded->get_data_at(1).to_string());
+}
+
+} // namespace doris::vectorized
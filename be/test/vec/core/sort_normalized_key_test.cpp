@@ -0,0 +1,104 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/core/sort_normalized_key.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest_pred_impl.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/core/sort_block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris::vectorized {
+
+static Block create_block(size_t rows) {
+    std::mt19937 rng(42);
+    auto ints = ColumnInt32::create();
+    auto null_map = ColumnUInt8::create();
+    auto strings = ColumnString::create();
+    auto bigints = ColumnInt64::create();
+    for (size_t i = 0; i < rows; ++i) {
+        ints->insert_value(int32_t(rng() % 5) - 2);
+        null_map->insert_value(rng() % 4 == 0);
+        // the long strings share the prefix of 16 bytes
+        std::string str = rng() % 2 ? "abcdefghijklmnopq" : "";
+        str.append(rng() % 3, char('a' + rng() % 3));
+        strings->insert_data(str.data(), str.size());
+        bigints->insert_value(int64_t(rng() % 3) - 1);
+    }
+    return Block({{ColumnNullable::create(std::move(ints), std::move(null_map)),
+                   make_nullable(std::make_shared<DataTypeInt32>()), "c0"},
+                  {std::move(strings), std::make_shared<DataTypeString>(), "c1"},
+                  {std::move(bigints), std::make_shared<DataTypeInt64>(), "c2"}});
+}
+
+TEST(SortNormalizedKeyTest, encode) {
+    auto block = create_block(10);
+    SortDescription description {{0, 1, 1}, {2, -1, 1}, {1, 1, 1}};
+    ColumnRawPtrs columns {block.get_by_position(0).column.get(),
+                           block.get_by_position(2).column.get(),
+                           block.get_by_position(1).column.get()};
+    std::vector<NormalizedKey> keys;
+    bool exact = true;
+    // the nullable int and the bigint take 13 bytes, the string takes the rest
+    EXPECT_EQ(3, NormalizedKeyEncoder::encode(columns, description, &keys, &exact));
+    EXPECT_FALSE(exact);
+    EXPECT_EQ(10, keys.size());
+
+    columns.pop_back();
+    description.pop_back();
+    EXPECT_EQ(2, NormalizedKeyEncoder::encode(columns, description, &keys, &exact));
+    EXPECT_TRUE(exact);
+
+    // the second nullable int doesn't fit in the rest 3 bytes
+    columns = {block.get_by_position(2).column.get(), block.get_by_position(0).column.get(),
+               block.get_by_position(0).column.get()};
+    description = {{2, 1, 1}, {0, 1, 1}, {0, 1, 1}};
+    EXPECT_EQ(2, NormalizedKeyEncoder::encode(columns, description, &keys, &exact));
+    EXPECT_FALSE(exact);
+}
+
+TEST(SortNormalizedKeyTest, sort_block) {
+    for (int direction : {1, -1}) {
+        for (int nulls_direction : {1, -1}) {
+            for (UInt64 limit : {0, 10}) {
+                auto block = create_block(1000);
+                SortDescription description {{0, direction, nulls_direction},
+                                             {1, -direction, nulls_direction},
+                                             {2, direction, -nulls_direction}};
+                Block sorted = block.clone_empty();
+                sort_block(block, sorted, description, limit);
+                EXPECT_EQ(limit == 0 ? 1000 : limit, sorted.rows());
+                EXPECT_TRUE(is_already_sorted(sorted, description));
+            }
+        }
+    }
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,191 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/format/csv/csv_reader.h"
+
+#include <gen_cpp/PlanNodes_types.h>
+#include <gen_cpp/Types_types.h>
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "gtest/gtest_pred_impl.h"
+#include "io/fs/local_file_system.h"
+#include "io/io_common.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "runtime/types.h"
+#include "testutil/desc_tbl_builder.h"
+#include "util/runtime_profile.h"
+#include "vec/core/block.h"
+#include "vec/exec/scan/vscanner.h"
+
+namespace doris::vectorized {
+
+static const std::string kTestDir = "./ut_dir/csv_reader_test";
+static constexpr size_t NUM_COLUMNS = 3;
+
+class CsvReaderTest : public testing::Test {
+public:
+    void SetUp() override {
+        EXPECT_TRUE(io::global_local_filesystem()->delete_and_create_directory(kTestDir).ok());
+        DescriptorTblBuilder builder(&_pool);
+        auto& tuple = builder.declare_tuple();
+        for (size_t i = 0; i < NUM_COLUMNS; ++i) {
+            tuple << TypeDescriptor::create_string_type();
+        }
+        DescriptorTbl* desc_tbl = builder.build();
+        _slot_descs = desc_tbl->get_tuple_descriptor(0)->slots();
+    }
+
+    void TearDown() override {
+        EXPECT_TRUE(io::global_local_filesystem()->delete_directory(kTestDir).ok());
+    }
+
+    // Read `content` as a csv file by a query scan, return the values of the rows.
+    std::vector<std::vector<std::string>> read_csv(const std::string& content,
+                                                   const std::string& column_separator,
+                                                   const std::string& line_delimiter) {
+        std::string path = kTestDir + "/data.csv";
+        std::ofstream(path, std::ios::binary) << content;
+
+        TFileScanRangeParams params;
+        params.__set_file_type(TFileType::FILE_LOCAL);
+        params.__set_format_type(TFileFormatType::FORMAT_CSV_PLAIN);
+        TFileTextScanRangeParams text_params;
+        text_params.__set_column_separator(column_separator);
+        text_params.__set_line_delimiter(line_delimiter);
+        text_params.__set_array_delimiter(",");
+        TFileAttributes file_attributes;
+        file_attributes.__set_text_params(text_params);
+        file_attributes.__set_trim_double_quotes(true);
+        params.__set_file_attributes(file_attributes);
+        std::vector<TFileScanSlotInfo> required_slots;
+        std::vector<int32_t> column_idxs;
+        for (size_t i = 0; i < NUM_COLUMNS; ++i) {
+            TFileScanSlotInfo slot_info;
+            slot_info.__set_slot_id(_slot_descs[i]->id());
+            slot_info.__set_is_file_slot(true);
+            required_slots.push_back(slot_info);
+            column_idxs.push_back(i);
+        }
+        params.__set_required_slots(required_slots);
+        params.__set_column_idxs(column_idxs);
+
+        TFileRangeDesc range;
+        range.__set_path(path);
+        range.__set_start_offset(0);
+        range.__set_size(content.size());
+        range.__set_file_size(content.size());
+
+        RuntimeState state((TQueryGlobals()));
+        RuntimeProfile profile("CsvReaderTest");
+        ScannerCounter counter;
+        io::IOContext io_ctx;
+        CsvReader reader(&state, &profile, &counter, params, range, _slot_descs, &io_ctx);
+        EXPECT_TRUE(reader.init_reader(false).ok());
+
+        std::vector<std::vector<std::string>> rows;
+        bool eof = false;
+        while (!eof) {
+            Block block;
+            for (auto* slot : _slot_descs) {
+                block.insert({slot->get_empty_mutable_column(), slot->get_data_type_ptr(),
+                              slot->col_name()});
+            }
+            size_t read_rows = 0;
+            EXPECT_TRUE(reader.get_next_block(&block, &read_rows, &eof).ok());
+            for (size_t row = 0; row < block.rows(); ++row) {
+                std::vector<std::string> values;
+                for (size_t i = 0; i < NUM_COLUMNS; ++i) {
+                    values.push_back(block.get_by_position(i).column->get_data_at(row).to_string());
+                }
+                rows.push_back(std::move(values));
+            }
+        }
+        return rows;
+    }
+
+    // Rows whose separators and line delimiters fall on and around the 32 byte boundaries of
+    // the structural index, some values are enclosed by double quotes, and the last line is
+    // shorter than 32 bytes and has no line delimiter.
+    static std::vector<std::vector<std::string>> rows_on_boundaries() {
+        std::vector<std::vector<std::string>> rows;
+        const std::vector<size_t> lengths = {0, 1, 30, 31, 32, 33, 62, 63, 64, 65};
+        for (size_t first : lengths) {
+            for (size_t second : lengths) {
+                std::string quoted = second >= 2 ? "\"" + std::string(second - 2, 'q') + "\""
+                                                 : std::string(second, 'q');
+                rows.push_back({std::string(first, static_cast<char>('a' + first % 26)),
+                                (first + second) % 2 ? quoted : std::string(second, 'b'), "c"});
+            }
+        }
+        rows.push_back({"x", "y", "z"});
+        return rows;
+    }
+
+    static std::string to_csv(const std::vector<std::vector<std::string>>& rows,
+                              const std::string& column_separator,
+                              const std::string& line_delimiter) {
+        std::string content;
+        for (size_t row = 0; row < rows.size(); ++row) {
+            for (size_t i = 0; i < rows[row].size(); ++i) {
+                content.append(i == 0 ? "" : column_separator).append(rows[row][i]);
+            }
+            if (row + 1 < rows.size()) {
+                content.append(line_delimiter);
+            }
+        }
+        return content;
+    }
+
+    // the values read from the file, with the enclosing double quotes trimmed
+    static std::vector<std::vector<std::string>> expected_values(
+            std::vector<std::vector<std::string>> rows) {
+        for (auto& row : rows) {
+            for (auto& value : row) {
+                if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+                    value = value.substr(1, value.size() - 2);
+                }
+            }
+        }
+        return rows;
+    }
+
+    ObjectPool _pool;
+    std::vector<SlotDescriptor*> _slot_descs;
+};
+
+TEST_F(CsvReaderTest, single_byte_separator) {
+    auto rows = rows_on_boundaries();
+    EXPECT_EQ(expected_values(rows), read_csv(to_csv(rows, ",", "\n"), ",", "\n"));
+    // a line shorter than 32 bytes only
+    EXPECT_EQ(expected_values({{"1", "\"22\"", "333"}}), read_csv("1,\"22\",333\n", ",", "\n"));
+}
+
+TEST_F(CsvReaderTest, multi_byte_separator) {
+    auto rows = rows_on_boundaries();
+    EXPECT_EQ(expected_values(rows), read_csv(to_csv(rows, "||", "\n"), "||", "\n"));
+    EXPECT_EQ(expected_values(rows), read_csv(to_csv(rows, ",", "\r\n"), ",", "\r\n"));
+    EXPECT_EQ(expected_values(rows), read_csv(to_csv(rows, "|+|", "\r\n"), "|+|", "\r\n"));
+}
+
+} // namespace doris::vectorized
@@ -17,13 +17,17 @@
 
 #include <cctz/time_zone.h>
 #include <gen_cpp/Descriptors_types.h>
+#include <gen_cpp/Exprs_types.h>
 #include <gen_cpp/PaloInternalService_types.h>
 #include <gen_cpp/PlanNodes_types.h>
 #include <gen_cpp/Types_types.h>
+#include <gen_cpp/parquet_types.h>
 #include <gtest/gtest-message.h>
 #include <gtest/gtest-test-part.h>
 #include <stddef.h>
 
+#include <algorithm>
+#include <fstream>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -37,8 +41,13 @@
 #include "io/fs/file_reader_writer_fwd.h"
 #include "io/fs/file_system.h"
 #include "io/fs/local_file_system.h"
+#include "runtime/descriptor_helper.h"
 #include "runtime/descriptors.h"
 #include "runtime/runtime_state.h"
+#include "runtime/types.h"
+#include "util/coding.h"
+#include "util/runtime_profile.h"
+#include "util/thrift_util.h"
 #include "util/timezone_utils.h"
 #include "vec/columns/column.h"
 #include "vec/core/block.h"
@@ -46,6 +55,8 @@
 #include "vec/data_types/data_type.h"
 #include "vec/data_types/data_type_factory.hpp"
 #include "vec/exec/format/parquet/vparquet_reader.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
 
 namespace doris {
 namespace vectorized {
@@ -164,5 +175,265 @@ TEST_F(ParquetReaderTest, normal) {
     delete p_reader;
 }
 
+static const std::string kTestDir = "./ut_dir/parquet_reader_test";
+
+// Append the column chunk of a required INT32 column to `file`, each data page has the PLAIN
+// values of `page_rows` rows. The pages are recorded in the offset index and the column index.
+static tparquet::ColumnChunk write_int_column(const std::string& name,
+                                              const std::vector<int32_t>& values, int page_rows,
+                                              std::string* file,
+                                              tparquet::OffsetIndex* offset_index,
+                                              tparquet::ColumnIndex* column_index) {
+    ThriftSerializer serializer(true, 1024);
+    int64_t chunk_start = file->size();
+    int num_rows = values.size();
+    for (int first_row = 0; first_row < num_rows; first_row += page_rows) {
+        int num_values = std::min(page_rows, num_rows - first_row);
+        tparquet::PageHeader header;
+        header.type = tparquet::PageType::DATA_PAGE;
+        header.uncompressed_page_size = num_values * sizeof(int32_t);
+        header.compressed_page_size = header.uncompressed_page_size;
+        tparquet::DataPageHeader data_page_header;
+        data_page_header.num_values = num_values;
+        data_page_header.encoding = tparquet::Encoding::PLAIN;
+        data_page_header.definition_level_encoding = tparquet::Encoding::RLE;
+        data_page_header.repetition_level_encoding = tparquet::Encoding::RLE;
+        header.__set_data_page_header(data_page_header);
+        std::string header_buf;
+        EXPECT_TRUE(serializer.serialize(&header, &header_buf).ok());
+
+        tparquet::PageLocation location;
+        location.offset = file->size();
+        location.compressed_page_size = header_buf.size() + header.compressed_page_size;
+        location.first_row_index = first_row;
+        offset_index->page_locations.push_back(location);
+
+        file->append(header_buf);
+        auto begin = values.begin() + first_row;
+        auto end = begin + num_values;
+        for (auto it = begin; it != end; ++it) {
+            put_fixed32_le(file, *it);
+        }
+        std::string min_value;
+        std::string max_value;
+        put_fixed32_le(&min_value, *std::min_element(begin, end));
+        put_fixed32_le(&max_value, *std::max_element(begin, end));
+        column_index->null_pages.push_back(false);
+        column_index->min_values.push_back(min_value);
+        column_index->max_values.push_back(max_value);
+    }
+    column_index->boundary_order = tparquet::BoundaryOrder::UNORDERED;
+
+    tparquet::ColumnMetaData meta_data;
+    meta_data.type = tparquet::Type::INT32;
+    meta_data.encodings = {tparquet::Encoding::PLAIN, tparquet::Encoding::RLE};
+    meta_data.path_in_schema = {name};
+    meta_data.codec = tparquet::CompressionCodec::UNCOMPRESSED;
+    meta_data.num_values = values.size();
+    meta_data.total_uncompressed_size = file->size() - chunk_start;
+    meta_data.total_compressed_size = meta_data.total_uncompressed_size;
+    meta_data.data_page_offset = chunk_start;
+    tparquet::ColumnChunk chunk;
+    chunk.file_offset = chunk_start;
+    chunk.__set_meta_data(meta_data);
+    return chunk;
+}
+
+static TExprNode create_node(TExprNodeType::type node_type, PrimitiveType type,
+                             int num_children) {
+    TExprNode node;
+    node.node_type = node_type;
+    node.type = TypeDescriptor(type).to_thrift();
+    node.__set_is_nullable(false);
+    node.num_children = num_children;
+    return node;
+}
+
+// The conjunct of `slot <op> value` on an INT slot of the tuple 0.
+static VExprContextSPtr create_int_conjunct(const std::string& op, int slot_id, int32_t value,
+                                            RuntimeState* state, const RowDescriptor& row_desc) {
+    TExprNode pred = create_node(TExprNodeType::BINARY_PRED, TYPE_BOOLEAN, 2);
+    TFunction fn;
+    fn.name.function_name = op;
+    fn.binary_type = TFunctionBinaryType::BUILTIN;
+    pred.__set_fn(fn);
+    TExprNode slot = create_node(TExprNodeType::SLOT_REF, TYPE_INT, 0);
+    TSlotRef slot_ref;
+    slot_ref.slot_id = slot_id;
+    slot_ref.tuple_id = 0;
+    slot.__set_slot_ref(slot_ref);
+    TExprNode literal = create_node(TExprNodeType::INT_LITERAL, TYPE_INT, 0);
+    TIntLiteral int_literal;
+    int_literal.value = value;
+    literal.__set_int_literal(int_literal);
+
+    TExpr texpr;
+    texpr.nodes = {pred, slot, literal};
+    VExprContextSPtr context;
+    EXPECT_TRUE(VExpr::create_expr_tree(texpr, context).ok());
+    EXPECT_TRUE(context->prepare(state, row_desc).ok());
+    EXPECT_TRUE(context->open(state).ok());
+    return context;
+}
+
+TEST_F(ParquetReaderTest, skip_filtered_pages_of_lazy_column) {
+    // k, v of 600 rows in 6 pages of 100 rows. The keys of the pages 1 to 4 are out of the
+    // range of `k >= 0 and k < 1000`, but their min/max values can't filter the pages.
+    static constexpr int kNumRows = 600;
+    static constexpr int kPageRows = 100;
+    std::vector<int32_t> keys;
+    std::vector<int32_t> values;
+    for (int row = 0; row < kNumRows; ++row) {
+        if (row < kPageRows || row >= 5 * kPageRows) {
+            keys.push_back(row);
+        } else {
+            keys.push_back(row % 2 == 0 ? -1000 : 1000);
+        }
+        values.push_back(row * 10);
+    }
+
+    // the page indexes are written after the column chunks as the parquet writers do
+    std::string file = "PAR1";
+    tparquet::OffsetIndex k_offset_index;
+    tparquet::OffsetIndex v_offset_index;
+    tparquet::ColumnIndex k_column_index;
+    tparquet::ColumnIndex v_column_index;
+    auto k_chunk = write_int_column("k", keys, kPageRows, &file, &k_offset_index, &k_column_index);
+    auto v_chunk =
+            write_int_column("v", values, kPageRows, &file, &v_offset_index, &v_column_index);
+    ThriftSerializer serializer(true, 1024);
+    std::string buf;
+    ASSERT_TRUE(serializer.serialize(&k_column_index, &buf).ok());
+    k_chunk.__set_column_index_offset(file.size());
+    k_chunk.__set_column_index_length(buf.size());
+    file.append(buf);
+    ASSERT_TRUE(serializer.serialize(&k_offset_index, &buf).ok());
+    k_chunk.__set_offset_index_offset(file.size());
+    k_chunk.__set_offset_index_length(buf.size());
+    file.append(buf);
+    ASSERT_TRUE(serializer.serialize(&v_offset_index, &buf).ok());
+    v_chunk.__set_offset_index_offset(file.size());
+    v_chunk.__set_offset_index_length(buf.size());
+    file.append(buf);
+
+    tparquet::FileMetaData file_meta;
+    file_meta.version = 1;
+    tparquet::SchemaElement root;
+    root.name = "schema";
+    root.__set_num_children(2);
+    file_meta.schema.push_back(root);
+    for (const auto* name : {"k", "v"}) {
+        tparquet::SchemaElement column;
+        column.name = name;
+        column.__set_type(tparquet::Type::INT32);
+        column.__set_repetition_type(tparquet::FieldRepetitionType::REQUIRED);
+        file_meta.schema.push_back(column);
+    }
+    tparquet::RowGroup row_group;
+    row_group.columns = {k_chunk, v_chunk};
+    row_group.total_byte_size = file.size() - k_chunk.file_offset;
+    row_group.num_rows = kNumRows;
+    file_meta.num_rows = kNumRows;
+    file_meta.row_groups = {row_group};
+    ASSERT_TRUE(serializer.serialize(&file_meta, &buf).ok());
+    file.append(buf);
+    put_fixed32_le(&file, buf.size());
+    file.append("PAR1");
+
+    ASSERT_TRUE(io::global_local_filesystem()->delete_and_create_directory(kTestDir).ok());
+    std::string path = kTestDir + "/page_index.parquet";
+    std::ofstream(path, std::ios::binary) << file;
+    io::FileReaderSPtr file_reader;
+    ASSERT_TRUE(io::global_local_filesystem()->open_file(path, &file_reader).ok());
+
+    TDescriptorTableBuilder table_builder;
+    TTupleDescriptorBuilder tuple_builder;
+    tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                   .type(TYPE_INT)
+                                   .nullable(false)
+                                   .column_name("k")
+                                   .column_pos(0)
+                                   .build());
+    tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                   .type(TYPE_INT)
+                                   .nullable(false)
+                                   .column_name("v")
+                                   .column_pos(1)
+                                   .build());
+    tuple_builder.build(&table_builder);
+    ObjectPool obj_pool;
+    DescriptorTbl* desc_tbl;
+    ASSERT_TRUE(DescriptorTbl::create(&obj_pool, table_builder.desc_tbl(), &desc_tbl).ok());
+    auto* tuple_desc = desc_tbl->get_tuple_descriptor(0);
+    RowDescriptor row_desc(tuple_desc, false);
+    RuntimeState state(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr);
+    state.init_mem_trackers();
+    state.set_desc_tbl(desc_tbl);
+    int k_slot_id = tuple_desc->slots()[0]->id();
+    VExprContextSPtrs conjuncts {create_int_conjunct("ge", k_slot_id, 0, &state, row_desc),
+                                 create_int_conjunct("lt", k_slot_id, 1000, &state, row_desc)};
+    std::unordered_map<int, VExprContextSPtrs> slot_id_to_filter_conjuncts {
+            {k_slot_id, conjuncts}};
+    std::unordered_map<std::string, int> colname_to_slot_id;
+    std::vector<std::string> column_names;
+    for (auto* slot : tuple_desc->slots()) {
+        colname_to_slot_id.emplace(slot->col_name(), slot->id());
+        column_names.push_back(slot->col_name());
+    }
+
+    cctz::time_zone ctz;
+    TimezoneUtils::find_cctz_time_zone(TimezoneUtils::default_time_zone, ctz);
+    TFileScanRangeParams scan_params;
+    TFileRangeDesc scan_range;
+    scan_range.__set_path(path);
+    scan_range.__set_start_offset(0);
+    scan_range.__set_size(file.size());
+    RuntimeProfile profile("ParquetReaderTest");
+    auto reader = std::make_unique<ParquetReader>(&profile, scan_params, scan_range, kNumRows,
+                                                  &ctz, nullptr, &state);
+    reader->set_file_reader(file_reader);
+    ASSERT_TRUE(reader->open().ok());
+    // no value range to filter the pages by the column index, the pages of the lazily read
+    // column `v` are only skipped by the filter of the predicate column `k`
+    ASSERT_TRUE(reader->init_reader(column_names, {}, nullptr, conjuncts, tuple_desc, &row_desc,
+                                    &colname_to_slot_id, nullptr, &slot_id_to_filter_conjuncts,
+                                    false)
+                        .ok());
+    ASSERT_TRUE(reader->set_fill_columns({}, {}).ok());
+
+    std::vector<int64_t> read_keys;
+    std::vector<int64_t> read_values;
+    bool eof = false;
+    while (!eof) {
+        Block block;
+        for (auto* slot : tuple_desc->slots()) {
+            block.insert({slot->get_empty_mutable_column(), slot->get_data_type_ptr(),
+                          slot->col_name()});
+        }
+        size_t read_rows = 0;
+        ASSERT_TRUE(reader->get_next_block(&block, &read_rows, &eof).ok());
+        for (size_t row = 0; row < block.rows(); ++row) {
+            read_keys.push_back(block.get_by_position(0).column->get_int(row));
+            read_values.push_back(block.get_by_position(1).column->get_int(row));
+        }
+    }
+    // the counters of the profile are updated on close
+    reader.reset();
+
+    std::vector<int64_t> expected_keys;
+    std::vector<int64_t> expected_values;
+    for (int row = 0; row < kNumRows; ++row) {
+        if (keys[row] >= 0 && keys[row] < 1000) {
+            expected_keys.push_back(keys[row]);
+            expected_values.push_back(values[row]);
+        }
+    }
+    EXPECT_EQ(expected_keys, read_keys);
+    EXPECT_EQ(expected_values, read_values);
+    // the 4 filtered pages of `v` are skipped without reading their headers
+    EXPECT_EQ(4, profile.get_counter("SkipPageByIndexCount")->value());
+    EXPECT_TRUE(io::global_local_filesystem()->delete_directory(kTestDir).ok());
+}
+
 } // namespace vectorized
 } // namespace doris
@@ -0,0 +1,71 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/format/parquet/parquet_scan_cache.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+#include <string.h>
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest_pred_impl.h"
+
+namespace doris::vectorized {
+
+class ParquetScanCacheTest : public testing::Test {};
+
+TEST_F(ParquetScanCacheTest, dict) {
+    ParquetScanCache* cache = ParquetScanCache::instance();
+    ASSERT_NE(nullptr, cache);
+    // the file without modification time can't be cached
+    EXPECT_TRUE(ParquetScanCache::file_key_prefix("/path/dict.parquet", 0).empty());
+    std::string prefix = ParquetScanCache::file_key_prefix("/path/dict.parquet", 1000);
+    EXPECT_FALSE(prefix.empty());
+
+    std::string dict = "abcdefgh";
+    std::unique_ptr<uint8_t[]> data(new uint8_t[dict.size()]);
+    EXPECT_FALSE(cache->lookup_dict(prefix, 4, &data, dict.size()));
+    cache->insert_dict(prefix, 4, (const uint8_t*)dict.data(), dict.size());
+    EXPECT_TRUE(cache->lookup_dict(prefix, 4, &data, dict.size()));
+    EXPECT_EQ(0, memcmp(dict.data(), data.get(), dict.size()));
+
+    // another column chunk, another version of file, or another page size
+    EXPECT_FALSE(cache->lookup_dict(prefix, 100, &data, dict.size()));
+    std::string new_prefix = ParquetScanCache::file_key_prefix("/path/dict.parquet", 2000);
+    EXPECT_FALSE(cache->lookup_dict(new_prefix, 4, &data, dict.size()));
+    EXPECT_FALSE(cache->lookup_dict(prefix, 4, &data, dict.size() - 1));
+}
+
+TEST_F(ParquetScanCacheTest, row_group_filter) {
+    ParquetScanCache* cache = ParquetScanCache::instance();
+    ASSERT_NE(nullptr, cache);
+    std::string prefix = ParquetScanCache::file_key_prefix("/path/filter.parquet", 1000);
+    bool filtered = false;
+    EXPECT_FALSE(cache->lookup_row_group_filter(prefix, 0, "a>1", &filtered));
+    cache->insert_row_group_filter(prefix, 0, "a>1", true);
+    cache->insert_row_group_filter(prefix, 1, "a>1", false);
+    EXPECT_TRUE(cache->lookup_row_group_filter(prefix, 0, "a>1", &filtered));
+    EXPECT_TRUE(filtered);
+    EXPECT_TRUE(cache->lookup_row_group_filter(prefix, 1, "a>1", &filtered));
+    EXPECT_FALSE(filtered);
+    // other predicates
+    EXPECT_FALSE(cache->lookup_row_group_filter(prefix, 0, "a>2", &filtered));
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,232 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/scan/scan_result_cache.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "gtest/gtest_pred_impl.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/beta_rowset.h"
+#include "olap/rowset/rowset_meta.h"
+#include "olap/tablet_schema.h"
+#include "util/defer_op.h"
+#include "util/runtime_profile.h"
+#include "vec/columns/column_vector.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+
+class ScanResultCacheTest : public testing::Test {};
+
+static Block create_block(int start, int rows) {
+    auto column = ColumnInt32::create();
+    for (int i = start; i < start + rows; ++i) {
+        column->insert_value(i);
+    }
+    return Block({{std::move(column), std::make_shared<DataTypeInt32>(), "k1"}});
+}
+
+TEST_F(ScanResultCacheTest, in_memory) {
+    ScanResultCache* cache = ScanResultCache::instance();
+    ASSERT_NE(nullptr, cache);
+    RuntimeProfile profile("test");
+    EXPECT_EQ(nullptr, cache->lookup("digest|1:2", &profile));
+
+    std::vector<Block> blocks;
+    blocks.emplace_back(create_block(0, 10));
+    blocks.emplace_back(create_block(10, 5));
+    size_t bytes = blocks[0].allocated_bytes() + blocks[1].allocated_bytes();
+    EXPECT_TRUE(cache->insert("digest|1:2", std::move(blocks), bytes, &profile).ok());
+    // another version of the tablet
+    EXPECT_EQ(nullptr, cache->lookup("digest|1:3", &profile));
+
+    // each reader reads all blocks, and the blocks read can be modified
+    for (int n = 0; n < 2; ++n) {
+        auto reader = cache->lookup("digest|1:2", &profile);
+        ASSERT_NE(nullptr, reader);
+        Block block;
+        bool eos = false;
+        int rows = 0;
+        while (true) {
+            EXPECT_TRUE(reader->read(&block, &eos).ok());
+            if (eos) {
+                break;
+            }
+            const auto& column =
+                    assert_cast<const ColumnInt32&>(*block.get_by_position(0).column);
+            for (size_t i = 0; i < column.size(); ++i) {
+                EXPECT_EQ(rows++, column.get_data()[i]);
+            }
+            block.clear();
+        }
+        EXPECT_EQ(15, rows);
+    }
+}
+
+TEST_F(ScanResultCacheTest, collect_block) {
+    ScanResultCache* cache = ScanResultCache::instance();
+    ASSERT_NE(nullptr, cache);
+    auto old_max_entry_bytes = config::scan_result_cache_max_entry_bytes;
+    auto old_max_memory_entry_bytes = config::scan_result_cache_max_memory_entry_bytes;
+    auto old_disk_capacity = config::scan_result_cache_disk_capacity;
+    Defer defer {[&]() {
+        config::scan_result_cache_max_entry_bytes = old_max_entry_bytes;
+        config::scan_result_cache_max_memory_entry_bytes = old_max_memory_entry_bytes;
+        config::scan_result_cache_disk_capacity = old_disk_capacity;
+    }};
+
+    // the blocks are copied until the bytes exceed the bound, then the copies are freed
+    Block block = create_block(0, 1024);
+    config::scan_result_cache_max_entry_bytes = block.allocated_bytes() * 5 / 2;
+    EXPECT_EQ(config::scan_result_cache_max_entry_bytes,
+              static_cast<int64_t>(cache->max_entry_bytes()));
+    std::vector<Block> blocks;
+    size_t bytes = 0;
+    EXPECT_TRUE(cache->collect_block(block, &blocks, &bytes));
+    EXPECT_TRUE(cache->collect_block(block, &blocks, &bytes));
+    EXPECT_EQ(2U, blocks.size());
+    EXPECT_FALSE(cache->collect_block(block, &blocks, &bytes));
+    EXPECT_TRUE(blocks.empty());
+
+    // a result that can't be kept in memory and has no disk capacity to spill to is not
+    // copied at all
+    config::scan_result_cache_max_memory_entry_bytes = 0;
+    config::scan_result_cache_disk_capacity = cache->spilled_bytes();
+    EXPECT_EQ(0U, cache->max_entry_bytes());
+    bytes = 0;
+    EXPECT_FALSE(cache->collect_block(block, &blocks, &bytes));
+    EXPECT_TRUE(blocks.empty());
+}
+
+static RowsetSharedPtr create_rowset(int64_t id) {
+    RowsetMetaSharedPtr rowset_meta(new RowsetMeta());
+    RowsetId rowset_id;
+    rowset_id.init(id);
+    rowset_meta->set_rowset_id(rowset_id);
+    return std::make_shared<BetaRowset>(std::make_shared<TabletSchema>(), "", rowset_meta);
+}
+
+static int read_rows(ScanResultCache::Reader* reader) {
+    Block block;
+    bool eos = false;
+    int rows = 0;
+    while (true) {
+        EXPECT_TRUE(reader->read(&block, &eos).ok());
+        if (eos) {
+            break;
+        }
+        rows += block.rows();
+        block.clear();
+    }
+    return rows;
+}
+
+TEST_F(ScanResultCacheTest, rowset_result) {
+    ScanResultCache* cache = ScanResultCache::instance();
+    ASSERT_NE(nullptr, cache);
+    RuntimeProfile profile("test");
+    std::vector<RowsetSharedPtr> input_rowsets {create_rowset(101), create_rowset(102)};
+    auto output_rowset = create_rowset(103);
+
+    for (int i = 0; i < 2; ++i) {
+        std::vector<Block> blocks;
+        blocks.emplace_back(create_block(0, 10 * (i + 1)));
+        size_t bytes = blocks[0].allocated_bytes();
+        EXPECT_TRUE(cache->insert_rowset_result("digest", input_rowsets[i]->rowset_id(),
+                                                std::move(blocks), bytes, &profile)
+                            .ok());
+    }
+    // only the first rowset has the result of another scan
+    std::vector<Block> blocks;
+    blocks.emplace_back(create_block(0, 1));
+    size_t bytes = blocks[0].allocated_bytes();
+    EXPECT_TRUE(cache->insert_rowset_result("other", input_rowsets[0]->rowset_id(),
+                                            std::move(blocks), bytes, &profile)
+                        .ok());
+
+    auto reader = cache->lookup(
+            ScanResultCache::rowset_key("digest", input_rowsets[1]->rowset_id()), &profile);
+    ASSERT_NE(nullptr, reader);
+    EXPECT_EQ(20, read_rows(reader.get()));
+
+    cache->carry_over_rowset_results(input_rowsets, output_rowset, &profile);
+    reader = cache->lookup(ScanResultCache::rowset_key("digest", output_rowset->rowset_id()),
+                           &profile);
+    ASSERT_NE(nullptr, reader);
+    EXPECT_EQ(30, read_rows(reader.get()));
+    EXPECT_EQ(nullptr, cache->lookup(ScanResultCache::rowset_key("other",
+                                                                 output_rowset->rowset_id()),
+                                     &profile));
+}
+
+TEST_F(ScanResultCacheTest, rowset_result_parts) {
+    ScanResultCache* cache = ScanResultCache::instance();
+    ASSERT_NE(nullptr, cache);
+    RuntimeProfile profile("test");
+    auto rowset = create_rowset(201);
+    auto key = ScanResultCache::rowset_key("parts", rowset->rowset_id());
+
+    // the result is cached when all the parts are added, in the order of the parts
+    ScanResultCache::RowsetResultParts parts("parts", rowset->rowset_id(), 3);
+    for (int part_id : {2, 0}) {
+        std::vector<Block> blocks;
+        blocks.emplace_back(create_block(part_id * 10, 10));
+        size_t bytes = blocks[0].allocated_bytes();
+        parts.add(part_id, std::move(blocks), bytes, &profile);
+        EXPECT_EQ(nullptr, cache->lookup(key, &profile));
+    }
+    std::vector<Block> blocks;
+    parts.add(1, std::move(blocks), 0, &profile);
+    auto reader = cache->lookup(key, &profile);
+    ASSERT_NE(nullptr, reader);
+    Block block;
+    bool eos = false;
+    std::vector<int> first_rows;
+    while (true) {
+        EXPECT_TRUE(reader->read(&block, &eos).ok());
+        if (eos) {
+            break;
+        }
+        first_rows.push_back(
+                assert_cast<const ColumnInt32&>(*block.get_by_position(0).column).get_data()[0]);
+        block.clear();
+    }
+    EXPECT_EQ(std::vector<int>({0, 20}), first_rows);
+
+    // nothing is cached if a part is aborted
+    auto other_rowset = create_rowset(202);
+    ScanResultCache::RowsetResultParts aborted_parts("parts", other_rowset->rowset_id(), 2);
+    blocks.clear();
+    blocks.emplace_back(create_block(0, 10));
+    size_t bytes = blocks[0].allocated_bytes();
+    aborted_parts.add(0, std::move(blocks), bytes, &profile);
+    aborted_parts.abort();
+    blocks.clear();
+    aborted_parts.add(1, std::move(blocks), 0, &profile);
+    EXPECT_EQ(nullptr,
+              cache->lookup(ScanResultCache::rowset_key("parts", other_rowset->rowset_id()),
+                            &profile));
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,73 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/scan/vfile_scanner.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <string>
+
+#include "gtest/gtest_pred_impl.h"
+#include "runtime/types.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_factory.hpp"
+#include "vec/io/reader_buffer.h"
+
+namespace doris::vectorized {
+
+// A block of a nullable column of `type` of the value parsed from the string.
+static Block create_block(const TypeDescriptor& type, std::string value) {
+    auto data_type = DataTypeFactory::instance().create_data_type(type, true);
+    auto column = data_type->create_column();
+    ReadBuffer buffer(value.data(), value.size());
+    EXPECT_TRUE(data_type->from_string(buffer, column.get()).ok());
+    return Block({{std::move(column), data_type, "c0"}});
+}
+
+static std::string cast_to_input_column(Block* block, const TypeDescriptor& type) {
+    auto return_type = DataTypeFactory::instance().create_data_type(type, true);
+    EXPECT_TRUE(VFileScanner::cast_to_input_column(block, 0, return_type).ok());
+    const auto& column = block->get_by_position(0);
+    EXPECT_EQ(return_type->get_name(), column.type->get_name());
+    return column.type->to_string(*column.column, 0);
+}
+
+TEST(VFileScannerTest, cast_to_narrower_input_column) {
+    // the decimals of the same scale take the precision of the slot
+    Block block = create_block(TypeDescriptor::create_decimalv3_type(18, 2), "123.45");
+    auto decimal = TypeDescriptor::create_decimalv3_type(12, 2);
+    EXPECT_EQ("123.45", cast_to_input_column(&block, decimal));
+    EXPECT_EQ(12U, remove_nullable(block.get_by_position(0).type)->get_precision());
+
+    // the datetimes take the scale of the slot
+    TypeDescriptor datetime(TYPE_DATETIMEV2);
+    block = create_block(datetime, "2023-01-02 03:04:05.123456");
+    datetime.scale = 0;
+    EXPECT_EQ("2023-01-02 03:04:05", cast_to_input_column(&block, datetime));
+    EXPECT_EQ(0U, remove_nullable(block.get_by_position(0).type)->get_scale());
+}
+
+TEST(VFileScannerTest, keep_string_input_column) {
+    Block block = create_block(TypeDescriptor::create_string_type(), "abc");
+    const auto* column = block.get_by_position(0).column.get();
+    EXPECT_EQ("abc", cast_to_input_column(&block, TypeDescriptor::create_string_type()));
+    // the strings of the expected type are not copied
+    EXPECT_EQ(column, block.get_by_position(0).column.get());
+}
+
+} // namespace doris::vectorized
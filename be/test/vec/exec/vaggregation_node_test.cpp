@@ -0,0 +1,682 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vaggregation_node.h"
+
+#include <fmt/format.h>
+#include <gen_cpp/Descriptors_types.h>
+#include <gen_cpp/Exprs_types.h>
+#include <gen_cpp/PaloInternalService_types.h>
+#include <gen_cpp/PlanNodes_types.h>
+#include <gen_cpp/Types_types.h>
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/config.h"
+#include "common/exception.h"
+#include "common/object_pool.h"
+#include "exec/exec_node.h"
+#include "gtest/gtest_pred_impl.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+#include "runtime/types.h"
+#include "util/defer_op.h"
+#include "util/runtime_profile.h"
+#include "util/threadpool.h"
+#include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/aggregate_functions/aggregate_function_simple_factory.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/arena.h"
+#include "vec/common/assert_cast.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_factory.hpp"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exprs/vectorized_fn_call.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
+#include "vec/exprs/vshared_expr.h"
+#include "vec/io/io_helper.h"
+#include "vec/io/reader_buffer.h"
+
+namespace doris::vectorized {
+
+// An aggregation node reading the blocks sunk by the test instead of a child node.
+class TestAggregationNode : public AggregationNode {
+public:
+    using AggregationNode::AggregationNode;
+
+    void add_child(ExecNode* child) { _children.push_back(child); }
+
+    // the root of the argument of the i-th agg function
+    const VExprSPtr& agg_input_root(size_t i) const {
+        return _aggregate_evaluators[i]->input_exprs_ctxs()[0]->root();
+    }
+
+    const Sizes& offsets_of_aggregate_states() const { return _offsets_of_aggregate_states; }
+    size_t total_size_of_aggregate_states() const { return _total_size_of_aggregate_states; }
+    size_t align_aggregate_states() const { return _align_aggregate_states; }
+    size_t size_of_fixed_states() const { return _size_of_fixed_states; }
+    ConstAggregateDataPtr fixed_states_template() const { return _fixed_states_template; }
+    const std::vector<size_t>& non_fixed_state_evaluators() const {
+        return _non_fixed_state_evaluators;
+    }
+
+    // the size and the alignment of the state of the i-th agg function
+    size_t size_of_state(size_t i) const {
+        return _aggregate_evaluators[i]->function()->size_of_data();
+    }
+    size_t align_of_state(size_t i) const {
+        return _aggregate_evaluators[i]->function()->align_of_data();
+    }
+
+    Status create_agg_status(AggregateDataPtr data) { return _create_agg_status(data); }
+    Status destroy_agg_status(AggregateDataPtr data) { return _destroy_agg_status(data); }
+};
+
+class AggregationNodeTest : public testing::Test {
+public:
+    struct Slot {
+        TypeDescriptor type;
+        bool nullable;
+    };
+
+    struct AggFunction {
+        std::string name;
+        int input_slot;
+        Slot output;
+        // the nodes of the argument in pre-order instead of the input slot if not empty
+        std::vector<TExprNode> input_nodes = {};
+    };
+
+    // Aggregate the input tuple of `input_slots`, grouped by the input slots `keys`. The
+    // group by keys and the results of the functions are the slots of the output tuple.
+    void build(const std::vector<Slot>& input_slots, const std::vector<int>& keys,
+               const std::vector<AggFunction>& functions) {
+        _input_slots = input_slots;
+        TDescriptorTable desc_tbl;
+        int slot_id = 0;
+        _add_tuple(&desc_tbl, 0, input_slots, &slot_id);
+        std::vector<Slot> output_slots;
+        for (int key : keys) {
+            output_slots.push_back(input_slots[key]);
+        }
+        for (const auto& function : functions) {
+            output_slots.push_back(function.output);
+        }
+        // the intermediate and the output tuples
+        _add_tuple(&desc_tbl, 1, output_slots, &slot_id);
+        _add_tuple(&desc_tbl, 2, output_slots, &slot_id);
+        DescriptorTbl* descs = nullptr;
+        ASSERT_TRUE(DescriptorTbl::create(&_pool, desc_tbl, &descs).ok());
+        _state.set_desc_tbl(descs);
+
+        TPlanNode child_tnode;
+        child_tnode.__set_node_id(0);
+        child_tnode.__set_node_type(TPlanNodeType::EXCHANGE_NODE);
+        child_tnode.__set_num_children(0);
+        child_tnode.__set_limit(-1);
+        child_tnode.__set_row_tuples({0});
+        child_tnode.__set_nullable_tuples({false});
+        auto* child = _pool.add(new ExecNode(&_pool, child_tnode, *descs));
+        ASSERT_TRUE(child->init(child_tnode, &_state).ok());
+
+        TAggregationNode agg_node;
+        for (int key : keys) {
+            agg_node.grouping_exprs.push_back(_slot_ref(key));
+        }
+        agg_node.__isset.grouping_exprs = true;
+        for (const auto& function : functions) {
+            agg_node.aggregate_functions.push_back(_agg_expr(function));
+        }
+        agg_node.__set_intermediate_tuple_id(1);
+        agg_node.__set_output_tuple_id(2);
+        agg_node.__set_need_finalize(true);
+        agg_node.__set_use_streaming_preaggregation(false);
+        agg_node.__set_is_first_phase(true);
+        TPlanNode tnode;
+        tnode.__set_node_id(1);
+        tnode.__set_node_type(TPlanNodeType::AGGREGATION_NODE);
+        tnode.__set_num_children(1);
+        tnode.__set_limit(-1);
+        tnode.__set_row_tuples({2});
+        tnode.__set_nullable_tuples({false});
+        tnode.__set_agg_node(agg_node);
+        _node = _pool.add(new TestAggregationNode(&_pool, tnode, *descs));
+        _node->add_child(child);
+        ASSERT_TRUE(_node->init(tnode, &_state).ok());
+        ASSERT_TRUE(_node->prepare(&_state).ok());
+        ASSERT_TRUE(_node->alloc_resource(&_state).ok());
+    }
+
+    // Sink the blocks, and return the output rows as "v1|v2|...", sorted.
+    std::vector<std::string> aggregate(std::vector<Block> blocks) {
+        for (auto& block : blocks) {
+            EXPECT_TRUE(_node->sink(&_state, &block, false).ok());
+        }
+        Block empty;
+        EXPECT_TRUE(_node->sink(&_state, &empty, true).ok());
+        std::vector<std::string> rows;
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            EXPECT_TRUE(_node->pull(&_state, &block, &eos).ok());
+            for (size_t row = 0; row < block.rows(); ++row) {
+                std::string value;
+                for (size_t i = 0; i < block.columns(); ++i) {
+                    const auto& column = block.get_by_position(i);
+                    value += (i == 0 ? "" : "|") + column.type->to_string(*column.column, row);
+                }
+                rows.push_back(std::move(value));
+            }
+        }
+        EXPECT_TRUE(_node->close(&_state).ok());
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    // A block of the input tuple, the values of the rows are given as strings.
+    Block make_block(const std::vector<std::vector<std::string>>& rows) {
+        Block block;
+        for (size_t i = 0; i < _input_slots.size(); ++i) {
+            auto type = DataTypeFactory::instance().create_data_type(_input_slots[i].type,
+                                                                     _input_slots[i].nullable);
+            auto column = type->create_column();
+            for (const auto& row : rows) {
+                if (row[i] == "NULL") {
+                    column->insert_default();
+                    continue;
+                }
+                ReadBuffer buffer(const_cast<char*>(row[i].data()), row[i].size());
+                EXPECT_TRUE(type->from_string(buffer, column.get()).ok());
+            }
+            block.insert({std::move(column), type, "c" + std::to_string(i)});
+        }
+        return block;
+    }
+
+    int64_t counter_value(const std::string& name) {
+        auto* counter = _node->runtime_profile()->get_counter(name);
+        return counter == nullptr ? -1 : counter->value();
+    }
+
+protected:
+    static void _add_tuple(TDescriptorTable* desc_tbl, int tuple_id,
+                           const std::vector<Slot>& slots, int* slot_id) {
+        for (size_t i = 0; i < slots.size(); ++i) {
+            TSlotDescriptor slot_desc;
+            slot_desc.__set_id((*slot_id)++);
+            slot_desc.__set_parent(tuple_id);
+            slot_desc.__set_slotType(slots[i].type.to_thrift());
+            slot_desc.__set_columnPos(i);
+            slot_desc.__set_byteOffset(0);
+            slot_desc.__set_nullIndicatorByte(slots[i].nullable ? i / 8 : 0);
+            slot_desc.__set_nullIndicatorBit(slots[i].nullable ? i % 8 : -1);
+            slot_desc.__set_colName("c" + std::to_string(i));
+            slot_desc.__set_slotIdx(i);
+            slot_desc.__set_isMaterialized(true);
+            desc_tbl->slotDescriptors.push_back(slot_desc);
+        }
+        desc_tbl->__isset.slotDescriptors = true;
+        TTupleDescriptor tuple_desc;
+        tuple_desc.__set_id(tuple_id);
+        tuple_desc.__set_byteSize(0);
+        tuple_desc.__set_numNullBytes((slots.size() + 7) / 8);
+        desc_tbl->tupleDescriptors.push_back(tuple_desc);
+    }
+
+    TExprNode _slot_ref_node(int input_slot) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::SLOT_REF);
+        node.__set_type(_input_slots[input_slot].type.to_thrift());
+        node.__set_num_children(0);
+        node.__set_is_nullable(_input_slots[input_slot].nullable);
+        TSlotRef slot_ref;
+        // the slots of the input tuple are the first ones
+        slot_ref.__set_slot_id(input_slot);
+        slot_ref.__set_tuple_id(0);
+        node.__set_slot_ref(slot_ref);
+        return node;
+    }
+
+    TExpr _slot_ref(int input_slot) {
+        TExpr expr;
+        expr.nodes.push_back(_slot_ref_node(input_slot));
+        return expr;
+    }
+
+    // a builtin binary function of the non-null arguments
+    static TExprNode _fn_node(const std::string& name, const TypeDescriptor& type) {
+        TFunctionName fn_name;
+        fn_name.__set_function_name(name);
+        TFunction fn;
+        fn.__set_name(fn_name);
+        fn.__set_binary_type(TFunctionBinaryType::BUILTIN);
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::ARITHMETIC_EXPR);
+        node.__set_type(type.to_thrift());
+        node.__set_num_children(2);
+        node.__set_is_nullable(false);
+        node.__set_fn(fn);
+        return node;
+    }
+
+    TExpr _agg_expr(const AggFunction& function) {
+        std::vector<TExprNode> input_nodes = function.input_nodes;
+        if (input_nodes.empty()) {
+            input_nodes.push_back(_slot_ref_node(function.input_slot));
+        }
+        TFunctionName name;
+        name.__set_function_name(function.name);
+        TFunction fn;
+        fn.__set_name(name);
+        fn.__set_binary_type(TFunctionBinaryType::BUILTIN);
+        fn.__set_arg_types({input_nodes[0].type});
+        fn.__set_ret_type(function.output.type.to_thrift());
+        fn.__set_has_var_args(false);
+        TAggregateExpr agg_expr;
+        agg_expr.__set_is_merge_agg(false);
+        agg_expr.__set_param_types({input_nodes[0].type});
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::AGG_EXPR);
+        node.__set_type(function.output.type.to_thrift());
+        node.__set_num_children(1);
+        node.__set_is_nullable(function.output.nullable);
+        node.__set_fn(fn);
+        node.__set_agg_expr(agg_expr);
+        TExpr expr;
+        expr.nodes.push_back(node);
+        expr.nodes.insert(expr.nodes.end(), input_nodes.begin(), input_nodes.end());
+        return expr;
+    }
+
+    ObjectPool _pool;
+    RuntimeState _state;
+    std::vector<Slot> _input_slots;
+    TestAggregationNode* _node = nullptr;
+};
+
+static const AggregationNodeTest::Slot STRING_SLOT = {TypeDescriptor::create_string_type(), false};
+static const AggregationNodeTest::Slot NULLABLE_STRING_SLOT = {
+        TypeDescriptor::create_string_type(), true};
+static const AggregationNodeTest::Slot INT_SLOT = {TypeDescriptor(TYPE_INT), false};
+static const AggregationNodeTest::Slot BIGINT_SLOT = {TypeDescriptor(TYPE_BIGINT), false};
+
+// The state of test_tracked_state, which counts the states alive and can fail to be created.
+struct TrackedState {
+    static inline int64_t num_alive = 0;
+    // the number of the states created before a creation fails, -1 if no creation fails
+    static inline int64_t creations_before_failure = -1;
+    static inline bool insert_result_thread_safe = true;
+    // the threads inserting the results
+    static inline std::mutex result_threads_lock;
+    static inline std::set<std::thread::id> result_threads;
+
+    TrackedState() {
+        if (creations_before_failure == 0) {
+            throw Exception(ErrorCode::INTERNAL_ERROR, "failed to create the tracked state");
+        }
+        if (creations_before_failure > 0) {
+            --creations_before_failure;
+        }
+        ++num_alive;
+    }
+
+    ~TrackedState() { --num_alive; }
+
+    int64_t sum = 0;
+};
+
+// test_tracked_state(bigint) is the sum of the values in a state with a non-trivial
+// destructor, which is created and destroyed by the function.
+class AggregateFunctionTrackedState final
+        : public IAggregateFunctionDataHelper<TrackedState, AggregateFunctionTrackedState> {
+public:
+    AggregateFunctionTrackedState(const DataTypes& argument_types_)
+            : IAggregateFunctionDataHelper(argument_types_) {}
+
+    static void register_function() {
+        TrackedState::num_alive = 0;
+        TrackedState::creations_before_failure = -1;
+        TrackedState::insert_result_thread_safe = true;
+        TrackedState::result_threads.clear();
+        AggregateFunctionSimpleFactory::instance().register_function(
+                "test_tracked_state",
+                [](const std::string& name, const DataTypes& argument_types,
+                   const bool result_is_nullable) -> AggregateFunctionPtr {
+                    return std::make_shared<AggregateFunctionTrackedState>(argument_types);
+                });
+    }
+
+    String get_name() const override { return "test_tracked_state"; }
+
+    DataTypePtr get_return_type() const override { return std::make_shared<DataTypeInt64>(); }
+
+    void add(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
+             Arena*) const override {
+        data(place).sum += assert_cast<const ColumnInt64&>(*columns[0]).get_element(row_num);
+    }
+
+    void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
+               Arena*) const override {
+        data(place).sum += data(rhs).sum;
+    }
+
+    void serialize(ConstAggregateDataPtr __restrict place, BufferWritable& buf) const override {
+        write_binary(data(place).sum, buf);
+    }
+
+    void deserialize(AggregateDataPtr __restrict place, BufferReadable& buf,
+                     Arena*) const override {
+        read_binary(data(place).sum, buf);
+    }
+
+    void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
+        {
+            std::lock_guard<std::mutex> lock(TrackedState::result_threads_lock);
+            TrackedState::result_threads.insert(std::this_thread::get_id());
+        }
+        assert_cast<ColumnInt64&>(to).get_data().push_back(data(place).sum);
+    }
+
+    bool is_insert_result_thread_safe() const override {
+        return TrackedState::insert_result_thread_safe;
+    }
+};
+
+// Rows of (string key, int key, bigint value) of `num_keys` distinct string keys, and the
+// expected output of grouping them by the keys with sum and count of the values.
+static void make_string_key_rows(int num_rows, int num_keys,
+                                 std::vector<std::vector<std::string>>* rows,
+                                 std::vector<std::string>* expected) {
+    std::map<std::pair<std::string, int>, std::pair<int64_t, int64_t>> groups;
+    for (int i = 0; i < num_rows; ++i) {
+        // some keys are null
+        std::string key = i % 7 == 3 ? "NULL" : "key_" + std::to_string(i % num_keys);
+        int int_key = i % 3;
+        rows->push_back({key, std::to_string(int_key), std::to_string(i)});
+        auto& group = groups[{key, int_key}];
+        group.first += i;
+        group.second++;
+    }
+    for (const auto& [keys, values] : groups) {
+        expected->push_back(fmt::format("{}|{}|{}|{}", keys.first, keys.second, values.first,
+                                        values.second));
+    }
+    std::sort(expected->begin(), expected->end());
+}
+
+TEST_F(AggregationNodeTest, string_key_dictionary) {
+    double old_ratio = config::agg_string_key_dict_max_ratio;
+    Defer defer {[&]() { config::agg_string_key_dict_max_ratio = old_ratio; }};
+
+    // low cardinality multi-column keys are aggregated by the dictionary codes, the keys of
+    // high cardinality fall back to the serialized keys on the first block, and the results
+    // are the same as without the dictionary
+    for (double ratio : {0.25, 0.0}) {
+        for (int num_keys : {5, 3000}) {
+            config::agg_string_key_dict_max_ratio = ratio;
+            build({NULLABLE_STRING_SLOT, INT_SLOT, BIGINT_SLOT}, {0, 1},
+                  {{"sum", 2, BIGINT_SLOT}, {"count", 2, BIGINT_SLOT}});
+            std::vector<std::vector<std::string>> rows;
+            std::vector<std::string> expected;
+            make_string_key_rows(9000, num_keys, &rows, &expected);
+            std::vector<Block> blocks;
+            for (size_t i = 0; i < rows.size(); i += 4096) {
+                blocks.push_back(make_block(std::vector<std::vector<std::string>>(
+                        rows.begin() + i, rows.begin() + std::min(i + 4096, rows.size()))));
+            }
+            EXPECT_EQ(expected, aggregate(std::move(blocks))) << ratio << " " << num_keys;
+            EXPECT_EQ(ratio > 0 && num_keys == 5 ? num_keys : 0,
+                      counter_value("StringKeyDictSize"))
+                    << ratio << " " << num_keys;
+        }
+    }
+}
+
+TEST_F(AggregationNodeTest, single_string_key_without_dictionary) {
+    double old_ratio = config::agg_string_key_dict_max_ratio;
+    config::agg_string_key_dict_max_ratio = 0.25;
+    Defer defer {[&]() { config::agg_string_key_dict_max_ratio = old_ratio; }};
+
+    // a single string key is hashed by the string hash table
+    build({STRING_SLOT, BIGINT_SLOT}, {0}, {{"sum", 1, BIGINT_SLOT}});
+    std::vector<std::vector<std::string>> rows;
+    for (int i = 0; i < 100; ++i) {
+        rows.push_back({"key_" + std::to_string(i % 2), std::to_string(i)});
+    }
+    std::vector<Block> blocks;
+    blocks.push_back(make_block(rows));
+    EXPECT_EQ(std::vector<std::string>({"key_0|2450", "key_1|2500"}),
+              aggregate(std::move(blocks)));
+    EXPECT_EQ(0, counter_value("StringKeyDictSize"));
+}
+
+TEST_F(AggregationNodeTest, shared_agg_inputs) {
+    // k, a, b, c: group by k, sum(a + b), sum((a + b) * c), with the default config which
+    // fuses `(a + b) * c` when the exprs are prepared
+    build({INT_SLOT, BIGINT_SLOT, BIGINT_SLOT, BIGINT_SLOT}, {0},
+          {{"sum", -1, BIGINT_SLOT,
+            {_fn_node("add", BIGINT_SLOT.type), _slot_ref_node(1), _slot_ref_node(2)}},
+           {"sum", -1, BIGINT_SLOT,
+            {_fn_node("multiply", BIGINT_SLOT.type), _fn_node("add", BIGINT_SLOT.type),
+             _slot_ref_node(1), _slot_ref_node(2), _slot_ref_node(3)}}});
+    if (!config::enable_shared_common_exprs) {
+        return;
+    }
+    // `a + b` is evaluated once, and `(a + b) * c` is not fused across it
+    EXPECT_NE(nullptr, dynamic_cast<VSharedExpr*>(_node->agg_input_root(0).get()));
+    const auto* multiply = dynamic_cast<VectorizedFnCall*>(_node->agg_input_root(1).get());
+    ASSERT_NE(nullptr, multiply);
+    EXPECT_NE(nullptr, dynamic_cast<VSharedExpr*>(multiply->get_child(0).get()));
+    EXPECT_EQ(nullptr, multiply->fused_kernel());
+
+    std::vector<std::vector<std::string>> rows;
+    std::map<int, std::pair<int64_t, int64_t>> groups;
+    for (int i = 0; i < 100; ++i) {
+        int64_t a = i, b = i % 7, c = i % 5;
+        rows.push_back({std::to_string(i % 3), std::to_string(a), std::to_string(b),
+                        std::to_string(c)});
+        groups[i % 3].first += a + b;
+        groups[i % 3].second += (a + b) * c;
+    }
+    std::vector<std::string> expected;
+    for (const auto& [key, sums] : groups) {
+        expected.push_back(fmt::format("{}|{}|{}", key, sums.first, sums.second));
+    }
+    std::vector<Block> blocks;
+    blocks.push_back(make_block(rows));
+    EXPECT_EQ(expected, aggregate(std::move(blocks)));
+}
+
+TEST_F(AggregationNodeTest, parallel_finalize) {
+    int old_parallelism = config::agg_finalize_parallelism;
+    std::unique_ptr<ThreadPool> thread_pool;
+    ASSERT_TRUE(ThreadPoolBuilder("AggFinalizeThreadPool")
+                        .set_min_threads(1)
+                        .set_max_threads(4)
+                        .build(&thread_pool)
+                        .ok());
+    ExecEnv::GetInstance()->set_agg_finalize_thread_pool(std::move(thread_pool));
+    Defer defer {[&]() {
+        config::agg_finalize_parallelism = old_parallelism;
+        ExecEnv::GetInstance()->set_agg_finalize_thread_pool(nullptr);
+    }};
+
+    TQueryOptions query_options;
+    query_options.__set_batch_size(1024);
+    ASSERT_TRUE(_state.init(TUniqueId(), query_options, TQueryGlobals(), ExecEnv::GetInstance())
+                        .ok());
+    _state.init_mem_trackers();
+
+    // more groups than the batches finalized concurrently at a time, some keys are null
+    int num_keys = 10 * _state.batch_size() + 5;
+    std::vector<std::vector<std::string>> rows;
+    for (int i = 0; i < 2 * num_keys; ++i) {
+        int key = i % num_keys;
+        rows.push_back({key % 1000 == 7 ? "NULL" : std::to_string(key), std::to_string(i)});
+    }
+    AggregateFunctionTrackedState::register_function();
+    // the results of test_tracked_state are inserted by the pool threads only if it is thread
+    // safe to insert them concurrently
+    std::vector<std::string> results[3];
+    std::pair<int, bool> cases[3] = {{1, true}, {4, true}, {4, false}};
+    for (int i = 0; i < 3; ++i) {
+        auto [parallelism, thread_safe] = cases[i];
+        config::agg_finalize_parallelism = parallelism;
+        TrackedState::insert_result_thread_safe = thread_safe;
+        TrackedState::result_threads.clear();
+        build({{TypeDescriptor(TYPE_INT), true}, BIGINT_SLOT}, {0},
+              {{"sum", 1, BIGINT_SLOT},
+               {"count", 1, BIGINT_SLOT},
+               {"test_tracked_state", 1, BIGINT_SLOT}});
+        std::vector<Block> blocks;
+        for (size_t j = 0; j < rows.size(); j += _state.batch_size()) {
+            blocks.push_back(make_block(std::vector<std::vector<std::string>>(
+                    rows.begin() + j,
+                    rows.begin() + std::min(j + _state.batch_size(), rows.size()))));
+        }
+        results[i] = aggregate(std::move(blocks));
+        bool in_parallel = TrackedState::result_threads.size() > 1;
+        EXPECT_EQ(parallelism > 1 && thread_safe, in_parallel) << i;
+        EXPECT_EQ(1U, TrackedState::result_threads.count(std::this_thread::get_id())) << i;
+    }
+    // the null keys are a single group
+    EXPECT_EQ(size_t(num_keys - num_keys / 1000), results[0].size());
+    EXPECT_EQ(results[0], results[1]);
+    EXPECT_EQ(results[0], results[2]);
+}
+
+TEST_F(AggregationNodeTest, fixed_size_states_first) {
+    // k, s, v: group by k, min(s), max(k), sum(v)
+    build({INT_SLOT, STRING_SLOT, BIGINT_SLOT}, {0},
+          {{"min", 1, STRING_SLOT}, {"max", 0, INT_SLOT}, {"sum", 2, BIGINT_SLOT}});
+    ASSERT_LT(_node->align_of_state(1), _node->align_of_state(2));
+    // the states of max and sum are packed at the beginning of the row, the more aligned sum
+    // before max, and the state of min(string) follows them
+    const auto& offsets = _node->offsets_of_aggregate_states();
+    EXPECT_EQ(std::vector<size_t>({0}), _node->non_fixed_state_evaluators());
+    EXPECT_EQ(0U, offsets[2]);
+    EXPECT_EQ(_node->size_of_state(2), offsets[1]);
+    EXPECT_EQ(offsets[1] + _node->size_of_state(1), _node->size_of_fixed_states());
+    EXPECT_LE(_node->size_of_fixed_states(), offsets[0]);
+    EXPECT_EQ(0U, offsets[0] % _node->align_of_state(0));
+    EXPECT_EQ(offsets[0] + _node->size_of_state(0), _node->total_size_of_aggregate_states());
+
+    std::vector<std::vector<std::string>> rows;
+    for (int i = 0; i < 100; ++i) {
+        rows.push_back({std::to_string(i % 2), "s_" + std::to_string(99 - i), std::to_string(i)});
+    }
+    std::vector<Block> blocks;
+    blocks.push_back(make_block(rows));
+    EXPECT_EQ(std::vector<std::string>({"0|s_1|0|2450", "1|s_0|1|2500"}),
+              aggregate(std::move(blocks)));
+}
+
+TEST_F(AggregationNodeTest, create_states_rollback) {
+    AggregateFunctionTrackedState::register_function();
+    Defer defer {[&]() { TrackedState::creations_before_failure = -1; }};
+
+    // k, v: group by k, test_tracked_state(v), sum(v), test_tracked_state(v)
+    build({INT_SLOT, BIGINT_SLOT}, {0},
+          {{"test_tracked_state", 1, BIGINT_SLOT},
+           {"sum", 1, BIGINT_SLOT},
+           {"test_tracked_state", 1, BIGINT_SLOT}});
+    EXPECT_EQ(std::vector<size_t>({0, 2}), _node->non_fixed_state_evaluators());
+    EXPECT_EQ(0U, _node->offsets_of_aggregate_states()[1]);
+    EXPECT_EQ(_node->size_of_state(1), _node->size_of_fixed_states());
+
+    Arena arena;
+    auto* place = arena.aligned_alloc(_node->total_size_of_aggregate_states(),
+                                      _node->align_aggregate_states());
+    // the state of the first tracked function is destroyed when the second one fails
+    TrackedState::creations_before_failure = 1;
+    EXPECT_THROW(static_cast<void>(_node->create_agg_status(place)), Exception);
+    EXPECT_EQ(0, TrackedState::num_alive);
+
+    // the fixed size states are copied from the template
+    TrackedState::creations_before_failure = -1;
+    memset(place, 0xff, _node->total_size_of_aggregate_states());
+    EXPECT_TRUE(_node->create_agg_status(place).ok());
+    EXPECT_EQ(2, TrackedState::num_alive);
+    EXPECT_EQ(0, memcmp(place, _node->fixed_states_template(), _node->size_of_fixed_states()));
+    EXPECT_TRUE(_node->destroy_agg_status(place).ok());
+    EXPECT_EQ(0, TrackedState::num_alive);
+    EXPECT_TRUE(_node->close(&_state).ok());
+}
+
+TEST_F(AggregationNodeTest, all_fixed_size_states) {
+    // k, v: group by k, sum(v), count(v), max(v), there are no states to destroy
+    build({INT_SLOT, BIGINT_SLOT}, {0},
+          {{"sum", 1, BIGINT_SLOT}, {"count", 1, BIGINT_SLOT}, {"max", 1, BIGINT_SLOT}});
+    EXPECT_TRUE(_node->non_fixed_state_evaluators().empty());
+    EXPECT_EQ(_node->total_size_of_aggregate_states(), _node->size_of_fixed_states());
+
+    std::vector<std::vector<std::string>> rows;
+    for (int i = 0; i < 100; ++i) {
+        rows.push_back({std::to_string(i % 2), std::to_string(i)});
+    }
+    std::vector<Block> blocks;
+    blocks.push_back(make_block(rows));
+    EXPECT_EQ(std::vector<std::string>({"0|2450|50|98", "1|2500|50|99"}),
+              aggregate(std::move(blocks)));
+}
+
+TEST_F(AggregationNodeTest, null_key_group_of_mixed_states) {
+    AggregateFunctionTrackedState::register_function();
+
+    // k, v, s: group by the nullable k, test_tracked_state(v), sum(v), min(s)
+    build({NULLABLE_STRING_SLOT, BIGINT_SLOT, STRING_SLOT}, {0},
+          {{"test_tracked_state", 1, BIGINT_SLOT},
+           {"sum", 1, BIGINT_SLOT},
+           {"min", 2, STRING_SLOT}});
+    EXPECT_EQ(std::vector<size_t>({0, 2}), _node->non_fixed_state_evaluators());
+
+    std::vector<std::vector<std::string>> rows;
+    std::map<std::string, std::pair<int64_t, std::string>> groups;
+    for (int i = 0; i < 100; ++i) {
+        std::string key = i % 5 == 0 ? "NULL" : "key_" + std::to_string(i % 3);
+        std::string value = "s_" + std::to_string(i % 10);
+        rows.push_back({key, std::to_string(i), value});
+        auto& group = groups.try_emplace(key, 0, value).first->second;
+        group.first += i;
+        group.second = std::min(group.second, value);
+    }
+    std::vector<std::string> expected;
+    for (const auto& [key, values] : groups) {
+        expected.push_back(fmt::format("{}|{}|{}|{}", key, values.first, values.first,
+                                       values.second));
+    }
+    std::sort(expected.begin(), expected.end());
+    std::vector<Block> blocks;
+    blocks.push_back(make_block(rows));
+    EXPECT_EQ(expected, aggregate(std::move(blocks)));
+    // the states of the null key are destroyed too
+    EXPECT_EQ(0, TrackedState::num_alive);
+}
+
+} // namespace doris::vectorized
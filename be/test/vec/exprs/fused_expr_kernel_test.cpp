@@ -0,0 +1,179 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/fused_expr_kernel.h"
+
+#include <gen_cpp/Exprs_types.h>
+#include <gen_cpp/PaloInternalService_types.h>
+#include <gen_cpp/Types_types.h>
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "gtest/gtest_pred_impl.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "runtime/types.h"
+#include "testutil/desc_tbl_builder.h"
+#include "vec/columns/column_const.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exprs/vectorized_fn_call.h"
+#include "vec/exprs/vexpr_context.h"
+
+namespace doris::vectorized {
+
+static TExprNode create_node(TExprNodeType::type node_type, PrimitiveType type,
+                             int num_children) {
+    TExprNode node;
+    node.node_type = node_type;
+    node.type = TypeDescriptor(type).to_thrift();
+    node.__set_is_nullable(false);
+    node.num_children = num_children;
+    return node;
+}
+
+static TExprNode create_fn_node(TExprNodeType::type node_type, const std::string& name,
+                                PrimitiveType type) {
+    TExprNode node = create_node(node_type, type, 2);
+    TFunction fn;
+    fn.name.function_name = name;
+    fn.binary_type = TFunctionBinaryType::BUILTIN;
+    node.__set_fn(fn);
+    return node;
+}
+
+static TExprNode create_slot_ref(PrimitiveType type, int slot_id) {
+    TExprNode node = create_node(TExprNodeType::SLOT_REF, type, 0);
+    TSlotRef slot_ref;
+    slot_ref.slot_id = slot_id;
+    slot_ref.tuple_id = 0;
+    node.__set_slot_ref(slot_ref);
+    return node;
+}
+
+static VExprContextSPtr prepare_expr(const std::vector<TExprNode>& nodes, RuntimeState* state,
+                                     const RowDescriptor& row_desc) {
+    TExpr texpr;
+    texpr.nodes = nodes;
+    VExprContextSPtr context;
+    EXPECT_TRUE(VExpr::create_expr_tree(texpr, context).ok());
+    EXPECT_TRUE(context->prepare(state, row_desc).ok());
+    EXPECT_TRUE(context->open(state).ok());
+    return context;
+}
+
+TEST(FusedExprKernelTest, execute) {
+    ObjectPool pool;
+    DescriptorTblBuilder builder(&pool);
+    builder.declare_tuple() << TYPE_BIGINT << TYPE_INT << TYPE_BIGINT << TYPE_DOUBLE
+                            << TYPE_DOUBLE;
+    DescriptorTbl* desc_tbl = builder.build();
+    RowDescriptor row_desc(const_cast<TupleDescriptor*>(desc_tbl->get_tuple_descriptor(0)),
+                           false);
+    RuntimeState state(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr);
+    state.init_mem_trackers();
+    state.set_desc_tbl(desc_tbl);
+
+    // more than a chunk of rows
+    const size_t num_rows = FusedExprKernel::CHUNK_SIZE * 2 + 10;
+    std::mt19937 rng(42);
+    auto a = ColumnInt64::create();
+    auto b = ColumnInt32::create();
+    auto c = ColumnInt64::create();
+    auto price = ColumnFloat64::create();
+    auto discount = ColumnFloat64::create();
+    for (size_t i = 0; i < num_rows; ++i) {
+        a->insert_value(int64_t(rng() % 1000) - 500);
+        b->insert_value(int32_t(rng() % 1000) - 500);
+        c->insert_value(int64_t(rng() % 1000) - 500);
+        price->insert_value(rng() % 100000 / 100.0);
+        discount->insert_value(rng() % 10 / 100.0);
+    }
+    Block block({{a->get_ptr(), std::make_shared<DataTypeInt64>(), "a"},
+                 {b->get_ptr(), std::make_shared<DataTypeInt32>(), "b"},
+                 {c->get_ptr(), std::make_shared<DataTypeInt64>(), "c"},
+                 {price->get_ptr(), std::make_shared<DataTypeFloat64>(), "price"},
+                 {discount->get_ptr(), std::make_shared<DataTypeFloat64>(), "discount"}});
+
+    // a * 2 + cast(b as bigint) > c
+    TExprNode two = create_node(TExprNodeType::INT_LITERAL, TYPE_BIGINT, 0);
+    TIntLiteral int_literal;
+    int_literal.value = 2;
+    two.__set_int_literal(int_literal);
+    auto compare_ctx = prepare_expr(
+            {create_fn_node(TExprNodeType::BINARY_PRED, "gt", TYPE_BOOLEAN),
+             create_fn_node(TExprNodeType::ARITHMETIC_EXPR, "add", TYPE_BIGINT),
+             create_fn_node(TExprNodeType::ARITHMETIC_EXPR, "multiply", TYPE_BIGINT),
+             create_slot_ref(TYPE_BIGINT, 0), two,
+             create_node(TExprNodeType::CAST_EXPR, TYPE_BIGINT, 1), create_slot_ref(TYPE_INT, 1),
+             create_slot_ref(TYPE_BIGINT, 2)},
+            &state, row_desc);
+    auto* root = dynamic_cast<VectorizedFnCall*>(compare_ctx->root().get());
+    ASSERT_NE(nullptr, root->fused_kernel());
+    int result_id = -1;
+    ASSERT_TRUE(compare_ctx->execute(&block, &result_id).ok());
+    const auto& compare_result =
+            assert_cast<const ColumnUInt8&>(*block.get_by_position(result_id).column).get_data();
+    ASSERT_EQ(num_rows, compare_result.size());
+    for (size_t i = 0; i < num_rows; ++i) {
+        EXPECT_EQ(a->get_element(i) * 2 + b->get_element(i) > c->get_element(i),
+                  compare_result[i]);
+    }
+
+    // price * (1 - discount)
+    TExprNode one = create_node(TExprNodeType::FLOAT_LITERAL, TYPE_DOUBLE, 0);
+    TFloatLiteral float_literal;
+    float_literal.value = 1;
+    one.__set_float_literal(float_literal);
+    auto arithmetic_ctx = prepare_expr(
+            {create_fn_node(TExprNodeType::ARITHMETIC_EXPR, "multiply", TYPE_DOUBLE),
+             create_slot_ref(TYPE_DOUBLE, 3),
+             create_fn_node(TExprNodeType::ARITHMETIC_EXPR, "subtract", TYPE_DOUBLE), one,
+             create_slot_ref(TYPE_DOUBLE, 4)},
+            &state, row_desc);
+    ASSERT_TRUE(arithmetic_ctx->execute(&block, &result_id).ok());
+    const auto& arithmetic_result =
+            assert_cast<const ColumnFloat64&>(*block.get_by_position(result_id).column)
+                    .get_data();
+    for (size_t i = 0; i < num_rows; ++i) {
+        EXPECT_EQ(price->get_element(i) * (1 - discount->get_element(i)), arithmetic_result[i]);
+    }
+
+    // a single node is not fused
+    auto single_ctx =
+            prepare_expr({create_fn_node(TExprNodeType::ARITHMETIC_EXPR, "add", TYPE_BIGINT),
+                          create_slot_ref(TYPE_BIGINT, 0), create_slot_ref(TYPE_BIGINT, 2)},
+                         &state, row_desc);
+    EXPECT_EQ(nullptr, dynamic_cast<VectorizedFnCall*>(single_ctx->root().get())->fused_kernel());
+
+    // fall back to the functions if the input is not the expected column
+    Block const_block = block;
+    const_block.replace_by_position(3, ColumnConst::create(ColumnFloat64::create(1, 10.0),
+                                                           num_rows));
+    EXPECT_EQ(nullptr, dynamic_cast<VectorizedFnCall*>(arithmetic_ctx->root().get())
+                               ->fused_kernel()
+                               ->execute(const_block));
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,112 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vcompound_pred.h"
+
+#include <gen_cpp/Exprs_types.h>
+#include <gen_cpp/Types_types.h>
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <memory>
+#include <vector>
+
+#include "common/config.h"
+#include "gtest/gtest_pred_impl.h"
+#include "runtime/types.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exprs/vslot_ref.h"
+
+namespace doris::vectorized {
+
+static TExprNode create_bool_node(TExprNodeType::type node_type, TExprOpcode::type opcode) {
+    TExprNode node;
+    node.node_type = node_type;
+    node.opcode = opcode;
+    node.type = TypeDescriptor(TYPE_BOOLEAN).to_thrift();
+    node.__set_is_nullable(true);
+    node.num_children = 0;
+    return node;
+}
+
+// -1 is null
+static ColumnPtr create_bool_column(const std::vector<int>& values) {
+    auto column = ColumnUInt8::create();
+    auto null_map = ColumnUInt8::create();
+    for (int value : values) {
+        column->insert_value(value == 1);
+        null_map->insert_value(value == -1);
+    }
+    return ColumnNullable::create(std::move(column), std::move(null_map));
+}
+
+static std::vector<int> execute_compound(TExprOpcode::type opcode, const ColumnPtr& lhs,
+                                         const ColumnPtr& rhs) {
+    auto pred = VCompoundPred::create_shared(
+            create_bool_node(TExprNodeType::COMPOUND_PRED, opcode));
+    for (int i = 0; i < 2; ++i) {
+        auto slot = VSlotRef::create_shared(
+                create_bool_node(TExprNodeType::SLOT_REF, TExprOpcode::INVALID_OPCODE));
+        slot->_column_id = i;
+        pred->add_child(slot);
+    }
+    auto type = make_nullable(std::make_shared<DataTypeUInt8>());
+    Block block({{lhs, type, "lhs"}, {rhs, type, "rhs"}});
+    int result_id = -1;
+    EXPECT_TRUE(pred->execute(nullptr, &block, &result_id).ok());
+
+    const auto& result = block.get_by_position(result_id).column;
+    std::vector<int> values;
+    for (size_t i = 0; i < result->size(); ++i) {
+        values.push_back(result->is_null_at(i) ? -1 : result->get_bool(i));
+    }
+    return values;
+}
+
+TEST(VCompoundPredTest, nullable_on_selection) {
+    double origin_ratio = config::expr_selection_max_ratio;
+    // evaluate the rhs on the selected rows even if most of the rows are selected
+    config::expr_selection_max_ratio = 1;
+
+    auto lhs = create_bool_column({1, 0, -1, 1, -1, 0});
+    auto rhs = create_bool_column({1, -1, 1, 0, -1, 0});
+    std::vector<int> and_result {1, 0, -1, 0, -1, 0};
+    EXPECT_EQ(and_result, execute_compound(TExprOpcode::COMPOUND_AND, lhs, rhs));
+    std::vector<int> or_result {1, -1, 1, 1, -1, 0};
+    EXPECT_EQ(or_result, execute_compound(TExprOpcode::COMPOUND_OR, lhs, rhs));
+
+    // the rhs is not evaluated if all the rows are decided by lhs
+    auto all_false = create_bool_column({0, 0, 0});
+    std::vector<int> all_false_result {0, 0, 0};
+    EXPECT_EQ(all_false_result, execute_compound(TExprOpcode::COMPOUND_AND, all_false,
+                                                 create_bool_column({1, -1, 1})));
+    std::vector<int> partial_result {-1, 1, 1};
+    EXPECT_EQ(partial_result, execute_compound(TExprOpcode::COMPOUND_OR, all_false,
+                                               create_bool_column({-1, 1, 1})));
+
+    // the input columns are not modified
+    EXPECT_EQ(6, lhs->size());
+    EXPECT_TRUE(rhs->is_null_at(1));
+
+    config::expr_selection_max_ratio = origin_ratio;
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,177 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vshared_expr.h"
+
+#include <gen_cpp/Exprs_types.h>
+#include <gen_cpp/PaloInternalService_types.h>
+#include <gen_cpp/Types_types.h>
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "common/object_pool.h"
+#include "gtest/gtest_pred_impl.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "runtime/types.h"
+#include "testutil/desc_tbl_builder.h"
+#include "util/defer_op.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exprs/vectorized_fn_call.h"
+#include "vec/exprs/vexpr_context.h"
+
+namespace doris::vectorized {
+
+static TExprNode create_node(TExprNodeType::type node_type, PrimitiveType type,
+                             int num_children) {
+    TExprNode node;
+    node.node_type = node_type;
+    node.type = TypeDescriptor(type).to_thrift();
+    node.__set_is_nullable(false);
+    node.num_children = num_children;
+    return node;
+}
+
+static TExprNode create_fn_node(TExprNodeType::type node_type, const std::string& name,
+                                PrimitiveType type) {
+    TExprNode node = create_node(node_type, type, 2);
+    TFunction fn;
+    fn.name.function_name = name;
+    fn.binary_type = TFunctionBinaryType::BUILTIN;
+    node.__set_fn(fn);
+    return node;
+}
+
+static TExprNode create_slot_ref(PrimitiveType type, int slot_id) {
+    TExprNode node = create_node(TExprNodeType::SLOT_REF, type, 0);
+    TSlotRef slot_ref;
+    slot_ref.slot_id = slot_id;
+    slot_ref.tuple_id = 0;
+    node.__set_slot_ref(slot_ref);
+    return node;
+}
+
+static VExprContextSPtr prepare_expr(const std::vector<TExprNode>& nodes, RuntimeState* state,
+                                     const RowDescriptor& row_desc) {
+    TExpr texpr;
+    texpr.nodes = nodes;
+    VExprContextSPtr context;
+    EXPECT_TRUE(VExpr::create_expr_tree(texpr, context).ok());
+    EXPECT_TRUE(context->prepare(state, row_desc).ok());
+    EXPECT_TRUE(context->open(state).ok());
+    return context;
+}
+
+static void check_share_common_exprs(bool fused) {
+    ObjectPool pool;
+    DescriptorTblBuilder builder(&pool);
+    builder.declare_tuple() << TYPE_BIGINT << TYPE_BIGINT << TYPE_BIGINT;
+    DescriptorTbl* desc_tbl = builder.build();
+    RowDescriptor row_desc(const_cast<TupleDescriptor*>(desc_tbl->get_tuple_descriptor(0)),
+                           false);
+    RuntimeState state(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr);
+    state.init_mem_trackers();
+    state.set_desc_tbl(desc_tbl);
+
+    const size_t num_rows = 100;
+    auto a = ColumnInt64::create();
+    auto b = ColumnInt64::create();
+    auto c = ColumnInt64::create();
+    for (size_t i = 0; i < num_rows; ++i) {
+        a->insert_value(i);
+        b->insert_value(i % 7);
+        c->insert_value(50);
+    }
+    auto type = std::make_shared<DataTypeInt64>();
+    Block block({{a->get_ptr(), type, "a"}, {b->get_ptr(), type, "b"}, {c->get_ptr(), type, "c"}});
+
+    // where a + b > c, select a + b, a + c
+    auto conjunct =
+            prepare_expr({create_fn_node(TExprNodeType::BINARY_PRED, "gt", TYPE_BOOLEAN),
+                          create_fn_node(TExprNodeType::ARITHMETIC_EXPR, "add", TYPE_BIGINT),
+                          create_slot_ref(TYPE_BIGINT, 0), create_slot_ref(TYPE_BIGINT, 1),
+                          create_slot_ref(TYPE_BIGINT, 2)},
+                         &state, row_desc);
+    auto projection =
+            prepare_expr({create_fn_node(TExprNodeType::ARITHMETIC_EXPR, "add", TYPE_BIGINT),
+                          create_slot_ref(TYPE_BIGINT, 0), create_slot_ref(TYPE_BIGINT, 1)},
+                         &state, row_desc);
+    auto other_projection =
+            prepare_expr({create_fn_node(TExprNodeType::ARITHMETIC_EXPR, "add", TYPE_BIGINT),
+                          create_slot_ref(TYPE_BIGINT, 0), create_slot_ref(TYPE_BIGINT, 2)},
+                         &state, row_desc);
+    // the kernel fused at prepare evaluates `a + b > c` without executing `a + b`
+    const auto* conjunct_root = dynamic_cast<VectorizedFnCall*>(conjunct->root().get());
+    ASSERT_NE(nullptr, conjunct_root);
+    EXPECT_EQ(fused, conjunct_root->fused_kernel() != nullptr);
+    VExprContextSPtrs ctxs {conjunct, projection, other_projection};
+    ASSERT_EQ(1, VSharedExpr::share_common_exprs(ctxs));
+    EXPECT_NE(nullptr, dynamic_cast<VSharedExpr*>(conjunct->root()->get_child(0).get()));
+    EXPECT_NE(nullptr, dynamic_cast<VSharedExpr*>(projection->root().get()));
+    EXPECT_EQ(nullptr, dynamic_cast<VSharedExpr*>(other_projection->root().get()));
+    // the conjunct is not fused across the shared expr
+    EXPECT_EQ(nullptr, conjunct_root->fused_kernel());
+
+    VSharedExprResults results(1);
+    results.attach_to(ctxs);
+    results.reset(&block);
+    ASSERT_TRUE(VExprContext::filter_block({conjunct}, &block, block.columns()).ok());
+    // a + b > 50
+    size_t selected_rows = 0;
+    for (size_t i = 0; i < num_rows; ++i) {
+        selected_rows += i + i % 7 > 50;
+    }
+    ASSERT_EQ(selected_rows, block.rows());
+
+    // the result of `a + b` is filtered with the block
+    const auto* shared_result = results.get(0, &block);
+    ASSERT_NE(nullptr, shared_result);
+    int result_column_id = -1;
+    ASSERT_TRUE(projection->execute(&block, &result_column_id).ok());
+    EXPECT_EQ(shared_result->column.get(), block.get_by_position(result_column_id).column.get());
+    const auto& sums =
+            assert_cast<const ColumnInt64&>(*block.get_by_position(result_column_id).column);
+    const auto& filtered_a = assert_cast<const ColumnInt64&>(*block.get_by_position(0).column);
+    const auto& filtered_b = assert_cast<const ColumnInt64&>(*block.get_by_position(1).column);
+    for (size_t i = 0; i < selected_rows; ++i) {
+        EXPECT_EQ(filtered_a.get_element(i) + filtered_b.get_element(i), sums.get_element(i));
+    }
+
+    // the results are not used on the other blocks
+    Block other_block = block;
+    EXPECT_EQ(nullptr, results.get(0, &other_block));
+    results.reset(&other_block);
+    EXPECT_EQ(nullptr, results.get(0, &other_block));
+}
+
+TEST(VSharedExprTest, share_common_exprs) {
+    bool enable_fused_expr_kernel = config::enable_fused_expr_kernel;
+    Defer defer {[&]() { config::enable_fused_expr_kernel = enable_fused_expr_kernel; }};
+    // the default config fuses the exprs
+    check_share_common_exprs(config::enable_fused_expr_kernel);
+    config::enable_fused_expr_kernel = !enable_fused_expr_kernel;
+    check_share_common_exprs(config::enable_fused_expr_kernel);
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,217 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/olap/vcollect_iterator.h"
+
+#include <gen_cpp/AgentService_types.h>
+#include <gen_cpp/Descriptors_types.h>
+#include <gen_cpp/PaloInternalService_types.h>
+#include <gen_cpp/Types_types.h>
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "common/status.h"
+#include "gtest/gtest_pred_impl.h"
+#include "olap/reader.h"
+#include "olap/rowset/rowset_reader.h"
+#include "olap/tablet.h"
+#include "olap/tablet_meta.h"
+#include "runtime/exec_env.h"
+#include "runtime/memory/mem_tracker_limiter.h"
+#include "runtime/query_context.h"
+#include "runtime/runtime_state.h"
+#include "util/uid_util.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+
+static Block create_key_block(const std::vector<int32_t>& keys) {
+    auto column = ColumnInt32::create();
+    for (auto key : keys) {
+        column->insert_value(key);
+    }
+    return Block({{std::move(column), std::make_shared<DataTypeInt32>(), "k"}});
+}
+
+// Returns the blocks of a rowset one by one, and counts the blocks read.
+class MockRowsetReader : public RowsetReader {
+public:
+    MockRowsetReader(std::vector<Block> blocks) : _blocks(std::move(blocks)) {}
+
+    Status init(RowsetReaderContext* read_context, const RowSetSplits& rs_splits) override {
+        return Status::OK();
+    }
+
+    Status get_segment_iterators(RowsetReaderContext* read_context,
+                                 std::vector<RowwiseIteratorUPtr>* out_iters,
+                                 const RowSetSplits& rs_splits, bool use_cache) override {
+        return Status::NotSupported("mock");
+    }
+
+    void reset_read_options() override {}
+
+    Status next_block(Block* block) override {
+        if (_num_blocks_read == _blocks.size()) {
+            block->clear_column_data();
+            return Status::Error<ErrorCode::END_OF_FILE>("");
+        }
+        *block = _blocks[_num_blocks_read++];
+        return Status::OK();
+    }
+
+    Status next_block_view(BlockView* block_view) override {
+        return Status::NotSupported("mock");
+    }
+
+    bool delete_flag() override { return false; }
+
+    Version version() override { return {2, 2}; }
+
+    RowsetSharedPtr rowset() override { return nullptr; }
+
+    int64_t filtered_rows() override { return 0; }
+
+    RowsetTypePB type() const override { return RowsetTypePB::BETA_ROWSET; }
+
+    int64_t newest_write_timestamp() override { return 0; }
+
+    bool update_profile(RuntimeProfile* profile) override { return false; }
+
+    RowsetReaderSharedPtr clone() override { return nullptr; }
+
+    size_t num_blocks_read() const { return _num_blocks_read; }
+
+private:
+    std::vector<Block> _blocks;
+    size_t _num_blocks_read = 0;
+};
+
+// A reader of ORDER BY k LIMIT n on a duplicate key tablet of an int key k.
+class TopNTabletReader : public TabletReader {
+public:
+    TopNTabletReader(RuntimeState* state, size_t limit) {
+        TColumn column;
+        column.__set_column_name("k");
+        TColumnType column_type;
+        column_type.__set_type(TPrimitiveType::INT);
+        column.__set_column_type(column_type);
+        column.__set_is_key(true);
+        TTabletSchema tablet_schema;
+        tablet_schema.__set_short_key_column_count(1);
+        tablet_schema.__set_schema_hash(3333);
+        tablet_schema.__set_keys_type(TKeysType::DUP_KEYS);
+        tablet_schema.__set_storage_type(TStorageType::COLUMN);
+        tablet_schema.__set_columns({column});
+        std::unordered_map<uint32_t, uint32_t> col_ordinal_to_unique_id {{0, 0}};
+        TabletMetaSharedPtr tablet_meta(new TabletMeta(
+                1, 1, 1, 1, 1, 1, tablet_schema, 1, col_ordinal_to_unique_id, UniqueId(1, 2),
+                TTabletType::TABLET_TYPE_DISK, TCompressionType::LZ4F));
+        _tablet = std::make_shared<Tablet>(tablet_meta, nullptr);
+        _tablet_schema = _tablet->tablet_schema();
+
+        _reader_type = ReaderType::READER_QUERY;
+        _reader_context.runtime_state = state;
+        _reader_context.use_topn_opt = true;
+        _orderby_key_columns = {0};
+        _reader_context.read_orderby_key_columns = &_orderby_key_columns;
+        _reader_context.read_orderby_key_limit = limit;
+    }
+
+    TabletSchemaSPtr schema() const { return _tablet_schema; }
+};
+
+class VCollectIteratorTest : public testing::Test {
+public:
+    void SetUp() override {
+        _query_ctx = std::make_unique<QueryContext>(1, ExecEnv::GetInstance(), TQueryOptions());
+        _query_ctx->query_mem_tracker = std::make_shared<MemTrackerLimiter>(
+                MemTrackerLimiter::Type::QUERY, "VCollectIteratorTest");
+        _state.set_query_ctx(_query_ctx.get());
+    }
+
+    // Read the rowsets in order, and return the keys of the result.
+    std::vector<int32_t> read_topn(const std::vector<std::shared_ptr<MockRowsetReader>>& readers,
+                                   TopNTabletReader* tablet_reader) {
+        VCollectIterator iterator;
+        iterator.init(tablet_reader, false, false, false);
+        EXPECT_TRUE(iterator.use_topn_next());
+        for (const auto& reader : readers) {
+            EXPECT_TRUE(iterator.add_child(RowSetSplits(reader)).ok());
+        }
+        Block block = create_key_block({});
+        std::vector<int32_t> keys;
+        auto st = iterator.next(&block);
+        if (st.ok()) {
+            const auto& column = block.get_by_position(0).column;
+            for (size_t i = 0; i < column->size(); ++i) {
+                keys.push_back(column->get_int(i));
+            }
+        } else {
+            EXPECT_TRUE(st.is<ErrorCode::END_OF_FILE>()) << st;
+        }
+        return keys;
+    }
+
+protected:
+    RuntimeState _state;
+    std::unique_ptr<QueryContext> _query_ctx;
+};
+
+TEST_F(VCollectIteratorTest, topn_skip_rowset_out_of_shared_threshold) {
+    TopNTabletReader tablet_reader(&_state, 5);
+    auto& runtime_predicate = _query_ctx->get_runtime_predicate();
+    ASSERT_TRUE(runtime_predicate.init(TYPE_INT, false).ok());
+    runtime_predicate.set_tablet_schema(tablet_reader.schema());
+    // another instance of the query already has 5 rows not greater than 50
+    ASSERT_TRUE(runtime_predicate.update(Field(Int64(50)), "k", false).ok());
+
+    // the heap is not full after the first rowset, the min key of the second rowset is out of
+    // the shared threshold, while the third rowset is within it
+    auto first = std::make_shared<MockRowsetReader>(
+            std::vector<Block> {create_key_block({0, 1, 2})});
+    auto second = std::make_shared<MockRowsetReader>(std::vector<Block> {
+            create_key_block({100, 101}), create_key_block({102, 103})});
+    auto third = std::make_shared<MockRowsetReader>(
+            std::vector<Block> {create_key_block({10, 11})});
+    EXPECT_EQ(std::vector<int32_t>({0, 1, 2, 10, 11}),
+              read_topn({first, second, third}, &tablet_reader));
+    // only the first block of the second rowset is read to find its min key
+    EXPECT_EQ(1U, second->num_blocks_read());
+    EXPECT_EQ(1U, third->num_blocks_read());
+}
+
+TEST_F(VCollectIteratorTest, topn_stop_rowset_after_limit) {
+    TopNTabletReader tablet_reader(&_state, 3);
+
+    // the rest of a rowset is skipped once its next row is not less than the 3rd row collected
+    // so far
+    auto first = std::make_shared<MockRowsetReader>(
+            std::vector<Block> {create_key_block({0, 5}), create_key_block({6, 7, 8})});
+    auto second = std::make_shared<MockRowsetReader>(
+            std::vector<Block> {create_key_block({1, 7}), create_key_block({8})});
+    EXPECT_EQ(std::vector<int32_t>({0, 1, 5}), read_topn({first, second}, &tablet_reader));
+    EXPECT_EQ(2U, first->num_blocks_read());
+    EXPECT_EQ(1U, second->num_blocks_read());
+}
+
+} // namespace doris::vectorized
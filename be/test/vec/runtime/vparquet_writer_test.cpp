@@ -0,0 +1,251 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/vparquet_writer.h"
+
+#include <fmt/format.h>
+#include <gen_cpp/DataSinks_types.h>
+#include <gen_cpp/Exprs_types.h>
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+#include <parquet/column_reader.h>
+#include <parquet/file_reader.h>
+#include <parquet/metadata.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "gtest/gtest_pred_impl.h"
+#include "io/fs/file_writer.h"
+#include "io/fs/local_file_system.h"
+#include "runtime/types.h"
+#include "util/defer_op.h"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_decimal.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
+
+namespace doris::vectorized {
+
+static const std::string kTestDir = "./ut_dir/vparquet_writer_test";
+
+class VParquetWriterTest : public testing::Test {
+public:
+    void SetUp() override {
+        EXPECT_TRUE(io::global_local_filesystem()->delete_and_create_directory(kTestDir).ok());
+        // id INT NOT NULL, name VARCHAR NULL, price DECIMAL(18, 2) NULL
+        _output_vexpr_ctxs.push_back(_slot_ref(0, TypeDescriptor(TYPE_INT), false));
+        _output_vexpr_ctxs.push_back(_slot_ref(1, TypeDescriptor::create_string_type(), true));
+        _output_vexpr_ctxs.push_back(
+                _slot_ref(2, TypeDescriptor::create_decimalv3_type(18, 2), true));
+        _parquet_schemas.push_back(
+                _schema("id", TParquetRepetitionType::REQUIRED, TParquetDataType::INT32));
+        _parquet_schemas.push_back(
+                _schema("name", TParquetRepetitionType::OPTIONAL, TParquetDataType::BYTE_ARRAY));
+        _parquet_schemas.push_back(
+                _schema("price", TParquetRepetitionType::OPTIONAL, TParquetDataType::BYTE_ARRAY));
+    }
+
+    void TearDown() override {
+        EXPECT_TRUE(io::global_local_filesystem()->delete_directory(kTestDir).ok());
+    }
+
+    // The rows [start, start + count), the names of every third row and the prices of every
+    // fourth row are null.
+    static Block make_block(int start, int count) {
+        auto id = ColumnInt32::create();
+        auto name = ColumnString::create();
+        auto name_null_map = ColumnUInt8::create();
+        auto price_type = std::make_shared<DataTypeDecimal<Decimal64>>(18, 2);
+        auto price = ColumnDecimal<Decimal64>::create(0, 2);
+        auto price_null_map = ColumnUInt8::create();
+        for (int i = start; i < start + count; ++i) {
+            id->insert_value(i);
+            std::string name_value = _name(i);
+            name->insert_data(name_value.data(), name_value.size());
+            name_null_map->insert_value(i % 3 == 0);
+            price->insert_value(Decimal64(i * 101));
+            price_null_map->insert_value(i % 4 == 1);
+        }
+        return Block({{std::move(id), std::make_shared<DataTypeInt32>(), "id"},
+                      {ColumnNullable::create(std::move(name), std::move(name_null_map)),
+                       make_nullable(std::make_shared<DataTypeString>()), "name"},
+                      {ColumnNullable::create(std::move(price), std::move(price_null_map)),
+                       make_nullable(price_type), "price"}});
+    }
+
+    static std::string expected_row(int i) {
+        std::string price =
+                i % 4 == 1 ? "NULL" : fmt::format("{}.{:02}", i * 101 / 100, i * 101 % 100);
+        return fmt::format("{}|{}|{}", i, i % 3 == 0 ? "NULL" : _name(i), price);
+    }
+
+    Status write_file(const std::string& path, const std::vector<Block>& blocks) {
+        io::FileWriterPtr file_writer;
+        RETURN_IF_ERROR(io::global_local_filesystem()->create_file(path, &file_writer));
+        VParquetWriterWrapper writer(file_writer.get(), _output_vexpr_ctxs, _parquet_schemas,
+                                     _compression_type, _disable_dictionary, _parquet_version,
+                                     false);
+        RETURN_IF_ERROR(writer.prepare());
+        for (const auto& block : blocks) {
+            RETURN_IF_ERROR(writer.write(block));
+        }
+        writer.close();
+        return Status::OK();
+    }
+
+    // Read back the rows of the file as "id|name|price", and the number of rows of every row
+    // group.
+    static std::vector<std::string> read_file(const std::string& path,
+                                              std::vector<int64_t>* row_group_rows) {
+        std::vector<std::string> rows;
+        auto reader = parquet::ParquetFileReader::OpenFile(path, false);
+        for (int rg = 0; rg < reader->metadata()->num_row_groups(); ++rg) {
+            auto rg_reader = reader->RowGroup(rg);
+            int64_t num_rows = rg_reader->metadata()->num_rows();
+            row_group_rows->push_back(num_rows);
+            auto ids = _read_column<parquet::Int32Reader, int32_t>(
+                    rg_reader.get(), 0, num_rows, [](int32_t v) { return std::to_string(v); });
+            auto names = _read_column<parquet::ByteArrayReader, parquet::ByteArray>(
+                    rg_reader.get(), 1, num_rows, _byte_array_to_string);
+            auto prices = _read_column<parquet::ByteArrayReader, parquet::ByteArray>(
+                    rg_reader.get(), 2, num_rows, _byte_array_to_string);
+            EXPECT_EQ(num_rows, static_cast<int64_t>(ids.size()));
+            EXPECT_EQ(num_rows, static_cast<int64_t>(names.size()));
+            EXPECT_EQ(num_rows, static_cast<int64_t>(prices.size()));
+            for (size_t i = 0; i < ids.size() && i < names.size() && i < prices.size(); ++i) {
+                rows.push_back(ids[i] + "|" + names[i] + "|" + prices[i]);
+            }
+        }
+        return rows;
+    }
+
+private:
+    // the names have different lengths
+    static std::string _name(int i) {
+        return "name_" + std::string(i % 20, 'n') + std::to_string(i);
+    }
+
+    static std::string _byte_array_to_string(const parquet::ByteArray& value) {
+        return std::string(reinterpret_cast<const char*>(value.ptr), value.len);
+    }
+
+    template <typename ReaderType, typename ValueType, typename Formatter>
+    static std::vector<std::string> _read_column(parquet::RowGroupReader* rg_reader, int col_id,
+                                                 int64_t num_rows, Formatter&& format) {
+        auto column_reader = rg_reader->Column(col_id);
+        auto* reader = static_cast<ReaderType*>(column_reader.get());
+        bool nullable = reader->descr()->max_definition_level() > 0;
+        std::vector<int16_t> def_levels(num_rows);
+        std::vector<ValueType> values(num_rows);
+        std::vector<std::string> result;
+        while (static_cast<int64_t>(result.size()) < num_rows && reader->HasNext()) {
+            int64_t values_read = 0;
+            int64_t levels_read =
+                    reader->ReadBatch(num_rows - static_cast<int64_t>(result.size()),
+                                      def_levels.data(), nullptr, values.data(), &values_read);
+            int64_t value_id = 0;
+            for (int64_t i = 0; i < levels_read; ++i) {
+                if (nullable && def_levels[i] == 0) {
+                    result.emplace_back("NULL");
+                } else {
+                    result.push_back(format(values[value_id++]));
+                }
+            }
+            EXPECT_EQ(values_read, value_id);
+        }
+        return result;
+    }
+
+    static VExprContextSPtr _slot_ref(int slot_id, const TypeDescriptor& type, bool nullable) {
+        TExprNode node;
+        node.node_type = TExprNodeType::SLOT_REF;
+        node.type = type.to_thrift();
+        node.num_children = 0;
+        node.__set_is_nullable(nullable);
+        TSlotRef slot_ref;
+        slot_ref.slot_id = slot_id;
+        slot_ref.tuple_id = 0;
+        node.__set_slot_ref(slot_ref);
+        TExpr texpr;
+        texpr.nodes.push_back(node);
+        VExprContextSPtr ctx;
+        EXPECT_TRUE(VExpr::create_expr_tree(texpr, ctx).ok());
+        return ctx;
+    }
+
+    static TParquetSchema _schema(const std::string& name, TParquetRepetitionType::type repetition,
+                                  TParquetDataType::type data_type) {
+        TParquetSchema schema;
+        schema.__set_schema_column_name(name);
+        schema.__set_schema_repetition_type(repetition);
+        schema.__set_schema_data_type(data_type);
+        schema.__set_schema_data_logical_type(TParquetDataLogicalType::UNDEFINED);
+        return schema;
+    }
+
+    VExprContextSPtrs _output_vexpr_ctxs;
+    std::vector<TParquetSchema> _parquet_schemas;
+    TParquetCompressionType::type _compression_type = TParquetCompressionType::SNAPPY;
+    bool _disable_dictionary = false;
+    TParquetVersion::type _parquet_version = TParquetVersion::PARQUET_1_0;
+};
+
+TEST_F(VParquetWriterTest, nullable_decimal_string_columns) {
+    std::string path = kTestDir + "/one_row_group.parquet";
+    ASSERT_TRUE(write_file(path, {make_block(0, 100)}).ok());
+
+    std::vector<int64_t> row_group_rows;
+    auto rows = read_file(path, &row_group_rows);
+    EXPECT_EQ(std::vector<int64_t>({100}), row_group_rows);
+    ASSERT_EQ(100U, rows.size());
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(expected_row(i), rows[i]);
+    }
+}
+
+TEST_F(VParquetWriterTest, multiple_row_groups) {
+    // every block after the first one starts a new row group
+    int32_t old_max_buffer_mb = config::parquet_writer_row_group_max_buffer_mb;
+    config::parquet_writer_row_group_max_buffer_mb = 0;
+    Defer defer {[&]() { config::parquet_writer_row_group_max_buffer_mb = old_max_buffer_mb; }};
+
+    // the empty block is skipped, and the block of row 10 has no null
+    std::string path = kTestDir + "/multiple_row_groups.parquet";
+    ASSERT_TRUE(write_file(path, {make_block(0, 10), make_block(10, 0), make_block(10, 1),
+                                  make_block(11, 1000)})
+                        .ok());
+
+    std::vector<int64_t> row_group_rows;
+    auto rows = read_file(path, &row_group_rows);
+    EXPECT_EQ(std::vector<int64_t>({10, 1, 1000}), row_group_rows);
+    ASSERT_EQ(1011U, rows.size());
+    for (int i = 0; i < 1011; ++i) {
+        EXPECT_EQ(expected_row(i), rows[i]);
+    }
+}
+
+} // namespace doris::vectorized
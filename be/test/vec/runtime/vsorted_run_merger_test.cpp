@@ -0,0 +1,78 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/vsorted_run_merger.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest_pred_impl.h"
+#include "util/runtime_profile.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+
+TEST(VSortedRunMergerTest, merge_runs) {
+    // the runs of multiple blocks, some of them are empty
+    std::vector<std::vector<std::vector<int64_t>>> runs {
+            {{1, 4, 7}, {10, 13}}, {}, {{2, 2, 5}}, {{0}, {3, 8}, {9, 20}}, {{6, 6}}};
+    std::vector<int64_t> expected;
+    std::vector<BlockSupplier> suppliers;
+    for (const auto& run : runs) {
+        auto index = std::make_shared<size_t>(0);
+        for (const auto& values : run) {
+            expected.insert(expected.end(), values.begin(), values.end());
+        }
+        suppliers.emplace_back([run, index](Block* block, bool* eos) {
+            if (*index == run.size()) {
+                *eos = true;
+                return Status::OK();
+            }
+            auto column = ColumnInt64::create();
+            for (auto value : run[(*index)++]) {
+                column->insert_value(value);
+            }
+            *block = Block({{std::move(column), std::make_shared<DataTypeInt64>(), "c0"}});
+            *eos = false;
+            return Status::OK();
+        });
+    }
+    std::sort(expected.begin(), expected.end());
+
+    RuntimeProfile profile("test");
+    SortDescription description {{0, 1, 1}};
+    VSortedRunMerger merger(description, 4, -1, 0, &profile);
+    EXPECT_TRUE(merger.prepare(suppliers).ok());
+
+    std::vector<int64_t> merged;
+    bool eos = false;
+    while (!eos) {
+        Block block;
+        EXPECT_TRUE(merger.get_next(&block, &eos).ok());
+        for (size_t i = 0; i < block.rows(); ++i) {
+            merged.push_back(block.get_by_position(0).column->get_int(i));
+        }
+    }
+    EXPECT_EQ(expected, merged);
+}
+
+} // namespace doris::vectorized